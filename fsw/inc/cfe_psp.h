@@ -86,6 +86,12 @@
 #define CFE_PSP_MEM_SIZE_WORD  0x02
 #define CFE_PSP_MEM_SIZE_DWORD 0x04
 
+/*
+** Checksum algorithms for CFE_PSP_MemChecksum()
+*/
+#define CFE_PSP_MEM_CHECKSUM_CRC32C     1 /**< CRC-32C (Castagnoli), as used by iSCSI and ext4 */
+#define CFE_PSP_MEM_CHECKSUM_FLETCHER32 2 /**< Fletcher-32 over little-endian 16-bit words */
+
 /*
  * Common definition for reset types at the PSP layer
  */
@@ -131,6 +137,38 @@
  */
 #define CFE_PSP_SOFT_TIMEBASE_NAME "cFS-Master"
 
+/*
+** Vectored CDS access
+*/
+/**
+ * @brief Flag for CFE_PSP_WriteToCDSv() and CFE_PSP_ReadFromCDSv()
+ *
+ * Issues a full memory barrier, so all copies are complete and visible before
+ * any memory access that follows the call (write), or so no copy observes data
+ * older than memory accesses that preceded the call (read).
+ */
+#define CFE_PSP_CDS_VEC_FENCE 0x01
+
+/**
+ * @brief One range of a vectored CDS write
+ */
+typedef struct
+{
+    uint32      CDSOffset; /**< Offset within the CDS */
+    uint32      NumBytes;  /**< Number of bytes to write */
+    const void *DataPtr;   /**< Data to write */
+} CFE_PSP_CDSWriteVec_t;
+
+/**
+ * @brief One range of a vectored CDS read
+ */
+typedef struct
+{
+    uint32 CDSOffset; /**< Offset within the CDS */
+    uint32 NumBytes;  /**< Number of bytes to read */
+    void * DataPtr;   /**< Buffer to read into */
+} CFE_PSP_CDSReadVec_t;
+
 /******************************************************************************
  FUNCTION PROTOTYPES
  ******************************************************************************/
@@ -336,6 +374,50 @@ extern int32 CFE_PSP_WriteToCDS(const void *PtrToDataToWrite, uint32 CDSOffset,
  */
 extern int32 CFE_PSP_ReadFromCDS(void *PtrToDataToRead, uint32 CDSOffset, uint32 NumBytes);
 
+/*--------------------------------------------------------------------------------------*/
+/**
+ * @brief Writes a set of ranges to the CDS Block.
+ *
+ * All entries are validated before any data is copied, so either every
+ * range is written or none of them are.  Entries are copied in array order.
+ *
+ * @param[in] Vec        Array of ranges to write
+ * @param[in] NumEntries Number of entries in the array
+ * @param[in] Flags      Zero or CFE_PSP_CDS_VEC_FENCE
+ *
+ * @return 0 (OS_SUCCESS or CFE_PSP_SUCCESS) on success, -1 (OS_ERROR or CFE_PSP_ERROR) on error
+ */
+extern int32 CFE_PSP_WriteToCDSv(const CFE_PSP_CDSWriteVec_t *Vec, uint32 NumEntries, uint32 Flags);
+
+/*--------------------------------------------------------------------------------------*/
+/**
+ * @brief Reads a set of ranges from the CDS Block.
+ *
+ * All entries are validated before any data is copied, so either every
+ * range is read or none of them are.  Entries are copied in array order.
+ *
+ * @param[in] Vec        Array of ranges to read
+ * @param[in] NumEntries Number of entries in the array
+ * @param[in] Flags      Zero or CFE_PSP_CDS_VEC_FENCE
+ *
+ * @return 0 (OS_SUCCESS or CFE_PSP_SUCCESS) on success, -1 (OS_ERROR or CFE_PSP_ERROR) on error
+ */
+extern int32 CFE_PSP_ReadFromCDSv(const CFE_PSP_CDSReadVec_t *Vec, uint32 NumEntries, uint32 Flags);
+
+/*--------------------------------------------------------------------------------------*/
+/**
+ * @brief Flushes modified CDS content to persistent storage.
+ *
+ * On platforms where the CDS is kept in volatile memory with a separate
+ * backing store, this copies only the portions of the CDS written since
+ * the previous flush out to that store.
+ *
+ * @retval CFE_PSP_SUCCESS               if the backing store is up to date
+ * @retval CFE_PSP_ERROR                 if the backing store could not be written
+ * @retval CFE_PSP_ERROR_NOT_IMPLEMENTED if the platform has no separate backing store
+ */
+extern int32 CFE_PSP_FlushCDS(void);
+
 /*--------------------------------------------------------------------------------------*/
 /**
  * @brief Returns the location and size of the ES Reset information area.
@@ -708,6 +790,54 @@ int32 CFE_PSP_MemRead32(cpuaddr MemoryAddress, uint32 *uint32Value);
  */
 int32 CFE_PSP_MemWrite32(cpuaddr MemoryAddress, uint32 uint32Value);
 
+/*--------------------------------------------------------------------------------------*/
+/**
+ * @brief Read a block of memory.
+ *
+ * The block must lie within a single range of the memory table (see CFE_PSP_MemRangeSet)
+ * that has the CFE_PSP_MEM_ATTR_READ attribute.  The memory is accessed using the word
+ * size of that range, so both the address and the size must be a multiple of it.
+ * Ranges with a word size of CFE_PSP_MEM_SIZE_BYTE are copied using the widest accesses
+ * the processor allows.
+ *
+ * @param[in]  MemoryAddress Address of the first byte to read
+ * @param[out] Buffer        The memory content will be copied to this buffer
+ * @param[in]  Size          Number of bytes to read
+ *
+ * @retval CFE_PSP_SUCCESS on success
+ * @retval CFE_PSP_INVALID_POINTER if the buffer is NULL
+ * @retval CFE_PSP_INVALID_MEM_ADDR or CFE_PSP_INVALID_MEM_RANGE if the block is not within a memory range
+ * @retval CFE_PSP_INVALID_MEM_ATTR if no range containing the block is readable
+ * @retval CFE_PSP_ERROR_ADDRESS_MISALIGNED if the address or size is not a multiple of the word size
+ * @retval CFE_PSP_ERROR_NOT_IMPLEMENTED if not implemented
+ */
+int32 CFE_PSP_MemReadBlock(cpuaddr MemoryAddress, void *Buffer, size_t Size);
+
+/*--------------------------------------------------------------------------------------*/
+/**
+ * @brief Write a block of memory.
+ *
+ * The block must lie within a single range of the memory table (see CFE_PSP_MemRangeSet)
+ * that has the CFE_PSP_MEM_ATTR_WRITE attribute.  The memory is accessed using the word
+ * size of that range, so both the address and the size must be a multiple of it.
+ * Ranges with a word size of CFE_PSP_MEM_SIZE_BYTE are copied using the widest accesses
+ * the processor allows.  Ranges of type CFE_PSP_MEM_EEPROM are instead written one word
+ * at a time with CFE_PSP_EepromWrite8/16/32.
+ *
+ * @param[out] MemoryAddress Address of the first byte to write
+ * @param[in]  Buffer        The content of this buffer will be copied to memory
+ * @param[in]  Size          Number of bytes to write
+ *
+ * @retval CFE_PSP_SUCCESS on success
+ * @retval CFE_PSP_INVALID_POINTER if the buffer is NULL
+ * @retval CFE_PSP_INVALID_MEM_ADDR or CFE_PSP_INVALID_MEM_RANGE if the block is not within a memory range
+ * @retval CFE_PSP_INVALID_MEM_ATTR if no range containing the block is writable
+ * @retval CFE_PSP_ERROR_ADDRESS_MISALIGNED if the address or size is not a multiple of the word size
+ * @retval CFE_PSP_ERROR_NOT_IMPLEMENTED if not implemented
+ * @retval Any error of the EEPROM API, for an EEPROM range
+ */
+int32 CFE_PSP_MemWriteBlock(cpuaddr MemoryAddress, const void *Buffer, size_t Size);
+
 /*--------------------------------------------------------------------------------------*/
 /**
  * @brief Copy 'n' bytes from 'src' to 'dest'
@@ -744,6 +874,75 @@ int32 CFE_PSP_MemCpy(void *dest, const void *src, uint32 n);
  */
 int32 CFE_PSP_MemSet(void *dest, uint8 value, uint32 n);
 
+/*--------------------------------------------------------------------------------------*/
+/**
+ * @brief Copy 'n' bytes from 'src' to 'dest', with a full size_t length
+ *
+ * Same as CFE_PSP_MemCpy() but not limited to 32-bit lengths.
+ * The source and destination must not overlap.
+ *
+ * @param[out] dest Pointer to the destination address to copy to
+ * @param[in]  src  Pointer to the address to copy from
+ * @param[in]  n    Number of bytes to copy
+ *
+ * @return Always returns CFE_PSP_SUCCESS
+ */
+int32 CFE_PSP_MemCpy64(void *dest, const void *src, size_t n);
+
+/*--------------------------------------------------------------------------------------*/
+/**
+ * @brief Copy 'n' bytes from 'src' to 'dest', bypassing the data cache where possible
+ *
+ * Intended for large blocks that will not be accessed again soon, such as
+ * memory dumps, so the copy does not evict the working set of other tasks.
+ * On processors without non-temporal stores this is a normal copy.
+ * The source and destination must not overlap.
+ *
+ * @param[out] dest Pointer to the destination address to copy to
+ * @param[in]  src  Pointer to the address to copy from
+ * @param[in]  n    Number of bytes to copy
+ *
+ * @return Always returns CFE_PSP_SUCCESS
+ */
+int32 CFE_PSP_MemCpyStream(void *dest, const void *src, size_t n);
+
+/*--------------------------------------------------------------------------------------*/
+/**
+ * @brief Compare 'n' bytes of two memory blocks
+ *
+ * @param[in]  s1             Pointer to the first block
+ * @param[in]  s2             Pointer to the second block
+ * @param[in]  n              Number of bytes to compare
+ * @param[out] MismatchOffset Set to the offset of the first differing byte, or to 'n' if
+ *                            the blocks are equal.  May be NULL if not needed.
+ *
+ * @retval CFE_PSP_SUCCESS         if the blocks are equal
+ * @retval CFE_PSP_ERROR           if the blocks differ
+ * @retval CFE_PSP_INVALID_POINTER if either block pointer is NULL
+ */
+int32 CFE_PSP_MemCmp(const void *s1, const void *s2, size_t n, size_t *MismatchOffset);
+
+/*--------------------------------------------------------------------------------------*/
+/**
+ * @brief Compute a checksum over a memory block
+ *
+ * The fastest implementation available on the processor is selected on first use.
+ *
+ * The checksum can be computed incrementally over several blocks by passing
+ * the output of one call as the input of the next; start with 0.  For
+ * CFE_PSP_MEM_CHECKSUM_FLETCHER32 all blocks but the last must have an even size.
+ *
+ * @param[in]     src      Pointer to the block
+ * @param[in]     n        Number of bytes in the block
+ * @param[in]     Type     CFE_PSP_MEM_CHECKSUM_CRC32C or CFE_PSP_MEM_CHECKSUM_FLETCHER32
+ * @param[in,out] Checksum Checksum of the previous blocks on input, updated checksum on output
+ *
+ * @retval CFE_PSP_SUCCESS         on success
+ * @retval CFE_PSP_INVALID_POINTER if a pointer is NULL
+ * @retval CFE_PSP_ERROR           if the checksum type is not valid
+ */
+int32 CFE_PSP_MemChecksum(const void *src, size_t n, uint32 Type, uint32 *Checksum);
+
 /*--------------------------------------------------------------------------------------*/
 /**
  * @brief Validates the memory range and type using the global CFE_PSP_MemoryTable
@@ -762,6 +961,30 @@ int32 CFE_PSP_MemSet(void *dest, uint8 value, uint32 n);
  */
 int32 CFE_PSP_MemValidateRange(cpuaddr Address, size_t Size, uint32 MemoryType);
 
+/*--------------------------------------------------------------------------------------*/
+/**
+ * @brief Finds the memory range that permits an access to a block of memory
+ *
+ * Looks for a range of the CFE_PSP_MemoryTable that contains the whole block, has all
+ * of the given attributes, and has a word size that both the address and the size
+ * are a multiple of.  This uses the same index as CFE_PSP_MemValidateRange, the
+ * details of the range can then be read with CFE_PSP_MemRangeGet.
+ *
+ * @param[in]  Address    Starting address of the block
+ * @param[in]  Size       Size of the block
+ * @param[in]  Attributes The attributes the access needs:
+ *                        (CFE_PSP_MEM_ATTR_WRITE, CFE_PSP_MEM_ATTR_READ, CFE_PSP_MEM_ATTR_READWRITE)
+ * @param[out] RangeNum   Index of the matching range
+ *
+ * @retval CFE_PSP_SUCCESS                  A matching range was found
+ * @retval CFE_PSP_INVALID_POINTER          RangeNum is NULL
+ * @retval CFE_PSP_INVALID_MEM_ADDR         No range contains the starting address
+ * @retval CFE_PSP_INVALID_MEM_RANGE        No range containing the starting address is large enough
+ * @retval CFE_PSP_INVALID_MEM_ATTR         No range containing the block has the attributes
+ * @retval CFE_PSP_ERROR_ADDRESS_MISALIGNED The block is not aligned to the word size of any suitable range
+ */
+int32 CFE_PSP_MemRangeFind(cpuaddr Address, size_t Size, uint32 Attributes, uint32 *RangeNum);
+
 /*--------------------------------------------------------------------------------------*/
 /**
  * @brief Returns the number of memory ranges in the CFE_PSP_MemoryTable
@@ -7,4 +7,5 @@ eeprom_direct
 ram_direct
 port_direct
 iodriver
+sysmon
 vxworks_sysmon
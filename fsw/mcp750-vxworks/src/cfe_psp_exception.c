@@ -142,7 +142,7 @@ void CFE_PSP_ExceptionHook(TASK_ID task_id, int vector, void *vpEsf)
          */
         Buffer->context_size = sizeof(Buffer->context_info);
 
-        CFE_PSP_Exception_WriteComplete();
+        CFE_PSP_Exception_WriteComplete(Buffer);
     }
 
     if (GLOBAL_CFE_CONFIGDATA.SystemNotify != NULL)
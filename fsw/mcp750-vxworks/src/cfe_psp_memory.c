@@ -191,6 +191,119 @@ int32 CFE_PSP_ReadFromCDS(void *PtrToDataToRead, uint32 CDSOffset, uint32 NumByt
     return return_code;
 }
 
+/******************************************************************************
+**
+**  Purpose:
+**   This function writes a set of ranges to the CDS Block
+**
+**  Arguments:
+**    See description in header file
+**
+**  Return:
+**    See description in header file
+*/
+
+int32 CFE_PSP_WriteToCDSv(const CFE_PSP_CDSWriteVec_t *Vec, uint32 NumEntries, uint32 Flags)
+{
+    uint8 *CDSPtr;
+    size_t CDSSize;
+    uint32 i;
+
+    if (Vec == NULL)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    /* Validate every range first, so the update is all or nothing */
+    CDSSize = CFE_PSP_ReservedMemoryMap.CDSMemory.BlockSize;
+    for (i = 0; i < NumEntries; ++i)
+    {
+        if (Vec[i].DataPtr == NULL || Vec[i].CDSOffset >= CDSSize || Vec[i].NumBytes > (CDSSize - Vec[i].CDSOffset))
+        {
+            return CFE_PSP_ERROR;
+        }
+    }
+
+    CDSPtr = CFE_PSP_ReservedMemoryMap.CDSMemory.BlockPtr;
+    for (i = 0; i < NumEntries; ++i)
+    {
+        memcpy(&CDSPtr[Vec[i].CDSOffset], Vec[i].DataPtr, Vec[i].NumBytes);
+    }
+
+    if ((Flags & CFE_PSP_CDS_VEC_FENCE) != 0)
+    {
+        __sync_synchronize();
+    }
+
+    return CFE_PSP_SUCCESS;
+}
+
+/******************************************************************************
+**
+**  Purpose:
+**   This function reads a set of ranges from the CDS Block
+**
+**  Arguments:
+**    See description in header file
+**
+**  Return:
+**    See description in header file
+*/
+
+int32 CFE_PSP_ReadFromCDSv(const CFE_PSP_CDSReadVec_t *Vec, uint32 NumEntries, uint32 Flags)
+{
+    const uint8 *CDSPtr;
+    size_t       CDSSize;
+    uint32       i;
+
+    if (Vec == NULL)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    /* Validate every range first, so the read is all or nothing */
+    CDSSize = CFE_PSP_ReservedMemoryMap.CDSMemory.BlockSize;
+    for (i = 0; i < NumEntries; ++i)
+    {
+        if (Vec[i].DataPtr == NULL || Vec[i].CDSOffset >= CDSSize || Vec[i].NumBytes > (CDSSize - Vec[i].CDSOffset))
+        {
+            return CFE_PSP_ERROR;
+        }
+    }
+
+    if ((Flags & CFE_PSP_CDS_VEC_FENCE) != 0)
+    {
+        __sync_synchronize();
+    }
+
+    CDSPtr = CFE_PSP_ReservedMemoryMap.CDSMemory.BlockPtr;
+    for (i = 0; i < NumEntries; ++i)
+    {
+        memcpy(Vec[i].DataPtr, &CDSPtr[Vec[i].CDSOffset], Vec[i].NumBytes);
+    }
+
+    return CFE_PSP_SUCCESS;
+}
+
+/******************************************************************************
+**
+**  Purpose:
+**   This function flushes the CDS Block to its backing store.
+**   The CDS lives directly in the preserved USER_RESERVED_MEM area on this
+**   platform, so there is no separate backing store to update.
+**
+**  Arguments:
+**    (none)
+**
+**  Return:
+**    CFE_PSP_ERROR_NOT_IMPLEMENTED
+*/
+
+int32 CFE_PSP_FlushCDS(void)
+{
+    return CFE_PSP_ERROR_NOT_IMPLEMENTED;
+}
+
 /*
 *********************************************************************************
 ** ES Reset Area related functions
@@ -24,6 +24,9 @@
  *
  * This is an implementation of the PSP EEPROM API calls that operates on a
  * memory-mapped disk file, therefore emulating the persistence of a real eeprom device.
+ *
+ * When built with PSP_EEPROM_MMAP_FILE_JOURNAL, writes are committed to the file
+ * through a journal instead, see cfe_psp_eeprom_mmap_journal.h
  */
 
 #include <unistd.h>
@@ -31,90 +34,133 @@
 #include <sys/mman.h>
 #include <sys/stat.h>
 
+#include <stdio.h>
+
 #include "cfe_psp.h"
+#include "cfe_psp_config.h"
 #include "cfe_psp_module.h"
 
+#ifdef CFE_PSP_EEPROM_MMAP_FILE_JOURNAL
+#include "cfe_psp_eeprom_mmap_journal.h"
+#endif
+
 /*
 ** Defines
 */
-#define EEPROM_FILE "EEPROM.DAT"
+
+/*
+** Build-time defaults for the simulated EEPROM layout, used for any value
+** not given on the command line (see CFE_PSP_EepromConfig_t).
+** Normally set by the build system from the PSP_EEPROM_MMAP_FILE_* options.
+*/
+#ifndef CFE_PSP_EEPROM_MMAP_FILE_NAME
+#define CFE_PSP_EEPROM_MMAP_FILE_NAME "EEPROM.DAT"
+#endif
+#ifndef CFE_PSP_EEPROM_MMAP_FILE_SIZE
+#define CFE_PSP_EEPROM_MMAP_FILE_SIZE 0x80000
+#endif
+#ifndef CFE_PSP_EEPROM_MMAP_FILE_BANKS
+#define CFE_PSP_EEPROM_MMAP_FILE_BANKS 1
+#endif
+
+/*
+** Banks at least this large get access pattern hints, see CFE_PSP_SetupEEPROM()
+*/
+#define EEPROM_MADVISE_THRESHOLD (1024 * 1024)
+
+/*
+** In journal mode the file is only updated by a commit, so the mapping
+** must not write back on its own.  It is also read-only, so a store that
+** does not go through the journal faults instead of being silently lost.
+*/
+#ifdef CFE_PSP_EEPROM_MMAP_FILE_JOURNAL
+#define EEPROM_MAP_FLAGS MAP_PRIVATE
+#define EEPROM_MAP_PROT  PROT_READ
+#else
+#define EEPROM_MAP_FLAGS MAP_SHARED
+#define EEPROM_MAP_PROT  (PROT_READ | PROT_WRITE)
+#endif
+
+/*
+** Memory range entry 0 is the RAM, each bank uses the entry after it
+*/
+#if (CFE_PSP_NUM_EEPROM_BANKS >= CFE_PSP_MEM_TABLE_SIZE)
+#error "CFE_PSP_MEM_TABLE_SIZE is too small for CFE_PSP_NUM_EEPROM_BANKS"
+#endif
 
 CFE_PSP_MODULE_DECLARE_SIMPLE(eeprom_mmap_file);
 
 /*
-** Simulate EEPROM by mapping in a file
+** Simulate an EEPROM bank by mapping in a file
 */
-int32 CFE_PSP_SetupEEPROM(uint32 EEPROMSize, cpuaddr *EEPROMAddress)
+int32 CFE_PSP_SetupEEPROM(uint32 Bank, const char *FileName, uint32 EEPROMSize, cpuaddr *EEPROMAddress)
 {
     int         FileDescriptor;
-    int         ReturnStatus;
     char *      DataBuffer;
     struct stat StatBuf;
 
     /*
-    ** Check to see if the file has been created.
-    ** If not, create it.
-    ** If so, then open it for read/write
+    ** Open the file, creating it if needed.
+    ** A file smaller than the bank (including a new one) is extended with
+    ** zeros; existing content is kept.
     */
-    ReturnStatus = stat(EEPROM_FILE, &StatBuf);
-    if (ReturnStatus == -1)
+    FileDescriptor = open(FileName, O_RDWR | O_CREAT, S_IRWXU);
+    if (FileDescriptor == -1)
     {
-        /*
-        ** File does not exist, create it.
-        */
-        FileDescriptor = open(EEPROM_FILE, O_RDWR | O_CREAT, S_IRWXU);
-        if (FileDescriptor == -1)
-        {
-            OS_printf("CFE_PSP: Cannot open EEPROM File: %s\n", EEPROM_FILE);
-            return -1;
-        }
-        else
-        {
-            /*
-            ** Need to seek to the desired EEPROM size
-            */
-            if (lseek(FileDescriptor, EEPROMSize - 1, SEEK_SET) == -1)
-            {
-                OS_printf("CFE_PSP: Cannot Seek to end of EEPROM file.\n");
-                close(FileDescriptor);
-                return -1;
-            }
+        OS_printf("CFE_PSP: Cannot open EEPROM File: %s\n", FileName);
+        perror("CFE_PSP: open");
+        return -1;
+    }
 
-            /*
-            ** Write a byte at the end of the File
-            */
-            if (write(FileDescriptor, "", 1) != 1)
-            {
-                OS_printf("CFE_PSP: Cannot write to EEPROM file\n");
-                close(FileDescriptor);
-                return -1;
-            }
-        }
+    if (fstat(FileDescriptor, &StatBuf) == -1 ||
+        ((size_t)StatBuf.st_size < EEPROMSize && ftruncate(FileDescriptor, EEPROMSize) == -1))
+    {
+        OS_printf("CFE_PSP: Cannot set size of EEPROM file %s\n", FileName);
+        close(FileDescriptor);
+        return -1;
     }
-    else
+
+#ifdef CFE_PSP_EEPROM_MMAP_FILE_JOURNAL
+    /*
+    ** Complete any commit that was interrupted, before mapping the file
+    */
+    if (eeprom_mmap_journal_Open(Bank, FileName, FileDescriptor, EEPROMSize) != CFE_PSP_SUCCESS)
     {
-        /*
-        ** File exists
-        */
-        FileDescriptor = open(EEPROM_FILE, O_RDWR);
-        if (FileDescriptor == -1)
-        {
-            OS_printf("CFE_PSP: Cannot open EEPROM File: %s\n", EEPROM_FILE);
-            perror("CFE_PSP: open");
-            return -1;
-        }
+        close(FileDescriptor);
+        return -1;
     }
+#endif
 
     /*
     ** Map the file to a memory space
     */
-    if ((DataBuffer = mmap(NULL, EEPROMSize, PROT_READ | PROT_WRITE, MAP_SHARED, FileDescriptor, 0)) == (void *)(-1))
+    if ((DataBuffer = mmap(NULL, EEPROMSize, EEPROM_MAP_PROT, EEPROM_MAP_FLAGS, FileDescriptor, 0)) ==
+        (void *)(-1))
     {
         OS_printf("CFE_PSP: mmap to EEPROM File failed\n");
+#ifdef CFE_PSP_EEPROM_MMAP_FILE_JOURNAL
+        eeprom_mmap_journal_Close(Bank);
+#endif
         close(FileDescriptor);
         return -1;
     }
 
+    /*
+    ** Large images hold many tables that are accessed individually, so
+    ** disable the sequential readahead and instead load the whole image
+    ** into the page cache now, ahead of the first access.
+    */
+    if (EEPROMSize >= EEPROM_MADVISE_THRESHOLD &&
+        (madvise(DataBuffer, EEPROMSize, MADV_RANDOM) == -1 || madvise(DataBuffer, EEPROMSize, MADV_WILLNEED) == -1))
+    {
+        OS_printf("CFE_PSP: madvise on EEPROM File %s failed\n", FileName);
+    }
+
+#ifdef CFE_PSP_EEPROM_MMAP_FILE_JOURNAL
+    /* The journal keeps using the descriptor to commit */
+    eeprom_mmap_journal_Attach(Bank, (cpuaddr)DataBuffer);
+#endif
+
     /*
     ** Return the address to the caller
     */
@@ -123,6 +169,39 @@ int32 CFE_PSP_SetupEEPROM(uint32 EEPROMSize, cpuaddr *EEPROMAddress)
     return 0;
 }
 
+#ifdef CFE_PSP_EEPROM_MMAP_FILE_JOURNAL
+
+/* For write - the journal needs to know which pages were modified,
+ * so all writes go through it.  Reads can still dereference directly.
+ */
+int32 CFE_PSP_EepromWrite32(cpuaddr MemoryAddress, uint32 uint32Value)
+{
+    return eeprom_mmap_journal_Write(MemoryAddress, &uint32Value, sizeof(uint32Value));
+}
+
+int32 CFE_PSP_EepromWrite16(cpuaddr MemoryAddress, uint16 uint16Value)
+{
+    return eeprom_mmap_journal_Write(MemoryAddress, &uint16Value, sizeof(uint16Value));
+}
+
+int32 CFE_PSP_EepromWrite8(cpuaddr MemoryAddress, uint8 ByteValue)
+{
+    return eeprom_mmap_journal_Write(MemoryAddress, &ByteValue, sizeof(ByteValue));
+}
+
+/* Writes between enable and disable are committed as one unit */
+int32 CFE_PSP_EepromWriteEnable(uint32 Bank)
+{
+    return eeprom_mmap_journal_Begin(Bank);
+}
+
+int32 CFE_PSP_EepromWriteDisable(uint32 Bank)
+{
+    return eeprom_mmap_journal_End(Bank);
+}
+
+#else
+
 /* For read/write - As this is mmap'ed we dereference the pointer directly.
  * Hopefully the caller didn't get it wrong.
  * No need to do anything special for 8/16/32 width access in this mode.
@@ -155,6 +234,8 @@ int32 CFE_PSP_EepromWriteDisable(uint32 Bank)
     return CFE_PSP_ERROR_NOT_IMPLEMENTED;
 }
 
+#endif
+
 int32 CFE_PSP_EepromPowerUp(uint32 Bank)
 {
     return CFE_PSP_SUCCESS;
@@ -167,33 +248,80 @@ int32 CFE_PSP_EepromPowerDown(uint32 Bank)
 
 void eeprom_mmap_file_Init(uint32 PspModuleId)
 {
-    int32   Status;
-    cpuaddr eeprom_address;
-    uint32  eeprom_size;
+    int32       Status;
+    cpuaddr     eeprom_address;
+    uint32      eeprom_size;
+    uint32      num_banks;
+    uint32      bank;
+    uint32      range_num;
+    const char *base_name;
+    char        file_name[CFE_PSP_EEPROM_FILE_NAME_LENGTH + 16];
 
     /* Inform the user that this module is in use */
     printf("CFE_PSP: Using MMAP simulated EEPROM implementation\n");
 
     /*
-    ** Create the simulated EEPROM segment by mapping a memory segment to a file.
-    ** Since the file will be saved, the "EEPROM" contents will be preserved.
-    ** Set up 512Kbytes of EEPROM
+    ** Use the layout from the command line, if given
     */
-    eeprom_size = 0x80000;
-    Status      = CFE_PSP_SetupEEPROM(eeprom_size, &eeprom_address);
+    base_name = CFE_PSP_EepromConfig.FileName;
+    if (base_name[0] == 0)
+    {
+        base_name = CFE_PSP_EEPROM_MMAP_FILE_NAME;
+    }
 
-    if (Status == 0)
+    eeprom_size = CFE_PSP_EepromConfig.BankSize;
+    if (eeprom_size == 0)
     {
-        /*
-        ** Install the 2nd memory range as the mapped file ( EEPROM )
-        */
-        Status = CFE_PSP_MemRangeSet(1, CFE_PSP_MEM_EEPROM, eeprom_address, eeprom_size, CFE_PSP_MEM_SIZE_DWORD,
-                                     CFE_PSP_MEM_ATTR_READWRITE);
-        OS_printf("CFE_PSP: EEPROM Range (2) created: Start Address = %08lX, Size = %08X Status = %d\n",
-                  (unsigned long)eeprom_address, (unsigned int)eeprom_size, Status);
+        eeprom_size = CFE_PSP_EEPROM_MMAP_FILE_SIZE;
     }
-    else
+
+    num_banks = CFE_PSP_EepromConfig.NumBanks;
+    if (num_banks == 0)
+    {
+        num_banks = CFE_PSP_EEPROM_MMAP_FILE_BANKS;
+    }
+    if (num_banks > CFE_PSP_NUM_EEPROM_BANKS)
     {
-        OS_printf("CFE_PSP: Cannot create EEPROM Range from Memory Mapped file.\n");
+        OS_printf("CFE_PSP: %u EEPROM banks configured, only %u supported\n", (unsigned int)num_banks,
+                  (unsigned int)CFE_PSP_NUM_EEPROM_BANKS);
+        num_banks = CFE_PSP_NUM_EEPROM_BANKS;
+    }
+
+    /*
+    ** Create the simulated EEPROM segments by mapping a memory segment to a file per bank.
+    ** Since the files will be saved, the "EEPROM" contents will be preserved.
+    */
+    for (bank = 0; bank < num_banks; ++bank)
+    {
+        if (bank == 0)
+        {
+            snprintf(file_name, sizeof(file_name), "%s", base_name);
+        }
+        else
+        {
+            snprintf(file_name, sizeof(file_name), "%s.%u", base_name, (unsigned int)bank);
+        }
+
+        Status = CFE_PSP_SetupEEPROM(bank, file_name, eeprom_size, &eeprom_address);
+        if (Status == 0)
+        {
+            /*
+            ** Install the memory range after the RAM as the mapped file ( EEPROM )
+            */
+            range_num = 1 + bank;
+            Status    = CFE_PSP_MemRangeSet(range_num, CFE_PSP_MEM_EEPROM, eeprom_address, eeprom_size,
+                                            CFE_PSP_MEM_SIZE_DWORD, CFE_PSP_MEM_ATTR_READWRITE);
+            OS_printf("CFE_PSP: EEPROM Range (%u) created: Start Address = %08lX, Size = %08X Status = %d\n",
+                      (unsigned int)range_num, (unsigned long)eeprom_address, (unsigned int)eeprom_size,
+                      (int)Status);
+        }
+        else
+        {
+            OS_printf("CFE_PSP: Cannot create EEPROM Range from Memory Mapped file %s.\n", file_name);
+        }
     }
+
+#ifdef CFE_PSP_EEPROM_MMAP_FILE_JOURNAL
+    eeprom_mmap_journal_StartTimer();
+#endif
 }
@@ -0,0 +1,664 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * Journal for the eeprom_mmap_file module, see cfe_psp_eeprom_mmap_journal.h
+ *
+ * A journal record is laid out as:
+ *  - header (eeprom_mmap_journal_header_t)
+ *  - NumPages entries, each a uint32 page index followed by the page content
+ *  - CRC-32C of all of the above, as a uint32
+ *
+ * The journal holds at most one record; it is truncated once the record
+ * has been applied to the EEPROM file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "cfe_psp.h"
+#include "cfe_psp_eeprom_mmap_journal.h"
+
+/*
+** Defines
+*/
+#define EEPROM_MMAP_JOURNAL_MAGIC  0x454A4E4C /* "EJNL" */
+#define EEPROM_MMAP_JOURNAL_SUFFIX ".jnl"
+
+typedef struct
+{
+    uint32 Magic;
+    uint32 Sequence;
+    uint32 PageSize;
+    uint32 NumPages;
+} eeprom_mmap_journal_header_t;
+
+typedef struct
+{
+    bool    IsOpen;
+    bool    WriteEnabled; /**< Transaction open, the timer does not commit */
+    int     ImageFd;
+    int     JournalFd;
+    cpuaddr BaseAddr;
+    size_t  ImageSize;
+    uint32  PageSize;
+    uint32  NumPages;
+    uint32  NumDirty;
+    uint32  Sequence;
+    uint32 *DirtyMap;
+    uint8 * RecordBuf;
+    char    JournalName[PATH_MAX];
+} eeprom_mmap_journal_bank_t;
+
+typedef struct
+{
+    pthread_mutex_t            Lock;
+    bool                       TimerStarted;
+    pthread_t                  TimerThread;
+    eeprom_mmap_journal_bank_t Banks[CFE_PSP_NUM_EEPROM_BANKS];
+} eeprom_mmap_journal_state_t;
+
+static eeprom_mmap_journal_state_t eeprom_mmap_journal_State = {.Lock = PTHREAD_MUTEX_INITIALIZER};
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper, size of a record holding NumPages pages
+ *
+ *-----------------------------------------------------------------*/
+static size_t eeprom_mmap_journal_RecordSize(const eeprom_mmap_journal_bank_t *BankPtr, uint32 NumPages)
+{
+    return sizeof(eeprom_mmap_journal_header_t) + ((size_t)NumPages * (sizeof(uint32) + BankPtr->PageSize)) +
+           sizeof(uint32);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper, full pwrite() that handles short writes
+ *
+ *-----------------------------------------------------------------*/
+static int32 eeprom_mmap_journal_WriteAll(int fd, const uint8 *Buffer, size_t Size, off_t Offset)
+{
+    ssize_t Result;
+
+    while (Size > 0)
+    {
+        Result = pwrite(fd, Buffer, Size, Offset);
+        if (Result < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (Result <= 0)
+        {
+            return CFE_PSP_ERROR;
+        }
+        Buffer += Result;
+        Offset += Result;
+        Size -= Result;
+    }
+
+    return CFE_PSP_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper, full pread() that handles short reads
+ *
+ *-----------------------------------------------------------------*/
+static int32 eeprom_mmap_journal_ReadAll(int fd, uint8 *Buffer, size_t Size, off_t Offset)
+{
+    ssize_t Result;
+
+    while (Size > 0)
+    {
+        Result = pread(fd, Buffer, Size, Offset);
+        if (Result < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (Result <= 0)
+        {
+            return CFE_PSP_ERROR;
+        }
+        Buffer += Result;
+        Offset += Result;
+        Size -= Result;
+    }
+
+    return CFE_PSP_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper, write the pages of a complete record into the EEPROM file
+ *
+ *-----------------------------------------------------------------*/
+static int32 eeprom_mmap_journal_Apply(eeprom_mmap_journal_bank_t *BankPtr, const uint8 *Record, uint32 NumPages)
+{
+    const uint8 *EntryPtr;
+    uint32       PageIndex;
+    uint32       i;
+
+    EntryPtr = Record + sizeof(eeprom_mmap_journal_header_t);
+    for (i = 0; i < NumPages; ++i)
+    {
+        memcpy(&PageIndex, EntryPtr, sizeof(PageIndex));
+        EntryPtr += sizeof(PageIndex);
+
+        if (eeprom_mmap_journal_WriteAll(BankPtr->ImageFd, EntryPtr, BankPtr->PageSize,
+                                         (off_t)PageIndex * BankPtr->PageSize) != CFE_PSP_SUCCESS)
+        {
+            return CFE_PSP_ERROR;
+        }
+        EntryPtr += BankPtr->PageSize;
+    }
+
+    if (fdatasync(BankPtr->ImageFd) < 0)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    /*
+     * The EEPROM file now has the content.  If the truncate is lost the
+     * record is simply replayed again, which is harmless.
+     */
+    if (ftruncate(BankPtr->JournalFd, 0) < 0)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    return CFE_PSP_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper, replay the record left in the journal, if any
+ *
+ *-----------------------------------------------------------------*/
+static void eeprom_mmap_journal_Replay(eeprom_mmap_journal_bank_t *BankPtr)
+{
+    eeprom_mmap_journal_header_t Header;
+    struct stat                  StatBuf;
+    const uint8 *                EntryPtr;
+    size_t                       RecordSize;
+    uint32                       PageIndex;
+    uint32                       Crc;
+    uint32                       StoredCrc;
+    uint32                       i;
+    bool                         IsValid;
+
+    if (fstat(BankPtr->JournalFd, &StatBuf) < 0 || StatBuf.st_size == 0)
+    {
+        return;
+    }
+
+    /*
+     * A record is only replayed if it is entirely present and intact;
+     * anything else is the remains of an interrupted commit, in which
+     * case the EEPROM file was not modified yet.
+     */
+    IsValid = false;
+    if ((size_t)StatBuf.st_size >= eeprom_mmap_journal_RecordSize(BankPtr, 0) &&
+        eeprom_mmap_journal_ReadAll(BankPtr->JournalFd, (uint8 *)&Header, sizeof(Header), 0) == CFE_PSP_SUCCESS &&
+        Header.Magic == EEPROM_MMAP_JOURNAL_MAGIC && Header.PageSize == BankPtr->PageSize &&
+        Header.NumPages <= BankPtr->NumPages)
+    {
+        RecordSize = eeprom_mmap_journal_RecordSize(BankPtr, Header.NumPages);
+        if ((size_t)StatBuf.st_size >= RecordSize &&
+            eeprom_mmap_journal_ReadAll(BankPtr->JournalFd, BankPtr->RecordBuf, RecordSize, 0) == CFE_PSP_SUCCESS)
+        {
+            Crc = 0;
+            CFE_PSP_MemChecksum(BankPtr->RecordBuf, RecordSize - sizeof(uint32), CFE_PSP_MEM_CHECKSUM_CRC32C, &Crc);
+            memcpy(&StoredCrc, &BankPtr->RecordBuf[RecordSize - sizeof(uint32)], sizeof(StoredCrc));
+            IsValid = (Crc == StoredCrc);
+        }
+    }
+
+    if (IsValid)
+    {
+        EntryPtr = BankPtr->RecordBuf + sizeof(Header);
+        for (i = 0; i < Header.NumPages; ++i)
+        {
+            memcpy(&PageIndex, EntryPtr, sizeof(PageIndex));
+            if (PageIndex >= BankPtr->NumPages)
+            {
+                IsValid = false;
+                break;
+            }
+            EntryPtr += sizeof(PageIndex) + BankPtr->PageSize;
+        }
+    }
+
+    if (!IsValid)
+    {
+        OS_printf("CFE_PSP: Discarding incomplete EEPROM journal %s\n", BankPtr->JournalName);
+        if (ftruncate(BankPtr->JournalFd, 0) < 0)
+        {
+            perror("CFE_PSP: ftruncate");
+        }
+        return;
+    }
+
+    BankPtr->Sequence = Header.Sequence + 1;
+    if (eeprom_mmap_journal_Apply(BankPtr, BankPtr->RecordBuf, Header.NumPages) == CFE_PSP_SUCCESS)
+    {
+        OS_printf("CFE_PSP: Replayed %u pages from EEPROM journal %s\n", (unsigned int)Header.NumPages,
+                  BankPtr->JournalName);
+    }
+    else
+    {
+        OS_printf("CFE_PSP: Error replaying EEPROM journal %s\n", BankPtr->JournalName);
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper, commit the dirty pages of a bank
+ * Must be called with the lock held
+ *
+ *-----------------------------------------------------------------*/
+static int32 eeprom_mmap_journal_Commit(eeprom_mmap_journal_bank_t *BankPtr)
+{
+    eeprom_mmap_journal_header_t Header;
+    uint8 *                      EntryPtr;
+    size_t                       RecordSize;
+    uint32                       PageIndex;
+    uint32                       Crc;
+    uint32                       Word;
+    uint32                       Bit;
+    int32                        Status;
+
+    if (BankPtr->NumDirty == 0)
+    {
+        return CFE_PSP_SUCCESS;
+    }
+
+    /*
+     * Build the record from the current content of the dirty pages.
+     * Each page appears once no matter how many writes touched it.
+     */
+    Header.Magic    = EEPROM_MMAP_JOURNAL_MAGIC;
+    Header.Sequence = BankPtr->Sequence;
+    Header.PageSize = BankPtr->PageSize;
+    Header.NumPages = BankPtr->NumDirty;
+    memcpy(BankPtr->RecordBuf, &Header, sizeof(Header));
+
+    EntryPtr = BankPtr->RecordBuf + sizeof(Header);
+    for (Word = 0; Word < ((BankPtr->NumPages + 31) / 32); ++Word)
+    {
+        for (Bit = 0; BankPtr->DirtyMap[Word] != 0 && Bit < 32; ++Bit)
+        {
+            if ((BankPtr->DirtyMap[Word] & (1U << Bit)) != 0)
+            {
+                PageIndex = (Word * 32) + Bit;
+                memcpy(EntryPtr, &PageIndex, sizeof(PageIndex));
+                EntryPtr += sizeof(PageIndex);
+                memcpy(EntryPtr, (const void *)(BankPtr->BaseAddr + ((size_t)PageIndex * BankPtr->PageSize)),
+                       BankPtr->PageSize);
+                EntryPtr += BankPtr->PageSize;
+            }
+        }
+    }
+
+    RecordSize = eeprom_mmap_journal_RecordSize(BankPtr, Header.NumPages);
+    Crc        = 0;
+    CFE_PSP_MemChecksum(BankPtr->RecordBuf, RecordSize - sizeof(uint32), CFE_PSP_MEM_CHECKSUM_CRC32C, &Crc);
+    memcpy(EntryPtr, &Crc, sizeof(Crc));
+
+    /*
+     * The record must be durable before the EEPROM file is touched,
+     * so an interruption leaves either the old or the new content.
+     */
+    Status = CFE_PSP_ERROR;
+    if (ftruncate(BankPtr->JournalFd, 0) == 0 &&
+        eeprom_mmap_journal_WriteAll(BankPtr->JournalFd, BankPtr->RecordBuf, RecordSize, 0) == CFE_PSP_SUCCESS &&
+        fdatasync(BankPtr->JournalFd) == 0)
+    {
+        ++BankPtr->Sequence;
+
+        /*
+         * If applying fails, the pages stay dirty so the next record
+         * includes them again; it replaces this one in the journal.
+         */
+        Status = eeprom_mmap_journal_Apply(BankPtr, BankPtr->RecordBuf, Header.NumPages);
+    }
+
+    if (Status == CFE_PSP_SUCCESS)
+    {
+        memset(BankPtr->DirtyMap, 0, ((BankPtr->NumPages + 31) / 32) * sizeof(uint32));
+        BankPtr->NumDirty = 0;
+    }
+    else
+    {
+        OS_printf("CFE_PSP: Error committing EEPROM journal %s\n", BankPtr->JournalName);
+    }
+
+    return Status;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper, background thread that bounds the commit latency
+ *
+ *-----------------------------------------------------------------*/
+static void *eeprom_mmap_journal_Timer(void *arg)
+{
+    struct timespec Interval;
+    uint32          Bank;
+
+    Interval.tv_sec  = CFE_PSP_EEPROM_MMAP_FILE_COMMIT_MSEC / 1000;
+    Interval.tv_nsec = (CFE_PSP_EEPROM_MMAP_FILE_COMMIT_MSEC % 1000) * 1000000;
+
+    while (true)
+    {
+        nanosleep(&Interval, NULL);
+
+        pthread_mutex_lock(&eeprom_mmap_journal_State.Lock);
+        for (Bank = 0; Bank < CFE_PSP_NUM_EEPROM_BANKS; ++Bank)
+        {
+            if (eeprom_mmap_journal_State.Banks[Bank].IsOpen && !eeprom_mmap_journal_State.Banks[Bank].WriteEnabled)
+            {
+                eeprom_mmap_journal_Commit(&eeprom_mmap_journal_State.Banks[Bank]);
+            }
+        }
+        pthread_mutex_unlock(&eeprom_mmap_journal_State.Lock);
+    }
+
+    return NULL;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper, get the state of an open bank
+ *
+ *-----------------------------------------------------------------*/
+static eeprom_mmap_journal_bank_t *eeprom_mmap_journal_GetBank(uint32 Bank)
+{
+    if (Bank >= CFE_PSP_NUM_EEPROM_BANKS || !eeprom_mmap_journal_State.Banks[Bank].IsOpen)
+    {
+        return NULL;
+    }
+
+    return &eeprom_mmap_journal_State.Banks[Bank];
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per internal API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 eeprom_mmap_journal_Open(uint32 Bank, const char *ImageName, int ImageFd, size_t ImageSize)
+{
+    eeprom_mmap_journal_bank_t *BankPtr;
+    struct stat                 StatBuf;
+    off_t                       PagedSize;
+
+    if (Bank >= CFE_PSP_NUM_EEPROM_BANKS)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    BankPtr = &eeprom_mmap_journal_State.Banks[Bank];
+    memset(BankPtr, 0, sizeof(*BankPtr));
+    BankPtr->JournalFd = -1;
+    BankPtr->ImageFd   = ImageFd;
+    BankPtr->ImageSize = ImageSize;
+    BankPtr->PageSize  = sysconf(_SC_PAGESIZE);
+    BankPtr->NumPages  = (ImageSize + BankPtr->PageSize - 1) / BankPtr->PageSize;
+
+    /*
+     * The last page may be partial; it is still handled as a whole page,
+     * so extend the file to a page multiple.  A file that is already larger,
+     * e.g. from a bigger bank, is never shrunk, so none of its content is lost.
+     */
+    PagedSize = (off_t)BankPtr->NumPages * BankPtr->PageSize;
+    if (fstat(ImageFd, &StatBuf) < 0 || (StatBuf.st_size < PagedSize && ftruncate(ImageFd, PagedSize) < 0))
+    {
+        OS_printf("CFE_PSP: Cannot resize EEPROM file %s\n", ImageName);
+        return CFE_PSP_ERROR;
+    }
+
+    snprintf(BankPtr->JournalName, sizeof(BankPtr->JournalName), "%s%s", ImageName, EEPROM_MMAP_JOURNAL_SUFFIX);
+    BankPtr->JournalFd = open(BankPtr->JournalName, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+    if (BankPtr->JournalFd < 0)
+    {
+        OS_printf("CFE_PSP: Cannot open EEPROM journal %s\n", BankPtr->JournalName);
+        return CFE_PSP_ERROR;
+    }
+
+    /* a commit holding every page must fit, so allocate everything up front */
+    BankPtr->DirtyMap  = calloc((BankPtr->NumPages + 31) / 32, sizeof(uint32));
+    BankPtr->RecordBuf = malloc(eeprom_mmap_journal_RecordSize(BankPtr, BankPtr->NumPages));
+    if (BankPtr->DirtyMap == NULL || BankPtr->RecordBuf == NULL)
+    {
+        OS_printf("CFE_PSP: Cannot allocate EEPROM journal buffers\n");
+        eeprom_mmap_journal_Close(Bank);
+        return CFE_PSP_ERROR;
+    }
+
+    eeprom_mmap_journal_Replay(BankPtr);
+
+    return CFE_PSP_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per internal API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void eeprom_mmap_journal_Close(uint32 Bank)
+{
+    eeprom_mmap_journal_bank_t *BankPtr;
+
+    if (Bank >= CFE_PSP_NUM_EEPROM_BANKS)
+    {
+        return;
+    }
+
+    BankPtr = &eeprom_mmap_journal_State.Banks[Bank];
+
+    pthread_mutex_lock(&eeprom_mmap_journal_State.Lock);
+    BankPtr->IsOpen = false;
+    pthread_mutex_unlock(&eeprom_mmap_journal_State.Lock);
+
+    if (BankPtr->JournalFd >= 0)
+    {
+        close(BankPtr->JournalFd);
+    }
+    free(BankPtr->DirtyMap);
+    free(BankPtr->RecordBuf);
+
+    /* the image descriptor belongs to the caller */
+    memset(BankPtr, 0, sizeof(*BankPtr));
+    BankPtr->JournalFd = -1;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per internal API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void eeprom_mmap_journal_Attach(uint32 Bank, cpuaddr BaseAddr)
+{
+    eeprom_mmap_journal_bank_t *BankPtr;
+
+    BankPtr = &eeprom_mmap_journal_State.Banks[Bank];
+
+    pthread_mutex_lock(&eeprom_mmap_journal_State.Lock);
+    BankPtr->BaseAddr = BaseAddr;
+    BankPtr->IsOpen   = true;
+    pthread_mutex_unlock(&eeprom_mmap_journal_State.Lock);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per internal API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void eeprom_mmap_journal_StartTimer(void)
+{
+    if (eeprom_mmap_journal_State.TimerStarted)
+    {
+        return;
+    }
+
+    if (pthread_create(&eeprom_mmap_journal_State.TimerThread, NULL, eeprom_mmap_journal_Timer, NULL) != 0)
+    {
+        OS_printf("CFE_PSP: Cannot start EEPROM journal thread, commits only on WriteDisable\n");
+        return;
+    }
+
+    pthread_detach(eeprom_mmap_journal_State.TimerThread);
+    eeprom_mmap_journal_State.TimerStarted = true;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per internal API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 eeprom_mmap_journal_Write(cpuaddr MemoryAddress, const void *Data, size_t Size)
+{
+    eeprom_mmap_journal_bank_t *BankPtr;
+    size_t                      Offset;
+    uint32                      Page;
+    uint32                      FirstPage;
+    uint32                      LastPage;
+    void *                      PagePtr;
+    size_t                      PagesSize;
+    uint32                      Bank;
+    int32                       Status;
+
+    Status = CFE_PSP_INVALID_MEM_ADDR;
+
+    pthread_mutex_lock(&eeprom_mmap_journal_State.Lock);
+    for (Bank = 0; Bank < CFE_PSP_NUM_EEPROM_BANKS; ++Bank)
+    {
+        BankPtr = &eeprom_mmap_journal_State.Banks[Bank];
+        if (!BankPtr->IsOpen || MemoryAddress < BankPtr->BaseAddr)
+        {
+            continue;
+        }
+
+        Offset = MemoryAddress - BankPtr->BaseAddr;
+        if (Offset >= BankPtr->ImageSize || Size > (BankPtr->ImageSize - Offset))
+        {
+            continue;
+        }
+
+        FirstPage = Offset / BankPtr->PageSize;
+        LastPage  = (Offset + Size - 1) / BankPtr->PageSize;
+        PagePtr   = (void *)(BankPtr->BaseAddr + ((size_t)FirstPage * BankPtr->PageSize));
+        PagesSize = (size_t)(LastPage - FirstPage + 1) * BankPtr->PageSize;
+
+        /* the mapping is read-only outside of this copy, so stray stores fault */
+        if (mprotect(PagePtr, PagesSize, PROT_READ | PROT_WRITE) < 0)
+        {
+            Status = CFE_PSP_ERROR;
+            break;
+        }
+
+        memcpy((void *)MemoryAddress, Data, Size);
+
+        if (mprotect(PagePtr, PagesSize, PROT_READ) < 0)
+        {
+            perror("CFE_PSP: mprotect");
+        }
+
+        for (Page = FirstPage; Page <= LastPage; ++Page)
+        {
+            if ((BankPtr->DirtyMap[Page / 32] & (1U << (Page % 32))) == 0)
+            {
+                BankPtr->DirtyMap[Page / 32] |= 1U << (Page % 32);
+                ++BankPtr->NumDirty;
+            }
+        }
+
+        Status = CFE_PSP_SUCCESS;
+        break;
+    }
+    pthread_mutex_unlock(&eeprom_mmap_journal_State.Lock);
+
+    return Status;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per internal API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 eeprom_mmap_journal_Begin(uint32 Bank)
+{
+    eeprom_mmap_journal_bank_t *BankPtr;
+
+    pthread_mutex_lock(&eeprom_mmap_journal_State.Lock);
+    BankPtr = eeprom_mmap_journal_GetBank(Bank);
+    if (BankPtr != NULL)
+    {
+        BankPtr->WriteEnabled = true;
+    }
+    pthread_mutex_unlock(&eeprom_mmap_journal_State.Lock);
+
+    if (BankPtr == NULL)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    return CFE_PSP_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per internal API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 eeprom_mmap_journal_End(uint32 Bank)
+{
+    eeprom_mmap_journal_bank_t *BankPtr;
+    int32                       Status;
+
+    Status = CFE_PSP_ERROR;
+
+    pthread_mutex_lock(&eeprom_mmap_journal_State.Lock);
+    BankPtr = eeprom_mmap_journal_GetBank(Bank);
+    if (BankPtr != NULL)
+    {
+        BankPtr->WriteEnabled = false;
+        Status                = eeprom_mmap_journal_Commit(BankPtr);
+    }
+    pthread_mutex_unlock(&eeprom_mmap_journal_State.Lock);
+
+    return Status;
+}
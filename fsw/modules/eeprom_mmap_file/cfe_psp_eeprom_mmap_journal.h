@@ -0,0 +1,126 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * Internal interface to the journal used by the eeprom_mmap_file module
+ * when built with PSP_EEPROM_MMAP_FILE_JOURNAL enabled.
+ *
+ * In this mode the EEPROM file is mapped privately, so writes do not reach
+ * the file on their own.  Each write marks the pages it touches as dirty.
+ * The mapping is read-only except while the journal copies data in, so
+ * every write must go through CFE_PSP_EepromWrite8/16/32 (CFE_PSP_MemWriteBlock
+ * also uses these for EEPROM ranges); any other store into a bank faults.
+ * A commit appends all dirty pages as a single checksummed record to the
+ * journal file and syncs it, then writes the pages into the EEPROM file,
+ * syncs it and truncates the journal.  A record found in the journal at
+ * startup is replayed if it is complete, or discarded otherwise, so each
+ * commit is applied entirely or not at all.
+ *
+ * A commit happens when CFE_PSP_EepromWriteDisable() is called, and
+ * periodically from a background thread while writes are not enabled.
+ * Writes between CFE_PSP_EepromWriteEnable() and CFE_PSP_EepromWriteDisable()
+ * are therefore committed together.
+ */
+
+#ifndef CFE_PSP_EEPROM_MMAP_JOURNAL_H
+#define CFE_PSP_EEPROM_MMAP_JOURNAL_H
+
+#include "common_types.h"
+#include "cfe_psp_config.h"
+
+/*
+ * Interval at which the background thread commits writes made outside of
+ * a WriteEnable/WriteDisable pair.
+ * Normally set by the build system from PSP_EEPROM_MMAP_FILE_COMMIT_MSEC.
+ */
+#ifndef CFE_PSP_EEPROM_MMAP_FILE_COMMIT_MSEC
+#define CFE_PSP_EEPROM_MMAP_FILE_COMMIT_MSEC 1000
+#endif
+
+/**
+ * \brief Open the journal for an EEPROM bank and replay any pending commit
+ *
+ * Must be called before the EEPROM file is mapped, as a replay updates the file.
+ *
+ * \param Bank       EEPROM bank number
+ * \param ImageName  Name of the EEPROM file; the journal is this name with ".jnl" appended
+ * \param ImageFd    Open read/write descriptor of the EEPROM file
+ * \param ImageSize  Size of the bank; the file is extended to a whole number of pages, never shrunk
+ *
+ * \returns CFE_PSP_SUCCESS if the journal is ready, or an error code
+ */
+int32 eeprom_mmap_journal_Open(uint32 Bank, const char *ImageName, int ImageFd, size_t ImageSize);
+
+/**
+ * \brief Close the journal of an EEPROM bank and release its resources
+ *
+ * Used when the bank cannot be set up after eeprom_mmap_journal_Open() succeeded.
+ * Pending writes are not committed.
+ *
+ * \param Bank EEPROM bank number
+ */
+void eeprom_mmap_journal_Close(uint32 Bank);
+
+/**
+ * \brief Set the address at which the EEPROM file for a bank is mapped
+ *
+ * \param Bank      EEPROM bank number
+ * \param BaseAddr  Address of the private mapping of the EEPROM file
+ */
+void eeprom_mmap_journal_Attach(uint32 Bank, cpuaddr BaseAddr);
+
+/**
+ * \brief Start the background thread that commits pending writes
+ */
+void eeprom_mmap_journal_StartTimer(void);
+
+/**
+ * \brief Write to a mapped EEPROM bank and mark the affected pages as dirty
+ *
+ * The affected pages are writable only during the copy.
+ *
+ * \param MemoryAddress Address within a mapped bank
+ * \param Data          Data to write
+ * \param Size          Number of bytes to write
+ *
+ * \returns CFE_PSP_SUCCESS, CFE_PSP_INVALID_MEM_ADDR if the range is not within a bank,
+ *          or CFE_PSP_ERROR if the pages cannot be made writable
+ */
+int32 eeprom_mmap_journal_Write(cpuaddr MemoryAddress, const void *Data, size_t Size);
+
+/**
+ * \brief Open a transaction; writes are not committed by the timer until it ends
+ *
+ * \param Bank EEPROM bank number
+ *
+ * \returns CFE_PSP_SUCCESS, or CFE_PSP_ERROR if the bank is not valid
+ */
+int32 eeprom_mmap_journal_Begin(uint32 Bank);
+
+/**
+ * \brief End the transaction and commit all pending writes of the bank
+ *
+ * \param Bank EEPROM bank number
+ *
+ * \returns CFE_PSP_SUCCESS, or CFE_PSP_ERROR if the bank is not valid or the commit failed
+ */
+int32 eeprom_mmap_journal_End(uint32 Bank);
+
+#endif /* CFE_PSP_EEPROM_MMAP_JOURNAL_H */
@@ -55,6 +55,82 @@ typedef struct
     CFE_PSP_IODriver_AdcCode_t *Samples; /**<  Array for ADC/DAC samples */
 } CFE_PSP_IODriver_AnalogRdWr_t;
 
+/**
+ * API container for reading channels along with the sample they belong to.
+ *
+ * Devices that sample their inputs in the background publish each sample as
+ * a whole, so all channels read in one call come from the same sample.  The
+ * sequence number increments with every sample, which lets the caller detect
+ * a stale or repeated reading.  The channels are selected as with the
+ * CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS opcode.
+ */
+typedef struct
+{
+    CFE_PSP_IODriver_AnalogRdWr_t RdWr;        /**<  Channels to read */
+    uint32                        Sequence;    /**<  Output: sequence number of the sample, 0 if none was taken yet */
+    uint64                        TimestampNs; /**<  Output: time of the sample, in nanoseconds of the device clock */
+} CFE_PSP_IODriver_AnalogSnapshot_t;
+
+/**
+ * Resolutions of the history of a channel
+ *
+ * Devices that keep a history may keep each sample, and/or entries that
+ * summarize all the samples of a minute or an hour.
+ */
+typedef enum
+{
+    CFE_PSP_IODriver_AnalogHistory_SAMPLES = 0, /**< One entry per sample */
+    CFE_PSP_IODriver_AnalogHistory_MINUTES = 1, /**< One entry per minute */
+    CFE_PSP_IODriver_AnalogHistory_HOURS   = 2, /**< One entry per hour */
+    CFE_PSP_IODriver_AnalogHistory_MAX
+} CFE_PSP_IODriver_AnalogHistoryResolution_t;
+
+/**
+ * One entry of the history of a channel
+ *
+ * For an entry of a single sample, Min, Mean and Max are all that sample.
+ */
+typedef struct
+{
+    uint64                     TimestampNs; /**<  Time of the sample, or start of the minute/hour */
+    CFE_PSP_IODriver_AdcCode_t Min;         /**<  Lowest sample */
+    CFE_PSP_IODriver_AdcCode_t Mean;        /**<  Mean of the samples */
+    CFE_PSP_IODriver_AdcCode_t Max;         /**<  Highest sample */
+} CFE_PSP_IODriver_AnalogHistoryEntry_t;
+
+/**
+ * API container for reading the history of one channel, selected by the subchannel
+ *
+ * Returns the most recent entries the device has, up to MaxEntries, oldest first.
+ */
+typedef struct
+{
+    uint16                                 Resolution; /**<  CFE_PSP_IODriver_AnalogHistoryResolution_t */
+    uint16                                 MaxEntries; /**<  Length of the Entries array */
+    uint16                                 NumEntries; /**<  Output: number of entries returned */
+    CFE_PSP_IODriver_AnalogHistoryEntry_t *Entries;    /**<  Output: array of MaxEntries entries */
+} CFE_PSP_IODriver_AnalogHistory_t;
+
+/**
+ * API container for the distribution of one channel, selected by the subchannel
+ *
+ * The distribution is over the most recent entries of the history at the given
+ * resolution.  For minutes and hours, the percentiles are those of the mean of
+ * each entry, while Min and Max are the extremes of all the samples, so a
+ * short spike still shows in Max.  Percentiles use the nearest-rank method.
+ */
+typedef struct
+{
+    uint16                     Resolution;    /**<  CFE_PSP_IODriver_AnalogHistoryResolution_t */
+    uint16                     WindowEntries; /**<  Number of most recent entries to use, 0 for all */
+    uint16                     NumEntries;    /**<  Output: number of entries used */
+    CFE_PSP_IODriver_AdcCode_t Min;           /**<  Output: lowest value */
+    CFE_PSP_IODriver_AdcCode_t P50;           /**<  Output: median */
+    CFE_PSP_IODriver_AdcCode_t P95;           /**<  Output: 95th percentile */
+    CFE_PSP_IODriver_AdcCode_t P99;           /**<  Output: 99th percentile */
+    CFE_PSP_IODriver_AdcCode_t Max;           /**<  Output: highest value */
+} CFE_PSP_IODriver_AnalogPercentiles_t;
+
 /**
  * Opcodes specific to analog io (ADC/DAC) devices
  */
@@ -62,8 +138,11 @@ enum
 {
     CFE_PSP_IODriver_ANALOG_IO_NOOP = CFE_PSP_IODriver_ANALOG_IO_CLASS_BASE,
 
-    CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS,  /**< CFE_PSP_IODriver_AnalogRdWr_t argument */
-    CFE_PSP_IODriver_ANALOG_IO_WRITE_CHANNELS, /**< CFE_PSP_IODriver_AnalogRdWr_t argument */
+    CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS,    /**< CFE_PSP_IODriver_AnalogRdWr_t argument */
+    CFE_PSP_IODriver_ANALOG_IO_WRITE_CHANNELS,   /**< CFE_PSP_IODriver_AnalogRdWr_t argument */
+    CFE_PSP_IODriver_ANALOG_IO_READ_SNAPSHOT,    /**< CFE_PSP_IODriver_AnalogSnapshot_t argument */
+    CFE_PSP_IODriver_ANALOG_IO_READ_HISTORY,     /**< CFE_PSP_IODriver_AnalogHistory_t argument */
+    CFE_PSP_IODriver_ANALOG_IO_READ_PERCENTILES, /**< CFE_PSP_IODriver_AnalogPercentiles_t argument */
 
     CFE_PSP_IODriver_ANALOG_IO_MAX
 };
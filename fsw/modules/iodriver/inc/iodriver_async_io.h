@@ -0,0 +1,201 @@
+/*
+ *  Copyright (c) 2015, United States government as represented by the
+ *  administrator of the National Aeronautics Space Administration.
+ *  All rights reserved. This software was created at NASA Glenn
+ *  Research Center pursuant to government contracts.
+ */
+
+/**
+ * \file
+ *
+ * Asynchronous requests for packet and stream interfaces
+ *
+ * Instead of blocking in CFE_PSP_IODriver_PACKET_IO_READ and the like, a
+ * task may attach a queue to a channel with the ATTACH_QUEUE opcode of the
+ * class, then:
+ *  - add read and write requests with CFE_PSP_IODriver_AsyncSubmit(), and
+ *    issue the SUBMIT opcode of the class so that the driver starts them
+ *  - take the results with CFE_PSP_IODriver_AsyncReap(), in the order the
+ *    driver completes the requests
+ *
+ * The driver gives the CompletionSem of the queue after adding results, so
+ * a single task can wait for the results of many channels by attaching
+ * queues that share one binary semaphore.
+ *
+ * Each queue holds two rings, for the requests and for the results, in
+ * memory provided by the caller.  Each ring has a single producer and a
+ * single consumer, and is accessed without locks: one task must do all the
+ * submitting and reaping of a queue.  The driver takes a request only when
+ * there is room for its result, so no result is ever lost; requests stay
+ * in their ring while the results are not reaped.
+ *
+ * The buffers of a request belong to the driver until its result is reaped.
+ */
+
+#ifndef CFE_PSP_IODRIVER_ASYNC_IO_H
+#define CFE_PSP_IODRIVER_ASYNC_IO_H
+
+/* Include all base definitions */
+#include "iodriver_base.h"
+
+/**
+ * A read or write request on a queue
+ */
+typedef struct
+{
+    uint32 CommandCode; /**< The READ or WRITE opcode of the class of the channel */
+    uint32 BufferSize;  /**< Size of the buffer for reads, size of the data for writes */
+    void * BufferMem;   /**< Buffer, not modified for writes */
+    void * UserData;    /**< Any value of the caller, returned with the result */
+} CFE_PSP_IODriver_AsyncRequest_t;
+
+/**
+ * The result of a request on a queue
+ */
+typedef struct
+{
+    int32  Status;     /**< Result of the request, as from the blocking opcode */
+    uint32 ActualSize; /**< Size of the data that was read or written */
+    void * BufferMem;  /**< Buffer of the request */
+    void * UserData;   /**< UserData of the request */
+} CFE_PSP_IODriver_AsyncCompletion_t;
+
+/**
+ * Indices of a ring with a single producer and a single consumer
+ *
+ * The indices count the entries ever added and taken, the entry at index N
+ * is at (N & Mask).
+ */
+typedef struct
+{
+    uint32 Mask; /**< Number of entries - 1, the number of entries is a power of 2 */
+    uint32 Head; /**< Entries taken, written by the consumer */
+    uint32 Tail; /**< Entries added, written by the producer */
+} CFE_PSP_IODriver_AsyncRing_t;
+
+/**
+ * A queue of requests and results, set up with CFE_PSP_IODriver_AsyncQueueInit()
+ */
+typedef struct
+{
+    CFE_PSP_IODriver_AsyncRing_t        SubmitRing;      /**< Requests, added by the caller */
+    CFE_PSP_IODriver_AsyncRequest_t *   SubmitEntries;   /**< Storage of the requests */
+    CFE_PSP_IODriver_AsyncRing_t        CompleteRing;    /**< Results, added by the driver */
+    CFE_PSP_IODriver_AsyncCompletion_t *CompleteEntries; /**< Storage of the results */
+    uint32    InFlight;      /**< Requests taken by the driver and not completed, used by the driver */
+    osal_id_t CompletionSem; /**< Binary semaphore given after adding results, or OS_OBJECT_ID_UNDEFINED */
+} CFE_PSP_IODriver_AsyncQueue_t;
+
+/**
+ * Adds a request to a queue, for the caller
+ *
+ * \returns true if added, false if the ring of requests is full
+ */
+static inline bool CFE_PSP_IODriver_AsyncSubmit(CFE_PSP_IODriver_AsyncQueue_t *        Queue,
+                                                const CFE_PSP_IODriver_AsyncRequest_t *Request)
+{
+    uint32 Tail = Queue->SubmitRing.Tail;
+
+    if (Tail - __atomic_load_n(&Queue->SubmitRing.Head, __ATOMIC_ACQUIRE) > Queue->SubmitRing.Mask)
+    {
+        return false;
+    }
+
+    Queue->SubmitEntries[Tail & Queue->SubmitRing.Mask] = *Request;
+    __atomic_store_n(&Queue->SubmitRing.Tail, Tail + 1, __ATOMIC_RELEASE);
+
+    return true;
+}
+
+/**
+ * Takes the next result from a queue, for the caller
+ *
+ * \returns true if a result was taken, false if there is none
+ */
+static inline bool CFE_PSP_IODriver_AsyncReap(CFE_PSP_IODriver_AsyncQueue_t *     Queue,
+                                              CFE_PSP_IODriver_AsyncCompletion_t *Completion)
+{
+    uint32 Head = Queue->CompleteRing.Head;
+
+    if (Head == __atomic_load_n(&Queue->CompleteRing.Tail, __ATOMIC_ACQUIRE))
+    {
+        return false;
+    }
+
+    *Completion = Queue->CompleteEntries[Head & Queue->CompleteRing.Mask];
+    __atomic_store_n(&Queue->CompleteRing.Head, Head + 1, __ATOMIC_RELEASE);
+
+    return true;
+}
+
+/**
+ * Takes the next request from a queue, for the driver
+ *
+ * The driver must add a result for it with CFE_PSP_IODriver_AsyncComplete().
+ *
+ * \returns true if a request was taken, false if there is none or no room for more results
+ */
+static inline bool CFE_PSP_IODriver_AsyncNextRequest(CFE_PSP_IODriver_AsyncQueue_t *  Queue,
+                                                     CFE_PSP_IODriver_AsyncRequest_t *Request)
+{
+    uint32 Head = Queue->SubmitRing.Head;
+    uint32 Pending;
+
+    Pending = Queue->CompleteRing.Tail - __atomic_load_n(&Queue->CompleteRing.Head, __ATOMIC_ACQUIRE);
+    if (Pending + Queue->InFlight > Queue->CompleteRing.Mask ||
+        Head == __atomic_load_n(&Queue->SubmitRing.Tail, __ATOMIC_ACQUIRE))
+    {
+        return false;
+    }
+
+    *Request = Queue->SubmitEntries[Head & Queue->SubmitRing.Mask];
+    __atomic_store_n(&Queue->SubmitRing.Head, Head + 1, __ATOMIC_RELEASE);
+    ++Queue->InFlight;
+
+    return true;
+}
+
+/**
+ * Adds the result of a request taken with CFE_PSP_IODriver_AsyncNextRequest(), for the driver
+ *
+ * The caller is not woken up until CFE_PSP_IODriver_AsyncNotify().
+ */
+static inline void CFE_PSP_IODriver_AsyncComplete(CFE_PSP_IODriver_AsyncQueue_t *           Queue,
+                                                  const CFE_PSP_IODriver_AsyncCompletion_t *Completion)
+{
+    uint32 Tail = Queue->CompleteRing.Tail;
+
+    Queue->CompleteEntries[Tail & Queue->CompleteRing.Mask] = *Completion;
+    __atomic_store_n(&Queue->CompleteRing.Tail, Tail + 1, __ATOMIC_RELEASE);
+    --Queue->InFlight;
+}
+
+/* ------------------------------------------------------------- */
+/**
+ * @brief Set up a queue of asynchronous requests
+ *
+ * @param Queue the queue to set up
+ * @param SubmitEntries storage for the requests
+ * @param NumSubmitEntries number of requests in the storage, a power of 2
+ * @param CompleteEntries storage for the results
+ * @param NumCompleteEntries number of results in the storage, a power of 2
+ * @param CompletionSem binary semaphore to give after adding results, or OS_OBJECT_ID_UNDEFINED to poll
+ *
+ * @retval #CFE_PSP_SUCCESS if successful
+ * @retval #CFE_PSP_INVALID_POINTER if a pointer is NULL
+ * @retval #CFE_PSP_ERROR if a number of entries is not a power of 2
+ */
+int32 CFE_PSP_IODriver_AsyncQueueInit(CFE_PSP_IODriver_AsyncQueue_t *Queue,
+                                      CFE_PSP_IODriver_AsyncRequest_t *SubmitEntries, uint32 NumSubmitEntries,
+                                      CFE_PSP_IODriver_AsyncCompletion_t *CompleteEntries, uint32 NumCompleteEntries,
+                                      osal_id_t CompletionSem);
+
+/* ------------------------------------------------------------- */
+/**
+ * @brief Wake up the caller of a queue after adding results, for the driver
+ *
+ * @param Queue the queue
+ */
+void CFE_PSP_IODriver_AsyncNotify(CFE_PSP_IODriver_AsyncQueue_t *Queue);
+
+#endif /* CFE_PSP_IODRIVER_ASYNC_IO_H */
@@ -45,6 +45,21 @@ typedef struct
     uint16 SubchannelId; /**<  Subchannel number - optional, set to 0 for devices that do not have multiple channels */
 } CFE_PSP_IODriver_Location_t;
 
+/**
+ * A location resolved to its device driver, for repeated requests.
+ *
+ * Set up with CFE_PSP_IODriver_Bind() and used with
+ * CFE_PSP_IODriver_CommandByHandle(), which then skips looking up the driver
+ * module at every request.  The storage belongs to the caller, and the
+ * handle remains valid for as long as the PSP runs.  Besides Location, the
+ * content is private to iodriver.
+ */
+typedef struct
+{
+    CFE_PSP_IODriver_Location_t Location; /**< The location that was bound */
+    const void *                Api;      /**< Driver API, NULL if not bound */
+} CFE_PSP_IODriver_Handle_t;
+
 /**
  * Wrapper for constant arguments, to avoid a compiler warning
  * about arguments differing in const-ness.  Use the inline functions to
@@ -145,6 +160,32 @@ enum
 
 };
 
+/**
+ * \brief Use counters of a lock of a device, as returned by CFE_PSP_IODriver_GetLockStats()
+ *
+ * A request is counted as contended if it had to wait for another holder of
+ * the lock to release it.  The counters wrap around.
+ */
+typedef struct
+{
+    uint32 ExclusiveCount;     /**< Number of requests that took the lock for themselves */
+    uint32 ExclusiveContended; /**< Number of those that had to wait */
+    uint32 SharedCount;        /**< Number of requests that shared the lock with other read-only requests */
+    uint32 SharedContended;    /**< Number of those that had to wait for an exclusive holder */
+} CFE_PSP_IODriver_LockStats_t;
+
+/**
+ * One request of a batch, see CFE_PSP_IODriver_CommandBatch()
+ */
+typedef struct
+{
+    CFE_PSP_IODriver_Location_t Location;    /**< Aggregate location identifier */
+    uint32                      CommandCode; /**< Request identifier */
+    CFE_PSP_IODriver_Arg_t      Arg;         /**< Request argument */
+    int32                       Status;      /**< Output: result of the request, as from CFE_PSP_IODriver_Command() */
+    int32                       LockSel;     /**< Used internally by iodriver */
+} CFE_PSP_IODriver_Request_t;
+
 /* ------------------------------------------------------------- */
 /**
  * @brief Find an IO device module ID by name
@@ -169,4 +210,78 @@ int32 CFE_PSP_IODriver_FindByName(const char *DriverName, uint32 *PspModuleId);
 int32 CFE_PSP_IODriver_Command(const CFE_PSP_IODriver_Location_t *Location, uint32 CommandCode,
                                CFE_PSP_IODriver_Arg_t Arg);
 
+/* ------------------------------------------------------------- */
+/**
+ * @brief Issue several requests to IO device modules
+ *
+ * The requests that use the same lock of a driver are executed together,
+ * in the order of the array, while holding that lock once.  The lock is
+ * shared if all of them only read.  The groups of requests for different
+ * locks, and the requests that use no lock of their driver, may execute in
+ * any order relative to each other.
+ *
+ * Each request gets the same result in its Status as from
+ * CFE_PSP_IODriver_Command().  Note that other requests for a lock wait
+ * until its whole group is done.
+ *
+ * @param Requests array of requests
+ * @param NumRequests number of requests in the array
+ *
+ * @retval #CFE_PSP_SUCCESS if all requests succeeded
+ * @retval #CFE_PSP_ERROR if at least one request failed, see the Status of each
+ * @retval #CFE_PSP_INVALID_POINTER if Requests is NULL
+ */
+int32 CFE_PSP_IODriver_CommandBatch(CFE_PSP_IODriver_Request_t *Requests, uint32 NumRequests);
+
+/* ------------------------------------------------------------- */
+/**
+ * @brief Resolve a location to its device driver, for use with CFE_PSP_IODriver_CommandByHandle()
+ *
+ * This also creates any locks that the driver uses, which are otherwise
+ * created by the first request that needs them.
+ *
+ * @param Location Aggregate location identifier
+ * @param Handle location to store the handle
+ *
+ * @retval #CFE_PSP_SUCCESS if successful
+ * @retval #CFE_PSP_INVALID_POINTER if Location or Handle is NULL
+ * @retval #CFE_PSP_INVALID_MODULE_ID if the module is not a device driver
+ * @retval #CFE_PSP_ERROR_NOT_IMPLEMENTED if the driver does not execute requests
+ * @retval #CFE_PSP_ERROR if the locks of the driver could not be created
+ */
+int32 CFE_PSP_IODriver_Bind(const CFE_PSP_IODriver_Location_t *Location, CFE_PSP_IODriver_Handle_t *Handle);
+
+/* ------------------------------------------------------------- */
+/**
+ * @brief Issue a request to the location of a handle
+ *
+ * Same as CFE_PSP_IODriver_Command(), without looking up the driver.
+ *
+ * @param Handle Handle set up by CFE_PSP_IODriver_Bind()
+ * @param CommandCode Request identifier
+ * @param Arg Request Argument
+ *
+ * @retval #CFE_PSP_SUCCESS if successful, or error code if not successful
+ * @retval #CFE_PSP_INVALID_POINTER if Handle is NULL or not bound
+ */
+int32 CFE_PSP_IODriver_CommandByHandle(const CFE_PSP_IODriver_Handle_t *Handle, uint32 CommandCode,
+                                       CFE_PSP_IODriver_Arg_t Arg);
+
+/* ------------------------------------------------------------- */
+/**
+ * @brief Get the use counters of a lock of an IO device module
+ *
+ * The locks of a device and the requests that use each of them are
+ * described in the header of the device driver.
+ *
+ * @param PspModuleId the device module ID
+ * @param LockIndex the lock of the device, starting at 0
+ * @param Stats location to store the counters
+ *
+ * @retval #CFE_PSP_SUCCESS if successful
+ * @retval #CFE_PSP_INVALID_POINTER if Stats is NULL
+ * @retval #CFE_PSP_ERROR_NOT_IMPLEMENTED if the device does not have this lock
+ */
+int32 CFE_PSP_IODriver_GetLockStats(uint32 PspModuleId, uint16 LockIndex, CFE_PSP_IODriver_LockStats_t *Stats);
+
 #endif /* IODRIVER_BASE_H */
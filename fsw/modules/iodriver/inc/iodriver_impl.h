@@ -22,6 +22,8 @@
 
 #include "cfe_psp_module.h"
 #include "iodriver_base.h"
+#include "iodriver_async_io.h"
+#include "iodriver_packet_io.h"
 
 /**
  * Macro to declare the global object for an IO device driver
@@ -43,13 +45,240 @@
 typedef int32 (*CFE_PSP_IODriver_ApiFunc_t)(uint32 CommandCode, uint16 Instance, uint16 SubChannel,
                                             CFE_PSP_IODriver_Arg_t arg);
 
+/**
+ * A lock of a device, protecting one of its concurrency domains (e.g. a bus or a channel)
+ *
+ * The lock is a reader/writer lock: requests that only read may hold it
+ * together, other requests hold it alone.  A request waiting for exclusive
+ * access makes new readers queue behind it, so that a steady flow of reads
+ * cannot hold off commands.
+ *
+ * The storage is declared by the driver, zero initialized, and the OSAL
+ * objects are created by iodriver the first time the lock is used.
+ */
+typedef struct
+{
+    uint32    Created;     /**< Nonzero once the OSAL objects below exist, accessed atomically */
+    osal_id_t Turnstile;   /**< Mutex held by an exclusive request while it waits */
+    osal_id_t ReaderMutex; /**< Mutex protecting Readers */
+    osal_id_t Access;      /**< Binary semaphore, held by an exclusive request or by the readers as a group */
+    uint32    Readers;     /**< Number of readers holding Access */
+
+    CFE_PSP_IODriver_LockStats_t Stats;
+} CFE_PSP_IODriver_Lock_t;
+
+/**
+ * Result of DeviceLock for a request that needs no lock
+ */
+#define CFE_PSP_IODRIVER_LOCK_NONE (-1)
+
+/**
+ * Flag in the result of DeviceLock for a request that only reads
+ */
+#define CFE_PSP_IODRIVER_LOCK_SHARED 0x00010000
+
+/**
+ * API of a device driver
+ *
+ * DeviceCommand executes the requests.  The locking around it is chosen by
+ * the first of these that the driver sets:
+ *  - DeviceLock, Locks and NumLocks: DeviceLock returns the index of the lock
+ *    in Locks that the request needs, from CFE_PSP_IODriver_LockExclusive() or
+ *    CFE_PSP_IODriver_LockShared(), or CFE_PSP_IODRIVER_LOCK_NONE.  A driver
+ *    should have a lock per resource that can be used independently, such as
+ *    each of its buses, so that requests to different resources never wait
+ *    for each other.
+ *  - DeviceMutex: returns a hash of the device, which selects one of the
+ *    mutexes shared by all drivers (see CFE_PSP_IODriver_GetMutex()), or a
+ *    negative value for no lock.
+ *  - neither: the driver does its own locking.
+ */
 typedef const struct
 {
     CFE_PSP_IODriver_ApiFunc_t DeviceCommand;
     CFE_PSP_IODriver_ApiFunc_t DeviceMutex;
+    CFE_PSP_IODriver_ApiFunc_t DeviceLock;
+    CFE_PSP_IODriver_Lock_t *  Locks;
+    uint16                     NumLocks;
 } CFE_PSP_IODriver_API_t;
 
+/**
+ * Gets the DeviceLock result of a request that needs the lock for itself
+ */
+static inline int32 CFE_PSP_IODriver_LockExclusive(uint16 LockIndex)
+{
+    return (int32)LockIndex;
+}
+
+/**
+ * Gets the DeviceLock result of a request that only reads, and may share the lock
+ */
+static inline int32 CFE_PSP_IODriver_LockShared(uint16 LockIndex)
+{
+    return (int32)LockIndex | CFE_PSP_IODRIVER_LOCK_SHARED;
+}
+
+/**
+ * Publication state of data that a device samples in the background
+ *
+ * The device keeps two copies of its sampled data, indexed 0 and 1.  The
+ * sampling task fills the copy given by CFE_PSP_IODriver_SnapshotWriteBegin()
+ * and then makes it current with CFE_PSP_IODriver_SnapshotPublish().
+ *
+ * Readers take no lock: they copy what they need from the copy given by
+ * CFE_PSP_IODriver_SnapshotReadBegin(), and start over if
+ * CFE_PSP_IODriver_SnapshotReadRetry() reports that the sampling task reused
+ * that copy in the meantime.  The copy being read is only reused once the
+ * next sample is published and the one after it is started, so a read that
+ * overlaps a single publish does not retry.  A reader that preempts the
+ * sampling task never has to retry, as the task only ever writes the copy
+ * that is not current, so this is also safe on a single CPU with any task
+ * priorities.
+ *
+ * Only a single task may publish.
+ */
+typedef struct
+{
+    volatile uint32 Sequence; /**< Number of published samples, the current copy is (Sequence & 1) */
+    volatile uint32 Filling;  /**< Sequence of the sample being filled, equal to Sequence between samples */
+} CFE_PSP_IODriver_Snapshot_t;
+
+/**
+ * Starts filling the next sample, for the sampling task
+ *
+ * \returns The copy (0 or 1) to fill
+ */
+static inline uint32 CFE_PSP_IODriver_SnapshotWriteBegin(CFE_PSP_IODriver_Snapshot_t *Snapshot)
+{
+    Snapshot->Filling = Snapshot->Sequence + 1;
+
+    /* readers of the copy must see that it is reused before any of the new data */
+    __sync_synchronize();
+
+    return Snapshot->Filling & 1;
+}
+
+/**
+ * Makes the copy filled since CFE_PSP_IODriver_SnapshotWriteBegin() the current one
+ */
+static inline void CFE_PSP_IODriver_SnapshotPublish(CFE_PSP_IODriver_Snapshot_t *Snapshot)
+{
+    /* the data must be complete before readers can see the new sequence */
+    __sync_synchronize();
+    Snapshot->Sequence = Snapshot->Filling;
+}
+
+/**
+ * Starts reading the current copy
+ *
+ * The data of the copy must be read after this, and checked with
+ * CFE_PSP_IODriver_SnapshotReadRetry() before it is used.
+ *
+ * \returns The sequence number, (Sequence & 1) is the copy to read
+ */
+static inline uint32 CFE_PSP_IODriver_SnapshotReadBegin(const CFE_PSP_IODriver_Snapshot_t *Snapshot)
+{
+    uint32 Sequence;
+
+    Sequence = Snapshot->Sequence;
+    __sync_synchronize();
+
+    return Sequence;
+}
+
+/**
+ * Checks whether the data read since CFE_PSP_IODriver_SnapshotReadBegin() may be inconsistent
+ *
+ * This is the case once the sampling task has started filling the copy that
+ * was read, that is two samples after the one read, even if the second one
+ * is not published yet.
+ *
+ * \returns true if the read must be done again
+ */
+static inline bool CFE_PSP_IODriver_SnapshotReadRetry(const CFE_PSP_IODriver_Snapshot_t *Snapshot, uint32 Sequence)
+{
+    __sync_synchronize();
+
+    return (uint32)(Snapshot->Filling - Sequence) >= 2;
+}
+
+/**
+ * Executes the requests of an asynchronous queue with the blocking opcodes of a driver
+ *
+ * A driver without its own asynchronous I/O can call this for the SUBMIT
+ * opcode of the class, so that the requests run in the task issuing SUBMIT,
+ * or from its own task, woken up by SUBMIT.  Each request is passed to
+ * DeviceCommand with the buffer structure of its READ or WRITE opcode, and
+ * the caller of the queue is notified once the requests are done.
+ *
+ * \returns Number of requests executed
+ */
+uint32 CFE_PSP_IODriver_AsyncProcess(CFE_PSP_IODriver_AsyncQueue_t *Queue, CFE_PSP_IODriver_ApiFunc_t DeviceCommand,
+                                     uint16 Instance, uint16 SubChannel);
+
+/**
+ * Maximum number of buffers of a CFE_PSP_IODriver_LoanPool_t
+ */
+#define CFE_PSP_IODRIVER_LOAN_POOL_MAX 32
+
+/**
+ * Buffers of a driver that it hands out with the packet loan opcodes
+ *
+ * Keeps track of the buffers on loan, the LoanId of a loan being the index
+ * of its buffer.  Loans may be taken and ended from any task, without locks.
+ */
+typedef struct
+{
+    uint8 *Memory;     /**< NumBuffers buffers of BufferSize bytes each */
+    uint32 BufferSize; /**< Size of each buffer */
+    uint32 NumBuffers; /**< Number of buffers, at most CFE_PSP_IODRIVER_LOAN_POOL_MAX */
+    uint32 OnLoan;     /**< Bit set for each buffer on loan, accessed atomically */
+} CFE_PSP_IODriver_LoanPool_t;
+
+/**
+ * Sets up a pool of loan buffers, none of them on loan
+ *
+ * \returns CFE_PSP_SUCCESS, CFE_PSP_INVALID_POINTER or CFE_PSP_ERROR if the number of buffers is out of range
+ */
+int32 CFE_PSP_IODriver_LoanPoolInit(CFE_PSP_IODriver_LoanPool_t *Pool, void *Memory, uint32 BufferSize,
+                                    uint32 NumBuffers);
+
+/**
+ * Loans out a given buffer, e.g. the one in which the device received a packet
+ *
+ * Sets the loan to the whole buffer, a driver loaning a received packet
+ * then reduces BufferSize to the size of the packet.
+ *
+ * \returns CFE_PSP_SUCCESS, or CFE_PSP_IODriver_PACKET_NO_LOAN_ERROR if the buffer is already on loan
+ */
+int32 CFE_PSP_IODriver_LoanTakeBuffer(CFE_PSP_IODriver_LoanPool_t *Pool, uint32 Index,
+                                      CFE_PSP_IODriver_PacketLoan_t *Loan);
+
+/**
+ * Loans out any buffer that is not on loan, as for CFE_PSP_IODriver_LoanTakeBuffer()
+ *
+ * \returns CFE_PSP_SUCCESS, or CFE_PSP_IODriver_PACKET_NO_LOAN_ERROR if all buffers are on loan
+ */
+int32 CFE_PSP_IODriver_LoanTake(CFE_PSP_IODriver_LoanPool_t *Pool, CFE_PSP_IODriver_PacketLoan_t *Loan);
+
+/**
+ * Checks that a loan passed back by the caller is one the pool has out, e.g. before sending from it
+ *
+ * \returns CFE_PSP_SUCCESS, or CFE_PSP_ERROR if the loan is not valid
+ */
+int32 CFE_PSP_IODriver_LoanCheck(const CFE_PSP_IODriver_LoanPool_t *Pool, const CFE_PSP_IODriver_PacketLoan_t *Loan);
+
+/**
+ * Ends a loan, the buffer can then be loaned out again
+ *
+ * \returns CFE_PSP_SUCCESS, or CFE_PSP_ERROR if the loan is not valid
+ */
+int32 CFE_PSP_IODriver_LoanEnd(CFE_PSP_IODriver_LoanPool_t *Pool, const CFE_PSP_IODriver_PacketLoan_t *Loan);
+
 osal_id_t CFE_PSP_IODriver_GetMutex(uint32 PspModuleId, int32 DeviceHash);
 int32     CFE_PSP_IODriver_HashMutex(int32 StartHash, int32 Datum);
 
+int32 CFE_PSP_IODriver_LockTake(uint32 PspModuleId, uint16 LockIndex, CFE_PSP_IODriver_Lock_t *Lock, bool Shared);
+void  CFE_PSP_IODriver_LockGive(CFE_PSP_IODriver_Lock_t *Lock, bool Shared);
+
 #endif /* IODRIVER_IMPL_H */
@@ -16,6 +16,7 @@
 
 /* Include all base definitions */
 #include "iodriver_base.h"
+#include "iodriver_async_io.h"
 
 /**
  * API container for packet read/write commands.
@@ -43,6 +44,31 @@ typedef struct
     void * BufferMem;
 } CFE_PSP_IODriver_ReadPacketBuffer_t;
 
+/**
+ * API container for the packet loan commands.
+ *
+ * A loan hands out memory of the driver, such as its DMA buffers, so that
+ * packets are not copied:
+ *  - LOAN_READ gets the next received packet, BufferMem and BufferSize
+ *    are set to the packet in driver memory
+ *  - LOAN_WRITE gets driver memory to build a packet in, BufferMem and
+ *    BufferSize are set to that memory and its size
+ *  - SEND_LOAN sends a packet built in a LOAN_WRITE loan, BufferSize set
+ *    to its actual size, and ends the loan
+ *  - RETURN_LOAN ends any loan without sending anything
+ *
+ * Every loan must be ended with SEND_LOAN or RETURN_LOAN, passing the
+ * structure as filled in by the driver.  The driver has a limited number of
+ * buffers, and fails loans with CFE_PSP_IODriver_PACKET_NO_LOAN_ERROR while
+ * all of them are on loan.
+ */
+typedef struct
+{
+    uint32 BufferSize; /**<  Size of the packet or of the memory, see above */
+    void * BufferMem;  /**<  Memory of the driver */
+    uint32 LoanId;     /**<  Identifier of the loan, set by the driver */
+} CFE_PSP_IODriver_PacketLoan_t;
+
 /**
  * Opcodes specific to packet oriented interfaces
  */
@@ -50,8 +76,14 @@ enum
 {
     CFE_PSP_IODriver_PACKET_IO_NOOP = CFE_PSP_IODriver_PACKET_IO_CLASS_BASE,
 
-    CFE_PSP_IODriver_PACKET_IO_READ,  /**< CFE_PSP_IODriver_ReadPacketBuffer_t argument */
-    CFE_PSP_IODriver_PACKET_IO_WRITE, /**< CFE_PSP_IODriver_WritePacketBuffer_t argument */
+    CFE_PSP_IODriver_PACKET_IO_READ,         /**< CFE_PSP_IODriver_ReadPacketBuffer_t argument */
+    CFE_PSP_IODriver_PACKET_IO_WRITE,        /**< CFE_PSP_IODriver_WritePacketBuffer_t argument */
+    CFE_PSP_IODriver_PACKET_IO_ATTACH_QUEUE, /**< CFE_PSP_IODriver_AsyncQueue_t * argument, NULL to detach */
+    CFE_PSP_IODriver_PACKET_IO_SUBMIT,       /**< no argument, starts the requests added to the attached queue */
+    CFE_PSP_IODriver_PACKET_IO_LOAN_READ,    /**< CFE_PSP_IODriver_PacketLoan_t argument, as output */
+    CFE_PSP_IODriver_PACKET_IO_LOAN_WRITE,   /**< CFE_PSP_IODriver_PacketLoan_t argument, as output */
+    CFE_PSP_IODriver_PACKET_IO_SEND_LOAN,    /**< CFE_PSP_IODriver_PacketLoan_t argument, from LOAN_WRITE */
+    CFE_PSP_IODriver_PACKET_IO_RETURN_LOAN,  /**< CFE_PSP_IODriver_PacketLoan_t argument, from any loan */
 
     CFE_PSP_IODriver_PACKET_IO_MAX
 };
@@ -65,7 +97,8 @@ enum
 {
     CFE_PSP_IODriver_PACKET_ERROR_BASE = -(CFE_PSP_IODriver_PACKET_IO_CLASS_BASE + 0xFFFF),
     CFE_PSP_IODriver_PACKET_LENGTH_ERROR,
-    CFE_PSP_IODriver_PACKET_CRC_ERROR
+    CFE_PSP_IODriver_PACKET_CRC_ERROR,
+    CFE_PSP_IODriver_PACKET_NO_LOAN_ERROR
 };
 
 #endif /* CFE_PSP_IODRIVER_PACKET_IO_H */
@@ -16,6 +16,7 @@
 
 /* Include all base definitions */
 #include "iodriver_base.h"
+#include "iodriver_async_io.h"
 
 /**
  * API container for stream write commands.
@@ -45,8 +46,10 @@ enum
 {
     CFE_PSP_IODriver_STREAM_IO_NOOP = CFE_PSP_IODriver_STREAM_IO_CLASS_BASE,
 
-    CFE_PSP_IODriver_STREAM_IO_READ,  /**< CFE_PSP_IODriver_ReadStreamBuffer_t argument */
-    CFE_PSP_IODriver_STREAM_IO_WRITE, /**< CFE_PSP_IODriver_WriteStreamBuffer_t argument */
+    CFE_PSP_IODriver_STREAM_IO_READ,         /**< CFE_PSP_IODriver_ReadStreamBuffer_t argument */
+    CFE_PSP_IODriver_STREAM_IO_WRITE,        /**< CFE_PSP_IODriver_WriteStreamBuffer_t argument */
+    CFE_PSP_IODriver_STREAM_IO_ATTACH_QUEUE, /**< CFE_PSP_IODriver_AsyncQueue_t * argument, NULL to detach */
+    CFE_PSP_IODriver_STREAM_IO_SUBMIT,       /**< no argument, starts the requests added to the attached queue */
 
     CFE_PSP_IODriver_STREAM_IO_MAX
 };
@@ -12,16 +12,26 @@
  * of functions declared in iodriver_base.h
  */
 
+#include <string.h>
+
 #include "cfe_psp_module.h"
 #include "iodriver_base.h"
 #include "iodriver_impl.h"
+#include "iodriver_packet_io.h"
+#include "iodriver_stream_io.h"
 
 #define CFE_PSP_IODRIVER_LOCK_TABLE_SIZE 7
 
+/* LockSel of a request of a batch once it has been executed */
+#define CFE_PSP_IODRIVER_BATCH_DONE (-2)
+
 CFE_PSP_MODULE_DECLARE_SIMPLE(iodriver);
 
 static osal_id_t CFE_PSP_IODriver_Mutex_Table[CFE_PSP_IODRIVER_LOCK_TABLE_SIZE];
 
+/* Serializes the creation of the locks declared by the drivers */
+static osal_id_t CFE_PSP_IODriver_LockCreateMutex;
+
 const CFE_PSP_IODriver_API_t CFE_PSP_IODriver_DEFAULT_API = {.DeviceCommand = NULL, .DeviceMutex = NULL};
 
 void iodriver_Init(uint32 PspModuleId)
@@ -34,6 +44,8 @@ void iodriver_Init(uint32 PspModuleId)
         snprintf(TempName, sizeof(TempName), "DriverMutex-%02u", (unsigned int)(i + 1));
         OS_MutSemCreate(&CFE_PSP_IODriver_Mutex_Table[i], TempName, 0);
     }
+
+    OS_MutSemCreate(&CFE_PSP_IODriver_LockCreateMutex, "DriverLockCreate", 0);
 }
 
 CFE_PSP_IODriver_API_t *CFE_PSP_IODriver_GetAPI(uint32 PspModuleId)
@@ -61,6 +73,9 @@ CFE_PSP_IODriver_API_t *CFE_PSP_IODriver_GetAPI(uint32 PspModuleId)
  * that come in concurrently, but also ensuring that requests to the _same_ board will be serialized.
  * The computation here seemed to produce a decent-enough spread across the mutex table without
  * overlaps (at least with the current set of hardware)
+ *
+ * This is only used for drivers that set DeviceMutex, drivers that declare their own
+ * locks never share them with other drivers.
  */
 osal_id_t CFE_PSP_IODriver_GetMutex(uint32 PspModuleId, int32 DeviceHash)
 {
@@ -91,15 +106,182 @@ int32 CFE_PSP_IODriver_HashMutex(int32 StartHash, int32 Datum)
     return ((StartHash + Datum) & 0x7FFFFFFF);
 }
 
-int32 CFE_PSP_IODriver_Command(const CFE_PSP_IODriver_Location_t *Location, uint32 CommandCode,
-                               CFE_PSP_IODriver_Arg_t Arg)
+/**
+ * Creates the OSAL objects of a lock declared by a driver, unless another task just did
+ */
+static int32 CFE_PSP_IODriver_LockCreate(uint32 PspModuleId, uint16 LockIndex, CFE_PSP_IODriver_Lock_t *Lock)
 {
-    int32                   Result;
-    osal_id_t               MutexId;
-    CFE_PSP_IODriver_API_t *API;
+    int32 Status;
+    char  TempName[OS_MAX_API_NAME];
+
+    if (OS_MutSemTake(CFE_PSP_IODriver_LockCreateMutex) != OS_SUCCESS)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    Status = OS_SUCCESS;
+    if (!Lock->Created)
+    {
+        snprintf(TempName, sizeof(TempName), "IOLock-%04X-%u-T", (unsigned int)(PspModuleId & 0xFFFF),
+                 (unsigned int)LockIndex);
+        Status = OS_MutSemCreate(&Lock->Turnstile, TempName, 0);
+        if (Status == OS_SUCCESS)
+        {
+            TempName[strlen(TempName) - 1] = 'R';
+            Status                         = OS_MutSemCreate(&Lock->ReaderMutex, TempName, 0);
+        }
+        if (Status == OS_SUCCESS)
+        {
+            TempName[strlen(TempName) - 1] = 'A';
+            Status                         = OS_BinSemCreate(&Lock->Access, TempName, OS_SEM_FULL, 0);
+        }
+
+        if (Status == OS_SUCCESS)
+        {
+            /* the IDs must be complete before other tasks can see the flag */
+            __atomic_store_n(&Lock->Created, 1, __ATOMIC_RELEASE);
+        }
+        else
+        {
+            OS_printf("CFE_PSP: Failed to create lock %u of device module 0x%08lx\n", (unsigned int)LockIndex,
+                      (unsigned long)PspModuleId);
+
+            if (OS_ObjectIdDefined(Lock->Turnstile))
+            {
+                OS_MutSemDelete(Lock->Turnstile);
+            }
+            if (OS_ObjectIdDefined(Lock->ReaderMutex))
+            {
+                OS_MutSemDelete(Lock->ReaderMutex);
+            }
+            Lock->Turnstile   = OS_OBJECT_ID_UNDEFINED;
+            Lock->ReaderMutex = OS_OBJECT_ID_UNDEFINED;
+            Lock->Access      = OS_OBJECT_ID_UNDEFINED;
+        }
+    }
+
+    OS_MutSemGive(CFE_PSP_IODriver_LockCreateMutex);
+
+    return (Status == OS_SUCCESS) ? CFE_PSP_SUCCESS : CFE_PSP_ERROR;
+}
+
+/**
+ * Takes a lock declared by a driver, shared with other readers or for the caller alone.
+ * A try without waiting comes first, so that the requests that had to wait can be counted.
+ */
+int32 CFE_PSP_IODriver_LockTake(uint32 PspModuleId, uint16 LockIndex, CFE_PSP_IODriver_Lock_t *Lock, bool Shared)
+{
+    if (!__atomic_load_n(&Lock->Created, __ATOMIC_ACQUIRE) &&
+        CFE_PSP_IODriver_LockCreate(PspModuleId, LockIndex, Lock) != CFE_PSP_SUCCESS)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    if (Shared)
+    {
+        /* queue behind an exclusive request that is already waiting */
+        OS_MutSemTake(Lock->Turnstile);
+        OS_MutSemGive(Lock->Turnstile);
+
+        OS_MutSemTake(Lock->ReaderMutex);
+        if (Lock->Readers == 0 && OS_BinSemTimedWait(Lock->Access, 0) != OS_SUCCESS)
+        {
+            ++Lock->Stats.SharedContended;
+            OS_BinSemTake(Lock->Access);
+        }
+        ++Lock->Readers;
+        ++Lock->Stats.SharedCount;
+        OS_MutSemGive(Lock->ReaderMutex);
+    }
+    else
+    {
+        OS_MutSemTake(Lock->Turnstile);
+        if (OS_BinSemTimedWait(Lock->Access, 0) != OS_SUCCESS)
+        {
+            ++Lock->Stats.ExclusiveContended;
+            OS_BinSemTake(Lock->Access);
+        }
+        ++Lock->Stats.ExclusiveCount;
+        OS_MutSemGive(Lock->Turnstile);
+    }
+
+    return CFE_PSP_SUCCESS;
+}
+
+void CFE_PSP_IODriver_LockGive(CFE_PSP_IODriver_Lock_t *Lock, bool Shared)
+{
+    if (Shared)
+    {
+        OS_MutSemTake(Lock->ReaderMutex);
+        --Lock->Readers;
+        if (Lock->Readers == 0)
+        {
+            OS_BinSemGive(Lock->Access);
+        }
+        OS_MutSemGive(Lock->ReaderMutex);
+    }
+    else
+    {
+        OS_BinSemGive(Lock->Access);
+    }
+}
+
+/**
+ * Executes a request of a driver that declares its own locks
+ */
+static int32 CFE_PSP_IODriver_LockedCommand(CFE_PSP_IODriver_API_t *API, const CFE_PSP_IODriver_Location_t *Location,
+                                            uint32 CommandCode, CFE_PSP_IODriver_Arg_t Arg)
+{
+    int32                    Result;
+    int32                    LockSel;
+    uint16                   LockIndex;
+    bool                     Shared;
+    CFE_PSP_IODriver_Lock_t *Lock;
 
-    API = CFE_PSP_IODriver_GetAPI(Location->PspModuleId);
-    if (API->DeviceCommand != NULL)
+    LockSel = API->DeviceLock(CommandCode, Location->SubsystemId, Location->SubchannelId, Arg);
+    if (LockSel < 0)
+    {
+        /* No locking required */
+        Result = API->DeviceCommand(CommandCode, Location->SubsystemId, Location->SubchannelId, Arg);
+    }
+    else
+    {
+        LockIndex = LockSel & 0xFFFF;
+        Shared    = (LockSel & CFE_PSP_IODRIVER_LOCK_SHARED) != 0;
+        if (API->Locks == NULL || LockIndex >= API->NumLocks)
+        {
+            /* Lock not declared - this is a driver implementation error */
+            Result = CFE_PSP_ERROR;
+        }
+        else
+        {
+            Lock   = &API->Locks[LockIndex];
+            Result = CFE_PSP_IODriver_LockTake(Location->PspModuleId, LockIndex, Lock, Shared);
+            if (Result == CFE_PSP_SUCCESS)
+            {
+                Result = API->DeviceCommand(CommandCode, Location->SubsystemId, Location->SubchannelId, Arg);
+                CFE_PSP_IODriver_LockGive(Lock, Shared);
+            }
+        }
+    }
+
+    return Result;
+}
+
+/**
+ * Executes a request with the locking chosen by the driver
+ */
+static int32 CFE_PSP_IODriver_ApiCommand(CFE_PSP_IODriver_API_t *API, const CFE_PSP_IODriver_Location_t *Location,
+                                         uint32 CommandCode, CFE_PSP_IODriver_Arg_t Arg)
+{
+    int32     Result;
+    osal_id_t MutexId;
+
+    if (API->DeviceCommand != NULL && API->DeviceLock != NULL)
+    {
+        Result = CFE_PSP_IODriver_LockedCommand(API, Location, CommandCode, Arg);
+    }
+    else if (API->DeviceCommand != NULL)
     {
         if (API->DeviceMutex != NULL)
         {
@@ -130,6 +312,183 @@ int32 CFE_PSP_IODriver_Command(const CFE_PSP_IODriver_Location_t *Location, uint
     return Result;
 }
 
+int32 CFE_PSP_IODriver_Command(const CFE_PSP_IODriver_Location_t *Location, uint32 CommandCode,
+                               CFE_PSP_IODriver_Arg_t Arg)
+{
+    return CFE_PSP_IODriver_ApiCommand(CFE_PSP_IODriver_GetAPI(Location->PspModuleId), Location, CommandCode, Arg);
+}
+
+/**
+ * Checks whether a request of a batch still has to be executed under the given lock
+ */
+static inline bool CFE_PSP_IODriver_BatchUsesLock(const CFE_PSP_IODriver_Request_t *Request, uint32 PspModuleId,
+                                                  uint16 LockIndex)
+{
+    return (Request->LockSel >= 0 && Request->Location.PspModuleId == PspModuleId &&
+            (Request->LockSel & 0xFFFF) == LockIndex);
+}
+
+int32 CFE_PSP_IODriver_CommandBatch(CFE_PSP_IODriver_Request_t *Requests, uint32 NumRequests)
+{
+    int32                       Result;
+    uint32                      i;
+    uint32                      j;
+    uint32                      PspModuleId;
+    uint16                      LockIndex;
+    bool                        Shared;
+    CFE_PSP_IODriver_API_t *    API;
+    CFE_PSP_IODriver_Request_t *Req;
+
+    if (Requests == NULL)
+    {
+        return CFE_PSP_INVALID_POINTER;
+    }
+
+    /* find the lock that each request uses, if any */
+    for (i = 0; i < NumRequests; ++i)
+    {
+        Req          = &Requests[i];
+        Req->LockSel = CFE_PSP_IODRIVER_LOCK_NONE;
+
+        API = CFE_PSP_IODriver_GetAPI(Req->Location.PspModuleId);
+        if (API->DeviceCommand != NULL && API->DeviceLock != NULL && API->Locks != NULL)
+        {
+            Req->LockSel = API->DeviceLock(Req->CommandCode, Req->Location.SubsystemId, Req->Location.SubchannelId,
+                                           Req->Arg);
+            if (Req->LockSel < 0)
+            {
+                /* any negative value means no lock, and must not be taken for CFE_PSP_IODRIVER_BATCH_DONE */
+                Req->LockSel = CFE_PSP_IODRIVER_LOCK_NONE;
+            }
+            else if ((Req->LockSel & 0xFFFF) >= API->NumLocks)
+            {
+                /* let the single request report the driver error */
+                Req->LockSel = CFE_PSP_IODRIVER_LOCK_NONE;
+            }
+        }
+    }
+
+    /* execute each request along with all later ones that use the same lock */
+    for (i = 0; i < NumRequests; ++i)
+    {
+        Req = &Requests[i];
+        if (Req->LockSel == CFE_PSP_IODRIVER_BATCH_DONE)
+        {
+            continue;
+        }
+
+        API = CFE_PSP_IODriver_GetAPI(Req->Location.PspModuleId);
+        if (Req->LockSel < 0)
+        {
+            Req->Status  = CFE_PSP_IODriver_ApiCommand(API, &Req->Location, Req->CommandCode, Req->Arg);
+            Req->LockSel = CFE_PSP_IODRIVER_BATCH_DONE;
+            continue;
+        }
+
+        PspModuleId = Req->Location.PspModuleId;
+        LockIndex   = Req->LockSel & 0xFFFF;
+        Shared      = true;
+        for (j = i; j < NumRequests; ++j)
+        {
+            if (CFE_PSP_IODriver_BatchUsesLock(&Requests[j], PspModuleId, LockIndex) &&
+                (Requests[j].LockSel & CFE_PSP_IODRIVER_LOCK_SHARED) == 0)
+            {
+                Shared = false;
+            }
+        }
+
+        Result = CFE_PSP_IODriver_LockTake(PspModuleId, LockIndex, &API->Locks[LockIndex], Shared);
+        for (j = i; j < NumRequests; ++j)
+        {
+            if (CFE_PSP_IODriver_BatchUsesLock(&Requests[j], PspModuleId, LockIndex))
+            {
+                if (Result == CFE_PSP_SUCCESS)
+                {
+                    Requests[j].Status =
+                        API->DeviceCommand(Requests[j].CommandCode, Requests[j].Location.SubsystemId,
+                                           Requests[j].Location.SubchannelId, Requests[j].Arg);
+                }
+                else
+                {
+                    Requests[j].Status = CFE_PSP_ERROR;
+                }
+                Requests[j].LockSel = CFE_PSP_IODRIVER_BATCH_DONE;
+            }
+        }
+        if (Result == CFE_PSP_SUCCESS)
+        {
+            CFE_PSP_IODriver_LockGive(&API->Locks[LockIndex], Shared);
+        }
+    }
+
+    Result = CFE_PSP_SUCCESS;
+    for (i = 0; i < NumRequests; ++i)
+    {
+        if (Requests[i].Status < 0)
+        {
+            Result = CFE_PSP_ERROR;
+        }
+    }
+
+    return Result;
+}
+
+int32 CFE_PSP_IODriver_Bind(const CFE_PSP_IODriver_Location_t *Location, CFE_PSP_IODriver_Handle_t *Handle)
+{
+    int32                   Result;
+    uint16                  i;
+    CFE_PSP_ModuleApi_t *   ModuleAPI;
+    CFE_PSP_IODriver_API_t *API;
+
+    if (Location == NULL || Handle == NULL)
+    {
+        return CFE_PSP_INVALID_POINTER;
+    }
+
+    Handle->Location = *Location;
+    Handle->Api      = NULL;
+
+    Result = CFE_PSP_Module_GetAPIEntry(Location->PspModuleId, &ModuleAPI);
+    if (Result != CFE_PSP_SUCCESS || ModuleAPI->ModuleType != CFE_PSP_MODULE_TYPE_DEVICEDRIVER)
+    {
+        return CFE_PSP_INVALID_MODULE_ID;
+    }
+
+    API = (const CFE_PSP_IODriver_API_t *)ModuleAPI->ExtendedApi;
+    if (API->DeviceCommand == NULL)
+    {
+        return CFE_PSP_ERROR_NOT_IMPLEMENTED;
+    }
+
+    /* create the locks now, rather than in the middle of a time critical request */
+    if (API->DeviceLock != NULL && API->Locks != NULL)
+    {
+        for (i = 0; i < API->NumLocks; ++i)
+        {
+            if (!__atomic_load_n(&API->Locks[i].Created, __ATOMIC_ACQUIRE) &&
+                CFE_PSP_IODriver_LockCreate(Location->PspModuleId, i, &API->Locks[i]) != CFE_PSP_SUCCESS)
+            {
+                return CFE_PSP_ERROR;
+            }
+        }
+    }
+
+    Handle->Api = API;
+
+    return CFE_PSP_SUCCESS;
+}
+
+int32 CFE_PSP_IODriver_CommandByHandle(const CFE_PSP_IODriver_Handle_t *Handle, uint32 CommandCode,
+                                       CFE_PSP_IODriver_Arg_t Arg)
+{
+    if (Handle == NULL || Handle->Api == NULL)
+    {
+        return CFE_PSP_INVALID_POINTER;
+    }
+
+    return CFE_PSP_IODriver_ApiCommand(Handle->Api, &Handle->Location, CommandCode, Arg);
+}
+
 int32 CFE_PSP_IODriver_FindByName(const char *DriverName, uint32 *PspModuleId)
 {
     int32                Result;
@@ -151,3 +510,248 @@ int32 CFE_PSP_IODriver_FindByName(const char *DriverName, uint32 *PspModuleId)
 
     return Result;
 }
+
+int32 CFE_PSP_IODriver_GetLockStats(uint32 PspModuleId, uint16 LockIndex, CFE_PSP_IODriver_LockStats_t *Stats)
+{
+    CFE_PSP_IODriver_API_t *API;
+
+    if (Stats == NULL)
+    {
+        return CFE_PSP_INVALID_POINTER;
+    }
+
+    API = CFE_PSP_IODriver_GetAPI(PspModuleId);
+    if (API->Locks == NULL || LockIndex >= API->NumLocks)
+    {
+        return CFE_PSP_ERROR_NOT_IMPLEMENTED;
+    }
+
+    /* the counters are only read, each of them may be slightly behind the others */
+    *Stats = API->Locks[LockIndex].Stats;
+
+    return CFE_PSP_SUCCESS;
+}
+
+int32 CFE_PSP_IODriver_AsyncQueueInit(CFE_PSP_IODriver_AsyncQueue_t *Queue,
+                                      CFE_PSP_IODriver_AsyncRequest_t *SubmitEntries, uint32 NumSubmitEntries,
+                                      CFE_PSP_IODriver_AsyncCompletion_t *CompleteEntries, uint32 NumCompleteEntries,
+                                      osal_id_t CompletionSem)
+{
+    if (Queue == NULL || SubmitEntries == NULL || CompleteEntries == NULL)
+    {
+        return CFE_PSP_INVALID_POINTER;
+    }
+    if (NumSubmitEntries == 0 || (NumSubmitEntries & (NumSubmitEntries - 1)) != 0 || NumCompleteEntries == 0 ||
+        (NumCompleteEntries & (NumCompleteEntries - 1)) != 0)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    memset(Queue, 0, sizeof(*Queue));
+    Queue->SubmitRing.Mask   = NumSubmitEntries - 1;
+    Queue->SubmitEntries     = SubmitEntries;
+    Queue->CompleteRing.Mask = NumCompleteEntries - 1;
+    Queue->CompleteEntries   = CompleteEntries;
+    Queue->CompletionSem     = CompletionSem;
+
+    return CFE_PSP_SUCCESS;
+}
+
+void CFE_PSP_IODriver_AsyncNotify(CFE_PSP_IODriver_AsyncQueue_t *Queue)
+{
+    if (OS_ObjectIdDefined(Queue->CompletionSem))
+    {
+        OS_BinSemGive(Queue->CompletionSem);
+    }
+}
+
+uint32 CFE_PSP_IODriver_AsyncProcess(CFE_PSP_IODriver_AsyncQueue_t *Queue, CFE_PSP_IODriver_ApiFunc_t DeviceCommand,
+                                     uint16 Instance, uint16 SubChannel)
+{
+    uint32                               Count;
+    CFE_PSP_IODriver_AsyncRequest_t      Request;
+    CFE_PSP_IODriver_AsyncCompletion_t   Completion;
+    CFE_PSP_IODriver_ReadPacketBuffer_t  ReadPacket;
+    CFE_PSP_IODriver_WritePacketBuffer_t WritePacket;
+    CFE_PSP_IODriver_ReadStreamBuffer_t  ReadStream;
+    CFE_PSP_IODriver_WriteStreamBuffer_t WriteStream;
+
+    Count = 0;
+    while (CFE_PSP_IODriver_AsyncNextRequest(Queue, &Request))
+    {
+        Completion.BufferMem = Request.BufferMem;
+        Completion.UserData  = Request.UserData;
+
+        switch (Request.CommandCode)
+        {
+            case CFE_PSP_IODriver_PACKET_IO_READ:
+            {
+                ReadPacket.BufferSize = Request.BufferSize;
+                ReadPacket.BufferMem  = Request.BufferMem;
+                Completion.Status =
+                    DeviceCommand(Request.CommandCode, Instance, SubChannel, CFE_PSP_IODriver_VPARG(&ReadPacket));
+                Completion.ActualSize = ReadPacket.BufferSize;
+                break;
+            }
+            case CFE_PSP_IODriver_PACKET_IO_WRITE:
+            {
+                WritePacket.OutputSize = Request.BufferSize;
+                WritePacket.BufferMem  = Request.BufferMem;
+                Completion.Status =
+                    DeviceCommand(Request.CommandCode, Instance, SubChannel, CFE_PSP_IODriver_VPARG(&WritePacket));
+                Completion.ActualSize = WritePacket.OutputSize;
+                break;
+            }
+            case CFE_PSP_IODriver_STREAM_IO_READ:
+            {
+                ReadStream.BufferSize = Request.BufferSize;
+                ReadStream.BufferMem  = Request.BufferMem;
+                Completion.Status =
+                    DeviceCommand(Request.CommandCode, Instance, SubChannel, CFE_PSP_IODriver_VPARG(&ReadStream));
+                Completion.ActualSize = ReadStream.BufferSize;
+                break;
+            }
+            case CFE_PSP_IODriver_STREAM_IO_WRITE:
+            {
+                WriteStream.BufferSize = Request.BufferSize;
+                WriteStream.BufferMem  = Request.BufferMem;
+                Completion.Status =
+                    DeviceCommand(Request.CommandCode, Instance, SubChannel, CFE_PSP_IODriver_VPARG(&WriteStream));
+                Completion.ActualSize = WriteStream.BufferSize;
+                break;
+            }
+            default:
+            {
+                Completion.Status = CFE_PSP_ERROR_NOT_IMPLEMENTED;
+                break;
+            }
+        }
+        if (Completion.Status < 0)
+        {
+            Completion.ActualSize = 0;
+        }
+
+        CFE_PSP_IODriver_AsyncComplete(Queue, &Completion);
+        ++Count;
+    }
+
+    if (Count > 0)
+    {
+        CFE_PSP_IODriver_AsyncNotify(Queue);
+    }
+
+    return Count;
+}
+
+int32 CFE_PSP_IODriver_LoanPoolInit(CFE_PSP_IODriver_LoanPool_t *Pool, void *Memory, uint32 BufferSize,
+                                    uint32 NumBuffers)
+{
+    if (Pool == NULL || Memory == NULL)
+    {
+        return CFE_PSP_INVALID_POINTER;
+    }
+    if (NumBuffers == 0 || NumBuffers > CFE_PSP_IODRIVER_LOAN_POOL_MAX)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    Pool->Memory     = Memory;
+    Pool->BufferSize = BufferSize;
+    Pool->NumBuffers = NumBuffers;
+    __atomic_store_n(&Pool->OnLoan, 0, __ATOMIC_RELEASE);
+
+    return CFE_PSP_SUCCESS;
+}
+
+/**
+ * Sets a loan to a buffer of a pool
+ */
+static void CFE_PSP_IODriver_LoanSet(CFE_PSP_IODriver_LoanPool_t *Pool, uint32 Index,
+                                     CFE_PSP_IODriver_PacketLoan_t *Loan)
+{
+    Loan->BufferMem  = &Pool->Memory[Index * Pool->BufferSize];
+    Loan->BufferSize = Pool->BufferSize;
+    Loan->LoanId     = Index;
+}
+
+int32 CFE_PSP_IODriver_LoanTakeBuffer(CFE_PSP_IODriver_LoanPool_t *Pool, uint32 Index,
+                                      CFE_PSP_IODriver_PacketLoan_t *Loan)
+{
+    uint32 Bit;
+
+    if (Index >= Pool->NumBuffers)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    Bit = 1U << Index;
+    if ((__atomic_fetch_or(&Pool->OnLoan, Bit, __ATOMIC_ACQUIRE) & Bit) != 0)
+    {
+        return CFE_PSP_IODriver_PACKET_NO_LOAN_ERROR;
+    }
+
+    CFE_PSP_IODriver_LoanSet(Pool, Index, Loan);
+
+    return CFE_PSP_SUCCESS;
+}
+
+int32 CFE_PSP_IODriver_LoanTake(CFE_PSP_IODriver_LoanPool_t *Pool, CFE_PSP_IODriver_PacketLoan_t *Loan)
+{
+    uint32 OnLoan;
+    uint32 Index;
+
+    /* another task may take the buffer found free first, then look again */
+    OnLoan = __atomic_load_n(&Pool->OnLoan, __ATOMIC_RELAXED);
+    while (true)
+    {
+        Index = 0;
+        while (Index < Pool->NumBuffers && (OnLoan & (1U << Index)) != 0)
+        {
+            ++Index;
+        }
+        if (Index >= Pool->NumBuffers)
+        {
+            return CFE_PSP_IODriver_PACKET_NO_LOAN_ERROR;
+        }
+        if (__atomic_compare_exchange_n(&Pool->OnLoan, &OnLoan, OnLoan | (1U << Index), false, __ATOMIC_ACQUIRE,
+                                        __ATOMIC_RELAXED))
+        {
+            break;
+        }
+    }
+
+    CFE_PSP_IODriver_LoanSet(Pool, Index, Loan);
+
+    return CFE_PSP_SUCCESS;
+}
+
+int32 CFE_PSP_IODriver_LoanCheck(const CFE_PSP_IODriver_LoanPool_t *Pool, const CFE_PSP_IODriver_PacketLoan_t *Loan)
+{
+    if (Loan == NULL || Loan->LoanId >= Pool->NumBuffers ||
+        Loan->BufferMem != &Pool->Memory[Loan->LoanId * Pool->BufferSize] ||
+        (__atomic_load_n(&Pool->OnLoan, __ATOMIC_ACQUIRE) & (1U << Loan->LoanId)) == 0)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    return CFE_PSP_SUCCESS;
+}
+
+int32 CFE_PSP_IODriver_LoanEnd(CFE_PSP_IODriver_LoanPool_t *Pool, const CFE_PSP_IODriver_PacketLoan_t *Loan)
+{
+    uint32 Bit;
+
+    if (CFE_PSP_IODriver_LoanCheck(Pool, Loan) != CFE_PSP_SUCCESS)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    /* a loan ended twice at the same time only clears the bit once */
+    Bit = 1U << Loan->LoanId;
+    if ((__atomic_fetch_and(&Pool->OnLoan, ~Bit, __ATOMIC_RELEASE) & Bit) == 0)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    return CFE_PSP_SUCCESS;
+}
@@ -0,0 +1,51 @@
+/*
+ *  Copyright (c) 2015, United States government as represented by the
+ *  administrator of the National Aeronautics Space Administration.
+ *  All rights reserved. This software was created at NASA Glenn
+ *  Research Center pursuant to government contracts.
+ */
+
+/**
+ * @file
+ *
+ * Auto-Generated stub implementations for functions defined in iodriver_async_io header
+ */
+
+#include "iodriver_async_io.h"
+#include "utgenstub.h"
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CFE_PSP_IODriver_AsyncNotify()
+ * ----------------------------------------------------
+ */
+void CFE_PSP_IODriver_AsyncNotify(CFE_PSP_IODriver_AsyncQueue_t *Queue)
+{
+    UT_GenStub_AddParam(CFE_PSP_IODriver_AsyncNotify, CFE_PSP_IODriver_AsyncQueue_t *, Queue);
+
+    UT_GenStub_Execute(CFE_PSP_IODriver_AsyncNotify, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CFE_PSP_IODriver_AsyncQueueInit()
+ * ----------------------------------------------------
+ */
+int32 CFE_PSP_IODriver_AsyncQueueInit(CFE_PSP_IODriver_AsyncQueue_t *Queue,
+                                      CFE_PSP_IODriver_AsyncRequest_t *SubmitEntries, uint32 NumSubmitEntries,
+                                      CFE_PSP_IODriver_AsyncCompletion_t *CompleteEntries, uint32 NumCompleteEntries,
+                                      osal_id_t CompletionSem)
+{
+    UT_GenStub_SetupReturnBuffer(CFE_PSP_IODriver_AsyncQueueInit, int32);
+
+    UT_GenStub_AddParam(CFE_PSP_IODriver_AsyncQueueInit, CFE_PSP_IODriver_AsyncQueue_t *, Queue);
+    UT_GenStub_AddParam(CFE_PSP_IODriver_AsyncQueueInit, CFE_PSP_IODriver_AsyncRequest_t *, SubmitEntries);
+    UT_GenStub_AddParam(CFE_PSP_IODriver_AsyncQueueInit, uint32, NumSubmitEntries);
+    UT_GenStub_AddParam(CFE_PSP_IODriver_AsyncQueueInit, CFE_PSP_IODriver_AsyncCompletion_t *, CompleteEntries);
+    UT_GenStub_AddParam(CFE_PSP_IODriver_AsyncQueueInit, uint32, NumCompleteEntries);
+    UT_GenStub_AddParam(CFE_PSP_IODriver_AsyncQueueInit, osal_id_t, CompletionSem);
+
+    UT_GenStub_Execute(CFE_PSP_IODriver_AsyncQueueInit, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CFE_PSP_IODriver_AsyncQueueInit, int32);
+}
@@ -14,6 +14,23 @@
 #include "iodriver_base.h"
 #include "utgenstub.h"
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CFE_PSP_IODriver_Bind()
+ * ----------------------------------------------------
+ */
+int32 CFE_PSP_IODriver_Bind(const CFE_PSP_IODriver_Location_t *Location, CFE_PSP_IODriver_Handle_t *Handle)
+{
+    UT_GenStub_SetupReturnBuffer(CFE_PSP_IODriver_Bind, int32);
+
+    UT_GenStub_AddParam(CFE_PSP_IODriver_Bind, const CFE_PSP_IODriver_Location_t *, Location);
+    UT_GenStub_AddParam(CFE_PSP_IODriver_Bind, CFE_PSP_IODriver_Handle_t *, Handle);
+
+    UT_GenStub_Execute(CFE_PSP_IODriver_Bind, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CFE_PSP_IODriver_Bind, int32);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CFE_PSP_IODriver_Command()
@@ -33,6 +50,42 @@ int32 CFE_PSP_IODriver_Command(const CFE_PSP_IODriver_Location_t *Location, uint
     return UT_GenStub_GetReturnValue(CFE_PSP_IODriver_Command, int32);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CFE_PSP_IODriver_CommandBatch()
+ * ----------------------------------------------------
+ */
+int32 CFE_PSP_IODriver_CommandBatch(CFE_PSP_IODriver_Request_t *Requests, uint32 NumRequests)
+{
+    UT_GenStub_SetupReturnBuffer(CFE_PSP_IODriver_CommandBatch, int32);
+
+    UT_GenStub_AddParam(CFE_PSP_IODriver_CommandBatch, CFE_PSP_IODriver_Request_t *, Requests);
+    UT_GenStub_AddParam(CFE_PSP_IODriver_CommandBatch, uint32, NumRequests);
+
+    UT_GenStub_Execute(CFE_PSP_IODriver_CommandBatch, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CFE_PSP_IODriver_CommandBatch, int32);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CFE_PSP_IODriver_CommandByHandle()
+ * ----------------------------------------------------
+ */
+int32 CFE_PSP_IODriver_CommandByHandle(const CFE_PSP_IODriver_Handle_t *Handle, uint32 CommandCode,
+                                       CFE_PSP_IODriver_Arg_t Arg)
+{
+    UT_GenStub_SetupReturnBuffer(CFE_PSP_IODriver_CommandByHandle, int32);
+
+    UT_GenStub_AddParam(CFE_PSP_IODriver_CommandByHandle, const CFE_PSP_IODriver_Handle_t *, Handle);
+    UT_GenStub_AddParam(CFE_PSP_IODriver_CommandByHandle, uint32, CommandCode);
+    UT_GenStub_AddParam(CFE_PSP_IODriver_CommandByHandle, CFE_PSP_IODriver_Arg_t, Arg);
+
+    UT_GenStub_Execute(CFE_PSP_IODriver_CommandByHandle, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CFE_PSP_IODriver_CommandByHandle, int32);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CFE_PSP_IODriver_FindByName()
@@ -49,3 +102,21 @@ int32 CFE_PSP_IODriver_FindByName(const char *DriverName, uint32 *PspModuleId)
 
     return UT_GenStub_GetReturnValue(CFE_PSP_IODriver_FindByName, int32);
 }
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CFE_PSP_IODriver_GetLockStats()
+ * ----------------------------------------------------
+ */
+int32 CFE_PSP_IODriver_GetLockStats(uint32 PspModuleId, uint16 LockIndex, CFE_PSP_IODriver_LockStats_t *Stats)
+{
+    UT_GenStub_SetupReturnBuffer(CFE_PSP_IODriver_GetLockStats, int32);
+
+    UT_GenStub_AddParam(CFE_PSP_IODriver_GetLockStats, uint32, PspModuleId);
+    UT_GenStub_AddParam(CFE_PSP_IODriver_GetLockStats, uint16, LockIndex);
+    UT_GenStub_AddParam(CFE_PSP_IODriver_GetLockStats, CFE_PSP_IODriver_LockStats_t *, Stats);
+
+    UT_GenStub_Execute(CFE_PSP_IODriver_GetLockStats, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CFE_PSP_IODriver_GetLockStats, int32);
+}
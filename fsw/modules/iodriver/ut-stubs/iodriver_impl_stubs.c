@@ -14,6 +14,26 @@
 #include "iodriver_impl.h"
 #include "utgenstub.h"
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CFE_PSP_IODriver_AsyncProcess()
+ * ----------------------------------------------------
+ */
+uint32 CFE_PSP_IODriver_AsyncProcess(CFE_PSP_IODriver_AsyncQueue_t *Queue, CFE_PSP_IODriver_ApiFunc_t DeviceCommand,
+                                     uint16 Instance, uint16 SubChannel)
+{
+    UT_GenStub_SetupReturnBuffer(CFE_PSP_IODriver_AsyncProcess, uint32);
+
+    UT_GenStub_AddParam(CFE_PSP_IODriver_AsyncProcess, CFE_PSP_IODriver_AsyncQueue_t *, Queue);
+    UT_GenStub_AddParam(CFE_PSP_IODriver_AsyncProcess, CFE_PSP_IODriver_ApiFunc_t, DeviceCommand);
+    UT_GenStub_AddParam(CFE_PSP_IODriver_AsyncProcess, uint16, Instance);
+    UT_GenStub_AddParam(CFE_PSP_IODriver_AsyncProcess, uint16, SubChannel);
+
+    UT_GenStub_Execute(CFE_PSP_IODriver_AsyncProcess, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CFE_PSP_IODriver_AsyncProcess, uint32);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CFE_PSP_IODriver_GetMutex()
@@ -47,3 +67,125 @@ int32 CFE_PSP_IODriver_HashMutex(int32 StartHash, int32 Datum)
 
     return UT_GenStub_GetReturnValue(CFE_PSP_IODriver_HashMutex, int32);
 }
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CFE_PSP_IODriver_LoanCheck()
+ * ----------------------------------------------------
+ */
+int32 CFE_PSP_IODriver_LoanCheck(const CFE_PSP_IODriver_LoanPool_t *Pool, const CFE_PSP_IODriver_PacketLoan_t *Loan)
+{
+    UT_GenStub_SetupReturnBuffer(CFE_PSP_IODriver_LoanCheck, int32);
+
+    UT_GenStub_AddParam(CFE_PSP_IODriver_LoanCheck, const CFE_PSP_IODriver_LoanPool_t *, Pool);
+    UT_GenStub_AddParam(CFE_PSP_IODriver_LoanCheck, const CFE_PSP_IODriver_PacketLoan_t *, Loan);
+
+    UT_GenStub_Execute(CFE_PSP_IODriver_LoanCheck, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CFE_PSP_IODriver_LoanCheck, int32);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CFE_PSP_IODriver_LoanEnd()
+ * ----------------------------------------------------
+ */
+int32 CFE_PSP_IODriver_LoanEnd(CFE_PSP_IODriver_LoanPool_t *Pool, const CFE_PSP_IODriver_PacketLoan_t *Loan)
+{
+    UT_GenStub_SetupReturnBuffer(CFE_PSP_IODriver_LoanEnd, int32);
+
+    UT_GenStub_AddParam(CFE_PSP_IODriver_LoanEnd, CFE_PSP_IODriver_LoanPool_t *, Pool);
+    UT_GenStub_AddParam(CFE_PSP_IODriver_LoanEnd, const CFE_PSP_IODriver_PacketLoan_t *, Loan);
+
+    UT_GenStub_Execute(CFE_PSP_IODriver_LoanEnd, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CFE_PSP_IODriver_LoanEnd, int32);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CFE_PSP_IODriver_LoanPoolInit()
+ * ----------------------------------------------------
+ */
+int32 CFE_PSP_IODriver_LoanPoolInit(CFE_PSP_IODriver_LoanPool_t *Pool, void *Memory, uint32 BufferSize,
+                                    uint32 NumBuffers)
+{
+    UT_GenStub_SetupReturnBuffer(CFE_PSP_IODriver_LoanPoolInit, int32);
+
+    UT_GenStub_AddParam(CFE_PSP_IODriver_LoanPoolInit, CFE_PSP_IODriver_LoanPool_t *, Pool);
+    UT_GenStub_AddParam(CFE_PSP_IODriver_LoanPoolInit, void *, Memory);
+    UT_GenStub_AddParam(CFE_PSP_IODriver_LoanPoolInit, uint32, BufferSize);
+    UT_GenStub_AddParam(CFE_PSP_IODriver_LoanPoolInit, uint32, NumBuffers);
+
+    UT_GenStub_Execute(CFE_PSP_IODriver_LoanPoolInit, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CFE_PSP_IODriver_LoanPoolInit, int32);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CFE_PSP_IODriver_LoanTake()
+ * ----------------------------------------------------
+ */
+int32 CFE_PSP_IODriver_LoanTake(CFE_PSP_IODriver_LoanPool_t *Pool, CFE_PSP_IODriver_PacketLoan_t *Loan)
+{
+    UT_GenStub_SetupReturnBuffer(CFE_PSP_IODriver_LoanTake, int32);
+
+    UT_GenStub_AddParam(CFE_PSP_IODriver_LoanTake, CFE_PSP_IODriver_LoanPool_t *, Pool);
+    UT_GenStub_AddParam(CFE_PSP_IODriver_LoanTake, CFE_PSP_IODriver_PacketLoan_t *, Loan);
+
+    UT_GenStub_Execute(CFE_PSP_IODriver_LoanTake, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CFE_PSP_IODriver_LoanTake, int32);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CFE_PSP_IODriver_LoanTakeBuffer()
+ * ----------------------------------------------------
+ */
+int32 CFE_PSP_IODriver_LoanTakeBuffer(CFE_PSP_IODriver_LoanPool_t *Pool, uint32 Index,
+                                      CFE_PSP_IODriver_PacketLoan_t *Loan)
+{
+    UT_GenStub_SetupReturnBuffer(CFE_PSP_IODriver_LoanTakeBuffer, int32);
+
+    UT_GenStub_AddParam(CFE_PSP_IODriver_LoanTakeBuffer, CFE_PSP_IODriver_LoanPool_t *, Pool);
+    UT_GenStub_AddParam(CFE_PSP_IODriver_LoanTakeBuffer, uint32, Index);
+    UT_GenStub_AddParam(CFE_PSP_IODriver_LoanTakeBuffer, CFE_PSP_IODriver_PacketLoan_t *, Loan);
+
+    UT_GenStub_Execute(CFE_PSP_IODriver_LoanTakeBuffer, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CFE_PSP_IODriver_LoanTakeBuffer, int32);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CFE_PSP_IODriver_LockGive()
+ * ----------------------------------------------------
+ */
+void CFE_PSP_IODriver_LockGive(CFE_PSP_IODriver_Lock_t *Lock, bool Shared)
+{
+    UT_GenStub_AddParam(CFE_PSP_IODriver_LockGive, CFE_PSP_IODriver_Lock_t *, Lock);
+    UT_GenStub_AddParam(CFE_PSP_IODriver_LockGive, bool, Shared);
+
+    UT_GenStub_Execute(CFE_PSP_IODriver_LockGive, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CFE_PSP_IODriver_LockTake()
+ * ----------------------------------------------------
+ */
+int32 CFE_PSP_IODriver_LockTake(uint32 PspModuleId, uint16 LockIndex, CFE_PSP_IODriver_Lock_t *Lock, bool Shared)
+{
+    UT_GenStub_SetupReturnBuffer(CFE_PSP_IODriver_LockTake, int32);
+
+    UT_GenStub_AddParam(CFE_PSP_IODriver_LockTake, uint32, PspModuleId);
+    UT_GenStub_AddParam(CFE_PSP_IODriver_LockTake, uint16, LockIndex);
+    UT_GenStub_AddParam(CFE_PSP_IODriver_LockTake, CFE_PSP_IODriver_Lock_t *, Lock);
+    UT_GenStub_AddParam(CFE_PSP_IODriver_LockTake, bool, Shared);
+
+    UT_GenStub_Execute(CFE_PSP_IODriver_LockTake, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CFE_PSP_IODriver_LockTake, int32);
+}
@@ -0,0 +1,220 @@
+/***********************************************************************
+ *  Copyright (c) 2017, United States government as represented by the
+ *  administrator of the National Aeronautics and Space Administration.
+ *  All rights reserved. This software was created at NASA Glenn
+ *  Research Center pursuant to government contracts.
+ *
+ *  \file linux_sysmon_schedstat_bench.c
+ *
+ ***********************************************************************/
+
+/*
+ * Microbenchmark of the linux_sysmon /proc/schedstat parser.
+ *
+ * For each CPU count this generates schedstat contents in the kernel's
+ * version 15 format, with three scheduling domains per CPU whose masks
+ * grow with the CPU count as on real hosts.  It checks that the parser
+ * returns the expected run times, then reports the time per parse of the
+ * data in memory, and per pread() plus parse of the same data in a file.
+ *
+ * Usage: linux_sysmon_schedstat_bench [iterations]
+ */
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "linux_sysmon_schedstat.h"
+
+#define BENCH_MAX_CPUS    1024
+#define BENCH_NUM_DOMAINS 3
+
+static const uint32_t BENCH_CPU_COUNTS[] = {4, 16, 64, 256, 1024};
+
+static uint64_t BENCH_RunTime[BENCH_MAX_CPUS];
+
+static uint64_t bench_now_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000) + now.tv_nsec;
+}
+
+/*
+ * Expected run time of a CPU in the synthetic data
+ */
+static uint64_t bench_run_time(uint32_t cpu)
+{
+    return 1000000007ULL * (cpu + 1);
+}
+
+/*
+ * Appends a cpumask of NumCpus bits as printed by the kernel,
+ * in groups of 8 hex digits separated by commas
+ */
+static size_t bench_put_mask(char *buf, uint32_t NumCpus)
+{
+    size_t   len;
+    uint32_t groups;
+    uint32_t i;
+
+    len    = 0;
+    groups = (NumCpus + 31) / 32;
+    for (i = 0; i < groups; ++i)
+    {
+        len += sprintf(&buf[len], "%s%08x", (i == 0) ? "" : ",", 0xFFFFFFFFU);
+    }
+
+    return len;
+}
+
+/*
+ * Generates the contents of /proc/schedstat for NumCpus CPUs
+ * Returns a malloc'ed buffer and its size.
+ */
+static char *bench_generate(uint32_t NumCpus, size_t *Size)
+{
+    char *   buf;
+    size_t   len;
+    uint32_t cpu;
+    uint32_t dom;
+    uint32_t i;
+
+    /* a domain line has a mask and 45 values of up to 10 digits */
+    buf = malloc(128 + NumCpus * (128 + BENCH_NUM_DOMAINS * (NumCpus / 4 + 600)));
+    if (buf == NULL)
+    {
+        return NULL;
+    }
+
+    len = sprintf(buf, "version 15\ntimestamp 4295123456\n");
+    for (cpu = 0; cpu < NumCpus; ++cpu)
+    {
+        len += sprintf(&buf[len], "cpu%" PRIu32 " 0 0 %" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu64
+                       " %" PRIu64 " %" PRIu32 "\n",
+                       cpu, 123456 + cpu, 23456 + cpu, 345678 + cpu, 45678 + cpu, bench_run_time(cpu),
+                       (uint64_t)987654321 * (cpu + 3), 765432 + cpu);
+
+        for (dom = 0; dom < BENCH_NUM_DOMAINS; ++dom)
+        {
+            len += sprintf(&buf[len], "domain%" PRIu32 " ", dom);
+            len += bench_put_mask(&buf[len], NumCpus);
+            for (i = 0; i < 45; ++i)
+            {
+                len += sprintf(&buf[len], " %" PRIu32, (i * 7919 + cpu * 104729) % 4000000000U);
+            }
+            buf[len++] = '\n';
+        }
+    }
+
+    *Size = len;
+    return buf;
+}
+
+static int bench_check(const char *Data, size_t Size, uint32_t NumCpus)
+{
+    uint32_t cpu;
+    uint32_t found;
+
+    memset(BENCH_RunTime, 0, sizeof(BENCH_RunTime));
+    found = linux_sysmon_parse_schedstat(Data, Size, BENCH_RunTime, BENCH_MAX_CPUS);
+    if (found != NumCpus)
+    {
+        printf("FAIL: found %" PRIu32 " CPUs, expected %" PRIu32 "\n", found, NumCpus);
+        return -1;
+    }
+
+    for (cpu = 0; cpu < NumCpus; ++cpu)
+    {
+        if (BENCH_RunTime[cpu] != bench_run_time(cpu))
+        {
+            printf("FAIL: CPU%" PRIu32 " run time %" PRIu64 ", expected %" PRIu64 "\n", cpu, BENCH_RunTime[cpu],
+                   bench_run_time(cpu));
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    char        path[] = "/tmp/linux_sysmon_bench_XXXXXX";
+    char *      data;
+    char *      rdbuf;
+    size_t      size;
+    uint32_t    iterations;
+    uint32_t    n;
+    uint32_t    i;
+    uint64_t    start;
+    uint64_t    parse_ns;
+    uint64_t    file_ns;
+    int         fd;
+    int         status;
+    const char *result;
+
+    iterations = 1000;
+    if (argc > 1)
+    {
+        iterations = strtoul(argv[1], NULL, 0);
+    }
+    if (iterations == 0)
+    {
+        iterations = 1;
+    }
+
+    status = EXIT_SUCCESS;
+    printf("%6s %10s %12s %12s %10s\n", "cpus", "bytes", "parse ns", "pread+p ns", "MB/s");
+
+    for (n = 0; n < sizeof(BENCH_CPU_COUNTS) / sizeof(BENCH_CPU_COUNTS[0]); ++n)
+    {
+        data = bench_generate(BENCH_CPU_COUNTS[n], &size);
+        if (data == NULL || bench_check(data, size, BENCH_CPU_COUNTS[n]) != 0)
+        {
+            free(data);
+            status = EXIT_FAILURE;
+            break;
+        }
+
+        start = bench_now_ns();
+        for (i = 0; i < iterations; ++i)
+        {
+            linux_sysmon_parse_schedstat(data, size, BENCH_RunTime, BENCH_MAX_CPUS);
+        }
+        parse_ns = (bench_now_ns() - start) / iterations;
+
+        /* same data through a file, as the module reads it */
+        file_ns = 0;
+        rdbuf   = malloc(size + 1);
+        fd      = mkstemp(path);
+        if (rdbuf != NULL && fd >= 0 && write(fd, data, size) == (ssize_t)size)
+        {
+            start = bench_now_ns();
+            for (i = 0; i < iterations; ++i)
+            {
+                linux_sysmon_parse_schedstat(rdbuf, pread(fd, rdbuf, size + 1, 0), BENCH_RunTime, BENCH_MAX_CPUS);
+            }
+            file_ns = (bench_now_ns() - start) / iterations;
+        }
+        if (fd >= 0)
+        {
+            close(fd);
+            unlink(path);
+            strcpy(path, "/tmp/linux_sysmon_bench_XXXXXX");
+        }
+
+        result = (file_ns == 0) ? " (file test failed)" : "";
+        printf("%6" PRIu32 " %10lu %12" PRIu64 " %12" PRIu64 " %10.1f%s\n", BENCH_CPU_COUNTS[n], (unsigned long)size,
+               parse_ns, file_ns, (parse_ns == 0) ? 0.0 : (double)size * 1000.0 / (double)parse_ns, result);
+
+        free(rdbuf);
+        free(data);
+    }
+
+    return status;
+}
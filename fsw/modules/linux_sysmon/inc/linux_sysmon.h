@@ -0,0 +1,116 @@
+/***********************************************************************
+ *  Copyright (c) 2017, United States government as represented by the
+ *  administrator of the National Aeronautics and Space Administration.
+ *  All rights reserved. This software was created at NASA Glenn
+ *  Research Center pursuant to government contracts.
+ *
+ *  \file linux_sysmon.h
+ *
+ ***********************************************************************/
+
+/*
+ * Public definitions for the linux_sysmon device driver, accessed via iodriver.
+ *
+ * Subsystems (see CFE_PSP_IODriver_LOOKUP_SUBSYSTEM), after the common ones
+ * described in sysmon_base.h:
+ *  - "per-task": load of each thread of the process, the subchannel is a slot number
+ *  - "per-node": average load of the CPUs of each NUMA node, the subchannel is the node number
+ *  - "memory": subchannels "rss" (resident size of the process, KiB), "mem-total" and
+ *    "mem-available" (system memory, KiB), "minor-fault-rate" and "major-fault-rate"
+ *    (page faults of the process per second)
+ *  - "io": subchannels "read-rate" and "write-rate", block I/O of the process in KiB/s
+ *  - "pressure": pressure stall information, subchannels "<resource>-<kind>-avg<N>" with
+ *    resource "cpu", "memory" or "io", kind "some" or "full" and N 10, 60 or 300 seconds
+ *
+ * Pressure values use the same 24 bit scale as loads, where 0xFFFFFF is 100%
+ * of the time stalled.
+ *
+ * The "memory", "io" and "pressure" values are updated at each sample, the rates
+ * being over the last sample period.  Reading them fails with CFE_PSP_ERROR if
+ * the kernel does not provide the data (e.g. without PSI or I/O accounting).
+ *
+ * The time of a sample returned by CFE_PSP_IODriver_ANALOG_IO_READ_SNAPSHOT is
+ * on CLOCK_MONOTONIC.
+ *
+ * The CPUs are those the system may bring online when the monitoring starts,
+ * without a fixed limit.  Systems without NUMA have a single node 0.
+ *
+ * A thread keeps its "per-task" slot for as long as it exists.  The slot of a
+ * thread is found with CFE_PSP_IODriver_LOOKUP_SUBCHANNEL on that subsystem,
+ * using the thread name (which the PSP sets to the OSAL task name, truncated
+ * to 15 characters), or with LINUX_SYSMON_LOOKUP_TASK using the OSAL task id.
+ * LINUX_SYSMON_GET_TASK_STATS then returns the full accounting of the slot.
+ *
+ * The sampling is configured as described in sysmon_base.h.
+ */
+
+#ifndef LINUX_SYSMON_H
+#define LINUX_SYSMON_H
+
+#include "common_types.h"
+#include "iodriver_base.h"
+#include "sysmon_base.h"
+
+/*
+ * Limits and defaults of the sampling configuration, kept for existing users
+ */
+#define LINUX_SYSMON_MIN_PERIOD_MS     CFE_PSP_SYSMON_MIN_PERIOD_MS
+#define LINUX_SYSMON_MAX_PERIOD_MS     CFE_PSP_SYSMON_MAX_PERIOD_MS
+#define LINUX_SYSMON_MAX_WINDOW        CFE_PSP_SYSMON_MAX_WINDOW
+#define LINUX_SYSMON_DEFAULT_PERIOD_MS CFE_PSP_SYSMON_DEFAULT_PERIOD_MS
+#define LINUX_SYSMON_DEFAULT_WINDOW    CFE_PSP_SYSMON_DEFAULT_WINDOW
+
+/*
+ * Number of "per-task" slots, threads beyond this are not monitored
+ */
+#ifndef LINUX_SYSMON_MAX_TASKS
+#define LINUX_SYSMON_MAX_TASKS 128
+#endif
+
+/*
+ * Size of a thread name, including the terminator (kernel limit)
+ */
+#define LINUX_SYSMON_TASK_NAME_SIZE 16
+
+/**
+ * Device specific opcodes of linux_sysmon
+ */
+enum
+{
+    /**
+     * U32 argument (OSAL task id, see OS_ObjectIdToInteger), subsystem "per-task".
+     * Returns the slot (subchannel) of the task, negative value if not found.
+     */
+    LINUX_SYSMON_LOOKUP_TASK = CFE_PSP_IODriver_EXTENDED_BASE + 1,
+
+    /**
+     * linux_sysmon_task_stats_t * argument, subsystem "per-task".
+     * Gets the accounting of the thread in the slot given as subchannel,
+     * returns CFE_PSP_ERROR if the slot is not in use.
+     */
+    LINUX_SYSMON_GET_TASK_STATS = CFE_PSP_IODriver_EXTENDED_BASE + 2
+};
+
+/**
+ * \brief Sampling configuration, as returned by CFE_PSP_IODriver_GET_CONFIGURATION
+ */
+typedef CFE_PSP_Sysmon_Config_t linux_sysmon_config_t;
+
+/**
+ * \brief Accounting of one thread, as returned by LINUX_SYSMON_GET_TASK_STATS
+ *
+ * The times and counts are totals since the thread started.
+ */
+typedef struct linux_sysmon_task_stats
+{
+    osal_id_t TaskId;                            /**< OSAL task id, undefined if not an OSAL task */
+    uint32    ThreadId;                          /**< Kernel thread id */
+    char      Name[LINUX_SYSMON_TASK_NAME_SIZE]; /**< Thread name */
+    uint64    CpuTimeNs;                         /**< Time spent running on a CPU */
+    uint64    RunQueueWaitNs;                    /**< Time spent runnable, waiting for a CPU */
+    uint64    VoluntarySwitches;                 /**< Context switches when the thread blocked */
+    uint64    InvoluntarySwitches;               /**< Context switches when the thread was preempted */
+    uint32    Load;                              /**< CPU load over the last sample, 24 bit as for "per-cpu" */
+} linux_sysmon_task_stats_t;
+
+#endif /* LINUX_SYSMON_H */
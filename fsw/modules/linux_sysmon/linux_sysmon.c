@@ -22,26 +22,86 @@
 #include <unistd.h>
 #include <errno.h>
 #include <string.h>
-#include <pthread.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <dirent.h>
 #include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
 
 #include "cfe_psp.h"
 #include "cfe_psp_module.h"
 #include "osapi-clock.h"
 
-#include "iodriver_impl.h"
-#include "iodriver_analog_io.h"
+#include "sysmon_impl.h"
+#include "linux_sysmon.h"
+#include "linux_sysmon_schedstat.h"
 
 /********************************************************************
  * Local Defines
  ********************************************************************/
 
-#define LINUX_SYSMON_AGGREGATE_SUBSYS   0
-#define LINUX_SYSMON_CPULOAD_SUBSYS     1
-#define LINUX_SYSMON_AGGR_CPULOAD_SUBCH 0
-#define LINUX_SYSMON_MAX_CPUS           128
-#define LINUX_SYSMON_SAMPLE_DELAY       30
+/* subsystems of the driver, after the common ones of sysmon_impl.h */
+#define LINUX_SYSMON_PER_TASK_SUBSYS (CFE_PSP_SYSMON_NUM_BASE_SUBSYS + 0)
+#define LINUX_SYSMON_PER_NODE_SUBSYS (CFE_PSP_SYSMON_NUM_BASE_SUBSYS + 1)
+#define LINUX_SYSMON_MEMORY_SUBSYS   (CFE_PSP_SYSMON_NUM_BASE_SUBSYS + 2)
+#define LINUX_SYSMON_IO_SUBSYS       (CFE_PSP_SYSMON_NUM_BASE_SUBSYS + 3)
+#define LINUX_SYSMON_PRESSURE_SUBSYS (CFE_PSP_SYSMON_NUM_BASE_SUBSYS + 4)
+
+/* index of the values of a subsystem of the driver in CFE_PSP_Sysmon_Sample_t */
+#define LINUX_SYSMON_VALUES(subsys) ((subsys)-CFE_PSP_SYSMON_NUM_BASE_SUBSYS)
+
+/* CPUs are addressed by subchannel number, which is 16 bits */
+#define LINUX_SYSMON_MAX_CPUS 65536
+
+/*
+ * Initial and maximum size of the buffer that /proc/schedstat is read into.
+ * The buffer grows as needed, which normally happens only on the first read.
+ */
+#define LINUX_SYSMON_SCHEDSTAT_BUF_SIZE 16384
+#define LINUX_SYSMON_SCHEDSTAT_BUF_MAX  (4 * 1024 * 1024)
+
+/* the sampling task */
+#define LINUX_SYSMON_TASK_STACK_SIZE 16384
+#define LINUX_SYSMON_TASK_PRIORITY   100
+
+/* subchannels of the "memory" subsystem */
+#define LINUX_SYSMON_MEM_RSS_SUBCH         0
+#define LINUX_SYSMON_MEM_TOTAL_SUBCH       1
+#define LINUX_SYSMON_MEM_AVAILABLE_SUBCH   2
+#define LINUX_SYSMON_MEM_MINOR_FAULT_SUBCH 3
+#define LINUX_SYSMON_MEM_MAJOR_FAULT_SUBCH 4
+#define LINUX_SYSMON_MEM_NUM_SUBCH         5
+
+/* subchannels of the "io" subsystem */
+#define LINUX_SYSMON_IO_READ_SUBCH  0
+#define LINUX_SYSMON_IO_WRITE_SUBCH 1
+#define LINUX_SYSMON_IO_NUM_SUBCH   2
+
+/*
+ * subchannels of the "pressure" subsystem, for each resource (cpu, memory, io)
+ * and kind of stall (some, full) there are the 10, 60 and 300 second averages
+ */
+#define LINUX_SYSMON_PSI_NUM_RESOURCES 3
+#define LINUX_SYSMON_PSI_NUM_KINDS     2
+#define LINUX_SYSMON_PSI_NUM_AVGS      3
+#define LINUX_SYSMON_PSI_NUM_SUBCH \
+    (LINUX_SYSMON_PSI_NUM_RESOURCES * LINUX_SYSMON_PSI_NUM_KINDS * LINUX_SYSMON_PSI_NUM_AVGS)
+
+/*
+ * /proc files sampled for the memory, io and pressure subsystems
+ * These are kept open and re-read from the start at each sample.
+ */
+#define LINUX_SYSMON_SRC_MEMINFO    0
+#define LINUX_SYSMON_SRC_STAT       1
+#define LINUX_SYSMON_SRC_STATM      2
+#define LINUX_SYSMON_SRC_IO         3
+#define LINUX_SYSMON_SRC_PSI_CPU    4 /* one per PSI resource, in subchannel order */
+#define LINUX_SYSMON_SRC_PSI_MEMORY 5
+#define LINUX_SYSMON_SRC_PSI_IO     6
+#define LINUX_SYSMON_NUM_SRC        7
 
 #ifdef DEBUG_BUILD
 #define LINUX_SYSMON_DEBUG(...) OS_printf(__VA_ARGS__)
@@ -53,40 +113,151 @@
  * Local Type Definitions
  ********************************************************************/
 
+/*
+ * Schedstat accounting of one CPU, its load is in the CFE_PSP_Sysmon_Cpu_t of the same number
+ */
 typedef struct linux_sysmon_cpuload_core
 {
-    CFE_PSP_IODriver_AdcCode_t avg_load;
-    unsigned long              last_run_time;
+    uint64_t last_run_time;
+    uint32_t node;
 } linux_sysmon_cpuload_core_t;
 
-typedef struct linux_sysmon_cpuload_state
+/*
+ * A NUMA node, its CPUs are node_cpus[first_cpu] to node_cpus[first_cpu + num_cpus - 1]
+ */
+typedef struct linux_sysmon_node
 {
-    volatile bool is_running;
-    volatile bool should_run;
+    uint32_t first_cpu;
+    uint32_t num_cpus;
+} linux_sysmon_node_t;
+
+/*
+ * A "per-task" slot, in use while stats.ThreadId is nonzero
+ *
+ * The /proc files of the thread stay open while the slot is in use, so each
+ * sample only re-reads them.
+ */
+typedef struct linux_sysmon_task
+{
+    linux_sysmon_task_stats_t stats;
+    uint32_t                  last_scan;    /* scan in which the thread was last found */
+    int                       schedstat_fd; /* /proc/self/task/<tid>/schedstat */
+    int                       status_fd;    /* /proc/self/task/<tid>/status */
+} linux_sysmon_task_t;
+
+/*
+ * Used to find an OSAL task by a (possibly truncated) thread name
+ */
+typedef struct linux_sysmon_name_match
+{
+    const char *name;
+    osal_id_t   task_id;
+} linux_sysmon_name_match_t;
+
+/*
+ * Latest values of the memory, io and pressure subsystems
+ */
+typedef struct linux_sysmon_resources
+{
+    int      src_fd[LINUX_SYSMON_NUM_SRC];
+    uint32_t page_kib;
+
+    /* cumulative counts at the last sample, rates are computed from these */
+    uint64_t last_minor_faults;
+    uint64_t last_major_faults;
+    uint64_t last_read_bytes;
+    uint64_t last_write_bytes;
+
+    /* whether the sources of each subsystem could be read at the last sample */
+    bool memory_valid;
+    bool io_valid;
+    bool pressure_valid;
 
-    uint8_t   num_cpus;
-    pthread_t task_id;
-    int       dev_fd;
-    uint32_t  num_samples;
-    uint64_t  last_sample_time;
+    CFE_PSP_IODriver_AdcCode_t memory[LINUX_SYSMON_MEM_NUM_SUBCH];
+    CFE_PSP_IODriver_AdcCode_t io[LINUX_SYSMON_IO_NUM_SUBCH];
+    CFE_PSP_IODriver_AdcCode_t pressure[LINUX_SYSMON_PSI_NUM_SUBCH];
+} linux_sysmon_resources_t;
 
-    linux_sysmon_cpuload_core_t per_core[LINUX_SYSMON_MAX_CPUS];
+/*
+ * Device specific data of one sample, the DriverData of each CFE_PSP_Sysmon_Sample_t
+ */
+typedef struct linux_sysmon_snapshot
+{
+    linux_sysmon_task_stats_t tasks[LINUX_SYSMON_MAX_TASKS];
+} linux_sysmon_snapshot_t;
+
+/*
+ * Sampling state of the driver, set up again at each start
+ * This is only used by the sampling, that is the sampling task once started.
+ */
+typedef struct linux_sysmon_cpuload_state
+{
+    uint32_t num_cpus; /* number of CPUs in /proc/schedstat */
+    uint32_t max_cpus; /* number of CPUs the state is allocated for */
+    uint32_t num_nodes;
+    int      dev_fd;
+    int      timer_fd; /* CLOCK_MONOTONIC timer, armed for the next sample */
+    int      wake_fd;  /* eventfd written by linux_sysmon_Wake() */
+    uint32_t task_scan;
+
+    /* reused for every read of /proc/schedstat */
+    char * schedstat_buf;
+    size_t schedstat_buf_size;
+
+    /* allocated at start for max_cpus CPUs and num_nodes nodes */
+    linux_sysmon_cpuload_core_t *per_core;
+    CFE_PSP_Sysmon_Cpu_t *       cpus;
+    uint64_t *                   run_time;
+    linux_sysmon_node_t *        nodes;
+    uint32_t *                   node_cpus; /* CPU numbers ordered by node */
+
+    linux_sysmon_resources_t resources;
+    linux_sysmon_task_t      tasks[LINUX_SYSMON_MAX_TASKS];
+
+    /* values of the subsystems of the driver in both snapshots */
+    CFE_PSP_IODriver_AdcCode_t task_load[2 * LINUX_SYSMON_MAX_TASKS];
+    CFE_PSP_IODriver_AdcCode_t memory[2 * LINUX_SYSMON_MEM_NUM_SUBCH];
+    CFE_PSP_IODriver_AdcCode_t io[2 * LINUX_SYSMON_IO_NUM_SUBCH];
+    CFE_PSP_IODriver_AdcCode_t pressure[2 * LINUX_SYSMON_PSI_NUM_SUBCH];
+    linux_sysmon_snapshot_t    snapshot[2];
 } linux_sysmon_cpuload_state_t;
 
+/*
+ * Storage of the snapshots and the history, allocated at the first start
+ *
+ * Readers of the snapshots take no lock, so this is kept for the lifetime
+ * of the module rather than released when stopping.
+ */
+typedef struct linux_sysmon_storage
+{
+    uint32_t                    max_cpus; /* number of CPUs the storage is allocated for */
+    uint32_t                    num_nodes;
+    CFE_PSP_IODriver_AdcCode_t *snapshot_values; /* CPU and node values of both snapshots, as one block */
+    CFE_PSP_Sysmon_History_t *  history;         /* aggregate load, then each CPU */
+} linux_sysmon_storage_t;
+
 typedef struct linux_sysmon_state
 {
     uint32_t                     local_module_id;
+    CFE_PSP_Sysmon_t             sysmon;
     linux_sysmon_cpuload_state_t cpu_load;
+    linux_sysmon_storage_t       storage;
 } linux_sysmon_state_t;
 
 /********************************************************************
  * Local Function Prototypes
  ********************************************************************/
 
-static void *  linux_sysmon_Task(void *arg);
-static int32_t linux_sysmon_Start(linux_sysmon_cpuload_state_t *state);
-static int32_t linux_sysmon_Stop(linux_sysmon_cpuload_state_t *state);
-static void    linux_sysmon_Init(uint32_t local_module_id);
+static uint64_t linux_sysmon_get_monotonic_ns(void);
+static void     linux_sysmon_Task(void);
+static int32_t  linux_sysmon_Open(CFE_PSP_Sysmon_t *sysmon);
+static uint32_t linux_sysmon_Collect(CFE_PSP_Sysmon_t *sysmon, CFE_PSP_Sysmon_Sample_t *sample, uint64_t elapsed_ns);
+static void     linux_sysmon_Close(CFE_PSP_Sysmon_t *sysmon);
+static void     linux_sysmon_WaitUntilNs(CFE_PSP_Sysmon_t *sysmon, uint64_t deadline_ns);
+static void     linux_sysmon_Wake(CFE_PSP_Sysmon_t *sysmon);
+static int32_t  linux_sysmon_Command(CFE_PSP_Sysmon_t *sysmon, uint32_t CommandCode, uint16_t SubsystemId,
+                                     uint16_t SubchannelId, CFE_PSP_IODriver_Arg_t Arg);
+static void     linux_sysmon_Init(uint32_t local_module_id);
 
 /* Function that starts up linux_sysmon driver. */
 static int32_t linux_sysmon_DevCmd(uint32_t CommandCode, uint16_t SubsystemId, uint16_t SubchannelId,
@@ -96,15 +267,56 @@ static int32_t linux_sysmon_DevCmd(uint32_t CommandCode, uint16_t SubsystemId, u
  * Global Data
  ********************************************************************/
 
+static CFE_PSP_IODriver_Lock_t linux_sysmon_locks[CFE_PSP_SYSMON_NUM_LOCKS];
+
 /* linux_sysmon device command that is called by iodriver to start up linux_sysmon */
-CFE_PSP_IODriver_API_t linux_sysmon_DevApi = {.DeviceCommand = linux_sysmon_DevCmd};
+CFE_PSP_IODriver_API_t linux_sysmon_DevApi = {.DeviceCommand = linux_sysmon_DevCmd,
+                                             .DeviceLock    = CFE_PSP_Sysmon_DevLock,
+                                             .Locks         = linux_sysmon_locks,
+                                             .NumLocks      = CFE_PSP_SYSMON_NUM_LOCKS};
 
 CFE_PSP_MODULE_DECLARE_IODEVICEDRIVER(linux_sysmon);
 
 static linux_sysmon_state_t linux_sysmon_global;
 
-static const char *linux_sysmon_subsystem_names[]  = {"aggregate", "per-cpu", NULL};
-static const char *linux_sysmon_subchannel_names[] = {"cpu-load", NULL};
+static const char *const linux_sysmon_subsystem_names[] = {"per-task", "per-node", "memory", "io", "pressure", NULL};
+
+static const char *const linux_sysmon_memory_names[] = {"rss", "mem-total", "mem-available", "minor-fault-rate",
+                                                        "major-fault-rate", NULL};
+static const char *const linux_sysmon_io_names[]     = {"read-rate", "write-rate", NULL};
+
+/* in the order <resource> * 6 + <kind> * 3 + <average> */
+static const char *const linux_sysmon_pressure_names[] = {
+    "cpu-some-avg10",      "cpu-some-avg60",      "cpu-some-avg300",
+    "cpu-full-avg10",      "cpu-full-avg60",      "cpu-full-avg300",
+    "memory-some-avg10",   "memory-some-avg60",   "memory-some-avg300",
+    "memory-full-avg10",   "memory-full-avg60",   "memory-full-avg300",
+    "io-some-avg10",       "io-some-avg60",       "io-some-avg300",
+    "io-full-avg10",       "io-full-avg60",       "io-full-avg300",
+    NULL};
+
+/* by subsystem of the driver, "per-task" subchannels are looked up by linux_sysmon_Command() */
+static const char *const *const linux_sysmon_subchannel_names[] = {
+    NULL, NULL, linux_sysmon_memory_names, linux_sysmon_io_names, linux_sysmon_pressure_names};
+
+static const CFE_PSP_Sysmon_Driver_t linux_sysmon_driver = {.Name            = "linux_sysmon",
+                                                            .SubsystemNames  = linux_sysmon_subsystem_names,
+                                                            .SubchannelNames = linux_sysmon_subchannel_names,
+                                                            .TaskEntry       = linux_sysmon_Task,
+                                                            .TaskName        = "LINUX_SYSMON",
+                                                            .TaskStackSize   = LINUX_SYSMON_TASK_STACK_SIZE,
+                                                            .TaskPriority    = LINUX_SYSMON_TASK_PRIORITY,
+                                                            .Open            = linux_sysmon_Open,
+                                                            .Collect         = linux_sysmon_Collect,
+                                                            .Close           = linux_sysmon_Close,
+                                                            .GetTimeNs       = linux_sysmon_get_monotonic_ns,
+                                                            .WaitUntilNs     = linux_sysmon_WaitUntilNs,
+                                                            .Wake            = linux_sysmon_Wake,
+                                                            .Command         = linux_sysmon_Command};
+
+static const char *linux_sysmon_source_paths[LINUX_SYSMON_NUM_SRC] = {
+    "/proc/meminfo", "/proc/self/stat", "/proc/self/statm", "/proc/self/io", "/proc/pressure/cpu",
+    "/proc/pressure/memory", "/proc/pressure/io"};
 
 /***********************************************************************
  * Global Functions
@@ -115,431 +327,1121 @@ void linux_sysmon_Init(uint32_t local_module_id)
     memset(&linux_sysmon_global, 0, sizeof(linux_sysmon_global));
 
     linux_sysmon_global.local_module_id = local_module_id;
+
+    CFE_PSP_Sysmon_InitState(&linux_sysmon_global.sysmon, &linux_sysmon_driver);
 }
 
-void linux_sysmon_read_cpuuse_line(const char *line_data, unsigned int *cpu_num, unsigned long *run_time)
+uint64_t linux_sysmon_get_monotonic_ns(void)
 {
-    unsigned long value;
-    const char *  val_end;
-    int           val_count;
+    struct timespec now;
 
-    /* each "cpu" line contains the cpu number followed by 9 values */
-    for (val_count = 0; val_count < 10 && *line_data != 0; ++val_count)
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000) + now.tv_nsec;
+}
+
+/*
+ * Reads all of /proc/schedstat into the state buffer
+ *
+ * A single pread() at offset 0 gets the whole file, as long as it fits.
+ * If the buffer was filled the file may be longer, so it is grown and the
+ * file read again.  Returns the number of bytes read, or -1 on error.
+ */
+ssize_t linux_sysmon_read_schedstat(linux_sysmon_cpuload_state_t *state)
+{
+    ssize_t rdsz;
+    char *  new_buf;
+
+    while (true)
     {
-        while (isspace((unsigned char)*line_data))
+        rdsz = pread(state->dev_fd, state->schedstat_buf, state->schedstat_buf_size, 0);
+        if (rdsz < 0 || (size_t)rdsz < state->schedstat_buf_size ||
+            state->schedstat_buf_size >= LINUX_SYSMON_SCHEDSTAT_BUF_MAX)
         {
-            ++line_data;
+            break;
         }
-        value = strtoul(line_data, (char **)&val_end, 10);
-        if (val_end == line_data)
+
+        new_buf = realloc(state->schedstat_buf, 2 * state->schedstat_buf_size);
+        if (new_buf == NULL)
         {
-            /* not a number, something went wrong */
+            /* use what was read, the parser ignores an incomplete last line */
             break;
         }
+        state->schedstat_buf = new_buf;
+        state->schedstat_buf_size *= 2;
+    }
 
-        line_data = val_end;
+    return rdsz;
+}
 
-        switch (val_count)
-        {
-            case 0: /* this is the cpu number */
-                *cpu_num = value;
-                break;
+void linux_sysmon_update_schedstat(linux_sysmon_cpuload_state_t *state, uint64_t elapsed_ns)
+{
+    ssize_t  rdsz;
+    uint32_t cpu_num;
+    uint32_t num_cpus;
 
-            case 7: /* this is the number of nanoseconds spent executing instructions on this CPU */
-                *run_time = value;
-                break;
+    linux_sysmon_cpuload_core_t *core_p;
+    CFE_PSP_Sysmon_Cpu_t *       cpu_p;
 
-            default: /* don't care about this one */
-                break;
-        }
+    rdsz = linux_sysmon_read_schedstat(state);
+    if (rdsz < 0)
+    {
+        /* not expected */
+        perror("pread(/proc/schedstat)");
+        return;
+    }
+
+    /* a CPU missing from the file keeps its last value, so reads as idle */
+    for (cpu_num = 0; cpu_num < state->max_cpus; ++cpu_num)
+    {
+        state->run_time[cpu_num] = state->per_core[cpu_num].last_run_time;
+    }
+
+    num_cpus = linux_sysmon_parse_schedstat(state->schedstat_buf, rdsz, state->run_time, state->max_cpus);
+    if (num_cpus == 0)
+    {
+        OS_printf("CFE_PSP(linux_sysmon): malformed data from /proc/schedstat\n");
+        return;
+    }
+
+    for (cpu_num = 0; cpu_num < num_cpus; ++cpu_num)
+    {
+        core_p                = &state->per_core[cpu_num];
+        cpu_p                 = &state->cpus[cpu_num];
+        cpu_p->Load           = CFE_PSP_Sysmon_ScaleLoad(state->run_time[cpu_num] - core_p->last_run_time, elapsed_ns);
+        core_p->last_run_time = state->run_time[cpu_num];
+        LINUX_SYSMON_DEBUG("CFE_PSP(linux_sysmon): CPU%u load=%06x\n", (unsigned int)cpu_num,
+                           (unsigned int)cpu_p->Load);
     }
+
+    state->num_cpus = num_cpus;
 }
 
-void linux_sysmon_update_schedstat(linux_sysmon_cpuload_state_t *state, int elapsed_ms)
+/*
+ * Reads a small /proc file in one go into a null-terminated buffer
+ * Returns the number of bytes read, or -1 on error.
+ */
+ssize_t linux_sysmon_read_file(const char *path, char *buf, size_t size)
 {
-    unsigned int  cpu_time_ms;
-    unsigned int  cpu_num;
-    unsigned int  highest_cpu_num;
-    unsigned long run_time;
-    char          line_data[256];
-    size_t        line_size;
-    ssize_t       line_rdsz;
-    char *        eol_p;
+    int     fd;
+    ssize_t rdsz;
 
-    linux_sysmon_cpuload_core_t *core_p;
+    fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return -1;
+    }
 
-    line_size       = 0;
-    highest_cpu_num = 0;
+    rdsz = read(fd, buf, size - 1);
+    close(fd);
+    if (rdsz < 0)
+    {
+        return -1;
+    }
 
-    /* Reset to beginning of file to re-read it */
-    lseek(state->dev_fd, 0, SEEK_SET);
+    buf[rdsz] = 0;
+    return rdsz;
+}
 
-    while (true)
+/*
+ * Re-reads an open /proc file from the start into a null-terminated buffer
+ * Returns the number of bytes read, or -1 if the file is not open or on error.
+ */
+ssize_t linux_sysmon_reread_file(int fd, char *buf, size_t size)
+{
+    ssize_t rdsz;
+
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    rdsz = pread(fd, buf, size - 1, 0);
+    if (rdsz < 0)
+    {
+        return -1;
+    }
+
+    buf[rdsz] = 0;
+    return rdsz;
+}
+
+/*
+ * Gets the value following "key" in a /proc/.../status file, or 0 if not found
+ * The key must include the preceding newline so it does not match within another key.
+ */
+unsigned long long linux_sysmon_get_status_value(const char *status, const char *key)
+{
+    const char *p;
+
+    p = strstr(status, key);
+    if (p == NULL)
     {
-        line_rdsz = read(state->dev_fd, &line_data[line_size], sizeof(line_data) - line_size);
-        if (line_rdsz <= 0)
+        return 0;
+    }
+
+    return strtoull(p + strlen(key), NULL, 10);
+}
+
+void linux_sysmon_match_task_name(osal_id_t object_id, void *arg)
+{
+    linux_sysmon_name_match_t *match = arg;
+    char                       name[OS_MAX_API_NAME];
+
+    if (OS_GetResourceName(object_id, name, sizeof(name)) == OS_SUCCESS &&
+        strncmp(name, match->name, LINUX_SYSMON_TASK_NAME_SIZE - 1) == 0)
+    {
+        match->task_id = object_id;
+    }
+}
+
+/*
+ * Maps a thread name back to the OSAL task that has it
+ *
+ * The PSP event handler names the threads of OSAL tasks after the task, truncated
+ * to the kernel limit.  A name of the maximum length may have been truncated, so
+ * in that case the tasks are searched for a matching prefix.
+ */
+osal_id_t linux_sysmon_find_task_id(const char *name)
+{
+    linux_sysmon_name_match_t match;
+
+    match.name    = name;
+    match.task_id = OS_OBJECT_ID_UNDEFINED;
+
+    if (OS_TaskGetIdByName(&match.task_id, name) != OS_SUCCESS)
+    {
+        match.task_id = OS_OBJECT_ID_UNDEFINED;
+        if (strlen(name) == (LINUX_SYSMON_TASK_NAME_SIZE - 1))
         {
-            /* error (not expected) or EOF, stop reading */
-            break;
+            OS_ForEachObjectOfType(OS_OBJECT_TYPE_OS_TASK, OS_OBJECT_CREATOR_ANY, linux_sysmon_match_task_name, &match);
         }
+    }
 
-        /* check for newline char */
-        eol_p = memchr(&line_data[line_size], '\n', line_rdsz);
-        line_size += line_rdsz;
+    return match.task_id;
+}
 
-        while (eol_p != NULL)
-        {
-            *eol_p = 0;
-            ++eol_p;
+/*
+ * Opens the /proc files of a thread taking a free "per-task" slot
+ * A file that cannot be opened, e.g. because the thread already exited, is left closed.
+ */
+void linux_sysmon_open_task(linux_sysmon_task_t *task, uint32_t tid)
+{
+    char path[64];
 
-            if (strncmp("cpu", line_data, 3) == 0)
-            {
-                cpu_num  = -1;
-                run_time = 0;
-                linux_sysmon_read_cpuuse_line(&line_data[3], &cpu_num, &run_time);
+    snprintf(path, sizeof(path), "/proc/self/task/%lu/schedstat", (unsigned long)tid);
+    task->schedstat_fd = open(path, O_RDONLY | O_CLOEXEC);
+    snprintf(path, sizeof(path), "/proc/self/task/%lu/status", (unsigned long)tid);
+    task->status_fd = open(path, O_RDONLY | O_CLOEXEC);
+}
 
-                if (cpu_num < LINUX_SYSMON_MAX_CPUS)
-                {
-                    core_p = &state->per_core[cpu_num];
-                    if (cpu_num > highest_cpu_num)
-                    {
-                        highest_cpu_num = cpu_num;
-                    }
-                }
-                else
-                {
-                    core_p = NULL;
-                }
+/*
+ * Closes the /proc files of a "per-task" slot in use and frees the slot
+ */
+void linux_sysmon_release_task(linux_sysmon_task_t *task)
+{
+    if (task->schedstat_fd >= 0)
+    {
+        close(task->schedstat_fd);
+    }
+    if (task->status_fd >= 0)
+    {
+        close(task->status_fd);
+    }
+    memset(task, 0, sizeof(*task));
+}
 
-                if (core_p != NULL)
-                {
-                    cpu_time_ms =
-                        OS_TimeGetTotalMilliseconds(OS_TimeFromTotalNanoseconds(run_time - core_p->last_run_time));
-                    core_p->last_run_time = run_time;
-                    if (cpu_time_ms >= elapsed_ms)
-                    {
-                        core_p->avg_load = 0xFFFFFF; /* max */
-                    }
-                    else if (elapsed_ms == 0)
-                    {
-                        core_p->avg_load = 0;
-                    }
-                    else
-                    {
-                        core_p->avg_load = (0x1000 * cpu_time_ms) / elapsed_ms;
-                        core_p->avg_load |= (core_p->avg_load << 12); /* Expand from 12->24 bit */
-                    }
-                    LINUX_SYSMON_DEBUG("CFE_PSP(linux_sysmon): CPU%u time_ms=%u ms, load=%06x\n", cpu_num, cpu_time_ms,
-                                       (unsigned int)core_p->avg_load);
-                }
-            }
+/*
+ * Reads the accounting of one thread into its slot, opening its files if the slot is free
+ */
+void linux_sysmon_update_task(linux_sysmon_task_t *task, uint32_t tid, uint64_t elapsed_ns)
+{
+    char               buf[2048];
+    char *             name_p;
+    size_t             name_len;
+    ssize_t            rdsz;
+    unsigned long long run_time;
+    unsigned long long wait_time;
+
+    /* schedstat holds: time on cpu (ns), time waiting on a runqueue (ns), number of timeslices */
+    rdsz = -1;
+    if (task->stats.ThreadId == tid)
+    {
+        rdsz = linux_sysmon_reread_file(task->schedstat_fd, buf, sizeof(buf));
+        if (rdsz < 0)
+        {
+            /* the files belong to a thread that exited, and whose id was reused since */
+            linux_sysmon_release_task(task);
+        }
+    }
+    if (task->stats.ThreadId != tid)
+    {
+        linux_sysmon_open_task(task, tid);
+        rdsz = linux_sysmon_reread_file(task->schedstat_fd, buf, sizeof(buf));
+    }
+    if (rdsz > 0 && sscanf(buf, "%llu %llu", &run_time, &wait_time) == 2)
+    {
+        if (task->stats.ThreadId == tid)
+        {
+            task->stats.Load = CFE_PSP_Sysmon_ScaleLoad(run_time - task->stats.CpuTimeNs, elapsed_ns);
+        }
+        task->stats.CpuTimeNs      = run_time;
+        task->stats.RunQueueWaitNs = wait_time;
+    }
+
+    if (linux_sysmon_reread_file(task->status_fd, buf, sizeof(buf)) > 0)
+    {
+        task->stats.VoluntarySwitches   = linux_sysmon_get_status_value(buf, "\nvoluntary_ctxt_switches:");
+        task->stats.InvoluntarySwitches = linux_sysmon_get_status_value(buf, "\nnonvoluntary_ctxt_switches:");
 
-            line_rdsz = eol_p - &line_data[0];
-            if (line_rdsz < line_size)
+        /* The first line is "Name:\t<name>" */
+        if (strncmp(buf, "Name:\t", 6) == 0)
+        {
+            name_p   = &buf[6];
+            name_len = strcspn(name_p, "\n");
+            if (name_len >= sizeof(task->stats.Name))
             {
-                memmove(line_data, eol_p, line_size - line_rdsz);
-                line_size -= line_rdsz;
+                name_len = sizeof(task->stats.Name) - 1;
             }
-            else
+            name_p[name_len] = 0;
+
+            /*
+             * An OSAL task sets its name from within the thread once it starts,
+             * until then it shows the name of its creator, so map it again
+             * whenever the name changes.
+             */
+            if (task->stats.ThreadId != tid || strcmp(task->stats.Name, name_p) != 0)
             {
-                line_size = 0;
+                strcpy(task->stats.Name, name_p);
+                task->stats.TaskId = linux_sysmon_find_task_id(name_p);
             }
-
-            eol_p = memchr(line_data, '\n', line_size);
-        }
-
-        if (line_size >= sizeof(line_data))
-        {
-            /* not supposed to happen, drop data */
-            OS_printf("CFE_PSP(linux_sysmon): malformed data from /proc/schedstat\n");
-            break;
         }
     }
 
-    state->num_cpus = 1 + highest_cpu_num;
+    task->stats.ThreadId = tid;
 }
 
-void *linux_sysmon_Task(void *arg)
+/*
+ * Updates the "per-task" slots from the threads currently in /proc/self/task
+ *
+ * Threads keep their slot; new threads take a free slot and the slots of
+ * threads that went away are freed.
+ */
+void linux_sysmon_update_tasks(linux_sysmon_cpuload_state_t *state, uint64_t elapsed_ns)
 {
-    linux_sysmon_cpuload_state_t *state = arg;
+    DIR *                dir;
+    struct dirent *      de;
+    char *               end_p;
+    unsigned long        tid;
+    uint32_t             slot;
+    uint32_t             free_slot;
+    linux_sysmon_task_t *task;
+
+    dir = opendir("/proc/self/task");
+    if (dir == NULL)
+    {
+        return;
+    }
 
-    OS_time_t     last_sample;
-    OS_time_t     curr_sample;
-    OS_time_t     next_sample;
-    int           msec_diff;
-    struct pollfd pfd;
+    ++state->task_scan;
+    while ((de = readdir(dir)) != NULL)
+    {
+        tid = strtoul(de->d_name, &end_p, 10);
+        if (*end_p != 0 || tid == 0)
+        {
+            /* not a thread, e.g. "." */
+            continue;
+        }
 
-    CFE_PSP_GetTime(&next_sample);
-    curr_sample = next_sample;
-    memset(&pfd, 0, sizeof(pfd));
+        free_slot = LINUX_SYSMON_MAX_TASKS;
+        for (slot = 0; slot < LINUX_SYSMON_MAX_TASKS; ++slot)
+        {
+            if (state->tasks[slot].stats.ThreadId == tid)
+            {
+                break;
+            }
+            if (free_slot == LINUX_SYSMON_MAX_TASKS && state->tasks[slot].stats.ThreadId == 0)
+            {
+                free_slot = slot;
+            }
+        }
+        if (slot == LINUX_SYSMON_MAX_TASKS)
+        {
+            slot = free_slot;
+        }
+        if (slot == LINUX_SYSMON_MAX_TASKS)
+        {
+            /* no room, this thread is not monitored */
+            continue;
+        }
 
-    linux_sysmon_update_schedstat(state, 0);
+        task = &state->tasks[slot];
+        linux_sysmon_update_task(task, tid, elapsed_ns);
+        task->last_scan = state->task_scan;
+    }
+
+    closedir(dir);
 
-    while (state->should_run)
+    for (slot = 0; slot < LINUX_SYSMON_MAX_TASKS; ++slot)
     {
-        next_sample = OS_TimeAdd(next_sample, OS_TimeFromTotalSeconds(LINUX_SYSMON_SAMPLE_DELAY));
-        msec_diff   = OS_TimeGetTotalMilliseconds(OS_TimeSubtract(next_sample, curr_sample));
-        if (msec_diff > 0)
+        if (state->tasks[slot].stats.ThreadId != 0 && state->tasks[slot].last_scan != state->task_scan)
         {
-            poll(&pfd, 0, msec_diff);
+            linux_sysmon_release_task(&state->tasks[slot]);
         }
+    }
+}
+
+/*
+ * Opens the /proc files of the memory, io and pressure subsystems
+ * Files that do not exist on this kernel (e.g. no PSI support) are left closed,
+ * reads of the corresponding subsystem then fail.
+ */
+void linux_sysmon_open_resources(linux_sysmon_cpuload_state_t *state)
+{
+    uint32_t src;
+    long     page_size;
 
-        last_sample = curr_sample;
-        CFE_PSP_GetTime(&curr_sample);
-        msec_diff = OS_TimeGetTotalMilliseconds(OS_TimeSubtract(curr_sample, last_sample));
-        linux_sysmon_update_schedstat(state, msec_diff);
+    for (src = 0; src < LINUX_SYSMON_NUM_SRC; ++src)
+    {
+        state->resources.src_fd[src] = open(linux_sysmon_source_paths[src], O_RDONLY | O_CLOEXEC);
     }
 
-    return NULL;
+    page_size = sysconf(_SC_PAGESIZE);
+    if (page_size < 1024)
+    {
+        page_size = 4096;
+    }
+    state->resources.page_kib = page_size / 1024;
 }
 
-/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
- * linux_sysmon_Start()
- * ------------------------------------------------------
- *  Starts the cpu load watcher function
- *
- * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
-int32_t linux_sysmon_Start(linux_sysmon_cpuload_state_t *state)
+/*
+ * Re-reads the /proc file of a source of the memory, io or pressure subsystems
+ * Returns the number of bytes read, or -1 if the file is not open or on error.
+ */
+ssize_t linux_sysmon_read_source(linux_sysmon_cpuload_state_t *state, uint32_t src, char *buf, size_t size)
 {
-    int32_t StatusCode;
-    int32_t DelayCount;
+    return linux_sysmon_reread_file(state->resources.src_fd[src], buf, size);
+}
 
-    DelayCount = 0;
-    if (state->is_running)
+/*
+ * Converts the increase of a counter over elapsed_ns into a rate per second, in units of scale
+ * This is done in microseconds so that it does not overflow with the longest period.
+ */
+CFE_PSP_IODriver_AdcCode_t linux_sysmon_rate(uint64_t delta, uint64_t elapsed_ns, uint32_t scale)
+{
+    uint64_t elapsed_us;
+    uint64_t rate;
+
+    elapsed_us = elapsed_ns / 1000;
+    if (elapsed_us == 0)
     {
-        /* already running, nothing to do */
-        StatusCode = CFE_PSP_SUCCESS;
+        return 0;
     }
-    else
+
+    rate = ((delta / elapsed_us) * 1000000 + ((delta % elapsed_us) * 1000000) / elapsed_us) / scale;
+    if (rate > INT32_MAX)
     {
-        /* start clean */
-        memset(state, 0, sizeof(*state));
-        StatusCode = CFE_PSP_ERROR;
+        rate = INT32_MAX;
+    }
+
+    return rate;
+}
 
-        state->dev_fd = open("/proc/schedstat", O_RDONLY);
-        if (state->dev_fd < 0)
+/*
+ * Parses the "some" and "full" lines of a /proc/pressure file into the 24 bit
+ * codes of one resource.  The averages are percentages with two decimals.
+ */
+bool linux_sysmon_parse_pressure(const char *data, CFE_PSP_IODriver_AdcCode_t *values)
+{
+    const char * line;
+    char         kind[5];
+    unsigned int whole[LINUX_SYSMON_PSI_NUM_AVGS];
+    unsigned int frac[LINUX_SYSMON_PSI_NUM_AVGS];
+    uint32_t     k;
+    uint32_t     i;
+    bool         found;
+
+    found = false;
+    for (line = data; line != NULL && *line != 0; line = strchr(line, '\n'))
+    {
+        if (*line == '\n')
         {
-            perror("open(/proc/schedstat)");
+            ++line;
+        }
+        if (sscanf(line, "%4s avg10=%u.%u avg60=%u.%u avg300=%u.%u", kind, &whole[0], &frac[0], &whole[1], &frac[1],
+                   &whole[2], &frac[2]) != 7)
+        {
+            continue;
+        }
+
+        if (strcmp(kind, "some") == 0)
+        {
+            k = 0;
+        }
+        else if (strcmp(kind, "full") == 0)
+        {
+            k = 1;
         }
         else
         {
-            state->should_run = true;
-            if (pthread_create(&state->task_id, NULL, linux_sysmon_Task, state) < 0)
-            {
-                perror("pthread_create()");
+            continue;
+        }
 
-                /* Clean up */
-                state->should_run = false;
-                close(state->dev_fd);
+        for (i = 0; i < LINUX_SYSMON_PSI_NUM_AVGS; ++i)
+        {
+            if (whole[i] >= 100)
+            {
+                values[k * LINUX_SYSMON_PSI_NUM_AVGS + i] = 0xFFFFFF;
             }
             else
             {
-                /* wait for the "num_cpus" to become nonzero, this should be
-                 * initialized in the first sample taken by the worker task */
-                while (state->num_cpus == 0 && DelayCount < 100000000 /*jphfix*/)
-                {
-                    ++DelayCount;
-                    OS_TaskDelay(10);
-                }
+                values[k * LINUX_SYSMON_PSI_NUM_AVGS + i] = ((whole[i] * 100 + frac[i]) * 0xFFFFFFULL) / 10000;
+            }
+        }
+        found = true;
+    }
 
-                if (state->num_cpus == 0)
-                {
-                    OS_printf("CFE_PSP(Linux_SysMon): Failed to detect number of CPUs\n");
+    return found;
+}
 
-                    /* Clean up */
-                    state->should_run = false;
-                    pthread_cancel(state->task_id);
-                    pthread_join(state->task_id, NULL);
-                    close(state->dev_fd);
-                }
-                else
-                {
-                    OS_printf("CFE_PSP(Linux_SysMon): Started CPU utilization monitoring on %u CPU(s)\n",
-                              (unsigned int)state->num_cpus);
+/*
+ * Samples the memory, io and pressure subsystems
+ * The fault and I/O rates are over the elapsed time, they are 0 on the first sample.
+ */
+void linux_sysmon_update_resources(linux_sysmon_cpuload_state_t *state, uint64_t elapsed_ns)
+{
+    linux_sysmon_resources_t *res;
+    char                      buf[2048];
+    const char *              p;
+    unsigned long             resident;
+    unsigned long long        minor_faults;
+    unsigned long long        major_faults;
+    unsigned long long        read_bytes;
+    unsigned long long        write_bytes;
+    uint32_t                  r;
+    bool                      valid;
+
+    res = &state->resources;
+
+    valid = false;
+    if (linux_sysmon_read_source(state, LINUX_SYSMON_SRC_STATM, buf, sizeof(buf)) > 0 &&
+        sscanf(buf, "%*u %lu", &resident) == 1)
+    {
+        res->memory[LINUX_SYSMON_MEM_RSS_SUBCH] = resident * res->page_kib;
+        valid                                   = true;
+    }
+    if (linux_sysmon_read_source(state, LINUX_SYSMON_SRC_MEMINFO, buf, sizeof(buf)) > 0)
+    {
+        res->memory[LINUX_SYSMON_MEM_TOTAL_SUBCH]     = linux_sysmon_get_status_value(buf, "MemTotal:");
+        res->memory[LINUX_SYSMON_MEM_AVAILABLE_SUBCH] = linux_sysmon_get_status_value(buf, "\nMemAvailable:");
+    }
+    else
+    {
+        valid = false;
+    }
+    /* the command name may contain anything, so the fields are counted from the last ')' */
+    if (linux_sysmon_read_source(state, LINUX_SYSMON_SRC_STAT, buf, sizeof(buf)) > 0 &&
+        (p = strrchr(buf, ')')) != NULL &&
+        sscanf(p + 1, " %*c %*d %*d %*d %*d %*d %*u %llu %*u %llu", &minor_faults, &major_faults) == 2)
+    {
+        res->memory[LINUX_SYSMON_MEM_MINOR_FAULT_SUBCH] =
+            linux_sysmon_rate(minor_faults - res->last_minor_faults, elapsed_ns, 1);
+        res->memory[LINUX_SYSMON_MEM_MAJOR_FAULT_SUBCH] =
+            linux_sysmon_rate(major_faults - res->last_major_faults, elapsed_ns, 1);
+        res->last_minor_faults = minor_faults;
+        res->last_major_faults = major_faults;
+    }
+    else
+    {
+        valid = false;
+    }
+    res->memory_valid = valid;
 
-                    StatusCode        = CFE_PSP_SUCCESS;
-                    state->is_running = true;
-                }
-            }
+    /* needs task I/O accounting in the kernel */
+    valid = false;
+    if (linux_sysmon_read_source(state, LINUX_SYSMON_SRC_IO, buf, sizeof(buf)) > 0)
+    {
+        read_bytes                           = linux_sysmon_get_status_value(buf, "\nread_bytes:");
+        write_bytes                          = linux_sysmon_get_status_value(buf, "\nwrite_bytes:");
+        res->io[LINUX_SYSMON_IO_READ_SUBCH]  = linux_sysmon_rate(read_bytes - res->last_read_bytes, elapsed_ns, 1024);
+        res->io[LINUX_SYSMON_IO_WRITE_SUBCH] = linux_sysmon_rate(write_bytes - res->last_write_bytes, elapsed_ns, 1024);
+        res->last_read_bytes                 = read_bytes;
+        res->last_write_bytes                = write_bytes;
+        valid                                = true;
+    }
+    res->io_valid = valid;
+
+    /* needs PSI support in the kernel; the "full" line of cpu may be absent, it is then 0 */
+    valid = false;
+    for (r = 0; r < LINUX_SYSMON_PSI_NUM_RESOURCES; ++r)
+    {
+        if (linux_sysmon_read_source(state, LINUX_SYSMON_SRC_PSI_CPU + r, buf, sizeof(buf)) > 0 &&
+            linux_sysmon_parse_pressure(buf,
+                                        &res->pressure[r * LINUX_SYSMON_PSI_NUM_KINDS * LINUX_SYSMON_PSI_NUM_AVGS]))
+        {
+            valid = true;
         }
     }
+    res->pressure_valid = valid;
+}
 
-    return StatusCode;
+/*
+ * Computes the average load of the CPUs of each node into the sample
+ */
+void linux_sysmon_update_nodes(linux_sysmon_cpuload_state_t *state, CFE_PSP_IODriver_AdcCode_t *per_node)
+{
+    uint32_t             cpu;
+    uint32_t             node;
+    uint32_t             i;
+    uint32_t             count;
+    uint64_t             sum;
+    linux_sysmon_node_t *node_p;
+
+    for (node = 0; node < state->num_nodes; ++node)
+    {
+        node_p = &state->nodes[node];
+        sum    = 0;
+        count  = 0;
+        for (i = 0; i < node_p->num_cpus; ++i)
+        {
+            cpu = state->node_cpus[node_p->first_cpu + i];
+            if (cpu < state->num_cpus)
+            {
+                sum += state->cpus[cpu].Load;
+                ++count;
+            }
+        }
+        if (count != 0)
+        {
+            sum /= count;
+        }
+        per_node[node] = sum;
+    }
 }
 
-int32_t linux_sysmon_Stop(linux_sysmon_cpuload_state_t *state)
+/*
+ * Takes a sample, as the Collect function of the sysmon engine
+ *
+ * The first sample (elapsed_ns 0) is the reference that the loads and rates
+ * of the next are computed from.  Returns 0 if /proc/schedstat could not be used.
+ */
+uint32_t linux_sysmon_Collect(CFE_PSP_Sysmon_t *sysmon, CFE_PSP_Sysmon_Sample_t *sample, uint64_t elapsed_ns)
 {
-    if (state->is_running)
+    linux_sysmon_cpuload_state_t *state;
+    linux_sysmon_snapshot_t *     snap;
+    uint32_t                      slot;
+    uint32_t                      idx;
+
+    /* There is just one global cpuload object */
+    state = &linux_sysmon_global.cpu_load;
+
+    linux_sysmon_update_schedstat(state, elapsed_ns);
+    linux_sysmon_update_tasks(state, elapsed_ns);
+    linux_sysmon_update_resources(state, elapsed_ns);
+
+    idx = LINUX_SYSMON_VALUES(LINUX_SYSMON_PER_NODE_SUBSYS);
+    linux_sysmon_update_nodes(state, sample->Values[idx]);
+    sample->NumValues[idx] = state->num_nodes;
+
+    /* slots not in use read as zero load */
+    snap = sample->DriverData;
+    idx  = LINUX_SYSMON_VALUES(LINUX_SYSMON_PER_TASK_SUBSYS);
+    for (slot = 0; slot < LINUX_SYSMON_MAX_TASKS; ++slot)
     {
-        state->should_run = false;
-        state->is_running = false;
-        pthread_cancel(state->task_id);
-        pthread_join(state->task_id, NULL);
-        close(state->dev_fd);
+        snap->tasks[slot]          = state->tasks[slot].stats;
+        sample->Values[idx][slot] = state->tasks[slot].stats.Load;
     }
+    sample->NumValues[idx] = LINUX_SYSMON_MAX_TASKS;
 
-    return CFE_PSP_SUCCESS;
+    idx = LINUX_SYSMON_VALUES(LINUX_SYSMON_MEMORY_SUBSYS);
+    memcpy(sample->Values[idx], state->resources.memory, sizeof(state->resources.memory));
+    sample->NumValues[idx] = state->resources.memory_valid ? LINUX_SYSMON_MEM_NUM_SUBCH : 0;
+
+    idx = LINUX_SYSMON_VALUES(LINUX_SYSMON_IO_SUBSYS);
+    memcpy(sample->Values[idx], state->resources.io, sizeof(state->resources.io));
+    sample->NumValues[idx] = state->resources.io_valid ? LINUX_SYSMON_IO_NUM_SUBCH : 0;
+
+    idx = LINUX_SYSMON_VALUES(LINUX_SYSMON_PRESSURE_SUBSYS);
+    memcpy(sample->Values[idx], state->resources.pressure, sizeof(state->resources.pressure));
+    sample->NumValues[idx] = state->resources.pressure_valid ? LINUX_SYSMON_PSI_NUM_SUBCH : 0;
+
+    return state->num_cpus;
 }
 
-int32_t linux_sysmon_calc_aggregate_cpu(linux_sysmon_cpuload_state_t *state, CFE_PSP_IODriver_AdcCode_t *Val)
+void linux_sysmon_Task(void)
 {
-    uint8_t  cpu;
-    uint32_t sum;
+    CFE_PSP_Sysmon_Run(&linux_sysmon_global.sysmon);
+}
 
-    sum = 0;
-    for (cpu = 0; cpu < state->num_cpus; ++cpu)
+/*
+ * Waits for the time of the next sample, as the WaitUntilNs function of the sysmon engine
+ *
+ * The timer is armed with an absolute deadline on the monotonic clock, the clock of
+ * linux_sysmon_get_monotonic_ns(), so the samples keep their schedule to the
+ * resolution of the kernel timers.
+ */
+void linux_sysmon_WaitUntilNs(CFE_PSP_Sysmon_t *sysmon, uint64_t deadline_ns)
+{
+    linux_sysmon_cpuload_state_t *state;
+    struct itimerspec             spec;
+    struct pollfd                 fds[2];
+    uint64_t                      now;
+    uint64_t                      count;
+    int                           timeout_ms;
+
+    state = &linux_sysmon_global.cpu_load;
+
+    memset(&spec, 0, sizeof(spec));
+    spec.it_value.tv_sec  = deadline_ns / 1000000000;
+    spec.it_value.tv_nsec = deadline_ns % 1000000000;
+
+    fds[0].fd     = state->timer_fd;
+    fds[0].events = POLLIN;
+    fds[1].fd     = state->wake_fd;
+    fds[1].events = POLLIN;
+    timeout_ms    = -1;
+    if (timerfd_settime(state->timer_fd, TFD_TIMER_ABSTIME, &spec, NULL) < 0)
     {
-        sum += state->per_core[cpu].avg_load;
+        /* should not happen, but do not spin: wait with the resolution of poll() */
+        perror("timerfd_settime()");
+        fds[0].fd  = -1;
+        now        = linux_sysmon_get_monotonic_ns();
+        timeout_ms = (deadline_ns > now) ? (int)((deadline_ns - now + 999999) / 1000000) : 0;
     }
 
-    if (cpu == 0)
+    if (poll(fds, 2, timeout_ms) < 0)
     {
-        *Val = 0;
-        return CFE_PSP_ERROR;
+        /* interrupted, the engine looks at the time again */
+        return;
     }
 
-    /* average of all cpus */
-    sum /= cpu;
-    LINUX_SYSMON_DEBUG("CFE_PSP(linux_sysmon): Aggregate CPU load=%06x\n", (unsigned int)sum);
-    *Val = sum;
+    /* both are non-blocking, the reads only clear what is pending */
+    if ((fds[0].revents & POLLIN) != 0 && read(state->timer_fd, &count, sizeof(count)) < 0)
+    {
+        perror("read(timerfd)");
+    }
+    if ((fds[1].revents & POLLIN) != 0 && read(state->wake_fd, &count, sizeof(count)) < 0)
+    {
+        perror("read(eventfd)");
+    }
+}
 
-    return CFE_PSP_SUCCESS;
+/*
+ * Ends the current or next wait of linux_sysmon_WaitUntilNs(), as the Wake function of the sysmon engine
+ */
+void linux_sysmon_Wake(CFE_PSP_Sysmon_t *sysmon)
+{
+    uint64_t one;
+
+    one = 1;
+    if (write(linux_sysmon_global.cpu_load.wake_fd, &one, sizeof(one)) < 0)
+    {
+        perror("write(eventfd)");
+    }
 }
 
-int32_t linux_sysmon_aggregate_dispatch(uint32_t CommandCode, uint16_t Subchannel, CFE_PSP_IODriver_Arg_t Arg)
+/*
+ * Assigns the CPUs in a cpulist (e.g. "0-3,8-11") to a NUMA node
+ */
+void linux_sysmon_parse_cpulist(linux_sysmon_cpuload_state_t *state, const char *list, uint32_t node)
 {
-    int32_t                       StatusCode;
-    linux_sysmon_cpuload_state_t *state;
+    unsigned long first;
+    unsigned long last;
+    unsigned long cpu;
+    char *        end_p;
 
-    /* There is just one global cpuload object */
-    state      = &linux_sysmon_global.cpu_load;
-    StatusCode = CFE_PSP_ERROR_NOT_IMPLEMENTED;
-    switch (CommandCode)
+    while (isdigit((unsigned char)*list))
     {
-        case CFE_PSP_IODriver_NOOP:
-        case CFE_PSP_IODriver_ANALOG_IO_NOOP:
+        first = strtoul(list, &end_p, 10);
+        last  = first;
+        if (*end_p == '-')
         {
-            /* NO-OP should return success -
-             * This is a required opcode as "generic" clients may use it to
-             * determine if a certain set of opcodes are supported or not
-             */
-            StatusCode = CFE_PSP_SUCCESS;
-            break;
+            last = strtoul(end_p + 1, &end_p, 10);
         }
-        /* Start/stop opcodes */
-        case CFE_PSP_IODriver_SET_RUNNING: /**< int32_t argument, 0=stop 1=start device */
-        {
-            if (Arg.U32)
-            {
-                StatusCode = linux_sysmon_Start(state);
-            }
-            else
-            {
-                StatusCode = linux_sysmon_Stop(state);
-            }
-            break;
-        }
-        case CFE_PSP_IODriver_GET_RUNNING: /**< no argument, returns positive nonzero (true) if running and zero (false)
-                                              if stopped, negative on error */
+
+        for (cpu = first; cpu <= last && cpu < state->max_cpus; ++cpu)
         {
-            StatusCode = state->is_running;
-            break;
+            state->per_core[cpu].node = node;
         }
-        case CFE_PSP_IODriver_SET_CONFIGURATION: /**< const string argument (device-dependent content) */
-        case CFE_PSP_IODriver_GET_CONFIGURATION: /**< void * argument (device-dependent content) */
+
+        list = end_p;
+        if (*list == ',')
         {
-            /* not implemented for now */
-            break;
+            ++list;
         }
-        case CFE_PSP_IODriver_LOOKUP_SUBSYSTEM: /**< const char * argument, looks up name and returns positive
-                                                    value for subsystem number, negative value for error */
-        {
-            uint16_t i;
+    }
+}
 
-            for (i = 0; linux_sysmon_subsystem_names[i] != NULL; ++i)
+/*
+ * Groups the CPUs by NUMA node, from /sys/devices/system/node/nodeN/cpulist
+ * Without NUMA support all CPUs are in node 0.
+ */
+int32_t linux_sysmon_read_numa_nodes(linux_sysmon_cpuload_state_t *state)
+{
+    DIR *          dir;
+    struct dirent *de;
+    char *         end_p;
+    char           path[64 + sizeof(de->d_name)];
+    char           cpulist[1024];
+    unsigned long  node;
+    uint32_t       cpu;
+    uint32_t       first_cpu;
+
+    state->num_nodes = 1;
+
+    dir = opendir("/sys/devices/system/node");
+    if (dir != NULL)
+    {
+        while ((de = readdir(dir)) != NULL)
+        {
+            if (strncmp(de->d_name, "node", 4) != 0)
             {
-                if (strcmp(Arg.ConstStr, linux_sysmon_subsystem_names[i]) == 0)
-                {
-                    StatusCode = i;
-                    break;
-                }
+                continue;
+            }
+            node = strtoul(&de->d_name[4], &end_p, 10);
+            if (end_p == &de->d_name[4] || *end_p != 0 || node >= state->max_cpus)
+            {
+                continue;
             }
 
-            break;
-        }
-        case CFE_PSP_IODriver_LOOKUP_SUBCHANNEL: /**< const char * argument, looks up name and returns positive
-                                                    value for channel number, negative value for error */
-        {
-            uint16_t i;
-
-            for (i = 0; linux_sysmon_subchannel_names[i] != NULL; ++i)
+            snprintf(path, sizeof(path), "/sys/devices/system/node/%s/cpulist", de->d_name);
+            if (linux_sysmon_read_file(path, cpulist, sizeof(cpulist)) > 0)
             {
-                if (strcmp(Arg.ConstStr, linux_sysmon_subchannel_names[i]) == 0)
+                linux_sysmon_parse_cpulist(state, cpulist, node);
+                if (node >= state->num_nodes)
                 {
-                    StatusCode = i;
-                    break;
+                    state->num_nodes = node + 1;
                 }
             }
+        }
+        closedir(dir);
+    }
 
-            break;
+    state->nodes     = calloc(state->num_nodes, sizeof(*state->nodes));
+    state->node_cpus = calloc(state->max_cpus, sizeof(*state->node_cpus));
+    if (state->nodes == NULL || state->node_cpus == NULL)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    /* lay out the CPUs of each node after those of the previous node */
+    for (cpu = 0; cpu < state->max_cpus; ++cpu)
+    {
+        ++state->nodes[state->per_core[cpu].node].num_cpus;
+    }
+    first_cpu = 0;
+    for (node = 0; node < state->num_nodes; ++node)
+    {
+        state->nodes[node].first_cpu = first_cpu;
+        first_cpu += state->nodes[node].num_cpus;
+        state->nodes[node].num_cpus = 0;
+    }
+    for (cpu = 0; cpu < state->max_cpus; ++cpu)
+    {
+        node = state->per_core[cpu].node;
+        state->node_cpus[state->nodes[node].first_cpu + state->nodes[node].num_cpus] = cpu;
+        ++state->nodes[node].num_cpus;
+    }
+
+    return CFE_PSP_SUCCESS;
+}
+
+/*
+ * Allocates the per-CPU state
+ *
+ * This is sized for all CPUs the system may bring online, which also covers
+ * the numbering gaps of CPUs that are currently offline.
+ */
+int32_t linux_sysmon_alloc_cpus(linux_sysmon_cpuload_state_t *state)
+{
+    long num_conf;
+    long num_online;
+
+    num_conf   = sysconf(_SC_NPROCESSORS_CONF);
+    num_online = sysconf(_SC_NPROCESSORS_ONLN);
+    if (num_conf < num_online)
+    {
+        num_conf = num_online;
+    }
+    if (num_conf < 1)
+    {
+        num_conf = 1;
+    }
+    if (num_conf > LINUX_SYSMON_MAX_CPUS)
+    {
+        num_conf = LINUX_SYSMON_MAX_CPUS;
+    }
+
+    state->max_cpus           = num_conf;
+    state->per_core           = calloc(state->max_cpus, sizeof(*state->per_core));
+    state->cpus               = calloc(state->max_cpus, sizeof(*state->cpus));
+    state->run_time           = calloc(state->max_cpus, sizeof(*state->run_time));
+    state->schedstat_buf_size = LINUX_SYSMON_SCHEDSTAT_BUF_SIZE;
+    state->schedstat_buf      = malloc(state->schedstat_buf_size);
+    if (state->per_core == NULL || state->cpus == NULL || state->run_time == NULL || state->schedstat_buf == NULL ||
+        linux_sysmon_read_numa_nodes(state) != CFE_PSP_SUCCESS)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    return CFE_PSP_SUCCESS;
+}
+
+/*
+ * Allocates the storage of the snapshots and the history, unless that was done at a previous start
+ *
+ * Storage kept from a previous start is used as long as it is large enough,
+ * as it is never released.
+ */
+int32_t linux_sysmon_alloc_storage(linux_sysmon_storage_t *storage, uint32_t max_cpus, uint32_t num_nodes)
+{
+    if (storage->snapshot_values != NULL && storage->history != NULL)
+    {
+        if (max_cpus > storage->max_cpus || num_nodes > storage->num_nodes)
+        {
+            OS_printf("CFE_PSP(Linux_SysMon): %u CPU(s) in %u NUMA node(s), was %u in %u at the first start\n",
+                      (unsigned int)max_cpus, (unsigned int)num_nodes, (unsigned int)storage->max_cpus,
+                      (unsigned int)storage->num_nodes);
+            return CFE_PSP_ERROR;
         }
-        case CFE_PSP_IODriver_QUERY_DIRECTION: /**< CFE_PSP_IODriver_Direction_t argument */
+
+        return CFE_PSP_SUCCESS;
+    }
+
+    /* the values of the CPUs, then those of the nodes */
+    if (storage->snapshot_values == NULL)
+    {
+        storage->snapshot_values =
+            calloc(CFE_PSP_SYSMON_CPU_STORAGE_SIZE(max_cpus) + 2 * num_nodes, sizeof(CFE_PSP_IODriver_AdcCode_t));
+    }
+    if (storage->history == NULL)
+    {
+        storage->history = calloc(CFE_PSP_SYSMON_HISTORY_STORAGE_SIZE(max_cpus), sizeof(*storage->history));
+    }
+    if (storage->snapshot_values == NULL || storage->history == NULL)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    storage->max_cpus  = max_cpus;
+    storage->num_nodes = num_nodes;
+
+    return CFE_PSP_SUCCESS;
+}
+
+/*
+ * Acquires the sources and the state of the sampling, as the Open function of the sysmon engine
+ */
+int32_t linux_sysmon_Open(CFE_PSP_Sysmon_t *sysmon)
+{
+    linux_sysmon_cpuload_state_t *state;
+    linux_sysmon_storage_t *      storage;
+    uint32_t                      Source;
+    uint32_t                      i;
+
+    /* start clean */
+    state   = &linux_sysmon_global.cpu_load;
+    storage = &linux_sysmon_global.storage;
+    memset(state, 0, sizeof(*state));
+    for (Source = 0; Source < LINUX_SYSMON_NUM_SRC; ++Source)
+    {
+        state->resources.src_fd[Source] = -1;
+    }
+
+    state->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    state->wake_fd  = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (state->timer_fd < 0 || state->wake_fd < 0)
+    {
+        perror("timerfd_create()/eventfd()");
+        state->dev_fd = -1;
+        return CFE_PSP_ERROR;
+    }
+
+    state->dev_fd = open("/proc/schedstat", O_RDONLY | O_CLOEXEC);
+    if (state->dev_fd < 0)
+    {
+        perror("open(/proc/schedstat)");
+        return CFE_PSP_ERROR;
+    }
+    if (linux_sysmon_alloc_cpus(state) != CFE_PSP_SUCCESS ||
+        linux_sysmon_alloc_storage(storage, state->max_cpus, state->num_nodes) != CFE_PSP_SUCCESS)
+    {
+        OS_printf("CFE_PSP(Linux_SysMon): Failed to allocate CPU state\n");
+        return CFE_PSP_ERROR;
+    }
+    linux_sysmon_open_resources(state);
+
+    CFE_PSP_Sysmon_SetCpuStorage(sysmon, state->max_cpus, state->cpus, storage->snapshot_values);
+    CFE_PSP_Sysmon_SetHistoryStorage(sysmon, storage->history);
+    CFE_PSP_Sysmon_SetValueStorage(sysmon, LINUX_SYSMON_PER_NODE_SUBSYS, state->num_nodes,
+                                   storage->snapshot_values + CFE_PSP_SYSMON_CPU_STORAGE_SIZE(state->max_cpus));
+    CFE_PSP_Sysmon_SetValueStorage(sysmon, LINUX_SYSMON_PER_TASK_SUBSYS, LINUX_SYSMON_MAX_TASKS, state->task_load);
+    CFE_PSP_Sysmon_SetValueStorage(sysmon, LINUX_SYSMON_MEMORY_SUBSYS, LINUX_SYSMON_MEM_NUM_SUBCH, state->memory);
+    CFE_PSP_Sysmon_SetValueStorage(sysmon, LINUX_SYSMON_IO_SUBSYS, LINUX_SYSMON_IO_NUM_SUBCH, state->io);
+    CFE_PSP_Sysmon_SetValueStorage(sysmon, LINUX_SYSMON_PRESSURE_SUBSYS, LINUX_SYSMON_PSI_NUM_SUBCH,
+                                   state->pressure);
+    for (i = 0; i < 2; ++i)
+    {
+        sysmon->Snapshot[i].DriverData = &state->snapshot[i];
+    }
+
+    LINUX_SYSMON_DEBUG("CFE_PSP(linux_sysmon): %u CPU(s) in %u NUMA node(s)\n", (unsigned int)state->max_cpus,
+                       (unsigned int)state->num_nodes);
+
+    return CFE_PSP_SUCCESS;
+}
+
+/*
+ * Releases what linux_sysmon_Open() acquired, as the Close function of the sysmon engine
+ * The storage of the snapshots and the history is kept, see linux_sysmon_storage_t.
+ */
+void linux_sysmon_Close(CFE_PSP_Sysmon_t *sysmon)
+{
+    linux_sysmon_cpuload_state_t *state;
+    uint32_t                      src;
+    uint32_t                      slot;
+
+    state = &linux_sysmon_global.cpu_load;
+    for (src = 0; src < LINUX_SYSMON_NUM_SRC; ++src)
+    {
+        if (state->resources.src_fd[src] >= 0)
         {
-            CFE_PSP_IODriver_Direction_t *DirPtr = (CFE_PSP_IODriver_Direction_t *)Arg.Vptr;
-            if (DirPtr != NULL)
-            {
-                *DirPtr    = CFE_PSP_IODriver_Direction_INPUT_ONLY;
-                StatusCode = CFE_PSP_SUCCESS;
-            }
-            break;
+            close(state->resources.src_fd[src]);
+            state->resources.src_fd[src] = -1;
         }
-        case CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS:
+    }
+    if (state->dev_fd >= 0)
+    {
+        close(state->dev_fd);
+        state->dev_fd = -1;
+    }
+    if (state->timer_fd >= 0)
+    {
+        close(state->timer_fd);
+        state->timer_fd = -1;
+    }
+    if (state->wake_fd >= 0)
+    {
+        close(state->wake_fd);
+        state->wake_fd = -1;
+    }
+    for (slot = 0; slot < LINUX_SYSMON_MAX_TASKS; ++slot)
+    {
+        if (state->tasks[slot].stats.ThreadId != 0)
         {
-            CFE_PSP_IODriver_AnalogRdWr_t *RdWr = Arg.Vptr;
+            linux_sysmon_release_task(&state->tasks[slot]);
+        }
+    }
 
-            if (RdWr->NumChannels == 1 && Subchannel == LINUX_SYSMON_AGGR_CPULOAD_SUBCH)
+    state->num_cpus  = 0;
+    state->max_cpus  = 0;
+    state->num_nodes = 0;
+
+    free(state->schedstat_buf);
+    free(state->per_core);
+    free(state->cpus);
+    free(state->run_time);
+    free(state->nodes);
+    free(state->node_cpus);
+    state->schedstat_buf   = NULL;
+    state->per_core        = NULL;
+    state->cpus            = NULL;
+    state->run_time        = NULL;
+    state->nodes           = NULL;
+    state->node_cpus       = NULL;
+}
+
+/*
+ * Finds the "per-task" slot of a thread in the current snapshot,
+ * by thread name if Name is not NULL, otherwise by OSAL task id
+ */
+int32_t linux_sysmon_find_task_slot(CFE_PSP_Sysmon_t *sysmon, const char *Name, osal_id_t TaskId)
+{
+    int32_t                          StatusCode;
+    uint32_t                         Sequence;
+    uint32_t                         slot;
+    const CFE_PSP_Sysmon_Sample_t *  sample;
+    const linux_sysmon_snapshot_t *  snap;
+    const linux_sysmon_task_stats_t *stats;
+
+    do
+    {
+        sample     = CFE_PSP_Sysmon_ReadBegin(sysmon, &Sequence);
+        snap       = sample->DriverData;
+        StatusCode = CFE_PSP_ERROR;
+        for (slot = 0; snap != NULL && slot < LINUX_SYSMON_MAX_TASKS; ++slot)
+        {
+            stats = &snap->tasks[slot];
+            if (stats->ThreadId != 0 &&
+                ((Name != NULL) ? (strncmp(Name, stats->Name, LINUX_SYSMON_TASK_NAME_SIZE - 1) == 0)
+                                : OS_ObjectIdEqual(stats->TaskId, TaskId)))
             {
-                StatusCode = linux_sysmon_calc_aggregate_cpu(state, RdWr->Samples);
+                StatusCode = slot;
+                break;
             }
-            break;
         }
-        default:
-            break;
-    }
+    } while (CFE_PSP_Sysmon_ReadRetry(sysmon, Sequence));
 
     return StatusCode;
 }
 
-int32_t linux_sysmon_cpu_load_dispatch(uint32_t CommandCode, uint16_t Subchannel, CFE_PSP_IODriver_Arg_t Arg)
+/*
+ * Handles the "per-task" opcodes that the sysmon engine does not, as the Command function of the engine
+ */
+int32_t linux_sysmon_Command(CFE_PSP_Sysmon_t *sysmon, uint32_t CommandCode, uint16_t SubsystemId,
+                             uint16_t SubchannelId, CFE_PSP_IODriver_Arg_t Arg)
 {
-    int32_t                       StatusCode;
-    linux_sysmon_cpuload_state_t *state;
+    int32_t StatusCode;
 
-    /* There is just one global cpuload object */
-    state      = &linux_sysmon_global.cpu_load;
     StatusCode = CFE_PSP_ERROR_NOT_IMPLEMENTED;
+    if (SubsystemId != LINUX_SYSMON_PER_TASK_SUBSYS)
+    {
+        return StatusCode;
+    }
+
     switch (CommandCode)
     {
-        case CFE_PSP_IODriver_NOOP:
-        case CFE_PSP_IODriver_ANALOG_IO_NOOP:
+        case CFE_PSP_IODriver_LOOKUP_SUBCHANNEL: /**< const char * argument, looks up thread name and returns
+                                                    slot number, negative value for error */
         {
-            /* NO-OP should return success -
-             * This is a required opcode as "generic" clients may use it to
-             * determine if a certain set of opcodes are supported or not
-             */
-            StatusCode = CFE_PSP_SUCCESS;
+            StatusCode = CFE_PSP_ERROR;
+            if (Arg.ConstStr != NULL)
+            {
+                StatusCode = linux_sysmon_find_task_slot(sysmon, Arg.ConstStr, OS_OBJECT_ID_UNDEFINED);
+            }
+            break;
+        }
+        case LINUX_SYSMON_LOOKUP_TASK:
+        {
+            StatusCode = linux_sysmon_find_task_slot(sysmon, NULL, OS_ObjectIdFromInteger(Arg.U32));
             break;
         }
-        case CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS:
+        case LINUX_SYSMON_GET_TASK_STATS:
         {
-            CFE_PSP_IODriver_AnalogRdWr_t *RdWr = Arg.Vptr;
-            uint32_t                       ch;
+            linux_sysmon_task_stats_t *    Stats = Arg.Vptr;
+            const CFE_PSP_Sysmon_Sample_t *sample;
+            const linux_sysmon_snapshot_t *snap;
+            uint32_t                       Sequence;
 
-            if (Subchannel < state->num_cpus && (Subchannel + RdWr->NumChannels) <= state->num_cpus)
+            StatusCode = CFE_PSP_ERROR;
+            if (Stats != NULL && SubchannelId < LINUX_SYSMON_MAX_TASKS)
             {
-                for (ch = Subchannel; ch < (Subchannel + RdWr->NumChannels); ++ch)
+                do
+                {
+                    sample = CFE_PSP_Sysmon_ReadBegin(sysmon, &Sequence);
+                    snap   = sample->DriverData;
+                    if (snap != NULL)
+                    {
+                        *Stats = snap->tasks[SubchannelId];
+                    }
+                    else
+                    {
+                        memset(Stats, 0, sizeof(*Stats));
+                    }
+                } while (CFE_PSP_Sysmon_ReadRetry(sysmon, Sequence));
+
+                if (Stats->ThreadId != 0)
                 {
-                    RdWr->Samples[ch] = state->per_core[ch].avg_load;
+                    StatusCode = CFE_PSP_SUCCESS;
                 }
             }
             break;
@@ -573,21 +1475,6 @@ int32_t linux_sysmon_cpu_load_dispatch(uint32_t CommandCode, uint16_t Subchannel
 int32_t linux_sysmon_DevCmd(uint32_t CommandCode, uint16_t SubsystemId, uint16_t SubchannelId,
                             CFE_PSP_IODriver_Arg_t Arg)
 {
-    int32_t StatusCode;
-
-    StatusCode = CFE_PSP_ERROR_NOT_IMPLEMENTED;
-    switch (SubsystemId)
-    {
-        case LINUX_SYSMON_AGGREGATE_SUBSYS:
-            StatusCode = linux_sysmon_aggregate_dispatch(CommandCode, SubchannelId, Arg);
-            break;
-        case LINUX_SYSMON_CPULOAD_SUBSYS:
-            StatusCode = linux_sysmon_cpu_load_dispatch(CommandCode, SubchannelId, Arg);
-            break;
-        default:
-            /* not implemented */
-            break;
-    }
-
-    return StatusCode;
+    /* There is just one global sysmon object */
+    return CFE_PSP_Sysmon_DevCmd(&linux_sysmon_global.sysmon, CommandCode, SubsystemId, SubchannelId, Arg);
 }
@@ -0,0 +1,123 @@
+/***********************************************************************
+ *  Copyright (c) 2017, United States government as represented by the
+ *  administrator of the National Aeronautics and Space Administration.
+ *  All rights reserved. This software was created at NASA Glenn
+ *  Research Center pursuant to government contracts.
+ *
+ *  \file linux_sysmon_schedstat.c
+ *
+ ***********************************************************************/
+
+/*
+ * NOTE: The format is documented here: https://docs.kernel.org/scheduler/sched-stats.html
+ *
+ * Each "cpuN" line has the cpu number followed by 9 values, the 7th of
+ * which is the number of nanoseconds spent executing tasks on this CPU.
+ */
+
+/************************************************************************
+ * Includes
+ ************************************************************************/
+
+#include <string.h>
+
+#include "linux_sysmon_schedstat.h"
+
+/********************************************************************
+ * Local Defines
+ ********************************************************************/
+
+/* position of the run time after the cpu number */
+#define LINUX_SYSMON_SCHEDSTAT_RUN_TIME_FIELD 7
+
+/***********************************************************************
+ * Local Functions
+ ********************************************************************/
+
+/*
+ * Parses an unsigned decimal number at *Pos, skipping leading blanks
+ * On success *Pos is moved past the number.
+ */
+static inline int linux_sysmon_scan_u64(const char **Pos, const char *End, uint64_t *Value)
+{
+    const char *p;
+    uint64_t    Result;
+
+    p = *Pos;
+    while (p < End && (*p == ' ' || *p == '\t'))
+    {
+        ++p;
+    }
+    if (p == End || (unsigned char)(*p - '0') > 9)
+    {
+        return 0;
+    }
+
+    Result = 0;
+    do
+    {
+        Result = (Result * 10) + (*p - '0');
+        ++p;
+    } while (p < End && (unsigned char)(*p - '0') <= 9);
+
+    *Pos   = p;
+    *Value = Result;
+    return 1;
+}
+
+/***********************************************************************
+ * Global Functions
+ ********************************************************************/
+
+uint32_t linux_sysmon_parse_schedstat(const char *Data, size_t Size, uint64_t *RunTime, uint32_t MaxCpus)
+{
+    const char *Pos;
+    const char *End;
+    const char *Eol;
+    uint64_t    CpuNum;
+    uint64_t    Value;
+    uint32_t    Field;
+    uint32_t    NumCpus;
+
+    Pos     = Data;
+    End     = Data + Size;
+    NumCpus = 0;
+
+    while (Pos < End)
+    {
+        Eol = memchr(Pos, '\n', End - Pos);
+        if (Eol == NULL)
+        {
+            /* incomplete line, the data was truncated */
+            break;
+        }
+
+        if ((Eol - Pos) > 3 && Pos[0] == 'c' && Pos[1] == 'p' && Pos[2] == 'u')
+        {
+            Pos += 3;
+            if (linux_sysmon_scan_u64(&Pos, Eol, &CpuNum))
+            {
+                for (Field = 1; Field <= LINUX_SYSMON_SCHEDSTAT_RUN_TIME_FIELD; ++Field)
+                {
+                    if (!linux_sysmon_scan_u64(&Pos, Eol, &Value))
+                    {
+                        break;
+                    }
+                }
+
+                if (Field > LINUX_SYSMON_SCHEDSTAT_RUN_TIME_FIELD && CpuNum < MaxCpus)
+                {
+                    RunTime[CpuNum] = Value;
+                    if (CpuNum >= NumCpus)
+                    {
+                        NumCpus = CpuNum + 1;
+                    }
+                }
+            }
+        }
+
+        Pos = Eol + 1;
+    }
+
+    return NumCpus;
+}
@@ -0,0 +1,47 @@
+/***********************************************************************
+ *  Copyright (c) 2017, United States government as represented by the
+ *  administrator of the National Aeronautics and Space Administration.
+ *  All rights reserved. This software was created at NASA Glenn
+ *  Research Center pursuant to government contracts.
+ *
+ *  \file linux_sysmon_schedstat.h
+ *
+ ***********************************************************************/
+
+/*
+ * Parser for the contents of /proc/schedstat, internal to linux_sysmon.
+ *
+ * The whole file is read into one buffer and scanned in place, without
+ * copying lines or allocating memory, so the cost is a single pass over
+ * the data however many CPUs and scheduling domains the host has.
+ *
+ * This only depends on the C library so it can also be built into the
+ * benchmark in the bench directory.
+ */
+
+#ifndef LINUX_SYSMON_SCHEDSTAT_H
+#define LINUX_SYSMON_SCHEDSTAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * \brief Extract the run time of each CPU from /proc/schedstat data
+ *
+ * Looks at the "cpuN" lines and stores the time spent running tasks on
+ * CPU N, in nanoseconds, into RunTime[N].  Entries of CPUs that are not
+ * listed, or not below MaxCpus, are left unchanged.  All other lines,
+ * e.g. the "domainN" lines, are skipped whatever their length.
+ *
+ * A final line without a newline is taken to be truncated and ignored.
+ *
+ * \param[in]    Data    File contents, need not be null-terminated
+ * \param[in]    Size    Size of the file contents
+ * \param[inout] RunTime Run time of each CPU
+ * \param[in]    MaxCpus Number of entries in RunTime
+ *
+ * \returns One more than the highest CPU number found, 0 if none
+ */
+uint32_t linux_sysmon_parse_schedstat(const char *Data, size_t Size, uint64_t *RunTime, uint32_t MaxCpus);
+
+#endif /* LINUX_SYSMON_SCHEDSTAT_H */
@@ -23,6 +23,8 @@
  * can access physical memory directly.
  */
 
+#include <string.h>
+
 #include "cfe_psp.h"
 #include "cfe_psp_module.h"
 
@@ -133,3 +135,184 @@ int32 CFE_PSP_MemWrite32(cpuaddr MemoryAddress, uint32 uint32Value)
 
     return CFE_PSP_SUCCESS;
 }
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper, validate a block access against the memory table
+ *
+ * Finds a range that contains the whole block and has the requested
+ * attribute, and returns its type and the word size to access it with.
+ *
+ *-----------------------------------------------------------------*/
+static int32 ram_direct_CheckBlock(cpuaddr MemoryAddress, size_t Size, uint32 Attribute, uint32 *MemoryType,
+                                   size_t *WordSize)
+{
+    int32   Status;
+    uint32  RangeNum;
+    uint32  RangeAttributes;
+    cpuaddr RangeStart;
+    size_t  RangeSize;
+
+    Status = CFE_PSP_MemRangeFind(MemoryAddress, Size, Attribute, &RangeNum);
+    if (Status != CFE_PSP_SUCCESS)
+    {
+        return Status;
+    }
+
+    return CFE_PSP_MemRangeGet(RangeNum, MemoryType, &RangeStart, &RangeSize, WordSize, &RangeAttributes);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper, write a block to an EEPROM range
+ *
+ * Goes through the EEPROM API one word at a time, as the EEPROM module
+ * may need more than a plain store (e.g. the journal of eeprom_mmap_file).
+ *
+ *-----------------------------------------------------------------*/
+static int32 ram_direct_WriteEepromBlock(cpuaddr MemoryAddress, const uint8 *BufPtr, size_t Size, size_t WordSize)
+{
+    int32  Status;
+    size_t i;
+    uint32 Value32;
+    uint16 Value16;
+
+    Status = CFE_PSP_SUCCESS;
+    for (i = 0; Status == CFE_PSP_SUCCESS && i < Size; i += WordSize)
+    {
+        switch (WordSize)
+        {
+            case CFE_PSP_MEM_SIZE_DWORD:
+                memcpy(&Value32, &BufPtr[i], sizeof(Value32));
+                Status = CFE_PSP_EepromWrite32(MemoryAddress + i, Value32);
+                break;
+
+            case CFE_PSP_MEM_SIZE_WORD:
+                memcpy(&Value16, &BufPtr[i], sizeof(Value16));
+                Status = CFE_PSP_EepromWrite16(MemoryAddress + i, Value16);
+                break;
+
+            default:
+                Status = CFE_PSP_EepromWrite8(MemoryAddress + i, BufPtr[i]);
+                break;
+        }
+    }
+
+    return Status;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per public API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CFE_PSP_MemReadBlock(cpuaddr MemoryAddress, void *Buffer, size_t Size)
+{
+    uint8 *BufPtr = Buffer;
+    int32  Status;
+    uint32 MemoryType;
+    size_t WordSize;
+    size_t i;
+    uint32 Value32;
+    uint16 Value16;
+
+    if (Buffer == NULL)
+    {
+        return CFE_PSP_INVALID_POINTER;
+    }
+
+    Status = ram_direct_CheckBlock(MemoryAddress, Size, CFE_PSP_MEM_ATTR_READ, &MemoryType, &WordSize);
+    if (Status != CFE_PSP_SUCCESS)
+    {
+        return Status;
+    }
+
+    /*
+     * Ranges with a fixed word size (e.g. device registers) are accessed
+     * with exactly that width.  The caller buffer may not be aligned, so
+     * it is always accessed with memcpy.
+     */
+    switch (WordSize)
+    {
+        case CFE_PSP_MEM_SIZE_DWORD:
+            for (i = 0; i < Size; i += sizeof(Value32))
+            {
+                Value32 = *((volatile uint32 *)(MemoryAddress + i));
+                memcpy(&BufPtr[i], &Value32, sizeof(Value32));
+            }
+            break;
+
+        case CFE_PSP_MEM_SIZE_WORD:
+            for (i = 0; i < Size; i += sizeof(Value16))
+            {
+                Value16 = *((volatile uint16 *)(MemoryAddress + i));
+                memcpy(&BufPtr[i], &Value16, sizeof(Value16));
+            }
+            break;
+
+        default:
+            memcpy(BufPtr, (const void *)MemoryAddress, Size);
+            break;
+    }
+
+    return CFE_PSP_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per public API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CFE_PSP_MemWriteBlock(cpuaddr MemoryAddress, const void *Buffer, size_t Size)
+{
+    const uint8 *BufPtr = Buffer;
+    int32        Status;
+    uint32       MemoryType;
+    size_t       WordSize;
+    size_t       i;
+    uint32       Value32;
+    uint16       Value16;
+
+    if (Buffer == NULL)
+    {
+        return CFE_PSP_INVALID_POINTER;
+    }
+
+    Status = ram_direct_CheckBlock(MemoryAddress, Size, CFE_PSP_MEM_ATTR_WRITE, &MemoryType, &WordSize);
+    if (Status != CFE_PSP_SUCCESS)
+    {
+        return Status;
+    }
+
+    if (MemoryType == CFE_PSP_MEM_EEPROM)
+    {
+        return ram_direct_WriteEepromBlock(MemoryAddress, BufPtr, Size, WordSize);
+    }
+
+    switch (WordSize)
+    {
+        case CFE_PSP_MEM_SIZE_DWORD:
+            for (i = 0; i < Size; i += sizeof(Value32))
+            {
+                memcpy(&Value32, &BufPtr[i], sizeof(Value32));
+                *((volatile uint32 *)(MemoryAddress + i)) = Value32;
+            }
+            break;
+
+        case CFE_PSP_MEM_SIZE_WORD:
+            for (i = 0; i < Size; i += sizeof(Value16))
+            {
+                memcpy(&Value16, &BufPtr[i], sizeof(Value16));
+                *((volatile uint16 *)(MemoryAddress + i)) = Value16;
+            }
+            break;
+
+        default:
+            memcpy((void *)MemoryAddress, BufPtr, Size);
+            break;
+    }
+
+    return CFE_PSP_SUCCESS;
+}
@@ -65,3 +65,13 @@ int32 CFE_PSP_MemWrite32(cpuaddr MemoryAddress, uint32 uint32Value)
 {
     return CFE_PSP_ERROR_NOT_IMPLEMENTED;
 }
+
+int32 CFE_PSP_MemReadBlock(cpuaddr MemoryAddress, void *Buffer, size_t Size)
+{
+    return CFE_PSP_ERROR_NOT_IMPLEMENTED;
+}
+
+int32 CFE_PSP_MemWriteBlock(cpuaddr MemoryAddress, const void *Buffer, size_t Size)
+{
+    return CFE_PSP_ERROR_NOT_IMPLEMENTED;
+}
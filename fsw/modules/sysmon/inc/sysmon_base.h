@@ -0,0 +1,96 @@
+/*
+ *  Copyright (c) 2017, United States government as represented by the
+ *  administrator of the National Aeronautics and Space Administration.
+ *  All rights reserved. This software was created at NASA Glenn
+ *  Research Center pursuant to government contracts.
+ */
+
+/**
+ * \file
+ *
+ * Definitions common to all sysmon device drivers (linux_sysmon, vxworks_sysmon
+ * and rtems_sysmon), accessed via iodriver.
+ *
+ * Subsystems of every driver (see CFE_PSP_IODriver_LOOKUP_SUBSYSTEM):
+ *  - "aggregate": subchannels "cpu-load", "cpu-load-min", "cpu-load-mean", "cpu-load-max"
+ *  - "per-cpu": load of each CPU, the subchannel is the CPU number
+ *  - "per-cpu-min", "per-cpu-mean", "per-cpu-max": same for the window statistics
+ *
+ * A driver may add its own subsystems after these, see the header of the driver.
+ *
+ * Loads are 24 bit ADC codes where 0xFFFFFF is full load.  The min/mean/max
+ * values are taken over the last complete window of samples.
+ *
+ * All values are published as a whole after each sample, so the channels read
+ * in one call always come from the same sample, and reading never blocks the
+ * sampling task.  CFE_PSP_IODriver_ANALOG_IO_READ_SNAPSHOT reads the same
+ * channels as CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS, and also returns the
+ * sequence number and time of that sample.  Reading fails with CFE_PSP_ERROR
+ * while the monitoring is stopped.
+ *
+ * The sampling can be changed at any time with CFE_PSP_IODriver_SET_CONFIGURATION
+ * on the "aggregate" subsystem, using a string of "key=value" settings separated
+ * by spaces or commas:
+ *  - "period_ms=N": time between samples, CFE_PSP_SYSMON_MIN_PERIOD_MS to CFE_PSP_SYSMON_MAX_PERIOD_MS
+ *  - "window=N":    number of samples per min/mean/max window, 1 to CFE_PSP_SYSMON_MAX_WINDOW
+ *  - "sync_start=N": 1 (default) to take the first sample within SET_RUNNING, so that
+ *    starting never waits on the sampling task; 0 to let the task take it, in which
+ *    case SET_RUNNING waits for it for up to 2 seconds
+ *
+ * For example "period_ms=100,window=50" reports statistics over 5 second windows.
+ * The current settings are returned by CFE_PSP_IODriver_GET_CONFIGURATION into
+ * a CFE_PSP_Sysmon_Config_t structure.
+ *
+ * The "cpu-load" subchannel of "aggregate" and each "per-cpu" subchannel also
+ * keep a history, in memory reserved when starting: the last
+ * CFE_PSP_SYSMON_HISTORY_SAMPLES samples, and the min/mean/max of the last
+ * CFE_PSP_SYSMON_HISTORY_MINUTES minutes and CFE_PSP_SYSMON_HISTORY_HOURS hours.
+ * A minute or hour appears once the first sample after it is taken.  The
+ * history is read with CFE_PSP_IODriver_ANALOG_IO_READ_HISTORY, and its
+ * distribution with CFE_PSP_IODriver_ANALOG_IO_READ_PERCENTILES, neither of
+ * which blocks the sampling or allocates memory.  Starting clears the history.
+ *
+ * Each driver has a single iodriver lock, index 0 for CFE_PSP_IODriver_GetLockStats.
+ * SET_RUNNING and SET_CONFIGURATION hold it alone and GET_CONFIGURATION shares
+ * it.  All other commands take no lock, so reads never wait for each other nor
+ * for starting, stopping or configuring.
+ */
+
+#ifndef SYSMON_BASE_H
+#define SYSMON_BASE_H
+
+#include "common_types.h"
+
+/*
+ * Limits and defaults of the sampling configuration
+ */
+#define CFE_PSP_SYSMON_MIN_PERIOD_MS     10
+#define CFE_PSP_SYSMON_MAX_PERIOD_MS     3600000
+#define CFE_PSP_SYSMON_MAX_WINDOW        100000
+#define CFE_PSP_SYSMON_DEFAULT_PERIOD_MS 1000
+#define CFE_PSP_SYSMON_DEFAULT_WINDOW    30
+
+/*
+ * Number of entries of the history of each load, per resolution
+ */
+#ifndef CFE_PSP_SYSMON_HISTORY_SAMPLES
+#define CFE_PSP_SYSMON_HISTORY_SAMPLES 64
+#endif
+#ifndef CFE_PSP_SYSMON_HISTORY_MINUTES
+#define CFE_PSP_SYSMON_HISTORY_MINUTES 60
+#endif
+#ifndef CFE_PSP_SYSMON_HISTORY_HOURS
+#define CFE_PSP_SYSMON_HISTORY_HOURS 24
+#endif
+
+/**
+ * \brief Sampling configuration, as returned by CFE_PSP_IODriver_GET_CONFIGURATION
+ */
+typedef struct CFE_PSP_Sysmon_Config
+{
+    uint32 SamplePeriodMs; /**< Time between samples in milliseconds */
+    uint32 WindowSamples;  /**< Number of samples per min/mean/max window */
+    uint32 SyncStart;      /**< Nonzero if the first sample is taken when starting */
+} CFE_PSP_Sysmon_Config_t;
+
+#endif /* SYSMON_BASE_H */
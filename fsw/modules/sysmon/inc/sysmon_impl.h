@@ -0,0 +1,456 @@
+/*
+ *  Copyright (c) 2017, United States government as represented by the
+ *  administrator of the National Aeronautics and Space Administration.
+ *  All rights reserved. This software was created at NASA Glenn
+ *  Research Center pursuant to government contracts.
+ */
+
+/**
+ * \file
+ *
+ * Engine shared by the sysmon device drivers
+ *
+ * The engine runs the sampling task, keeps the window statistics, publishes
+ * each sample for lock-free reading and implements the iodriver opcodes of
+ * the common subsystems (see sysmon_base.h).  A driver only provides a
+ * CFE_PSP_Sysmon_Driver_t, whose Collect function gets the load of each CPU,
+ * plus the values of any subsystems specific to that driver.
+ *
+ * Each driver holds one CFE_PSP_Sysmon_t, set up with CFE_PSP_Sysmon_InitState()
+ * from the module Init function, and passes the iodriver commands on to
+ * CFE_PSP_Sysmon_DevCmd().  Its iodriver API has CFE_PSP_SYSMON_NUM_LOCKS
+ * locks, selected by CFE_PSP_Sysmon_DevLock().
+ */
+
+#ifndef SYSMON_IMPL_H
+#define SYSMON_IMPL_H
+
+#ifndef _CFE_PSP_MODULE_
+#error "Do not include this file from outside the PSP"
+#endif
+
+#include "cfe_psp_module.h"
+#include "iodriver_impl.h"
+#include "iodriver_analog_io.h"
+#include "sysmon_base.h"
+
+/*
+ * The common subsystems, the subsystems of the driver follow these
+ */
+#define CFE_PSP_SYSMON_AGGREGATE_SUBSYS   0
+#define CFE_PSP_SYSMON_CPULOAD_SUBSYS     1
+#define CFE_PSP_SYSMON_CPULOAD_MIN_SUBSYS 2
+#define CFE_PSP_SYSMON_CPULOAD_AVG_SUBSYS 3
+#define CFE_PSP_SYSMON_CPULOAD_MAX_SUBSYS 4
+#define CFE_PSP_SYSMON_NUM_BASE_SUBSYS    5
+
+/* the "per-cpu", "per-cpu-min", "per-cpu-mean" and "per-cpu-max" subsystems */
+#define CFE_PSP_SYSMON_NUM_CPU_SUBSYS 4
+
+/* maximum number of subsystems of a driver */
+#define CFE_PSP_SYSMON_MAX_DRIVER_SUBSYS 8
+
+/* subchannels of the "aggregate" subsystem */
+#define CFE_PSP_SYSMON_AGGR_CPULOAD_SUBCH 0
+#define CFE_PSP_SYSMON_AGGR_MIN_SUBCH     1
+#define CFE_PSP_SYSMON_AGGR_AVG_SUBCH     2
+#define CFE_PSP_SYSMON_AGGR_MAX_SUBCH     3
+#define CFE_PSP_SYSMON_AGGR_NUM_SUBCH     4
+
+/* statistics kept over each window of samples */
+#define CFE_PSP_SYSMON_STAT_MIN 0
+#define CFE_PSP_SYSMON_STAT_AVG 1
+#define CFE_PSP_SYSMON_STAT_MAX 2
+#define CFE_PSP_SYSMON_NUM_STAT 3
+
+/*
+ * How long starting waits for the sampling task to take its first sample,
+ * when that is not taken synchronously, and stopping waits for it to exit
+ */
+#define CFE_PSP_SYSMON_TASK_TIMEOUT_MS 2000
+
+/*
+ * Number of codes in the snapshot storage of the CPUs, see CFE_PSP_Sysmon_SetCpuStorage()
+ */
+#define CFE_PSP_SYSMON_CPU_STORAGE_SIZE(max_cpus) (2 * CFE_PSP_SYSMON_NUM_CPU_SUBSYS * (max_cpus))
+
+/*
+ * The rings of the history, by CFE_PSP_IODriver_AnalogHistoryResolution_t
+ *
+ * Each ring has one slot more than the entries readers see, which is where
+ * the sampling writes the next entry, so it never changes what a reader
+ * may be reading.
+ */
+#define CFE_PSP_SYSMON_NUM_RINGS     CFE_PSP_IODriver_AnalogHistory_MAX
+#define CFE_PSP_SYSMON_HISTORY_SLOTS \
+    (CFE_PSP_SYSMON_HISTORY_SAMPLES + CFE_PSP_SYSMON_HISTORY_MINUTES + CFE_PSP_SYSMON_HISTORY_HOURS + CFE_PSP_SYSMON_NUM_RINGS)
+
+/*
+ * Number of histories in the storage of the driver, see CFE_PSP_Sysmon_SetHistoryStorage()
+ */
+#define CFE_PSP_SYSMON_HISTORY_STORAGE_SIZE(max_cpus) (1 + (max_cpus))
+
+/**
+ * Min/mean/max of a load over a window of samples
+ *
+ * The Stat values are those of the last complete window,
+ * the others accumulate the window in progress.
+ */
+typedef struct CFE_PSP_Sysmon_Window
+{
+    CFE_PSP_IODriver_AdcCode_t Stat[CFE_PSP_SYSMON_NUM_STAT];
+    CFE_PSP_IODriver_AdcCode_t CurrMin;
+    CFE_PSP_IODriver_AdcCode_t CurrMax;
+    uint64                     CurrSum;
+} CFE_PSP_Sysmon_Window_t;
+
+/**
+ * Sampling state of one CPU
+ *
+ * The driver sets Load from its Collect function, the rest belongs to the engine.
+ */
+typedef struct CFE_PSP_Sysmon_Cpu
+{
+    CFE_PSP_IODriver_AdcCode_t Load;
+    CFE_PSP_Sysmon_Window_t    Window;
+} CFE_PSP_Sysmon_Cpu_t;
+
+/**
+ * Minute or hour of a load in progress
+ */
+typedef struct CFE_PSP_Sysmon_Bucket
+{
+    uint64                     Sum;
+    uint32                     Count;
+    CFE_PSP_IODriver_AdcCode_t Min;
+    CFE_PSP_IODriver_AdcCode_t Max;
+} CFE_PSP_Sysmon_Bucket_t;
+
+/**
+ * Entry of the history of a load, the time is kept once for all loads
+ */
+typedef struct CFE_PSP_Sysmon_Entry
+{
+    CFE_PSP_IODriver_AdcCode_t Min;
+    CFE_PSP_IODriver_AdcCode_t Mean;
+    CFE_PSP_IODriver_AdcCode_t Max;
+} CFE_PSP_Sysmon_Entry_t;
+
+/**
+ * History of one load
+ *
+ * The slots of all the rings follow each other, see CFE_PSP_SYSMON_HISTORY_SLOTS.
+ * The buckets accumulate the minute and the hour in progress, and are only used
+ * by the sampling.
+ */
+typedef struct CFE_PSP_Sysmon_History
+{
+    CFE_PSP_Sysmon_Entry_t  Slots[CFE_PSP_SYSMON_HISTORY_SLOTS];
+    CFE_PSP_Sysmon_Bucket_t Buckets[CFE_PSP_SYSMON_NUM_RINGS - 1];
+} CFE_PSP_Sysmon_History_t;
+
+/**
+ * Position of a ring of the history
+ */
+typedef struct CFE_PSP_Sysmon_RingPos
+{
+    uint16 Head;  /* slot of the newest entry */
+    uint16 Count; /* number of entries readers see */
+} CFE_PSP_Sysmon_RingPos_t;
+
+/**
+ * Values of one sample as seen by readers, see CFE_PSP_IODriver_Snapshot_t
+ *
+ * The Collect function of the driver fills NumValues and Values of its own
+ * subsystems, and DriverData if it uses that, in the copy it is given.  That
+ * copy holds the sample before the previous one, so everything must be set
+ * again at every sample.
+ */
+typedef struct CFE_PSP_Sysmon_Sample
+{
+    uint64                      TimestampNs;
+    uint32                      NumCpus;
+    CFE_PSP_IODriver_AdcCode_t  Aggregate[CFE_PSP_SYSMON_AGGR_NUM_SUBCH];
+    CFE_PSP_IODriver_AdcCode_t *PerCpu[CFE_PSP_SYSMON_NUM_CPU_SUBSYS]; /* by subsystem, from "per-cpu" */
+
+    /* by driver subsystem; NumValues is 0 if the values could not be sampled */
+    uint32                      NumValues[CFE_PSP_SYSMON_MAX_DRIVER_SUBSYS];
+    CFE_PSP_IODriver_AdcCode_t *Values[CFE_PSP_SYSMON_MAX_DRIVER_SUBSYS];
+
+    /* device specific data of the driver, set by its Open function */
+    void *DriverData;
+
+    /* history of the aggregate load then of each CPU, and the entries to read from it */
+    const CFE_PSP_Sysmon_History_t *History;
+    CFE_PSP_Sysmon_RingPos_t        Rings[CFE_PSP_SYSMON_NUM_RINGS];
+} CFE_PSP_Sysmon_Sample_t;
+
+typedef struct CFE_PSP_Sysmon CFE_PSP_Sysmon_t;
+
+/**
+ * Functions and properties of a sysmon driver
+ */
+typedef const struct CFE_PSP_Sysmon_Driver
+{
+    const char *Name; /**< Name used in messages */
+
+    /**
+     * Names of the subsystems of the driver, NULL terminated, numbered from
+     * CFE_PSP_SYSMON_NUM_BASE_SUBSYS.  May be NULL if there are none.
+     */
+    const char *const *SubsystemNames;
+
+    /**
+     * For each subsystem of the driver, the NULL terminated names of its
+     * subchannels for CFE_PSP_IODriver_LOOKUP_SUBCHANNEL, or NULL.  The
+     * array itself may be NULL if no subsystem has names.
+     */
+    const char *const *const *SubchannelNames;
+
+    /**
+     * Entry point of the sampling task, which only calls CFE_PSP_Sysmon_Run()
+     */
+    osal_task_entry TaskEntry;
+    const char *    TaskName;
+    size_t          TaskStackSize;
+    osal_priority_t TaskPriority;
+
+    /**
+     * Acquires the resources of the driver when starting
+     *
+     * This must set up the storage with CFE_PSP_Sysmon_SetCpuStorage(), and with
+     * CFE_PSP_Sysmon_SetValueStorage() for each subsystem of the driver.  Setting
+     * up the history with CFE_PSP_Sysmon_SetHistoryStorage() is optional.
+     *
+     * Readers of the snapshots take no lock, so this storage must stay valid
+     * for the lifetime of the module, even after Close.
+     */
+    int32 (*Open)(CFE_PSP_Sysmon_t *Sysmon);
+
+    /**
+     * Takes a sample
+     *
+     * Sets the Load of each CPU, and the values of the subsystems of the driver
+     * in Sample.  ElapsedNs is the time since the previous sample, it is 0 for the
+     * first sample after starting, which only serves as the reference of the next.
+     *
+     * Returns the number of CPUs, 0 if the loads could not be sampled.
+     */
+    uint32 (*Collect)(CFE_PSP_Sysmon_t *Sysmon, CFE_PSP_Sysmon_Sample_t *Sample, uint64 ElapsedNs);
+
+    /**
+     * Releases what Open acquired, but the storage, also called if Open failed
+     */
+    void (*Close)(CFE_PSP_Sysmon_t *Sysmon);
+
+    /**
+     * Optional: gets the time in nanoseconds, on a clock that preferably does not
+     * jump.  The local time of OSAL is used if NULL.
+     */
+    uint64 (*GetTimeNs)(void);
+
+    /**
+     * Optional: waits until DeadlineNs on the clock of GetTimeNs, or until Wake
+     * is called, also if it was called before the wait began.  Must be set
+     * along with Wake.
+     *
+     * If NULL, the task waits on a semaphore with OS_BinSemTimedWait(), so the
+     * samples are taken with a resolution of a millisecond, or of the clock
+     * tick where that is coarser.
+     */
+    void (*WaitUntilNs)(CFE_PSP_Sysmon_t *Sysmon, uint64 DeadlineNs);
+
+    /**
+     * Optional: ends the current or next wait of WaitUntilNs
+     */
+    void (*Wake)(CFE_PSP_Sysmon_t *Sysmon);
+
+    /**
+     * Optional: handles device specific opcodes
+     *
+     * Called for every command before the engine handles it.  Returns
+     * CFE_PSP_ERROR_NOT_IMPLEMENTED to let the engine handle the command.
+     */
+    int32 (*Command)(CFE_PSP_Sysmon_t *Sysmon, uint32 CommandCode, uint16 Subsystem, uint16 Subchannel,
+                     CFE_PSP_IODriver_Arg_t Arg);
+} CFE_PSP_Sysmon_Driver_t;
+
+/**
+ * State of a sysmon driver
+ *
+ * Everything but the configuration and the snapshots is only used by the
+ * sampling, that is the sampling task once started.  The commands only read
+ * the snapshots.
+ */
+struct CFE_PSP_Sysmon
+{
+    const CFE_PSP_Sysmon_Driver_t *Driver;
+    uint32                         NumDriverSubsys;
+
+    volatile bool IsRunning;
+    volatile bool ShouldRun;
+
+    /* may be changed by SET_CONFIGURATION while running */
+    volatile uint32 SamplePeriodMs;
+    volatile uint32 WindowSamples;
+    bool            SyncStart;
+
+    osal_id_t TaskId;
+    osal_id_t WakeSemId;  /* given to make the task look at ShouldRun and the period again */
+    osal_id_t EventSemId; /* given by the task after its first sample (if not SyncStart) and when it exits */
+
+    uint32 MaxCpus;
+    uint32 NumCpus;
+    uint32 WindowCount;
+    uint32 NumSamples;
+    uint64 LastSampleNs;
+    uint64 NextSampleNs;
+
+    /* storage of the driver, see CFE_PSP_Sysmon_SetCpuStorage() */
+    CFE_PSP_Sysmon_Cpu_t *Cpus;
+    uint32                MaxValues[CFE_PSP_SYSMON_MAX_DRIVER_SUBSYS];
+
+    CFE_PSP_IODriver_AdcCode_t AggregateLoad;
+    CFE_PSP_Sysmon_Window_t    AggregateWindow;
+
+    /* history, see CFE_PSP_Sysmon_SetHistoryStorage() */
+    CFE_PSP_Sysmon_History_t *History;
+    CFE_PSP_Sysmon_RingPos_t  Rings[CFE_PSP_SYSMON_NUM_RINGS];
+    uint64                    BucketIndex[CFE_PSP_SYSMON_NUM_RINGS]; /* minute/hour in progress, since the epoch */
+    bool                      BucketActive[CFE_PSP_SYSMON_NUM_RINGS];
+    uint64                    HistoryTimestampNs[CFE_PSP_SYSMON_HISTORY_SLOTS]; /* time of each slot */
+
+    CFE_PSP_IODriver_Snapshot_t Published;
+    CFE_PSP_Sysmon_Sample_t     Snapshot[2];
+};
+
+/**
+ * \brief Sets up the state of a driver, with the default configuration
+ *
+ * \param[out] Sysmon State of the driver
+ * \param[in]  Driver Functions and properties of the driver
+ */
+void CFE_PSP_Sysmon_InitState(CFE_PSP_Sysmon_t *Sysmon, const CFE_PSP_Sysmon_Driver_t *Driver);
+
+/**
+ * \brief Main entry point for the iodriver commands of a driver
+ *
+ * \param[inout] Sysmon      State of the driver
+ * \param[in]    CommandCode The CFE_PSP_IODriver_xxx command
+ * \param[in]    Subsystem   The monitor subsystem identifier
+ * \param[in]    Subchannel  The monitor subchannel identifier
+ * \param[in]    Arg         The arguments for the corresponding command
+ *
+ * \returns Status code as for the iodriver DeviceCommand
+ */
+int32 CFE_PSP_Sysmon_DevCmd(CFE_PSP_Sysmon_t *Sysmon, uint32 CommandCode, uint16 Subsystem, uint16 Subchannel,
+                            CFE_PSP_IODriver_Arg_t Arg);
+
+/*
+ * Number of iodriver locks of a driver
+ */
+#define CFE_PSP_SYSMON_NUM_LOCKS 1
+
+/**
+ * \brief Selects the iodriver lock of a command, the DeviceLock of every driver
+ *
+ * Starting, stopping and configuring hold the lock alone, and getting the
+ * configuration shares it.  All other commands only read the snapshots or
+ * constant data, and take no lock.
+ *
+ * \param[in] CommandCode The CFE_PSP_IODriver_xxx command
+ * \param[in] Subsystem   The monitor subsystem identifier
+ * \param[in] Subchannel  The monitor subchannel identifier
+ * \param[in] Arg         The arguments for the corresponding command
+ *
+ * \returns The lock as for the iodriver DeviceLock
+ */
+int32 CFE_PSP_Sysmon_DevLock(uint32 CommandCode, uint16 Subsystem, uint16 Subchannel, CFE_PSP_IODriver_Arg_t Arg);
+
+/**
+ * \brief Body of the sampling task, returns when the monitoring is stopped
+ *
+ * \param[inout] Sysmon State of the driver
+ */
+void CFE_PSP_Sysmon_Run(CFE_PSP_Sysmon_t *Sysmon);
+
+/**
+ * \brief Takes a sample and publishes it, as done by the sampling task each period
+ *
+ * \param[inout] Sysmon State of the driver
+ * \param[in]    First  true for the first sample after starting, which is not added to the windows
+ */
+void CFE_PSP_Sysmon_TakeSample(CFE_PSP_Sysmon_t *Sysmon, bool First);
+
+/**
+ * \brief Sets the storage of the CPUs, from the Open function of the driver
+ *
+ * \param[inout] Sysmon         State of the driver
+ * \param[in]    MaxCpus        Maximum number of CPUs
+ * \param[in]    Cpus           Sampling state of MaxCpus CPUs
+ * \param[in]    SnapshotValues Storage of CFE_PSP_SYSMON_CPU_STORAGE_SIZE(MaxCpus) codes
+ */
+void CFE_PSP_Sysmon_SetCpuStorage(CFE_PSP_Sysmon_t *Sysmon, uint32 MaxCpus, CFE_PSP_Sysmon_Cpu_t *Cpus,
+                                  CFE_PSP_IODriver_AdcCode_t *SnapshotValues);
+
+/**
+ * \brief Sets the storage of a subsystem of the driver, from its Open function
+ *
+ * \param[inout] Sysmon         State of the driver
+ * \param[in]    Subsystem      Subsystem, from CFE_PSP_SYSMON_NUM_BASE_SUBSYS
+ * \param[in]    MaxValues      Maximum number of values of the subsystem
+ * \param[in]    SnapshotValues Storage of 2 * MaxValues codes
+ */
+void CFE_PSP_Sysmon_SetValueStorage(CFE_PSP_Sysmon_t *Sysmon, uint16 Subsystem, uint32 MaxValues,
+                                    CFE_PSP_IODriver_AdcCode_t *SnapshotValues);
+
+/**
+ * \brief Gives the engine the storage of the history of the loads
+ *
+ * Must be called after CFE_PSP_Sysmon_SetCpuStorage().
+ *
+ * \param[inout] Sysmon  State of the driver
+ * \param[in]    History Storage of CFE_PSP_SYSMON_HISTORY_STORAGE_SIZE(MaxCpus) histories
+ */
+void CFE_PSP_Sysmon_SetHistoryStorage(CFE_PSP_Sysmon_t *Sysmon, CFE_PSP_Sysmon_History_t *History);
+
+/**
+ * \brief Converts the busy part of a total (e.g. time) to a 24 bit load
+ *
+ * The load has a resolution of 12 bits, which are duplicated to fill 24 bits.
+ *
+ * \param[in] Busy  Busy part
+ * \param[in] Total Total, the load is 0 if this is 0
+ *
+ * \returns Load, 0xFFFFFF if Busy is Total or more
+ */
+CFE_PSP_IODriver_AdcCode_t CFE_PSP_Sysmon_ScaleLoad(uint64 Busy, uint64 Total);
+
+/**
+ * \brief Starts reading the current snapshot, for the device specific commands of a driver
+ *
+ * Used as CFE_PSP_IODriver_SnapshotReadBegin(), with CFE_PSP_Sysmon_ReadRetry().
+ *
+ * \param[in]  Sysmon   State of the driver
+ * \param[out] Sequence Sequence number to pass to CFE_PSP_Sysmon_ReadRetry()
+ *
+ * \returns The snapshot to read
+ */
+static inline const CFE_PSP_Sysmon_Sample_t *CFE_PSP_Sysmon_ReadBegin(const CFE_PSP_Sysmon_t *Sysmon,
+                                                                      uint32 *                Sequence)
+{
+    *Sequence = CFE_PSP_IODriver_SnapshotReadBegin(&Sysmon->Published);
+    return &Sysmon->Snapshot[*Sequence & 1];
+}
+
+/**
+ * \brief Checks whether the snapshot read since CFE_PSP_Sysmon_ReadBegin() may be inconsistent
+ *
+ * \returns true if the read must be done again
+ */
+static inline bool CFE_PSP_Sysmon_ReadRetry(const CFE_PSP_Sysmon_t *Sysmon, uint32 Sequence)
+{
+    return CFE_PSP_IODriver_SnapshotReadRetry(&Sysmon->Published, Sequence);
+}
+
+#endif /* SYSMON_IMPL_H */
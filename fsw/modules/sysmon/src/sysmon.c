@@ -0,0 +1,1289 @@
+/*
+ *  Copyright (c) 2017, United States government as represented by the
+ *  administrator of the National Aeronautics and Space Administration.
+ *  All rights reserved. This software was created at NASA Glenn
+ *  Research Center pursuant to government contracts.
+ */
+
+/**
+ * \file
+ *
+ * Engine shared by the sysmon device drivers.  This is the implementation
+ * of functions declared in sysmon_impl.h
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cfe_psp.h"
+#include "osapi-clock.h"
+
+#include "sysmon_impl.h"
+
+CFE_PSP_MODULE_DECLARE_SIMPLE(sysmon);
+
+static const char *CFE_PSP_Sysmon_SubsystemNames[CFE_PSP_SYSMON_NUM_BASE_SUBSYS] = {
+    "aggregate", "per-cpu", "per-cpu-min", "per-cpu-mean", "per-cpu-max"};
+static const char *CFE_PSP_Sysmon_AggregateNames[] = {"cpu-load", "cpu-load-min", "cpu-load-mean", "cpu-load-max",
+                                                      NULL};
+
+/* first slot and number of slots of each ring of the history */
+static const uint16 CFE_PSP_Sysmon_RingOffset[CFE_PSP_SYSMON_NUM_RINGS] = {
+    0, CFE_PSP_SYSMON_HISTORY_SAMPLES + 1, CFE_PSP_SYSMON_HISTORY_SAMPLES + CFE_PSP_SYSMON_HISTORY_MINUTES + 2};
+static const uint16 CFE_PSP_Sysmon_RingSlots[CFE_PSP_SYSMON_NUM_RINGS] = {CFE_PSP_SYSMON_HISTORY_SAMPLES + 1,
+                                                                         CFE_PSP_SYSMON_HISTORY_MINUTES + 1,
+                                                                         CFE_PSP_SYSMON_HISTORY_HOURS + 1};
+
+/* length of the entries of each ring, 0 for single samples */
+static const uint64 CFE_PSP_Sysmon_RingBucketNs[CFE_PSP_SYSMON_NUM_RINGS] = {0, 60000000000ULL, 3600000000000ULL};
+
+void sysmon_Init(uint32 PspModuleId)
+{
+    /* nothing to do, each driver holds its own state */
+}
+
+void CFE_PSP_Sysmon_InitState(CFE_PSP_Sysmon_t *Sysmon, const CFE_PSP_Sysmon_Driver_t *Driver)
+{
+    memset(Sysmon, 0, sizeof(*Sysmon));
+
+    Sysmon->Driver         = Driver;
+    Sysmon->SamplePeriodMs = CFE_PSP_SYSMON_DEFAULT_PERIOD_MS;
+    Sysmon->WindowSamples  = CFE_PSP_SYSMON_DEFAULT_WINDOW;
+    Sysmon->SyncStart      = true;
+
+    if (Driver->SubsystemNames != NULL)
+    {
+        while (Sysmon->NumDriverSubsys < CFE_PSP_SYSMON_MAX_DRIVER_SUBSYS &&
+               Driver->SubsystemNames[Sysmon->NumDriverSubsys] != NULL)
+        {
+            ++Sysmon->NumDriverSubsys;
+        }
+    }
+}
+
+void CFE_PSP_Sysmon_SetCpuStorage(CFE_PSP_Sysmon_t *Sysmon, uint32 MaxCpus, CFE_PSP_Sysmon_Cpu_t *Cpus,
+                                  CFE_PSP_IODriver_AdcCode_t *SnapshotValues)
+{
+    uint32 i;
+    uint32 Subsys;
+
+    Sysmon->MaxCpus = MaxCpus;
+    Sysmon->Cpus    = Cpus;
+    for (i = 0; i < 2; ++i)
+    {
+        for (Subsys = 0; Subsys < CFE_PSP_SYSMON_NUM_CPU_SUBSYS; ++Subsys)
+        {
+            Sysmon->Snapshot[i].PerCpu[Subsys] = &SnapshotValues[(i * CFE_PSP_SYSMON_NUM_CPU_SUBSYS + Subsys) * MaxCpus];
+        }
+    }
+}
+
+void CFE_PSP_Sysmon_SetValueStorage(CFE_PSP_Sysmon_t *Sysmon, uint16 Subsystem, uint32 MaxValues,
+                                    CFE_PSP_IODriver_AdcCode_t *SnapshotValues)
+{
+    uint32 Index;
+
+    Index = Subsystem - CFE_PSP_SYSMON_NUM_BASE_SUBSYS;
+    if (Subsystem >= CFE_PSP_SYSMON_NUM_BASE_SUBSYS && Index < Sysmon->NumDriverSubsys)
+    {
+        Sysmon->MaxValues[Index]          = MaxValues;
+        Sysmon->Snapshot[0].Values[Index] = SnapshotValues;
+        Sysmon->Snapshot[1].Values[Index] = SnapshotValues + MaxValues;
+    }
+}
+
+void CFE_PSP_Sysmon_SetHistoryStorage(CFE_PSP_Sysmon_t *Sysmon, CFE_PSP_Sysmon_History_t *History)
+{
+    Sysmon->History             = History;
+    Sysmon->Snapshot[0].History = History;
+    Sysmon->Snapshot[1].History = History;
+}
+
+/*
+ * Publishes a sample without any values once the driver is closed, so reads fail
+ *
+ * The storage itself is left in place: readers take no lock, and one may
+ * still be reading the previous sample.
+ */
+void CFE_PSP_Sysmon_PublishEmpty(CFE_PSP_Sysmon_t *Sysmon)
+{
+    CFE_PSP_Sysmon_Sample_t *Sample;
+
+    Sysmon->NumCpus = 0;
+
+    Sample              = &Sysmon->Snapshot[CFE_PSP_IODriver_SnapshotWriteBegin(&Sysmon->Published)];
+    Sample->TimestampNs = 0;
+    Sample->NumCpus     = 0;
+    Sample->DriverData  = NULL;
+    memset(Sample->NumValues, 0, sizeof(Sample->NumValues));
+    memset(Sample->Rings, 0, sizeof(Sample->Rings));
+
+    CFE_PSP_IODriver_SnapshotPublish(&Sysmon->Published);
+}
+
+CFE_PSP_IODriver_AdcCode_t CFE_PSP_Sysmon_ScaleLoad(uint64 Busy, uint64 Total)
+{
+    CFE_PSP_IODriver_AdcCode_t Load;
+
+    if (Total == 0)
+    {
+        Load = 0;
+    }
+    else if (Busy >= Total)
+    {
+        Load = 0xFFFFFF; /* max */
+    }
+    else
+    {
+        Load = (0x1000 * Busy) / Total;
+        Load |= (Load << 12); /* Expand from 12->24 bit */
+    }
+
+    return Load;
+}
+
+uint64 CFE_PSP_Sysmon_GetTimeNs(const CFE_PSP_Sysmon_t *Sysmon)
+{
+    OS_time_t Now;
+
+    if (Sysmon->Driver->GetTimeNs != NULL)
+    {
+        return Sysmon->Driver->GetTimeNs();
+    }
+
+    memset(&Now, 0, sizeof(Now));
+    OS_GetLocalTime(&Now);
+    return OS_TimeGetTotalNanoseconds(Now);
+}
+
+/*
+ * Adds a sample to the window in progress
+ * The first sample of a window resets it.
+ */
+void CFE_PSP_Sysmon_WindowAdd(CFE_PSP_Sysmon_Window_t *Window, uint32 Count, CFE_PSP_IODriver_AdcCode_t Load)
+{
+    if (Count == 0 || Load < Window->CurrMin)
+    {
+        Window->CurrMin = Load;
+    }
+    if (Count == 0 || Load > Window->CurrMax)
+    {
+        Window->CurrMax = Load;
+    }
+    if (Count == 0)
+    {
+        Window->CurrSum = 0;
+    }
+    Window->CurrSum += Load;
+}
+
+/*
+ * Makes the window in progress the reported one
+ */
+void CFE_PSP_Sysmon_WindowFinish(CFE_PSP_Sysmon_Window_t *Window, uint32 Count)
+{
+    Window->Stat[CFE_PSP_SYSMON_STAT_MIN] = Window->CurrMin;
+    Window->Stat[CFE_PSP_SYSMON_STAT_AVG] = Window->CurrSum / Count;
+    Window->Stat[CFE_PSP_SYSMON_STAT_MAX] = Window->CurrMax;
+}
+
+/*
+ * Computes the aggregate load and feeds all the windows with the latest sample
+ */
+void CFE_PSP_Sysmon_UpdateStats(CFE_PSP_Sysmon_t *Sysmon)
+{
+    uint32 Cpu;
+    uint64 Sum;
+    uint32 WindowSamples;
+
+    Sum = 0;
+    for (Cpu = 0; Cpu < Sysmon->NumCpus; ++Cpu)
+    {
+        Sum += Sysmon->Cpus[Cpu].Load;
+        CFE_PSP_Sysmon_WindowAdd(&Sysmon->Cpus[Cpu].Window, Sysmon->WindowCount, Sysmon->Cpus[Cpu].Load);
+    }
+
+    /* average of all cpus */
+    if (Cpu != 0)
+    {
+        Sum /= Cpu;
+    }
+    Sysmon->AggregateLoad = Sum;
+    CFE_PSP_Sysmon_WindowAdd(&Sysmon->AggregateWindow, Sysmon->WindowCount, Sum);
+
+    ++Sysmon->WindowCount;
+
+    /* the window size may have been reduced below the current count, so check with >= */
+    WindowSamples = Sysmon->WindowSamples;
+    if (Sysmon->WindowCount >= WindowSamples)
+    {
+        for (Cpu = 0; Cpu < Sysmon->NumCpus; ++Cpu)
+        {
+            CFE_PSP_Sysmon_WindowFinish(&Sysmon->Cpus[Cpu].Window, Sysmon->WindowCount);
+        }
+        CFE_PSP_Sysmon_WindowFinish(&Sysmon->AggregateWindow, Sysmon->WindowCount);
+        Sysmon->WindowCount = 0;
+    }
+}
+
+/*
+ * Empties the history, once the storage is set up
+ */
+void CFE_PSP_Sysmon_HistoryReset(CFE_PSP_Sysmon_t *Sysmon)
+{
+    uint32 Channel;
+
+    memset(Sysmon->Rings, 0, sizeof(Sysmon->Rings));
+    memset(Sysmon->BucketIndex, 0, sizeof(Sysmon->BucketIndex));
+    memset(Sysmon->BucketActive, 0, sizeof(Sysmon->BucketActive));
+    if (Sysmon->History != NULL)
+    {
+        for (Channel = 0; Channel < CFE_PSP_SYSMON_HISTORY_STORAGE_SIZE(Sysmon->MaxCpus); ++Channel)
+        {
+            memset(Sysmon->History[Channel].Buckets, 0, sizeof(Sysmon->History[Channel].Buckets));
+        }
+    }
+}
+
+/*
+ * Moves a ring to its next slot, where the caller then writes the entry of each load
+ * Readers only see the entry once the sample is published.
+ */
+uint32 CFE_PSP_Sysmon_RingNext(CFE_PSP_Sysmon_t *Sysmon, uint32 Ring, uint64 TimestampNs)
+{
+    CFE_PSP_Sysmon_RingPos_t *Pos = &Sysmon->Rings[Ring];
+    uint32                    Slot;
+
+    if (Pos->Count != 0)
+    {
+        Pos->Head = (Pos->Head + 1) % CFE_PSP_Sysmon_RingSlots[Ring];
+    }
+    if (Pos->Count < CFE_PSP_Sysmon_RingSlots[Ring] - 1)
+    {
+        ++Pos->Count;
+    }
+
+    Slot                             = CFE_PSP_Sysmon_RingOffset[Ring] + Pos->Head;
+    Sysmon->HistoryTimestampNs[Slot] = TimestampNs;
+
+    return Slot;
+}
+
+/*
+ * Adds samples to a minute or hour in progress
+ */
+void CFE_PSP_Sysmon_BucketAdd(CFE_PSP_Sysmon_Bucket_t *Bucket, const CFE_PSP_Sysmon_Bucket_t *Samples)
+{
+    if (Samples->Count != 0)
+    {
+        if (Bucket->Count == 0 || Samples->Min < Bucket->Min)
+        {
+            Bucket->Min = Samples->Min;
+        }
+        if (Bucket->Count == 0 || Samples->Max > Bucket->Max)
+        {
+            Bucket->Max = Samples->Max;
+        }
+        Bucket->Sum += Samples->Sum;
+        Bucket->Count += Samples->Count;
+    }
+}
+
+/*
+ * Completes the minute or hour in progress of a ring, and adds it to the next ring
+ */
+void CFE_PSP_Sysmon_HistoryFlush(CFE_PSP_Sysmon_t *Sysmon, uint32 Ring, uint32 NumChannels)
+{
+    CFE_PSP_Sysmon_History_t *History;
+    CFE_PSP_Sysmon_Bucket_t * Bucket;
+    CFE_PSP_Sysmon_Entry_t *  Entry;
+    uint64                    TimestampNs;
+    uint64                    NextIndex;
+    uint32                    Next;
+    uint32                    Slot;
+    uint32                    Channel;
+
+    TimestampNs = Sysmon->BucketIndex[Ring] * CFE_PSP_Sysmon_RingBucketNs[Ring];
+
+    /* the next ring may have to complete its own bucket first */
+    Next = Ring + 1;
+    if (Next < CFE_PSP_SYSMON_NUM_RINGS)
+    {
+        NextIndex = TimestampNs / CFE_PSP_Sysmon_RingBucketNs[Next];
+        if (Sysmon->BucketActive[Next] && Sysmon->BucketIndex[Next] != NextIndex)
+        {
+            CFE_PSP_Sysmon_HistoryFlush(Sysmon, Next, NumChannels);
+        }
+        Sysmon->BucketIndex[Next]  = NextIndex;
+        Sysmon->BucketActive[Next] = true;
+    }
+
+    Slot = CFE_PSP_Sysmon_RingNext(Sysmon, Ring, TimestampNs);
+    for (Channel = 0; Channel < NumChannels; ++Channel)
+    {
+        History = &Sysmon->History[Channel];
+        Bucket  = &History->Buckets[Ring - 1];
+        Entry   = &History->Slots[Slot];
+        if (Bucket->Count == 0)
+        {
+            /* the CPU was not there during that time */
+            memset(Entry, 0, sizeof(*Entry));
+        }
+        else
+        {
+            Entry->Min  = Bucket->Min;
+            Entry->Mean = Bucket->Sum / Bucket->Count;
+            Entry->Max  = Bucket->Max;
+        }
+        if (Next < CFE_PSP_SYSMON_NUM_RINGS)
+        {
+            CFE_PSP_Sysmon_BucketAdd(&History->Buckets[Next - 1], Bucket);
+        }
+        memset(Bucket, 0, sizeof(*Bucket));
+    }
+
+    Sysmon->BucketActive[Ring] = false;
+}
+
+/*
+ * Adds the loads of a sample to the history
+ */
+void CFE_PSP_Sysmon_HistoryUpdate(CFE_PSP_Sysmon_t *Sysmon, uint64 Now)
+{
+    CFE_PSP_Sysmon_History_t *History;
+    CFE_PSP_Sysmon_Bucket_t   Sample;
+    uint32                    NumChannels;
+    uint32                    Channel;
+    uint32                    Ring;
+    uint32                    Slot;
+
+    NumChannels = CFE_PSP_SYSMON_HISTORY_STORAGE_SIZE(Sysmon->NumCpus);
+
+    /* complete the minute and the hour that this sample is past */
+    for (Ring = CFE_PSP_IODriver_AnalogHistory_MINUTES; Ring < CFE_PSP_SYSMON_NUM_RINGS; ++Ring)
+    {
+        if (Sysmon->BucketActive[Ring] && Sysmon->BucketIndex[Ring] != Now / CFE_PSP_Sysmon_RingBucketNs[Ring])
+        {
+            CFE_PSP_Sysmon_HistoryFlush(Sysmon, Ring, NumChannels);
+        }
+    }
+
+    Slot = CFE_PSP_Sysmon_RingNext(Sysmon, CFE_PSP_IODriver_AnalogHistory_SAMPLES, Now);
+    for (Channel = 0; Channel < NumChannels; ++Channel)
+    {
+        History = &Sysmon->History[Channel];
+
+        Sample.Count = 1;
+        Sample.Min   = (Channel == 0) ? Sysmon->AggregateLoad : Sysmon->Cpus[Channel - 1].Load;
+        Sample.Max   = Sample.Min;
+        Sample.Sum   = Sample.Min;
+
+        History->Slots[Slot].Min  = Sample.Min;
+        History->Slots[Slot].Mean = Sample.Min;
+        History->Slots[Slot].Max  = Sample.Min;
+        CFE_PSP_Sysmon_BucketAdd(&History->Buckets[CFE_PSP_IODriver_AnalogHistory_MINUTES - 1], &Sample);
+    }
+
+    Sysmon->BucketIndex[CFE_PSP_IODriver_AnalogHistory_MINUTES] =
+        Now / CFE_PSP_Sysmon_RingBucketNs[CFE_PSP_IODriver_AnalogHistory_MINUTES];
+    Sysmon->BucketActive[CFE_PSP_IODriver_AnalogHistory_MINUTES] = true;
+}
+
+/*
+ * Takes a sample into the snapshot that readers are not using, and makes it the current one
+ *
+ * The first sample after starting is only the reference of the next,
+ * its loads are published but not added to the windows.
+ */
+void CFE_PSP_Sysmon_TakeSample(CFE_PSP_Sysmon_t *Sysmon, bool First)
+{
+    CFE_PSP_Sysmon_Sample_t *Sample;
+    uint64                   Now;
+    uint64                   ElapsedNs;
+    uint32                   Cpu;
+    uint32                   Stat;
+    uint32                   Index;
+
+    Sample = &Sysmon->Snapshot[CFE_PSP_IODriver_SnapshotWriteBegin(&Sysmon->Published)];
+
+    /*
+     * The loads are computed over the actual time since the last sample,
+     * so a late wakeup still gives the right value.
+     */
+    Now       = CFE_PSP_Sysmon_GetTimeNs(Sysmon);
+    ElapsedNs = 0;
+    if (!First && Now > Sysmon->LastSampleNs)
+    {
+        ElapsedNs = Now - Sysmon->LastSampleNs;
+    }
+    Sysmon->LastSampleNs = Now;
+
+    Sysmon->NumCpus = Sysmon->Driver->Collect(Sysmon, Sample, ElapsedNs);
+    if (Sysmon->NumCpus > Sysmon->MaxCpus)
+    {
+        Sysmon->NumCpus = Sysmon->MaxCpus;
+    }
+    for (Index = 0; Index < Sysmon->NumDriverSubsys; ++Index)
+    {
+        if (Sample->NumValues[Index] > Sysmon->MaxValues[Index])
+        {
+            Sample->NumValues[Index] = Sysmon->MaxValues[Index];
+        }
+    }
+
+    if (!First)
+    {
+        ++Sysmon->NumSamples;
+        CFE_PSP_Sysmon_UpdateStats(Sysmon);
+        if (Sysmon->History != NULL)
+        {
+            CFE_PSP_Sysmon_HistoryUpdate(Sysmon, Now);
+        }
+    }
+
+    Sample->TimestampNs                                  = Now;
+    Sample->NumCpus                                      = Sysmon->NumCpus;
+    Sample->Aggregate[CFE_PSP_SYSMON_AGGR_CPULOAD_SUBCH] = Sysmon->AggregateLoad;
+    for (Stat = 0; Stat < CFE_PSP_SYSMON_NUM_STAT; ++Stat)
+    {
+        Sample->Aggregate[CFE_PSP_SYSMON_AGGR_MIN_SUBCH + Stat] = Sysmon->AggregateWindow.Stat[Stat];
+    }
+    for (Cpu = 0; Cpu < Sysmon->NumCpus; ++Cpu)
+    {
+        Sample->PerCpu[0][Cpu] = Sysmon->Cpus[Cpu].Load;
+        for (Stat = 0; Stat < CFE_PSP_SYSMON_NUM_STAT; ++Stat)
+        {
+            Sample->PerCpu[1 + Stat][Cpu] = Sysmon->Cpus[Cpu].Window.Stat[Stat];
+        }
+    }
+    memcpy(Sample->Rings, Sysmon->Rings, sizeof(Sample->Rings));
+
+    CFE_PSP_IODriver_SnapshotPublish(&Sysmon->Published);
+}
+
+/*
+ * Sets the time of the next sample to one period from the last
+ */
+void CFE_PSP_Sysmon_Schedule(CFE_PSP_Sysmon_t *Sysmon)
+{
+    Sysmon->NextSampleNs = Sysmon->LastSampleNs + (uint64)Sysmon->SamplePeriodMs * 1000000;
+}
+
+/*
+ * Waits until DeadlineNs, or until CFE_PSP_Sysmon_Wake()
+ */
+void CFE_PSP_Sysmon_WaitUntil(CFE_PSP_Sysmon_t *Sysmon, uint64 Now, uint64 DeadlineNs)
+{
+    if (Sysmon->Driver->WaitUntilNs != NULL)
+    {
+        Sysmon->Driver->WaitUntilNs(Sysmon, DeadlineNs);
+    }
+    else
+    {
+        OS_BinSemTimedWait(Sysmon->WakeSemId, (DeadlineNs - Now + 999999) / 1000000);
+    }
+}
+
+/*
+ * Makes the sampling task look at ShouldRun and the period again
+ */
+void CFE_PSP_Sysmon_Wake(CFE_PSP_Sysmon_t *Sysmon)
+{
+    if (Sysmon->Driver->Wake != NULL)
+    {
+        Sysmon->Driver->Wake(Sysmon);
+    }
+    else
+    {
+        OS_BinSemGive(Sysmon->WakeSemId);
+    }
+}
+
+void CFE_PSP_Sysmon_Run(CFE_PSP_Sysmon_t *Sysmon)
+{
+    uint64 Now;
+    uint64 PeriodNs;
+    uint64 DeadlineNs;
+
+    if (!Sysmon->SyncStart)
+    {
+        /* Start is waiting for the first sample */
+        CFE_PSP_Sysmon_TakeSample(Sysmon, true);
+        CFE_PSP_Sysmon_Schedule(Sysmon);
+        OS_BinSemGive(Sysmon->EventSemId);
+        if (Sysmon->NumCpus == 0)
+        {
+            return;
+        }
+    }
+
+    /*
+     * The samples follow an absolute schedule, so the sampling does not drift.
+     * Waking up early (CFE_PSP_Sysmon_Wake) only checks whether to stop, and
+     * picks up a change of the period.
+     */
+    while (Sysmon->ShouldRun)
+    {
+        Now = CFE_PSP_Sysmon_GetTimeNs(Sysmon);
+        if (Now < Sysmon->NextSampleNs)
+        {
+            DeadlineNs = Sysmon->NextSampleNs;
+            if (DeadlineNs - Now > (uint64)CFE_PSP_SYSMON_MAX_PERIOD_MS * 1000000)
+            {
+                /* the clock went back */
+                DeadlineNs = Now + (uint64)Sysmon->SamplePeriodMs * 1000000;
+                CFE_PSP_Sysmon_Schedule(Sysmon);
+            }
+            CFE_PSP_Sysmon_WaitUntil(Sysmon, Now, DeadlineNs);
+            continue;
+        }
+
+        CFE_PSP_Sysmon_TakeSample(Sysmon, false);
+
+        /* skip the samples that were missed, if any */
+        PeriodNs = (uint64)Sysmon->SamplePeriodMs * 1000000;
+        Sysmon->NextSampleNs += PeriodNs;
+        if (Sysmon->NextSampleNs <= Now)
+        {
+            Sysmon->NextSampleNs = Now + PeriodNs;
+        }
+    }
+
+    OS_BinSemGive(Sysmon->EventSemId);
+}
+
+/*
+ * Releases everything that CFE_PSP_Sysmon_Start() acquired
+ */
+void CFE_PSP_Sysmon_Cleanup(CFE_PSP_Sysmon_t *Sysmon)
+{
+    /* readers must not see the values of the driver any more once it is closed */
+    CFE_PSP_Sysmon_PublishEmpty(Sysmon);
+    Sysmon->Driver->Close(Sysmon);
+
+    if (OS_ObjectIdDefined(Sysmon->WakeSemId))
+    {
+        OS_BinSemDelete(Sysmon->WakeSemId);
+        Sysmon->WakeSemId = OS_OBJECT_ID_UNDEFINED;
+    }
+    if (OS_ObjectIdDefined(Sysmon->EventSemId))
+    {
+        OS_BinSemDelete(Sysmon->EventSemId);
+        Sysmon->EventSemId = OS_OBJECT_ID_UNDEFINED;
+    }
+}
+
+/*
+ * Creates the semaphores and the sampling task
+ *
+ * Unless the first sample was already taken synchronously, this waits until
+ * the task has taken it, up to CFE_PSP_SYSMON_TASK_TIMEOUT_MS.
+ */
+int32 CFE_PSP_Sysmon_StartTask(CFE_PSP_Sysmon_t *Sysmon)
+{
+    const CFE_PSP_Sysmon_Driver_t *Driver = Sysmon->Driver;
+    char                           SemName[OS_MAX_API_NAME];
+
+    snprintf(SemName, sizeof(SemName), "%.*s-W", (int)sizeof(SemName) - 3, Driver->TaskName);
+    if (OS_BinSemCreate(&Sysmon->WakeSemId, SemName, OS_SEM_EMPTY, 0) != OS_SUCCESS)
+    {
+        Sysmon->WakeSemId = OS_OBJECT_ID_UNDEFINED;
+        return CFE_PSP_ERROR;
+    }
+    snprintf(SemName, sizeof(SemName), "%.*s-E", (int)sizeof(SemName) - 3, Driver->TaskName);
+    if (OS_BinSemCreate(&Sysmon->EventSemId, SemName, OS_SEM_EMPTY, 0) != OS_SUCCESS)
+    {
+        Sysmon->EventSemId = OS_OBJECT_ID_UNDEFINED;
+        return CFE_PSP_ERROR;
+    }
+
+    Sysmon->ShouldRun = true;
+    if (OS_TaskCreate(&Sysmon->TaskId, Driver->TaskName, Driver->TaskEntry, OSAL_TASK_STACK_ALLOCATE,
+                      Driver->TaskStackSize, Driver->TaskPriority, 0) != OS_SUCCESS)
+    {
+        OS_printf("CFE_PSP(%s): Failed to create the sampling task\n", Driver->Name);
+        Sysmon->ShouldRun = false;
+        return CFE_PSP_ERROR;
+    }
+
+    if (!Sysmon->SyncStart)
+    {
+        if (OS_BinSemTimedWait(Sysmon->EventSemId, CFE_PSP_SYSMON_TASK_TIMEOUT_MS) != OS_SUCCESS)
+        {
+            OS_printf("CFE_PSP(%s): Timed out waiting for the first sample\n", Driver->Name);
+
+            Sysmon->ShouldRun = false;
+            OS_TaskDelete(Sysmon->TaskId);
+            return CFE_PSP_ERROR_TIMEOUT;
+        }
+
+        if (Sysmon->NumCpus == 0)
+        {
+            OS_printf("CFE_PSP(%s): Failed to detect number of CPUs\n", Driver->Name);
+
+            /* the task exits by itself in this case */
+            Sysmon->ShouldRun = false;
+            return CFE_PSP_ERROR;
+        }
+    }
+
+    return CFE_PSP_SUCCESS;
+}
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * CFE_PSP_Sysmon_Start()
+ * ------------------------------------------------------
+ *  Starts the cpu load watcher function
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+int32 CFE_PSP_Sysmon_Start(CFE_PSP_Sysmon_t *Sysmon)
+{
+    int32 StatusCode;
+
+    if (Sysmon->IsRunning)
+    {
+        /* already running, nothing to do */
+        return CFE_PSP_SUCCESS;
+    }
+
+    /* start clean, but keep the configuration and the sequence of the snapshots */
+    Sysmon->WindowCount   = 0;
+    Sysmon->NumSamples    = 0;
+    Sysmon->AggregateLoad = 0;
+    memset(&Sysmon->AggregateWindow, 0, sizeof(Sysmon->AggregateWindow));
+
+    StatusCode = Sysmon->Driver->Open(Sysmon);
+    if (StatusCode != CFE_PSP_SUCCESS)
+    {
+        OS_printf("CFE_PSP(%s): Failed to open the CPU load sources\n", Sysmon->Driver->Name);
+    }
+    else
+    {
+        CFE_PSP_Sysmon_HistoryReset(Sysmon);
+
+        if (Sysmon->SyncStart)
+        {
+            /* the task then starts with the first period, so there is nothing to wait for */
+            CFE_PSP_Sysmon_TakeSample(Sysmon, true);
+            CFE_PSP_Sysmon_Schedule(Sysmon);
+        }
+
+        if (Sysmon->SyncStart && Sysmon->NumCpus == 0)
+        {
+            OS_printf("CFE_PSP(%s): Failed to detect number of CPUs\n", Sysmon->Driver->Name);
+            StatusCode = CFE_PSP_ERROR;
+        }
+        else
+        {
+            StatusCode = CFE_PSP_Sysmon_StartTask(Sysmon);
+        }
+    }
+
+    if (StatusCode == CFE_PSP_SUCCESS)
+    {
+        OS_printf("CFE_PSP(%s): Started CPU utilization monitoring on %u CPU(s), %lu ms period\n",
+                  Sysmon->Driver->Name, (unsigned int)Sysmon->NumCpus, (unsigned long)Sysmon->SamplePeriodMs);
+
+        Sysmon->IsRunning = true;
+    }
+    else
+    {
+        /* Clean up */
+        CFE_PSP_Sysmon_Cleanup(Sysmon);
+    }
+
+    return StatusCode;
+}
+
+int32 CFE_PSP_Sysmon_Stop(CFE_PSP_Sysmon_t *Sysmon)
+{
+    if (Sysmon->IsRunning)
+    {
+        Sysmon->ShouldRun = false;
+        Sysmon->IsRunning = false;
+
+        /* let the task exit by itself, so it is not stopped in the middle of a sample */
+        CFE_PSP_Sysmon_Wake(Sysmon);
+        if (OS_BinSemTimedWait(Sysmon->EventSemId, CFE_PSP_SYSMON_TASK_TIMEOUT_MS) != OS_SUCCESS)
+        {
+            OS_TaskDelete(Sysmon->TaskId);
+        }
+
+        CFE_PSP_Sysmon_Cleanup(Sysmon);
+    }
+
+    return CFE_PSP_SUCCESS;
+}
+
+/*
+ * Parses a configuration string as described in sysmon_base.h
+ *
+ * All settings are checked before any is applied, so an invalid
+ * string leaves the configuration unchanged.
+ */
+int32 CFE_PSP_Sysmon_SetConfig(CFE_PSP_Sysmon_t *Sysmon, const char *ConfigStr)
+{
+    uint32        SamplePeriodMs;
+    uint32        WindowSamples;
+    bool          SyncStart;
+    unsigned long Value;
+    const char *  Key;
+    char *        EndPtr;
+    size_t        KeyLen;
+
+    if (ConfigStr == NULL)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    SamplePeriodMs = Sysmon->SamplePeriodMs;
+    WindowSamples  = Sysmon->WindowSamples;
+    SyncStart      = Sysmon->SyncStart;
+
+    while (*ConfigStr != 0)
+    {
+        if (*ConfigStr == ' ' || *ConfigStr == ',')
+        {
+            ++ConfigStr;
+            continue;
+        }
+
+        Key    = ConfigStr;
+        KeyLen = 0;
+        while (Key[KeyLen] != '=' && Key[KeyLen] != 0)
+        {
+            ++KeyLen;
+        }
+        if (Key[KeyLen] != '=' || !isdigit((unsigned char)Key[KeyLen + 1]))
+        {
+            OS_printf("CFE_PSP(%s): Bad configuration setting: %s\n", Sysmon->Driver->Name, Key);
+            return CFE_PSP_ERROR;
+        }
+
+        Value = strtoul(&Key[KeyLen + 1], &EndPtr, 10);
+        if (*EndPtr != 0 && *EndPtr != ' ' && *EndPtr != ',')
+        {
+            OS_printf("CFE_PSP(%s): Bad configuration setting: %s\n", Sysmon->Driver->Name, Key);
+            return CFE_PSP_ERROR;
+        }
+
+        if (KeyLen == 9 && strncmp(Key, "period_ms", KeyLen) == 0 && Value >= CFE_PSP_SYSMON_MIN_PERIOD_MS &&
+            Value <= CFE_PSP_SYSMON_MAX_PERIOD_MS)
+        {
+            SamplePeriodMs = Value;
+        }
+        else if (KeyLen == 6 && strncmp(Key, "window", KeyLen) == 0 && Value >= 1 &&
+                 Value <= CFE_PSP_SYSMON_MAX_WINDOW)
+        {
+            WindowSamples = Value;
+        }
+        else if (KeyLen == 10 && strncmp(Key, "sync_start", KeyLen) == 0 && Value <= 1)
+        {
+            SyncStart = (Value != 0);
+        }
+        else
+        {
+            OS_printf("CFE_PSP(%s): Bad configuration setting: %s\n", Sysmon->Driver->Name, Key);
+            return CFE_PSP_ERROR;
+        }
+
+        ConfigStr = EndPtr;
+    }
+
+    Sysmon->WindowSamples = WindowSamples;
+    Sysmon->SyncStart     = SyncStart;
+    if (SamplePeriodMs != Sysmon->SamplePeriodMs)
+    {
+        Sysmon->SamplePeriodMs = SamplePeriodMs;
+        if (Sysmon->IsRunning)
+        {
+            /* the task reschedules from the last sample */
+            Sysmon->NextSampleNs = Sysmon->LastSampleNs + (uint64)SamplePeriodMs * 1000000;
+            CFE_PSP_Sysmon_Wake(Sysmon);
+        }
+    }
+
+    return CFE_PSP_SUCCESS;
+}
+
+/*
+ * Gets the values of a subsystem in a snapshot, NULL if it has none
+ */
+const CFE_PSP_IODriver_AdcCode_t *CFE_PSP_Sysmon_GetValues(const CFE_PSP_Sysmon_t *       Sysmon,
+                                                           const CFE_PSP_Sysmon_Sample_t *Sample, uint16 Subsystem,
+                                                           uint32 *NumValues)
+{
+    const CFE_PSP_IODriver_AdcCode_t *Values;
+
+    Values     = NULL;
+    *NumValues = 0;
+    if (Subsystem == CFE_PSP_SYSMON_AGGREGATE_SUBSYS)
+    {
+        if (Sample->NumCpus != 0)
+        {
+            Values     = Sample->Aggregate;
+            *NumValues = CFE_PSP_SYSMON_AGGR_NUM_SUBCH;
+        }
+    }
+    else if (Subsystem < CFE_PSP_SYSMON_NUM_BASE_SUBSYS)
+    {
+        Values     = Sample->PerCpu[Subsystem - CFE_PSP_SYSMON_CPULOAD_SUBSYS];
+        *NumValues = Sample->NumCpus;
+    }
+    else if ((uint32)(Subsystem - CFE_PSP_SYSMON_NUM_BASE_SUBSYS) < Sysmon->NumDriverSubsys)
+    {
+        Values     = Sample->Values[Subsystem - CFE_PSP_SYSMON_NUM_BASE_SUBSYS];
+        *NumValues = Sample->NumValues[Subsystem - CFE_PSP_SYSMON_NUM_BASE_SUBSYS];
+    }
+
+    return Values;
+}
+
+/*
+ * Reads channels of a subsystem, all from the current snapshot
+ * This implements both ANALOG_IO_READ_CHANNELS and ANALOG_IO_READ_SNAPSHOT (if Snapshot is not NULL).
+ */
+int32 CFE_PSP_Sysmon_ReadChannels(CFE_PSP_Sysmon_t *Sysmon, uint16 Subsystem, uint16 Subchannel,
+                                  CFE_PSP_IODriver_AnalogRdWr_t *RdWr, CFE_PSP_IODriver_AnalogSnapshot_t *Snapshot)
+{
+    int32                             StatusCode;
+    uint32                            Sequence;
+    uint32                            NumValues;
+    uint64                            TimestampNs;
+    const CFE_PSP_Sysmon_Sample_t *   Sample;
+    const CFE_PSP_IODriver_AdcCode_t *Values;
+
+    if (RdWr == NULL)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    do
+    {
+        Sample = CFE_PSP_Sysmon_ReadBegin(Sysmon, &Sequence);
+        Values = CFE_PSP_Sysmon_GetValues(Sysmon, Sample, Subsystem, &NumValues);
+        if (Values != NULL && Subchannel < NumValues && (Subchannel + RdWr->NumChannels) <= NumValues)
+        {
+            memcpy(RdWr->Samples, &Values[Subchannel], RdWr->NumChannels * sizeof(*Values));
+            TimestampNs = Sample->TimestampNs;
+            StatusCode  = CFE_PSP_SUCCESS;
+        }
+        else
+        {
+            TimestampNs = 0;
+            StatusCode  = CFE_PSP_ERROR;
+        }
+    } while (CFE_PSP_Sysmon_ReadRetry(Sysmon, Sequence));
+
+    if (StatusCode == CFE_PSP_SUCCESS && Snapshot != NULL)
+    {
+        Snapshot->Sequence    = Sequence;
+        Snapshot->TimestampNs = TimestampNs;
+    }
+
+    return StatusCode;
+}
+
+/*
+ * Gets the history of a load and the entries of a ring to read, in the current snapshot
+ * Returns the number of entries, at most MaxEntries (0 for all), and the slot of the oldest one.
+ */
+uint32 CFE_PSP_Sysmon_HistoryEntries(const CFE_PSP_Sysmon_Sample_t *Sample, uint16 Subsystem, uint16 Subchannel,
+                                     uint16 Resolution, uint32 MaxEntries, const CFE_PSP_Sysmon_History_t **History,
+                                     uint32 *FirstSlot)
+{
+    const CFE_PSP_Sysmon_RingPos_t *Pos;
+    uint32                          Channel;
+    uint32                          NumEntries;
+
+    *History = NULL;
+    if (Sample->History == NULL || Resolution >= CFE_PSP_SYSMON_NUM_RINGS)
+    {
+        return 0;
+    }
+
+    if (Subsystem == CFE_PSP_SYSMON_AGGREGATE_SUBSYS && Subchannel == CFE_PSP_SYSMON_AGGR_CPULOAD_SUBCH &&
+        Sample->NumCpus != 0)
+    {
+        Channel = 0;
+    }
+    else if (Subsystem == CFE_PSP_SYSMON_CPULOAD_SUBSYS && Subchannel < Sample->NumCpus)
+    {
+        Channel = 1 + Subchannel;
+    }
+    else
+    {
+        return 0;
+    }
+
+    Pos        = &Sample->Rings[Resolution];
+    NumEntries = Pos->Count;
+    if (MaxEntries != 0 && NumEntries > MaxEntries)
+    {
+        NumEntries = MaxEntries;
+    }
+
+    *History   = &Sample->History[Channel];
+    *FirstSlot = (Pos->Head + CFE_PSP_Sysmon_RingSlots[Resolution] - NumEntries + 1) % CFE_PSP_Sysmon_RingSlots[Resolution];
+
+    return NumEntries;
+}
+
+/*
+ * Reads the history of one load, as of the current snapshot
+ */
+int32 CFE_PSP_Sysmon_ReadHistory(CFE_PSP_Sysmon_t *Sysmon, uint16 Subsystem, uint16 Subchannel,
+                                 CFE_PSP_IODriver_AnalogHistory_t *Request)
+{
+    const CFE_PSP_Sysmon_Sample_t * Sample;
+    const CFE_PSP_Sysmon_History_t *History;
+    const CFE_PSP_Sysmon_Entry_t *  Entry;
+    uint32                          Sequence;
+    uint32                          NumEntries;
+    uint32                          FirstSlot;
+    uint32                          Slot;
+    uint32                          i;
+
+    if (Request == NULL || (Request->Entries == NULL && Request->MaxEntries != 0))
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    do
+    {
+        Sample     = CFE_PSP_Sysmon_ReadBegin(Sysmon, &Sequence);
+        NumEntries = CFE_PSP_Sysmon_HistoryEntries(Sample, Subsystem, Subchannel, Request->Resolution,
+                                                   Request->MaxEntries, &History, &FirstSlot);
+        if (Request->MaxEntries == 0)
+        {
+            NumEntries = 0;
+        }
+        for (i = 0; i < NumEntries; ++i)
+        {
+            Slot  = CFE_PSP_Sysmon_RingOffset[Request->Resolution] +
+                   (FirstSlot + i) % CFE_PSP_Sysmon_RingSlots[Request->Resolution];
+            Entry = &History->Slots[Slot];
+
+            Request->Entries[i].TimestampNs = Sysmon->HistoryTimestampNs[Slot];
+            Request->Entries[i].Min         = Entry->Min;
+            Request->Entries[i].Mean        = Entry->Mean;
+            Request->Entries[i].Max         = Entry->Max;
+        }
+    } while (CFE_PSP_Sysmon_ReadRetry(Sysmon, Sequence));
+
+    if (History == NULL)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    Request->NumEntries = NumEntries;
+    return CFE_PSP_SUCCESS;
+}
+
+/*
+ * Gets the distribution of one load over its recent history, as of the current snapshot
+ *
+ * The values are copied within the read, and sorted afterwards, so the
+ * sampling never waits for the sort.
+ */
+int32 CFE_PSP_Sysmon_ReadPercentiles(CFE_PSP_Sysmon_t *Sysmon, uint16 Subsystem, uint16 Subchannel,
+                                     CFE_PSP_IODriver_AnalogPercentiles_t *Request)
+{
+    const CFE_PSP_Sysmon_Sample_t * Sample;
+    const CFE_PSP_Sysmon_History_t *History;
+    const CFE_PSP_Sysmon_Entry_t *  Entry;
+    CFE_PSP_IODriver_AdcCode_t      Values[CFE_PSP_SYSMON_HISTORY_SLOTS];
+    CFE_PSP_IODriver_AdcCode_t      Value;
+    CFE_PSP_IODriver_AdcCode_t      Min;
+    CFE_PSP_IODriver_AdcCode_t      Max;
+    uint32                          Sequence;
+    uint32                          NumEntries;
+    uint32                          FirstSlot;
+    uint32                          Slot;
+    uint32                          i;
+    uint32                          j;
+
+    if (Request == NULL)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    do
+    {
+        Sample     = CFE_PSP_Sysmon_ReadBegin(Sysmon, &Sequence);
+        NumEntries = CFE_PSP_Sysmon_HistoryEntries(Sample, Subsystem, Subchannel, Request->Resolution,
+                                                   Request->WindowEntries, &History, &FirstSlot);
+        Min        = 0;
+        Max        = 0;
+        for (i = 0; i < NumEntries; ++i)
+        {
+            Slot  = CFE_PSP_Sysmon_RingOffset[Request->Resolution] +
+                   (FirstSlot + i) % CFE_PSP_Sysmon_RingSlots[Request->Resolution];
+            Entry = &History->Slots[Slot];
+
+            Values[i] = Entry->Mean;
+            if (i == 0 || Entry->Min < Min)
+            {
+                Min = Entry->Min;
+            }
+            if (i == 0 || Entry->Max > Max)
+            {
+                Max = Entry->Max;
+            }
+        }
+    } while (CFE_PSP_Sysmon_ReadRetry(Sysmon, Sequence));
+
+    if (NumEntries == 0)
+    {
+        /* no such load, or nothing in its history yet */
+        return CFE_PSP_ERROR;
+    }
+
+    /* insertion sort, there are few values */
+    for (i = 1; i < NumEntries; ++i)
+    {
+        Value = Values[i];
+        for (j = i; j > 0 && Values[j - 1] > Value; --j)
+        {
+            Values[j] = Values[j - 1];
+        }
+        Values[j] = Value;
+    }
+
+    /* nearest rank: the smallest value that at least P percent of the values do not exceed */
+    Request->NumEntries = NumEntries;
+    Request->Min        = Min;
+    Request->P50        = Values[(50 * NumEntries + 99) / 100 - 1];
+    Request->P95        = Values[(95 * NumEntries + 99) / 100 - 1];
+    Request->P99        = Values[(99 * NumEntries + 99) / 100 - 1];
+    Request->Max        = Max;
+
+    return CFE_PSP_SUCCESS;
+}
+
+/*
+ * Looks up a name in a NULL terminated table, returns its index or CFE_PSP_ERROR
+ */
+int32 CFE_PSP_Sysmon_LookupName(const char *const *Names, const char *Name)
+{
+    int32 i;
+
+    if (Names != NULL && Name != NULL)
+    {
+        for (i = 0; Names[i] != NULL; ++i)
+        {
+            if (strcmp(Name, Names[i]) == 0)
+            {
+                return i;
+            }
+        }
+    }
+
+    return CFE_PSP_ERROR;
+}
+
+/*
+ * Handles the commands of the "aggregate" subsystem that control the whole device
+ */
+int32 CFE_PSP_Sysmon_DeviceCommand(CFE_PSP_Sysmon_t *Sysmon, uint32 CommandCode, CFE_PSP_IODriver_Arg_t Arg)
+{
+    int32 StatusCode;
+
+    StatusCode = CFE_PSP_ERROR_NOT_IMPLEMENTED;
+    switch (CommandCode)
+    {
+        /* Start/stop opcodes */
+        case CFE_PSP_IODriver_SET_RUNNING: /**< int32_t argument, 0=stop 1=start device */
+        {
+            if (Arg.U32)
+            {
+                StatusCode = CFE_PSP_Sysmon_Start(Sysmon);
+            }
+            else
+            {
+                StatusCode = CFE_PSP_Sysmon_Stop(Sysmon);
+            }
+            break;
+        }
+        case CFE_PSP_IODriver_GET_RUNNING: /**< no argument, returns positive nonzero (true) if running and zero (false)
+                                              if stopped, negative on error */
+        {
+            StatusCode = Sysmon->IsRunning;
+            break;
+        }
+        case CFE_PSP_IODriver_SET_CONFIGURATION: /**< const string argument (device-dependent content) */
+        {
+            StatusCode = CFE_PSP_Sysmon_SetConfig(Sysmon, Arg.ConstStr);
+            break;
+        }
+        case CFE_PSP_IODriver_GET_CONFIGURATION: /**< void * argument (device-dependent content) */
+        {
+            CFE_PSP_Sysmon_Config_t *Config = Arg.Vptr;
+
+            if (Config != NULL)
+            {
+                Config->SamplePeriodMs = Sysmon->SamplePeriodMs;
+                Config->WindowSamples  = Sysmon->WindowSamples;
+                Config->SyncStart      = Sysmon->SyncStart;
+                StatusCode             = CFE_PSP_SUCCESS;
+            }
+            break;
+        }
+        case CFE_PSP_IODriver_LOOKUP_SUBSYSTEM: /**< const char * argument, looks up name and returns positive
+                                                    value for subsystem number, negative value for error */
+        {
+            uint16 i;
+
+            StatusCode = CFE_PSP_ERROR;
+            for (i = 0; Arg.ConstStr != NULL && i < (CFE_PSP_SYSMON_NUM_BASE_SUBSYS + Sysmon->NumDriverSubsys); ++i)
+            {
+                if (strcmp(Arg.ConstStr, (i < CFE_PSP_SYSMON_NUM_BASE_SUBSYS)
+                                             ? CFE_PSP_Sysmon_SubsystemNames[i]
+                                             : Sysmon->Driver->SubsystemNames[i - CFE_PSP_SYSMON_NUM_BASE_SUBSYS]) == 0)
+                {
+                    StatusCode = i;
+                    break;
+                }
+            }
+            break;
+        }
+        case CFE_PSP_IODriver_LOOKUP_SUBCHANNEL: /**< const char * argument, looks up name and returns positive
+                                                    value for channel number, negative value for error */
+        {
+            StatusCode = CFE_PSP_Sysmon_LookupName(CFE_PSP_Sysmon_AggregateNames, Arg.ConstStr);
+            break;
+        }
+        case CFE_PSP_IODriver_QUERY_DIRECTION: /**< CFE_PSP_IODriver_Direction_t argument */
+        {
+            CFE_PSP_IODriver_Direction_t *DirPtr = (CFE_PSP_IODriver_Direction_t *)Arg.Vptr;
+            if (DirPtr != NULL)
+            {
+                *DirPtr    = CFE_PSP_IODriver_Direction_INPUT_ONLY;
+                StatusCode = CFE_PSP_SUCCESS;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    return StatusCode;
+}
+
+int32 CFE_PSP_Sysmon_DevLock(uint32 CommandCode, uint16 Subsystem, uint16 Subchannel, CFE_PSP_IODriver_Arg_t Arg)
+{
+    int32 Lock;
+
+    switch (CommandCode)
+    {
+        case CFE_PSP_IODriver_SET_RUNNING:
+        case CFE_PSP_IODriver_SET_CONFIGURATION:
+        {
+            /* these start and stop the task, and change its configuration */
+            Lock = CFE_PSP_IODriver_LockExclusive(0);
+            break;
+        }
+        case CFE_PSP_IODriver_GET_CONFIGURATION:
+        {
+            /* the settings are only consistent with each other between changes */
+            Lock = CFE_PSP_IODriver_LockShared(0);
+            break;
+        }
+        default:
+        {
+            /* reads of the snapshots need no lock, their storage is never released */
+            Lock = CFE_PSP_IODRIVER_LOCK_NONE;
+            break;
+        }
+    }
+
+    return Lock;
+}
+
+int32 CFE_PSP_Sysmon_DevCmd(CFE_PSP_Sysmon_t *Sysmon, uint32 CommandCode, uint16 Subsystem, uint16 Subchannel,
+                            CFE_PSP_IODriver_Arg_t Arg)
+{
+    int32 StatusCode;
+
+    StatusCode = CFE_PSP_ERROR_NOT_IMPLEMENTED;
+    if (Sysmon->Driver->Command != NULL)
+    {
+        StatusCode = Sysmon->Driver->Command(Sysmon, CommandCode, Subsystem, Subchannel, Arg);
+    }
+    if (StatusCode != CFE_PSP_ERROR_NOT_IMPLEMENTED ||
+        Subsystem >= (CFE_PSP_SYSMON_NUM_BASE_SUBSYS + Sysmon->NumDriverSubsys))
+    {
+        return StatusCode;
+    }
+
+    switch (CommandCode)
+    {
+        case CFE_PSP_IODriver_NOOP:
+        case CFE_PSP_IODriver_ANALOG_IO_NOOP:
+        {
+            /* NO-OP should return success -
+             * This is a required opcode as "generic" clients may use it to
+             * determine if a certain set of opcodes are supported or not
+             */
+            StatusCode = CFE_PSP_SUCCESS;
+            break;
+        }
+        case CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS:
+        {
+            StatusCode = CFE_PSP_Sysmon_ReadChannels(Sysmon, Subsystem, Subchannel, Arg.Vptr, NULL);
+            break;
+        }
+        case CFE_PSP_IODriver_ANALOG_IO_READ_SNAPSHOT:
+        {
+            CFE_PSP_IODriver_AnalogSnapshot_t *Snapshot = Arg.Vptr;
+
+            StatusCode = CFE_PSP_ERROR;
+            if (Snapshot != NULL)
+            {
+                StatusCode = CFE_PSP_Sysmon_ReadChannels(Sysmon, Subsystem, Subchannel, &Snapshot->RdWr, Snapshot);
+            }
+            break;
+        }
+        case CFE_PSP_IODriver_ANALOG_IO_READ_HISTORY:
+        case CFE_PSP_IODriver_ANALOG_IO_READ_PERCENTILES:
+        {
+            /* only the loads have a history */
+            if (Subsystem == CFE_PSP_SYSMON_AGGREGATE_SUBSYS || Subsystem == CFE_PSP_SYSMON_CPULOAD_SUBSYS)
+            {
+                if (CommandCode == CFE_PSP_IODriver_ANALOG_IO_READ_HISTORY)
+                {
+                    StatusCode = CFE_PSP_Sysmon_ReadHistory(Sysmon, Subsystem, Subchannel, Arg.Vptr);
+                }
+                else
+                {
+                    StatusCode = CFE_PSP_Sysmon_ReadPercentiles(Sysmon, Subsystem, Subchannel, Arg.Vptr);
+                }
+            }
+            break;
+        }
+        case CFE_PSP_IODriver_LOOKUP_SUBCHANNEL: /**< const char * argument, looks up name and returns
+                                                    subchannel number, negative value for error */
+        {
+            if (Subsystem >= CFE_PSP_SYSMON_NUM_BASE_SUBSYS && Sysmon->Driver->SubchannelNames != NULL &&
+                Sysmon->Driver->SubchannelNames[Subsystem - CFE_PSP_SYSMON_NUM_BASE_SUBSYS] != NULL)
+            {
+                StatusCode = CFE_PSP_Sysmon_LookupName(
+                    Sysmon->Driver->SubchannelNames[Subsystem - CFE_PSP_SYSMON_NUM_BASE_SUBSYS], Arg.ConstStr);
+                break;
+            }
+        }
+        /* fall through */
+        default:
+        {
+            if (Subsystem == CFE_PSP_SYSMON_AGGREGATE_SUBSYS)
+            {
+                StatusCode = CFE_PSP_Sysmon_DeviceCommand(Sysmon, CommandCode, Arg);
+            }
+            break;
+        }
+    }
+
+    return StatusCode;
+}
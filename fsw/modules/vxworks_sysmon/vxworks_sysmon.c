@@ -22,8 +22,6 @@
  ************************************************************************/
 #include "cfe_psp.h"
 
-#include "iodriver_impl.h"
-#include "iodriver_analog_io.h"
 #include <stdarg.h>
 #include <spyLib.h>
 #include <private/spyLibP.h>
@@ -37,15 +35,26 @@ static void vxworks_sysmon_Init(uint32_t local_module_id);
 /********************************************************************
  * Global Data
  ********************************************************************/
+static CFE_PSP_IODriver_Lock_t vxworks_sysmon_locks[CFE_PSP_SYSMON_NUM_LOCKS];
+
 /* vxworks_sysmon device command that is called by iodriver to start up vxworks_sysmon */
-CFE_PSP_IODriver_API_t vxworks_sysmon_DevApi = {.DeviceCommand = vxworks_sysmon_DevCmd};
+CFE_PSP_IODriver_API_t vxworks_sysmon_DevApi = {.DeviceCommand = vxworks_sysmon_DevCmd,
+                                               .DeviceLock    = CFE_PSP_Sysmon_DevLock,
+                                               .Locks         = vxworks_sysmon_locks,
+                                               .NumLocks      = CFE_PSP_SYSMON_NUM_LOCKS};
 
 CFE_PSP_MODULE_DECLARE_IODEVICEDRIVER(vxworks_sysmon);
 
 vxworks_sysmon_state_t vxworks_sysmon_global;
 
-static const char *vxworks_sysmon_subsystem_names[]  = {"aggregate", "per-cpu", NULL};
-static const char *vxworks_sysmon_subchannel_names[] = {"cpu-load", NULL};
+static const CFE_PSP_Sysmon_Driver_t vxworks_sysmon_driver = {.Name          = "vxworks_sysmon",
+                                                              .TaskEntry     = vxworks_sysmon_Task,
+                                                              .TaskName      = VXWORKS_SYSMON_TASK_NAME,
+                                                              .TaskStackSize = VXWORKS_SYSMON_STACK_SIZE,
+                                                              .TaskPriority  = VXWORKS_SYSMON_TASK_PRIORITY,
+                                                              .Open          = vxworks_sysmon_Open,
+                                                              .Collect       = vxworks_sysmon_Collect,
+                                                              .Close         = vxworks_sysmon_Close};
 
 /***********************************************************************
  * Global Functions
@@ -54,12 +63,15 @@ void vxworks_sysmon_Init(uint32_t local_module_id)
 {
     memset(&vxworks_sysmon_global, 0, sizeof(vxworks_sysmon_global));
     vxworks_sysmon_global.local_module_id = local_module_id;
+
+    CFE_PSP_Sysmon_InitState(&vxworks_sysmon_global.sysmon, &vxworks_sysmon_driver);
 }
 
 int vxworks_sysmon_update_stat(const char *fmt, ...)
 {
     vxworks_sysmon_cpuload_state_t *state = &vxworks_sysmon_global.cpu_load;
     vxworks_sysmon_cpuload_core_t *core_p = &state->per_core[state->num_cpus];
+    CFE_PSP_Sysmon_Cpu_t          *cpu_p  = &state->cpus[state->num_cpus];
 
     int curr_load;
     va_list arg;
@@ -93,22 +105,13 @@ int vxworks_sysmon_update_stat(const char *fmt, ...)
             core_p->idle_state.idle_ticks_since_last_report = va_arg(arg, int);
 
             curr_load = VXWORKS_SYSMON_MAX_SCALE - core_p->idle_state.idle_percent_since_last_report;
-
-            if (curr_load >= 100)
-            {
-                core_p->avg_load = 0xFFFFFF; /* max */
-            }
-            else if (curr_load <= 0)
-            {
-                core_p->avg_load = 0;
-            }
-            else
+            if (curr_load < 0)
             {
-                core_p->avg_load = (0x1000 * curr_load) / VXWORKS_SYSMON_MAX_SCALE ;
-                core_p->avg_load |= (core_p->avg_load << 12); /* Expand from 12->24 bit */
+                curr_load = 0;
             }
+            cpu_p->Load = CFE_PSP_Sysmon_ScaleLoad(curr_load, VXWORKS_SYSMON_MAX_SCALE);
 
-            VXWORKS_SYSMON_DEBUG("CFE_PSP(vxworks_sysmon): load=%06x\n", (unsigned int)core_p->avg_load);
+            VXWORKS_SYSMON_DEBUG("CFE_PSP(vxworks_sysmon): load=%06x\n", (unsigned int)cpu_p->Load);
             VXWORKS_SYSMON_DEBUG("Name: %s, Total Percent: %d, Total Ticks: %d, Idle Percent: %d, Idle Ticks: %d\n",
                                  core_p->idle_state.name,
                                  core_p->idle_state.total_idle_percent,
@@ -127,13 +130,23 @@ int vxworks_sysmon_update_stat(const char *fmt, ...)
 }
 
 void vxworks_sysmon_Task(void)
+{
+    CFE_PSP_Sysmon_Run(&vxworks_sysmon_global.sysmon);
+}
+
+/*
+ * Starts the spy on the idle time of the CPUs, as the Open function of the sysmon engine
+ */
+int32_t vxworks_sysmon_Open(CFE_PSP_Sysmon_t *sysmon)
 {
     int status;
     vxworks_sysmon_cpuload_state_t *state = &vxworks_sysmon_global.cpu_load;
 
     /* Initialize */
     spyLibInit(VXWORKS_SYSMON_MAX_SPY_TASKS);
-    memset(state->per_core, 0, VXWORKS_SYSMON_MAX_CPUS * sizeof(vxworks_sysmon_cpuload_core_t));
+    memset(state, 0, sizeof(*state));
+    CFE_PSP_Sysmon_SetCpuStorage(sysmon, VXWORKS_SYSMON_MAX_CPUS, state->cpus, state->snapshot_values);
+    CFE_PSP_Sysmon_SetHistoryStorage(sysmon, state->history);
 
     /* 
     ** Begin collecting data by enabling the auxilary clock interrupts at a frequency of interrupts per 
@@ -142,243 +155,34 @@ void vxworks_sysmon_Task(void)
     status = spyClkStartCommon(VXWORKS_AUX_CLOCK_INTERRUPT_FREQ, (FUNCPTR)OS_printf);
     if (status != OK)
     {
-        state->should_run = false;
-        state->is_running = false;
         OS_printf("CFE_PSP(vxworks_sysmon): Error Initializing Auxillary Clock: Status %d\n", status);
+        return CFE_PSP_ERROR;
     }
 
-    while (state->should_run)
-    {
-        OS_TaskDelay(VXWORKS_SYSMON_SAMPLE_DELAY);
-
-        state->num_cpus = 0;
-        spyReportCommon( (FUNCPTR)vxworks_sysmon_update_stat);
-    }
-
-    spyClkStopCommon(); /* Disable auxillary clock interrupts */
-
-}
-
-/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
- * vxworks_sysmon_Start()
- * ------------------------------------------------------
- *  Starts the cpu load watcher function
- *
- * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
-int32_t vxworks_sysmon_Start(vxworks_sysmon_cpuload_state_t *state)
-{
-    uint32_t  StatusCode;
-
-    if (state->is_running)
-    {
-        /* already running, nothing to do */
-        StatusCode = CFE_PSP_SUCCESS;
-    }
-    else
-    {
-        /* start clean */
-        memset(state, 0, sizeof(*state));
-        state->should_run = true;
-        StatusCode = OS_TaskCreate(&state->task_id, 
-                                   VXWORKS_SYSMON_TASK_NAME, 
-                                   vxworks_sysmon_Task,
-                                   NULL, 
-                                   VXWORKS_SYSMON_STACK_SIZE, 
-                                   VXWORKS_SYSMON_TASK_PRIORITY, 
-                                   0);
-        if(StatusCode !=  OS_SUCCESS)
-        {
-            perror("vxworks_task_create()");
-            StatusCode = CFE_PSP_ERROR;
-            state->should_run = false;
-        }
-        else
-        {
-
-            OS_printf("CFE_PSP(VXWORKS_SYSMON): Started CPU utilization monitoring\n");
-            state->is_running = true;
-            StatusCode        = CFE_PSP_SUCCESS;
-        } 
-    }
-    return StatusCode;
-}
-
-int32_t vxworks_sysmon_Stop(vxworks_sysmon_cpuload_state_t *state)
-{
-    if (state->is_running)
-    {
-        state->should_run = false;
-        state->is_running = false;
-        OS_TaskDelete(state->task_id);
-
-        spyClkStopCommon(); /* Disable auxillary clock interrupts */
-    }
-
-    return CFE_PSP_SUCCESS;
-}
-
-int32_t vxworks_sysmon_calc_aggregate_cpu(vxworks_sysmon_cpuload_state_t *state, CFE_PSP_IODriver_AdcCode_t *Val)
-{
-
-    uint8_t  cpu;
-    uint32_t sum;
-
-    sum = 0;
-    for (cpu = 0; cpu < VXWORKS_SYSMON_MAX_CPUS; cpu++ )
-    {
-        sum += state->per_core[cpu].avg_load; 
-    }
-
-    sum /= VXWORKS_SYSMON_MAX_CPUS;
-    *Val = sum;
-
-    VXWORKS_SYSMON_DEBUG("CFE_PSP(vxworks_sysmon): Aggregate CPU load=%08X\n", (unsigned int)sum);
-
     return CFE_PSP_SUCCESS;
 }
 
-int32_t vxworks_sysmon_aggregate_dispatch(uint32_t CommandCode, uint16_t Subchannel, CFE_PSP_IODriver_Arg_t Arg)
+/*
+ * Gets the loads since the last report, as the Collect function of the sysmon engine
+ *
+ * Every CPU is reported, a CPU without an IDLE line in the report keeps its last load.
+ */
+uint32_t vxworks_sysmon_Collect(CFE_PSP_Sysmon_t *sysmon, CFE_PSP_Sysmon_Sample_t *sample, uint64_t elapsed_ns)
 {
-    int32_t                       StatusCode;
-    vxworks_sysmon_cpuload_state_t *state;
-
-    /* There is just one global cpuload object */
-    state      = &vxworks_sysmon_global.cpu_load;
-    
-    StatusCode = CFE_PSP_ERROR_NOT_IMPLEMENTED;
-    switch (CommandCode)
-    {
-        case CFE_PSP_IODriver_NOOP:
-        case CFE_PSP_IODriver_ANALOG_IO_NOOP:
-            VXWORKS_SYSMON_DEBUG("CFE_PSP(vxworks_sysmon): Noop \n");
-            break;
-        case CFE_PSP_IODriver_SET_RUNNING: 
-        {
-            if (Arg.U32)
-            {
-                StatusCode = vxworks_sysmon_Start(state);
-            }
-            else
-            {
-                StatusCode = vxworks_sysmon_Stop(state);
-            }
-            break;
-        }
-        case CFE_PSP_IODriver_GET_RUNNING:                                    
-        {
-            StatusCode = state->is_running;
-            break;
-        }
-        case CFE_PSP_IODriver_SET_CONFIGURATION: /**< const string argument (device-dependent content) */
-        case CFE_PSP_IODriver_GET_CONFIGURATION: /**< void * argument (device-dependent content) */
-        {
-            /* not implemented for now */
-            break;
-        }
-        case CFE_PSP_IODriver_LOOKUP_SUBSYSTEM: /**< const char * argument, looks up name and returns positive
-                                                    value for subsystem number, negative value for error */
-        {
-            uint16_t i;
-
-            for (i = 0; vxworks_sysmon_subsystem_names[i] != NULL; ++i)
-            {
-                if (strcmp(Arg.ConstStr, vxworks_sysmon_subsystem_names[i]) == 0)
-                {
-                    StatusCode = i;
-                    break;
-                }
-            }
-
-            break;
-        }
-        case CFE_PSP_IODriver_LOOKUP_SUBCHANNEL: /**< const char * argument, looks up name and returns positive
-                                                    value for channel number, negative value for error */
-        {
-            uint16_t i;
-
-            for (i = 0; vxworks_sysmon_subchannel_names[i] != NULL; ++i)
-            {
-                if (strcmp(Arg.ConstStr, vxworks_sysmon_subchannel_names[i]) == 0)
-                {
-                    StatusCode = i;
-                    break;
-                }
-            }
-
-            break;
-        }
-        case CFE_PSP_IODriver_QUERY_DIRECTION: /**< CFE_PSP_IODriver_Direction_t argument */
-        {
-            CFE_PSP_IODriver_Direction_t *DirPtr = (CFE_PSP_IODriver_Direction_t *)Arg.Vptr;
-            if (DirPtr != NULL)
-            {
-                *DirPtr    = CFE_PSP_IODriver_Direction_INPUT_ONLY;
-                StatusCode = CFE_PSP_SUCCESS;
-            }
-            break;
-        }
-        case CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS:
-        {
-            CFE_PSP_IODriver_AnalogRdWr_t *RdWr = Arg.Vptr;
+    vxworks_sysmon_cpuload_state_t *state = &vxworks_sysmon_global.cpu_load;
 
-            if (RdWr->NumChannels == 1 && Subchannel == VXWORKS_SYSMON_AGGR_CPULOAD_SUBCH)
-            {
-                StatusCode = vxworks_sysmon_calc_aggregate_cpu(state, RdWr->Samples);
-            }
-            break;
-        }
-        default:
-            break;
-    }
+    state->num_cpus = 0;
+    spyReportCommon( (FUNCPTR)vxworks_sysmon_update_stat);
 
-    return StatusCode;
+    return VXWORKS_SYSMON_MAX_CPUS;
 }
 
-int32_t vxworks_sysmon_cpu_load_dispatch(uint32_t CommandCode, uint16_t Subchannel, CFE_PSP_IODriver_Arg_t Arg)
+/*
+ * Stops the spy, as the Close function of the sysmon engine
+ */
+void vxworks_sysmon_Close(CFE_PSP_Sysmon_t *sysmon)
 {
-    int32_t                       StatusCode;
-    vxworks_sysmon_cpuload_state_t *state;
-
-    /* There is just one global cpuload object */
-    state      = &vxworks_sysmon_global.cpu_load;
-    StatusCode = CFE_PSP_ERROR_NOT_IMPLEMENTED;
-    switch (CommandCode)
-    {
-        case CFE_PSP_IODriver_NOOP:
-        case CFE_PSP_IODriver_ANALOG_IO_NOOP:
-        {
-            /* NO-OP should return success -
-             * This is a required opcode as "generic" clients may use it to
-             * determine if a certain set of opcodes are supported or not
-             */
-            StatusCode = CFE_PSP_SUCCESS;
-            break;
-        }
-        case CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS:
-        {
-            CFE_PSP_IODriver_AnalogRdWr_t *RdWr = Arg.Vptr;
-            uint32_t                       ch;
-
-            if (Subchannel < VXWORKS_SYSMON_MAX_CPUS && (Subchannel + RdWr->NumChannels) <= VXWORKS_SYSMON_MAX_CPUS)
-            {
-                for (ch = Subchannel; ch < (Subchannel + RdWr->NumChannels); ++ch)
-                {
-                    RdWr->Samples[ch] = state->per_core[ch].avg_load;
-                }
-                StatusCode = CFE_PSP_SUCCESS;
-            }
-            else
-            {
-                StatusCode = CFE_PSP_ERROR;
-            }
-
-            break;
-        }
-        default:
-            break;
-    }
-
-    return StatusCode;
+    spyClkStopCommon(); /* Disable auxillary clock interrupts */
 }
 
 /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
@@ -401,23 +205,8 @@ int32_t vxworks_sysmon_cpu_load_dispatch(uint32_t CommandCode, uint16_t Subchann
  * \retval #CFE_PSP_SUCCESS if successful
  */
 int32_t vxworks_sysmon_DevCmd(uint32_t CommandCode, uint16_t SubsystemId, uint16_t SubchannelId,
-                            CFE_PSP_IODriver_Arg_t Arg)
+                              CFE_PSP_IODriver_Arg_t Arg)
 {
-    int32_t StatusCode;
-
-    StatusCode = CFE_PSP_ERROR_NOT_IMPLEMENTED;
-    switch (SubsystemId)
-    {
-        case VXWORKS_SYSMON_AGGREGATE_SUBSYS:
-            StatusCode = vxworks_sysmon_aggregate_dispatch(CommandCode, SubchannelId, Arg);
-            break;
-        case VXWORKS_SYSMON_CPULOAD_SUBSYS:
-            StatusCode = vxworks_sysmon_cpu_load_dispatch(CommandCode, SubchannelId, Arg);
-            break;
-        default:
-            /* not implemented */
-            break;
-    }
-
-    return StatusCode;
+    /* There is just one global sysmon object */
+    return CFE_PSP_Sysmon_DevCmd(&vxworks_sysmon_global.sysmon, CommandCode, SubsystemId, SubchannelId, Arg);
 }
@@ -25,6 +25,8 @@
 #ifndef VXWORKS_SYSMON_H_
 #define VXWORKS_SYSMON_H_
 
+#include "sysmon_impl.h"
+
 /********************************************************************
  * Local Defines
  ********************************************************************/
@@ -34,10 +36,6 @@
     #define VXWORKS_SYSMON_MAX_CPUS  1
 #endif
 
-#define VXWORKS_SYSMON_AGGREGATE_SUBSYS   0
-#define VXWORKS_SYSMON_CPULOAD_SUBSYS     1
-#define VXWORKS_SYSMON_AGGR_CPULOAD_SUBCH 0
-#define VXWORKS_SYSMON_SAMPLE_DELAY       1000
 #define VXWORKS_SYSMON_TASK_PRIORITY      100
 #define VXWORKS_SYSMON_STACK_SIZE         4096
 #define VXWORKS_AUX_CLOCK_INTERRUPT_FREQ  100  /* Frequency to collect data (interrupts per second) */
@@ -67,27 +65,29 @@ typedef struct vxworks_sysmon_va_arg
 
 typedef struct vxworks_sysmon_cpuload_core
 {
-    CFE_PSP_IODriver_AdcCode_t avg_load;
-
     vxworks_sysmon_va_arg_t idle_state;
 } vxworks_sysmon_cpuload_core_t;
 
+/*
+ * Sampling state of the driver, only used by the sampling
+ * The loads are in cpus, the rest of each sample belongs to the sysmon engine.
+ */
 typedef struct vxworks_sysmon_cpuload_state
 {
-    volatile bool is_running;
-    volatile bool should_run;
-
-    osal_id_t   task_id;
-
     uint8_t    num_cpus;
 
     vxworks_sysmon_cpuload_core_t per_core[VXWORKS_SYSMON_MAX_CPUS];
+    CFE_PSP_Sysmon_Cpu_t          cpus[VXWORKS_SYSMON_MAX_CPUS];
+
+    CFE_PSP_IODriver_AdcCode_t snapshot_values[CFE_PSP_SYSMON_CPU_STORAGE_SIZE(VXWORKS_SYSMON_MAX_CPUS)];
+    CFE_PSP_Sysmon_History_t   history[CFE_PSP_SYSMON_HISTORY_STORAGE_SIZE(VXWORKS_SYSMON_MAX_CPUS)];
 
 } vxworks_sysmon_cpuload_state_t;
 
 typedef struct vxworks_sysmon_state
 {
-    uint32_t                     local_module_id;
+    uint32_t                       local_module_id;
+    CFE_PSP_Sysmon_t               sysmon;
     vxworks_sysmon_cpuload_state_t cpu_load;
 } vxworks_sysmon_state_t;
 
@@ -97,14 +97,12 @@ typedef struct vxworks_sysmon_state
 int vxworks_sysmon_update_stat(const char *fmt, ...);
 void vxworks_sysmon_Task(void);
 
-int32_t vxworks_sysmon_Start(vxworks_sysmon_cpuload_state_t *state);
-int32_t vxworks_sysmon_Stop(vxworks_sysmon_cpuload_state_t *state);
-
-int32_t vxworks_sysmon_aggregate_dispatch(uint32_t CommandCode, uint16_t Subchannel, CFE_PSP_IODriver_Arg_t Arg);
-int32_t vxworks_sysmon_calc_aggregate_cpu(vxworks_sysmon_cpuload_state_t *state, CFE_PSP_IODriver_AdcCode_t *Val);
+int32_t  vxworks_sysmon_Open(CFE_PSP_Sysmon_t *sysmon);
+uint32_t vxworks_sysmon_Collect(CFE_PSP_Sysmon_t *sysmon, CFE_PSP_Sysmon_Sample_t *sample, uint64_t elapsed_ns);
+void     vxworks_sysmon_Close(CFE_PSP_Sysmon_t *sysmon);
 
 /* Function that starts up vxworks_sysmon driver. */
 int32_t vxworks_sysmon_DevCmd(uint32_t CommandCode, uint16_t SubsystemId, uint16_t SubchannelId,
-                                   CFE_PSP_IODriver_Arg_t Arg);
+                              CFE_PSP_IODriver_Arg_t Arg);
 
 #endif /* VXWORKS_SYSMON_H_ */
@@ -25,6 +25,8 @@
 #include <time.h>
 #include <pthread.h>
 
+#include "cfe_psp_exception_context.h"
+
 /*
 ** This define sets the number of memory ranges that are defined in the memory range definition
 ** table.
@@ -36,9 +38,18 @@
  * that can be stored.
  *
  * It must always be a power of two.
+ * Normally set by the build system from PSP_LINUX_EXCEPTION_ENTRIES.
+ */
+#ifndef CFE_PSP_MAX_EXCEPTION_ENTRIES
+#define CFE_PSP_MAX_EXCEPTION_ENTRIES 16
+#endif
+
+/**
+ * Maximum number of loaded objects (executable and shared libraries)
+ * tracked for exception reporting.  Objects loaded beyond this limit
+ * are not reported in the exception context.
  */
-#define CFE_PSP_MAX_EXCEPTION_ENTRIES        4
-#define CFE_PSP_MAX_EXCEPTION_BACKTRACE_SIZE 16
+#define CFE_PSP_MAX_LOADMAP_MODULES 64
 
 /*
  * A random 32-bit value that is used as the "validity flag"
@@ -111,22 +122,10 @@ typedef struct
  */
 typedef pthread_t CFE_PSP_Exception_SysTaskId_t;
 
-/**
- * \brief Exception context data which is relevant for offline/post-mortem diagnosis.
- *
- * This may be stored in a persistent exception log file for later analysis.
+/*
+ * The exception context data (CFE_PSP_Exception_ContextDataEntry_t)
+ * is defined in cfe_psp_exception_context.h
  */
-typedef struct
-{
-    struct timespec event_time;
-    siginfo_t       si;
-
-    /*
-     * Note this is a variably-filled array based on the number of addresses
-     * reported by the library.  It should be last.
-     */
-    void *bt_addrs[CFE_PSP_MAX_EXCEPTION_BACKTRACE_SIZE];
-} CFE_PSP_Exception_ContextDataEntry_t;
 
 /*
 ** Watchdog minimum and maximum values ( in milliseconds )
@@ -135,9 +134,30 @@ typedef struct
 #define CFE_PSP_WATCHDOG_MAX (0xFFFFFFFF)
 
 /*
-** Number of EEPROM banks on this platform
+** Maximum number of EEPROM banks on this platform
+**
+** The number actually used is selected at startup, see CFE_PSP_EepromConfig_t.
+** Each bank uses one memory range entry, in addition to the RAM entry.
 */
-#define CFE_PSP_NUM_EEPROM_BANKS 1
+#define CFE_PSP_NUM_EEPROM_BANKS 8
+
+/*
+** Maximum length of the simulated EEPROM file path
+*/
+#define CFE_PSP_EEPROM_FILE_NAME_LENGTH 256
+
+/**
+ * \brief Simulated EEPROM layout selected on the command line
+ *
+ * Any value left at zero (or an empty name) means that the EEPROM module
+ * uses its own build-time default.
+ */
+typedef struct
+{
+    char   FileName[CFE_PSP_EEPROM_FILE_NAME_LENGTH]; /**< File of bank 0; bank N uses FileName.N */
+    uint32 BankSize;                                  /**< Size of each bank in bytes */
+    uint32 NumBanks;                                  /**< Number of banks, at most CFE_PSP_NUM_EEPROM_BANKS */
+} CFE_PSP_EepromConfig_t;
 
 /*
  * Information about the "idle task" --
@@ -145,4 +165,27 @@ typedef struct
  */
 extern CFE_PSP_IdleTaskState_t CFE_PSP_IdleTaskState;
 
+/*
+ * Simulated EEPROM layout from the command line
+ */
+extern CFE_PSP_EepromConfig_t CFE_PSP_EepromConfig;
+
+/*
+ * Refresh the list of loaded objects reported with exceptions.
+ * Called at startup and whenever an OSAL module is loaded or unloaded.
+ */
+extern void CFE_PSP_ExceptionUpdateLoadMap(void);
+
+/*
+ * Saves the loaded objects referenced by an exception context, see cfe_psp_exception.c.
+ * Safe to call from a signal handler.
+ */
+extern void CFE_PSP_ExceptionSaveLoadMap(CFE_PSP_Exception_ContextDataEntry_t *Context, const void *FaultAddr);
+
+/*
+ * Restart the cFE (processor reset) when a watchdog deadline is missed,
+ * set from the command line.  Otherwise the miss is only recorded.
+ */
+extern bool CFE_PSP_WatchdogRestartOnMiss;
+
 #endif
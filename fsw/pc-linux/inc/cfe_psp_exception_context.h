@@ -0,0 +1,114 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * Layout of the exception context saved by the pc-linux PSP.
+ *
+ * This is the data that ends up in the exception/reset log, so it is also
+ * used by the host-side symbolizer in tools/exception-symbolizer.  For that
+ * reason this header must only depend on system headers.
+ */
+
+#ifndef CFE_PSP_EXCEPTION_CONTEXT_H
+#define CFE_PSP_EXCEPTION_CONTEXT_H
+
+#include <stdint.h>
+#include <signal.h>
+#include <time.h>
+
+/*
+ * Maximum number of return addresses saved with each exception
+ */
+#define CFE_PSP_MAX_EXCEPTION_BACKTRACE_SIZE 16
+
+/*
+ * Maximum number of loaded objects saved with each exception.
+ * Only objects that contain an address of the backtrace are saved.
+ */
+#define CFE_PSP_MAX_EXCEPTION_MODULES 4
+
+/*
+ * Size of the saved build-id; this fits the usual 160-bit SHA1 build-id,
+ * longer ones are truncated.
+ */
+#define CFE_PSP_EXCEPTION_BUILD_ID_SIZE 20
+
+/*
+ * Size of the saved object name, including the terminator.
+ * Only the base name is saved, which may be truncated.
+ */
+#define CFE_PSP_EXCEPTION_MODULE_NAME_SIZE 27
+
+/*
+ * Signal used for the records of missed watchdog deadlines.
+ *
+ * Such a record has si_signo set to this with si_code SI_TIMER, and:
+ *  - si_timerid: the watchdog deadline in milliseconds
+ *  - si_value.sival_int: the time since the watchdog was last serviced, in milliseconds
+ *  - si_overrun: the number of deadlines missed since the cFE started
+ *
+ * The backtrace is that of the thread that enabled the watchdog, if it
+ * could be taken.
+ */
+#define CFE_PSP_WATCHDOG_SIGNAL SIGUSR2
+
+/**
+ * \brief Location of a loaded object (executable or shared library)
+ *
+ * Subtracting LoadBias from a run-time address gives the address as
+ * seen in the ELF file, which is what the symbol tables refer to.
+ */
+typedef struct
+{
+    uintptr_t LoadBias;                                 /**< Run-time address minus link-time address */
+    uintptr_t StartAddr;                                /**< Run-time start of the loadable segments */
+    uintptr_t EndAddr;                                  /**< Run-time end of the loadable segments */
+    uint8_t   BuildIdSize;                              /**< Number of valid bytes in BuildId, 0 if none */
+    uint8_t   BuildId[CFE_PSP_EXCEPTION_BUILD_ID_SIZE]; /**< GNU build-id of the object */
+    char      Name[CFE_PSP_EXCEPTION_MODULE_NAME_SIZE]; /**< Base name of the object */
+} CFE_PSP_Exception_ModuleInfo_t;
+
+/**
+ * \brief Exception context data which is relevant for offline/post-mortem diagnosis.
+ *
+ * This may be stored in a persistent exception log file for later analysis.
+ *
+ * The backtrace comes before the module list, so if the log truncates the
+ * context the return addresses are kept in preference to the module list.
+ */
+typedef struct
+{
+    struct timespec event_time;
+    siginfo_t       si;
+
+    uint16_t NumAddrs;   /**< Number of valid entries in bt_addrs */
+    uint16_t NumModules; /**< Number of valid entries in modules */
+    uint32_t Reserved;   /**< Keeps bt_addrs aligned; always zero */
+
+    void *bt_addrs[CFE_PSP_MAX_EXCEPTION_BACKTRACE_SIZE];
+
+    /*
+     * Note this is a variably-filled array based on the number of objects
+     * referenced by the backtrace.  It should be last.
+     */
+    CFE_PSP_Exception_ModuleInfo_t modules[CFE_PSP_MAX_EXCEPTION_MODULES];
+} CFE_PSP_Exception_ContextDataEntry_t;
+
+#endif /* CFE_PSP_EXCEPTION_CONTEXT_H */
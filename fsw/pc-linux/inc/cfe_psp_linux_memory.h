@@ -0,0 +1,77 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * Internal interface between the pc-linux reserved memory logic and the
+ * backend that provides the underlying storage.
+ *
+ * Exactly one backend is compiled in, selected via the PSP_LINUX_RESERVED_MEMORY
+ * build option:
+ *  - cfe_psp_memory_shm.c:  one SysV shared memory segment per area (default)
+ *  - cfe_psp_memory_mmap.c: all areas in a single file mapped from a configurable directory
+ */
+
+#ifndef CFE_PSP_LINUX_MEMORY_H
+#define CFE_PSP_LINUX_MEMORY_H
+
+#include "common_types.h"
+#include "cfe_psp_memory.h"
+#include "target_config.h"
+
+/*
+ * Define the PSP-supported capacities to be the maximum allowed,
+ * (since the PC-linux PSP has the advantage of abundant disk space to hold this)
+ */
+#define CFE_PSP_CDS_SIZE           (GLOBAL_CONFIGDATA.CfeConfig->CdsSize)
+#define CFE_PSP_RESET_AREA_SIZE    (GLOBAL_CONFIGDATA.CfeConfig->ResetAreaSize)
+#define CFE_PSP_USER_RESERVED_SIZE (GLOBAL_CONFIGDATA.CfeConfig->UserReservedSize)
+
+/*
+ * The boot record and exception storage are kept together at the start of
+ * the reset area, so they are preserved on a processor reset.
+ */
+typedef struct
+{
+    CFE_PSP_ReservedMemoryBootRecord_t BootRecord;
+    CFE_PSP_ExceptionStorage_t         ExceptionStorage;
+} CFE_PSP_LinuxReservedAreaFixedLayout_t;
+
+/**
+ * \brief Attach the reserved memory areas
+ *
+ * Creates or attaches the storage for the CDS, reset area (including the
+ * fixed layout above) and user reserved area, and sets the corresponding
+ * pointers and sizes in CFE_PSP_ReservedMemoryMap.
+ *
+ * Any failure is fatal and results in a call to CFE_PSP_Panic().
+ *
+ * \returns true if the CDS storage was newly created, false if existing content was attached
+ */
+bool CFE_PSP_AttachReservedMemory_Impl(void);
+
+/**
+ * \brief Unlink the reserved memory storage
+ *
+ * The storage is marked for deletion so it will be recreated on the next
+ * start, but the local mappings remain usable until the process ends.
+ */
+void CFE_PSP_DeleteReservedMemory_Impl(void);
+
+#endif /* CFE_PSP_LINUX_MEMORY_H */
@@ -7,4 +7,5 @@ eeprom_mmap_file
 ram_notimpl
 port_notimpl
 iodriver
+sysmon
 linux_sysmon
@@ -34,6 +34,7 @@ S
 **  Include Files
 */
 #include <stdio.h>
+#include <stddef.h>
 #include <string.h>
 #include <pthread.h>
 
@@ -49,16 +50,251 @@ S
 
 #include <execinfo.h>
 #include <signal.h>
+#include <errno.h>
+#include <link.h>
+
+/*
+ * A copy of the list of loaded objects
+ */
+typedef struct
+{
+    uint32                         NumModules;
+    CFE_PSP_Exception_ModuleInfo_t Modules[CFE_PSP_MAX_LOADMAP_MODULES];
+} CFE_PSP_LoadMapSnapshot_t;
+
+/*
+ * The signal handler cannot call dl_iterate_phdr(), so the list of loaded
+ * objects is copied in task context whenever it changes.
+ *
+ * There are two copies, and the one selected by the low bit of Generation
+ * is current.  An update fills the other copy and then increments Generation,
+ * so the signal handler can take its copy without a lock and only needs to
+ * retry if Generation changed while it was reading.
+ */
+typedef struct
+{
+    pthread_mutex_t           UpdateLock;
+    volatile uint32           Generation;
+    CFE_PSP_LoadMapSnapshot_t Snapshot[2];
+} CFE_PSP_LoadMapState_t;
 
 /*
  * A set of asynchronous signals which will be masked during other signal processing
  */
 sigset_t CFE_PSP_AsyncMask;
 
+CFE_PSP_LoadMapState_t CFE_PSP_LoadMapState = {.UpdateLock = PTHREAD_MUTEX_INITIALIZER};
+
 /***************************************************************************
  **                        FUNCTIONS DEFINITIONS
  ***************************************************************************/
 
+/*
+**
+** Callback for dl_iterate_phdr() that adds one loaded object to a snapshot.
+**
+*/
+int CFE_PSP_ExceptionLoadMapCallback(struct dl_phdr_info *info, size_t size, void *arg)
+{
+    CFE_PSP_LoadMapSnapshot_t *     Snapshot = arg;
+    CFE_PSP_Exception_ModuleInfo_t *Module;
+    const ElfW(Phdr) *              Phdr;
+    const ElfW(Nhdr) *              Note;
+    const char *                    Name;
+    cpuaddr                         NotePos;
+    cpuaddr                         NoteEnd;
+    size_t                          BuildIdSize;
+    uint16                          i;
+
+    if (Snapshot->NumModules >= CFE_PSP_MAX_LOADMAP_MODULES)
+    {
+        /* no room for more - stop iterating */
+        return 1;
+    }
+
+    Module = &Snapshot->Modules[Snapshot->NumModules];
+    memset(Module, 0, sizeof(*Module));
+    Module->LoadBias  = info->dlpi_addr;
+    Module->StartAddr = ~(uintptr_t)0;
+
+    for (i = 0; i < info->dlpi_phnum; ++i)
+    {
+        Phdr = &info->dlpi_phdr[i];
+        if (Phdr->p_type == PT_LOAD)
+        {
+            if (info->dlpi_addr + Phdr->p_vaddr < Module->StartAddr)
+            {
+                Module->StartAddr = info->dlpi_addr + Phdr->p_vaddr;
+            }
+            if (info->dlpi_addr + Phdr->p_vaddr + Phdr->p_memsz > Module->EndAddr)
+            {
+                Module->EndAddr = info->dlpi_addr + Phdr->p_vaddr + Phdr->p_memsz;
+            }
+        }
+        else if (Phdr->p_type == PT_NOTE && Module->BuildIdSize == 0)
+        {
+            /* each note is a header, then the name and descriptor padded to 4 bytes */
+            NotePos = info->dlpi_addr + Phdr->p_vaddr;
+            NoteEnd = NotePos + Phdr->p_memsz;
+            while ((NotePos + sizeof(*Note)) <= NoteEnd)
+            {
+                Note = (const ElfW(Nhdr) *)NotePos;
+                NotePos += sizeof(*Note) + ((Note->n_namesz + 3) & ~3) + ((Note->n_descsz + 3) & ~3);
+                if (NotePos > NoteEnd)
+                {
+                    break;
+                }
+                if (Note->n_type == NT_GNU_BUILD_ID && Note->n_namesz == 4 && memcmp(Note + 1, "GNU", 4) == 0)
+                {
+                    BuildIdSize = Note->n_descsz;
+                    if (BuildIdSize > sizeof(Module->BuildId))
+                    {
+                        BuildIdSize = sizeof(Module->BuildId);
+                    }
+                    memcpy(Module->BuildId, (const uint8 *)(Note + 1) + 4, BuildIdSize);
+                    Module->BuildIdSize = BuildIdSize;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (Module->EndAddr == 0)
+    {
+        /* nothing is mapped, so no address can refer to it */
+        return 0;
+    }
+
+    /* the main program is reported first, without a name */
+    Name = info->dlpi_name;
+    if (Name == NULL || Name[0] == 0)
+    {
+        Name = (Snapshot->NumModules == 0) ? program_invocation_short_name : "";
+    }
+    else if (strrchr(Name, '/') != NULL)
+    {
+        Name = strrchr(Name, '/') + 1;
+    }
+    strncpy(Module->Name, Name, sizeof(Module->Name) - 1);
+
+    ++Snapshot->NumModules;
+
+    return 0;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per internal API
+ * See description in cfe_psp_config.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CFE_PSP_ExceptionUpdateLoadMap(void)
+{
+    CFE_PSP_LoadMapSnapshot_t *Snapshot;
+
+    pthread_mutex_lock(&CFE_PSP_LoadMapState.UpdateLock);
+
+    Snapshot             = &CFE_PSP_LoadMapState.Snapshot[(CFE_PSP_LoadMapState.Generation + 1) & 1];
+    Snapshot->NumModules = 0;
+    dl_iterate_phdr(CFE_PSP_ExceptionLoadMapCallback, Snapshot);
+
+    /* publish the new copy only once it is complete */
+    __sync_synchronize();
+    ++CFE_PSP_LoadMapState.Generation;
+
+    pthread_mutex_unlock(&CFE_PSP_LoadMapState.UpdateLock);
+}
+
+/*
+**
+** Adds the loaded object containing Addr to the exception context,
+** unless it is already there or the context is full.
+**
+*/
+void CFE_PSP_ExceptionAddModule(CFE_PSP_Exception_ContextDataEntry_t *Context,
+                                const CFE_PSP_LoadMapSnapshot_t *Snapshot, const void *Addr)
+{
+    const CFE_PSP_Exception_ModuleInfo_t *Module;
+    uint32                                NumModules;
+    uint32                                i;
+
+    NumModules = Snapshot->NumModules;
+    if (NumModules > CFE_PSP_MAX_LOADMAP_MODULES)
+    {
+        NumModules = CFE_PSP_MAX_LOADMAP_MODULES;
+    }
+
+    Module = NULL;
+    for (i = 0; i < NumModules; ++i)
+    {
+        if ((uintptr_t)Addr >= Snapshot->Modules[i].StartAddr && (uintptr_t)Addr < Snapshot->Modules[i].EndAddr)
+        {
+            Module = &Snapshot->Modules[i];
+            break;
+        }
+    }
+
+    if (Module == NULL)
+    {
+        return;
+    }
+
+    for (i = 0; i < Context->NumModules; ++i)
+    {
+        if (Context->modules[i].StartAddr == Module->StartAddr)
+        {
+            return;
+        }
+    }
+
+    if (Context->NumModules < CFE_PSP_MAX_EXCEPTION_MODULES)
+    {
+        memcpy(&Context->modules[Context->NumModules], Module, sizeof(*Module));
+        ++Context->NumModules;
+    }
+}
+
+/*
+**
+** Saves the loaded objects referenced by the exception into the context:
+** the one containing FaultAddr (if not NULL) followed by those containing
+** the backtrace addresses.  Called from the signal handler.
+**
+*/
+void CFE_PSP_ExceptionSaveLoadMap(CFE_PSP_Exception_ContextDataEntry_t *Context, const void *FaultAddr)
+{
+    const CFE_PSP_LoadMapSnapshot_t *Snapshot;
+    uint32                           Generation;
+    uint32                           Attempt;
+    uint32                           i;
+
+    for (Attempt = 0; Attempt < 3; ++Attempt)
+    {
+        Generation = CFE_PSP_LoadMapState.Generation;
+        __sync_synchronize();
+
+        Snapshot            = &CFE_PSP_LoadMapState.Snapshot[Generation & 1];
+        Context->NumModules = 0;
+        if (FaultAddr != NULL)
+        {
+            CFE_PSP_ExceptionAddModule(Context, Snapshot, FaultAddr);
+        }
+        for (i = 0; i < Context->NumAddrs; ++i)
+        {
+            CFE_PSP_ExceptionAddModule(Context, Snapshot, Context->bt_addrs[i]);
+        }
+
+        __sync_synchronize();
+        if (Generation == CFE_PSP_LoadMapState.Generation)
+        {
+            return;
+        }
+    }
+
+    /* the list kept changing, so what was copied may be inconsistent */
+    Context->NumModules = 0;
+}
+
 /*
 **
 ** Installed as a signal handler to log exception events.
@@ -69,21 +305,6 @@ void CFE_PSP_ExceptionSigHandler(int signo, siginfo_t *si, void *ctxt)
     CFE_PSP_Exception_LogData_t *Buffer;
     int                          NumAddrs;
 
-    /*
-     * Note that the time between CFE_PSP_Exception_GetNextContextBuffer()
-     * and CFE_PSP_Exception_WriteComplete() is sensitive in that it is
-     * accessing a global.
-     *
-     * Cannot use a conventional lock because this is a signal handler, the
-     * solution would need to involve a signal-safe spinlock and/or C11
-     * atomic ops.
-     *
-     * This means if another exception occurs on another task during this
-     * time window, it may use the same buffer.
-     *
-     * However, exceptions should be rare enough events that this is highly
-     * unlikely to occur, so leaving this unhandled for now.
-     */
     Buffer = CFE_PSP_Exception_GetNextContextBuffer();
     if (Buffer != NULL)
     {
@@ -95,11 +316,23 @@ void CFE_PSP_ExceptionSigHandler(int signo, siginfo_t *si, void *ctxt)
          */
         clock_gettime(CLOCK_MONOTONIC, &Buffer->context_info.event_time);
         memcpy(&Buffer->context_info.si, si, sizeof(Buffer->context_info.si));
-        NumAddrs             = backtrace(Buffer->context_info.bt_addrs, CFE_PSP_MAX_EXCEPTION_BACKTRACE_SIZE);
-        Buffer->context_size = offsetof(CFE_PSP_Exception_ContextDataEntry_t, bt_addrs[NumAddrs]);
+        NumAddrs = backtrace(Buffer->context_info.bt_addrs, CFE_PSP_MAX_EXCEPTION_BACKTRACE_SIZE);
+        Buffer->context_info.NumAddrs = NumAddrs;
+
+        /* for these signals si_addr is the faulting instruction */
+        if (signo == SIGFPE || signo == SIGILL)
+        {
+            CFE_PSP_ExceptionSaveLoadMap(&Buffer->context_info, si->si_addr);
+        }
+        else
+        {
+            CFE_PSP_ExceptionSaveLoadMap(&Buffer->context_info, NULL);
+        }
+        Buffer->context_size =
+            offsetof(CFE_PSP_Exception_ContextDataEntry_t, modules[Buffer->context_info.NumModules]);
         /* pthread_self() is signal-safe per POSIX.1-2013 */
         Buffer->sys_task_id = pthread_self();
-        CFE_PSP_Exception_WriteComplete();
+        CFE_PSP_Exception_WriteComplete(Buffer);
     }
 
     /*
@@ -208,6 +441,12 @@ void CFE_PSP_AttachExceptions(void)
      */
     backtrace(Addr, 1);
 
+    /*
+     * Take the initial list of loaded objects.  This is updated whenever
+     * OSAL loads or unloads a module.
+     */
+    CFE_PSP_ExceptionUpdateLoadMap();
+
     OS_printf("CFE_PSP: %s called\n", __func__);
 
     /*
@@ -266,9 +505,35 @@ void CFE_PSP_SetDefaultExceptionEnvironment(void)
     CFE_PSP_AttachSigHandler(SIGFPE);
 }
 
+/*
+**
+** Finds the saved object containing Addr and returns the name and the offset
+** of Addr from the start of the object.  Returns NULL if none was saved.
+**
+*/
+const char *CFE_PSP_ExceptionLocateAddr(const CFE_PSP_Exception_LogData_t *Buffer, uintptr_t Addr, uintptr_t *Offset)
+{
+    const CFE_PSP_Exception_ModuleInfo_t *Module;
+    uint32                                i;
+
+    for (i = 0; i < Buffer->context_info.NumModules && i < CFE_PSP_MAX_EXCEPTION_MODULES; ++i)
+    {
+        Module = &Buffer->context_info.modules[i];
+        if (Addr >= Module->StartAddr && Addr < Module->EndAddr)
+        {
+            *Offset = Addr - Module->LoadBias;
+            return Module->Name;
+        }
+    }
+
+    return NULL;
+}
+
 int32 CFE_PSP_ExceptionGetSummary_Impl(const CFE_PSP_Exception_LogData_t *Buffer, char *ReasonBuf, uint32 ReasonSize)
 {
     const char *ComputedReason = "unknown";
+    const char *ModuleName;
+    uintptr_t   Offset;
 
     /* check the "code" within the siginfo structure, which reveals more info about the FP exception */
     if (Buffer->context_info.si.si_signo == SIGFPE)
@@ -302,8 +567,28 @@ int32 CFE_PSP_ExceptionGetSummary_Impl(const CFE_PSP_Exception_LogData_t *Buffer
             default:
                 ComputedReason = "Unknown SIGFPE";
         }
-        (void)snprintf(ReasonBuf, ReasonSize, "%s at ip 0x%lx", ComputedReason,
-                       (unsigned long)Buffer->context_info.si.si_addr);
+
+        /*
+         * The offset within the object is the address seen in the ELF file,
+         * which can be looked up offline (e.g. with addr2line or the symbolizer tool)
+         */
+        ModuleName = CFE_PSP_ExceptionLocateAddr(Buffer, (uintptr_t)Buffer->context_info.si.si_addr, &Offset);
+        if (ModuleName != NULL)
+        {
+            (void)snprintf(ReasonBuf, ReasonSize, "%s at ip 0x%lx (%s+0x%lx)", ComputedReason,
+                           (unsigned long)Buffer->context_info.si.si_addr, ModuleName, (unsigned long)Offset);
+        }
+        else
+        {
+            (void)snprintf(ReasonBuf, ReasonSize, "%s at ip 0x%lx", ComputedReason,
+                           (unsigned long)Buffer->context_info.si.si_addr);
+        }
+    }
+    else if (Buffer->context_info.si.si_signo == CFE_PSP_WATCHDOG_SIGNAL && Buffer->context_info.si.si_code == SI_TIMER)
+    {
+        /* recorded by the watchdog monitor, see cfe_psp_exception_context.h */
+        (void)snprintf(ReasonBuf, ReasonSize, "Watchdog deadline of %u ms missed, not serviced for %d ms",
+                       (unsigned int)Buffer->context_info.si.si_timerid, Buffer->context_info.si.si_value.sival_int);
     }
     else if (Buffer->context_info.si.si_signo == SIGINT)
     {
@@ -41,8 +41,7 @@
 #include <unistd.h>
 #include <string.h>
 #include <sys/types.h>
-#include <sys/ipc.h>
-#include <sys/shm.h>
+#include <sys/stat.h>
 #include <fcntl.h>
 
 /*
@@ -61,34 +60,39 @@
 */
 #include "cfe_psp_config.h"
 #include "cfe_psp_memory.h"
+#include "cfe_psp_linux_memory.h"
 
-#define CFE_PSP_CDS_KEY_FILE      ".cdskeyfile"
-#define CFE_PSP_RESET_KEY_FILE    ".resetkeyfile"
-#define CFE_PSP_RESERVED_KEY_FILE ".reservedkeyfile"
+/*
+ * Regular file that holds a copy of the CDS, so its content can survive
+ * loss of the shared memory segment (i.e. a host reboot).  Only pages
+ * that have been written since the last flush are copied out.
+ */
+#define CFE_PSP_CDS_BACKING_FILE "CDS.DAT"
 
-#include "target_config.h"
+#define CFE_PSP_CDS_DIRTYMAP_BITS (8 * sizeof(uint32))
 
 /*
- * Define the PSP-supported capacities to be the maximum allowed,
- * (since the PC-linux PSP has the advantage of abundant disk space to hold this)
+ * Tracking of CDS pages modified since the last flush to the backing file.
+ *
+ * The bitmap words are updated with atomic operations, so WriteToCDS can
+ * be called concurrently from several tasks and also concurrently with a
+ * flush, without any additional locking.
  */
-#define CFE_PSP_CDS_SIZE           (GLOBAL_CONFIGDATA.CfeConfig->CdsSize)
-#define CFE_PSP_RESET_AREA_SIZE    (GLOBAL_CONFIGDATA.CfeConfig->ResetAreaSize)
-#define CFE_PSP_USER_RESERVED_SIZE (GLOBAL_CONFIGDATA.CfeConfig->UserReservedSize)
-
 typedef struct
 {
-    CFE_PSP_ReservedMemoryBootRecord_t BootRecord;
-    CFE_PSP_ExceptionStorage_t         ExceptionStorage;
-} CFE_PSP_LinuxReservedAreaFixedLayout_t;
+    int     BackingFd;
+    uint32  PageShift;
+    uint32  NumPages;
+    uint32  NumMapWords;
+    uint32 *DirtyMap;
+} CFE_PSP_LinuxCDSTracking_t;
 
 /*
 ** Internal prototypes for this module
 */
-void CFE_PSP_InitCDS(void);
-void CFE_PSP_InitResetArea(void);
 void CFE_PSP_InitVolatileDiskMem(void);
-void CFE_PSP_InitUserReservedArea(void);
+void CFE_PSP_InitCDSBackingStore(bool IsNewSegment);
+void CFE_PSP_MarkCDSDirty(uint32 CDSOffset, uint32 NumBytes);
 
 /*
 **  External Declarations
@@ -99,9 +103,7 @@ extern unsigned int _fini;
 /*
 ** Global variables
 */
-int ResetAreaShmId;
-int CDSShmId;
-int UserShmId;
+CFE_PSP_LinuxCDSTracking_t CFE_PSP_CDSTracking = {.BackingFd = -1};
 
 /*
 ** Pointer to the vxWorks USER_RESERVED_MEMORY area
@@ -114,84 +116,277 @@ CFE_PSP_ReservedMemoryMap_t CFE_PSP_ReservedMemoryMap;
 ** CDS related functions
 *********************************************************************************
 */
-/*
-**
-*/
 /******************************************************************************
 **
-**  Purpose: This function is used by the ES startup code to initialize the
-**            Critical Data store area
+**  Purpose:
+**    Opens the CDS backing file and allocates the dirty page map.
+**
+**    If the CDS storage was just created (i.e. the host was rebooted or
+**    the storage was removed) and the backing file holds a full copy of
+**    the CDS, the CDS is reloaded from the file.  Otherwise every page is
+**    marked dirty so the next flush brings the file up to date.
 **
+**    Failures here are not fatal; the CDS remains usable in memory, but
+**    CFE_PSP_FlushCDS() will report an error.
 **
 **  Arguments:
-**    (none)
+**    IsNewSegment - whether the CDS storage was just created
 **
 **  Return:
 **    (none)
 */
-
-void CFE_PSP_InitCDS(void)
+void CFE_PSP_InitCDSBackingStore(bool IsNewSegment)
 {
-    key_t key;
+    struct stat StatBuf;
+    long        PageSize;
+    bool        IsLoaded;
+    uint32      i;
 
-    /*
-    ** Make the Shared memory key
-    */
-    if ((key = ftok(CFE_PSP_CDS_KEY_FILE, 'R')) == -1)
+    PageSize                      = sysconf(_SC_PAGESIZE);
+    CFE_PSP_CDSTracking.PageShift = 0;
+    while ((1L << CFE_PSP_CDSTracking.PageShift) < PageSize)
     {
-        perror("CFE_PSP - Cannot Create CDS Shared memory key");
-        CFE_PSP_Panic(CFE_PSP_ERROR);
+        ++CFE_PSP_CDSTracking.PageShift;
     }
 
-    /*
-    ** connect to (and possibly create) the segment:
-    */
-    if ((CDSShmId = shmget(key, CFE_PSP_CDS_SIZE, 0644 | IPC_CREAT)) == -1)
+    CFE_PSP_CDSTracking.NumPages = (CFE_PSP_CDS_SIZE + (1UL << CFE_PSP_CDSTracking.PageShift) - 1) >>
+                                   CFE_PSP_CDSTracking.PageShift;
+    CFE_PSP_CDSTracking.NumMapWords =
+        (CFE_PSP_CDSTracking.NumPages + CFE_PSP_CDS_DIRTYMAP_BITS - 1) / CFE_PSP_CDS_DIRTYMAP_BITS;
+    CFE_PSP_CDSTracking.DirtyMap = calloc(CFE_PSP_CDSTracking.NumMapWords, sizeof(uint32));
+    if (CFE_PSP_CDSTracking.DirtyMap == NULL)
     {
-        perror("CFE_PSP - Cannot shmget CDS Shared memory Segment");
-        CFE_PSP_Panic(CFE_PSP_ERROR);
+        OS_printf("CFE_PSP: Cannot allocate CDS dirty page map, CDS will not be persisted\n");
+        return;
     }
 
-    /*
-    ** attach to the segment to get a pointer to it:
-    */
-    CFE_PSP_ReservedMemoryMap.CDSMemory.BlockPtr = shmat(CDSShmId, (void *)0, 0);
-    if (CFE_PSP_ReservedMemoryMap.CDSMemory.BlockPtr == (void *)(-1))
+    CFE_PSP_CDSTracking.BackingFd = open(CFE_PSP_CDS_BACKING_FILE, O_RDWR | O_CREAT, 0644);
+    if (CFE_PSP_CDSTracking.BackingFd < 0)
+    {
+        perror("CFE_PSP - Cannot open CDS backing file");
+        return;
+    }
+
+    IsLoaded = false;
+    if (fstat(CFE_PSP_CDSTracking.BackingFd, &StatBuf) == 0 && StatBuf.st_size == CFE_PSP_CDS_SIZE)
+    {
+        /*
+         * A reattached segment is authoritative, but a previous process may
+         * have been killed before flushing its writes, so the file cannot be
+         * assumed to match it: leave IsLoaded false to flush every page.
+         */
+        if (IsNewSegment && pread(CFE_PSP_CDSTracking.BackingFd, CFE_PSP_ReservedMemoryMap.CDSMemory.BlockPtr,
+                                  CFE_PSP_CDS_SIZE, 0) == CFE_PSP_CDS_SIZE)
+        {
+            OS_printf("CFE_PSP: Restored CDS content from %s\n", CFE_PSP_CDS_BACKING_FILE);
+            IsLoaded = true;
+        }
+    }
+    else if (ftruncate(CFE_PSP_CDSTracking.BackingFd, CFE_PSP_CDS_SIZE) < 0)
     {
-        perror("CFE_PSP - Cannot shmat to CDS Shared memory Segment");
-        CFE_PSP_Panic(CFE_PSP_ERROR);
+        perror("CFE_PSP - Cannot size CDS backing file");
     }
 
-    CFE_PSP_ReservedMemoryMap.CDSMemory.BlockSize = CFE_PSP_CDS_SIZE;
+    if (!IsLoaded)
+    {
+        for (i = 0; i < CFE_PSP_CDSTracking.NumMapWords; ++i)
+        {
+            CFE_PSP_CDSTracking.DirtyMap[i] = 0xFFFFFFFF;
+        }
+    }
 }
 
 /******************************************************************************
 **
 **  Purpose:
-**   This is an internal function to delete the CDS Shared memory segment.
+**    Marks the CDS pages spanned by the given range as modified.
+**    The range must have already been validated by the caller.
 **
 **  Arguments:
-**    (none)
+**    CDSOffset - offset of the first modified byte
+**    NumBytes  - number of modified bytes
 **
 **  Return:
 **    (none)
 */
-void CFE_PSP_DeleteCDS(void)
+void CFE_PSP_MarkCDSDirty(uint32 CDSOffset, uint32 NumBytes)
 {
-    int             ReturnCode;
-    struct shmid_ds ShmCtrl;
+    uint32 Page;
+    uint32 LastPage;
 
-    ReturnCode = shmctl(CDSShmId, IPC_RMID, &ShmCtrl);
+    if (CFE_PSP_CDSTracking.DirtyMap == NULL || NumBytes == 0)
+    {
+        return;
+    }
 
-    if (ReturnCode == 0)
+    Page     = CDSOffset >> CFE_PSP_CDSTracking.PageShift;
+    LastPage = (CDSOffset + NumBytes - 1) >> CFE_PSP_CDSTracking.PageShift;
+    while (Page <= LastPage)
     {
-        OS_printf("CFE_PSP: Critical Data Store Shared memory segment removed\n");
+        __atomic_fetch_or(&CFE_PSP_CDSTracking.DirtyMap[Page / CFE_PSP_CDS_DIRTYMAP_BITS],
+                          1U << (Page % CFE_PSP_CDS_DIRTYMAP_BITS), __ATOMIC_RELEASE);
+        ++Page;
     }
-    else
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per public API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CFE_PSP_WriteToCDSv(const CFE_PSP_CDSWriteVec_t *Vec, uint32 NumEntries, uint32 Flags)
+{
+    uint8 *CDSPtr;
+    size_t CDSSize;
+    uint32 i;
+
+    if (Vec == NULL)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    /* Validate every range first, so the update is all or nothing */
+    CDSSize = CFE_PSP_CDS_SIZE;
+    for (i = 0; i < NumEntries; ++i)
+    {
+        if (Vec[i].DataPtr == NULL || Vec[i].CDSOffset >= CDSSize || Vec[i].NumBytes > (CDSSize - Vec[i].CDSOffset))
+        {
+            return CFE_PSP_ERROR;
+        }
+    }
+
+    CDSPtr = CFE_PSP_ReservedMemoryMap.CDSMemory.BlockPtr;
+    for (i = 0; i < NumEntries; ++i)
+    {
+        memcpy(&CDSPtr[Vec[i].CDSOffset], Vec[i].DataPtr, Vec[i].NumBytes);
+        CFE_PSP_MarkCDSDirty(Vec[i].CDSOffset, Vec[i].NumBytes);
+    }
+
+    if ((Flags & CFE_PSP_CDS_VEC_FENCE) != 0)
+    {
+        __sync_synchronize();
+    }
+
+    return CFE_PSP_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per public API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CFE_PSP_ReadFromCDSv(const CFE_PSP_CDSReadVec_t *Vec, uint32 NumEntries, uint32 Flags)
+{
+    const uint8 *CDSPtr;
+    size_t       CDSSize;
+    uint32       i;
+
+    if (Vec == NULL)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    /* Validate every range first, so the read is all or nothing */
+    CDSSize = CFE_PSP_CDS_SIZE;
+    for (i = 0; i < NumEntries; ++i)
+    {
+        if (Vec[i].DataPtr == NULL || Vec[i].CDSOffset >= CDSSize || Vec[i].NumBytes > (CDSSize - Vec[i].CDSOffset))
+        {
+            return CFE_PSP_ERROR;
+        }
+    }
+
+    if ((Flags & CFE_PSP_CDS_VEC_FENCE) != 0)
+    {
+        __sync_synchronize();
+    }
+
+    CDSPtr = CFE_PSP_ReservedMemoryMap.CDSMemory.BlockPtr;
+    for (i = 0; i < NumEntries; ++i)
+    {
+        memcpy(Vec[i].DataPtr, &CDSPtr[Vec[i].CDSOffset], Vec[i].NumBytes);
+    }
+
+    return CFE_PSP_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per public API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CFE_PSP_FlushCDS(void)
+{
+    uint8 *BasePtr;
+    uint32 Word;
+    uint32 DirtyBits;
+    uint32 Bit;
+    uint32 Page;
+    size_t Offset;
+    size_t Length;
+    bool   IsWritten;
+    int32  return_code;
+
+    if (CFE_PSP_CDSTracking.DirtyMap == NULL || CFE_PSP_CDSTracking.BackingFd < 0)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    BasePtr     = CFE_PSP_ReservedMemoryMap.CDSMemory.BlockPtr;
+    IsWritten   = false;
+    return_code = CFE_PSP_SUCCESS;
+
+    for (Word = 0; Word < CFE_PSP_CDSTracking.NumMapWords; ++Word)
+    {
+        /*
+         * Claim the dirty bits before copying the pages out.  A write that
+         * lands while the page is being copied sets the bit again, so it
+         * will be picked up by the next flush rather than lost.
+         */
+        DirtyBits = __atomic_exchange_n(&CFE_PSP_CDSTracking.DirtyMap[Word], 0, __ATOMIC_ACQUIRE);
+
+        for (Bit = 0; DirtyBits != 0; ++Bit, DirtyBits >>= 1)
+        {
+            if ((DirtyBits & 1) == 0)
+            {
+                continue;
+            }
+
+            Page = (Word * CFE_PSP_CDS_DIRTYMAP_BITS) + Bit;
+            if (Page >= CFE_PSP_CDSTracking.NumPages)
+            {
+                break;
+            }
+
+            Offset = (size_t)Page << CFE_PSP_CDSTracking.PageShift;
+            Length = (size_t)1 << CFE_PSP_CDSTracking.PageShift;
+            if ((Offset + Length) > CFE_PSP_CDS_SIZE)
+            {
+                Length = CFE_PSP_CDS_SIZE - Offset;
+            }
+
+            if (pwrite(CFE_PSP_CDSTracking.BackingFd, &BasePtr[Offset], Length, Offset) == (ssize_t)Length)
+            {
+                IsWritten = true;
+            }
+            else
+            {
+                /* leave it marked so it is retried on the next flush */
+                __atomic_fetch_or(&CFE_PSP_CDSTracking.DirtyMap[Word], 1U << Bit, __ATOMIC_RELEASE);
+                return_code = CFE_PSP_ERROR;
+            }
+        }
+    }
+
+    if (IsWritten && fdatasync(CFE_PSP_CDSTracking.BackingFd) < 0)
     {
-        OS_printf("CFE_PSP: Error Removing Critical Data Store Shared memory Segment.\n");
-        OS_printf("CFE_PSP: It can be manually checked and removed using the ipcs and ipcrm commands.\n");
+        return_code = CFE_PSP_ERROR;
     }
+
+    return return_code;
 }
 
 /*----------------------------------------------------------------
@@ -239,6 +434,7 @@ int32 CFE_PSP_WriteToCDS(const void *PtrToDataToWrite, uint32 CDSOffset, uint32
             CopyPtr = CFE_PSP_ReservedMemoryMap.CDSMemory.BlockPtr;
             CopyPtr += CDSOffset;
             memcpy(CopyPtr, (char *)PtrToDataToWrite, NumBytes);
+            CFE_PSP_MarkCDSDirty(CDSOffset, NumBytes);
 
             return_code = CFE_PSP_SUCCESS;
         }
@@ -293,106 +489,6 @@ int32 CFE_PSP_ReadFromCDS(void *PtrToDataToRead, uint32 CDSOffset, uint32 NumByt
 *********************************************************************************
 */
 
-/******************************************************************************
-**
-**  Purpose:
-**    This function is used by the ES startup code to initialize the
-**     ES Reset Area.
-**
-**  Arguments:
-**    (none)
-**
-**  Return:
-**    (none)
-*/
-void CFE_PSP_InitResetArea(void)
-{
-    key_t                                   key;
-    size_t                                  total_size;
-    size_t                                  reset_offset;
-    size_t                                  align_mask;
-    cpuaddr                                 block_addr;
-    CFE_PSP_LinuxReservedAreaFixedLayout_t *FixedBlocksPtr;
-    /*
-    ** Make the Shared memory key
-    */
-    if ((key = ftok(CFE_PSP_RESET_KEY_FILE, 'R')) == -1)
-    {
-        perror("CFE_PSP - Cannot Create Reset Area Shared memory key");
-        CFE_PSP_Panic(CFE_PSP_ERROR);
-    }
-
-    /*
-     * NOTE: Historically the CFE ES reset area also contains the Exception log.
-     * This is now allocated as a separate structure in the PSP, but it can
-     * reside in this shared memory segment so it will be preserved on a processor
-     * reset.
-     */
-    align_mask   = sysconf(_SC_PAGESIZE) - 1; /* align blocks to whole memory pages */
-    total_size   = sizeof(CFE_PSP_LinuxReservedAreaFixedLayout_t);
-    total_size   = (total_size + align_mask) & ~align_mask;
-    reset_offset = total_size;
-    total_size += CFE_PSP_RESET_AREA_SIZE;
-    total_size = (total_size + align_mask) & ~align_mask;
-
-    /*
-    ** connect to (and possibly create) the segment:
-    */
-    if ((ResetAreaShmId = shmget(key, total_size, 0644 | IPC_CREAT)) == -1)
-    {
-        perror("CFE_PSP - Cannot shmget Reset Area Shared memory Segment");
-        CFE_PSP_Panic(CFE_PSP_ERROR);
-    }
-
-    /*
-    ** attach to the segment to get a pointer to it:
-    */
-    block_addr = (cpuaddr)shmat(ResetAreaShmId, (void *)0, 0);
-    if (block_addr == (cpuaddr)(-1))
-    {
-        perror("CFE_PSP - Cannot shmat to Reset Area Shared memory Segment");
-        CFE_PSP_Panic(CFE_PSP_ERROR);
-    }
-
-    FixedBlocksPtr = (CFE_PSP_LinuxReservedAreaFixedLayout_t *)block_addr;
-    block_addr += reset_offset;
-
-    CFE_PSP_ReservedMemoryMap.BootPtr             = &FixedBlocksPtr->BootRecord;
-    CFE_PSP_ReservedMemoryMap.ExceptionStoragePtr = &FixedBlocksPtr->ExceptionStorage;
-
-    CFE_PSP_ReservedMemoryMap.ResetMemory.BlockPtr  = (void *)block_addr;
-    CFE_PSP_ReservedMemoryMap.ResetMemory.BlockSize = CFE_PSP_RESET_AREA_SIZE;
-}
-
-/******************************************************************************
-**
-**  Purpose:
-**   This is an internal function to delete the Reset Area Shared memory segment.
-**
-**  Arguments:
-**    (none)
-**
-**  Return:
-**    (none)
-*/
-void CFE_PSP_DeleteResetArea(void)
-{
-    int             ReturnCode;
-    struct shmid_ds ShmCtrl;
-
-    ReturnCode = shmctl(ResetAreaShmId, IPC_RMID, &ShmCtrl);
-
-    if (ReturnCode == 0)
-    {
-        OS_printf("Reset Area Shared memory segment removed\n");
-    }
-    else
-    {
-        OS_printf("Error Removing Reset Area Shared memory Segment.\n");
-        OS_printf("It can be manually checked and removed using the ipcs and ipcrm commands.\n");
-    }
-}
-
 /*----------------------------------------------------------------
  *
  * Implemented per public API
@@ -423,82 +519,6 @@ int32 CFE_PSP_GetResetArea(cpuaddr *PtrToResetArea, uint32 *SizeOfResetArea)
 *********************************************************************************
 */
 
-/******************************************************************************
-**
-**  Purpose:
-**    This function is used by the ES startup code to initialize the
-**      ES user reserved area.
-**
-**  Arguments:
-**    (none)
-**
-**  Return:
-**    (none)
-*/
-void CFE_PSP_InitUserReservedArea(void)
-{
-    key_t key;
-
-    /*
-    ** Make the Shared memory key
-    */
-    if ((key = ftok(CFE_PSP_RESERVED_KEY_FILE, 'R')) == -1)
-    {
-        perror("CFE_PSP - Cannot Create User Reserved Area Shared memory key");
-        CFE_PSP_Panic(CFE_PSP_ERROR);
-    }
-
-    /*
-    ** connect to (and possibly create) the segment:
-    */
-    if ((UserShmId = shmget(key, CFE_PSP_USER_RESERVED_SIZE, 0644 | IPC_CREAT)) == -1)
-    {
-        perror("CFE_PSP - Cannot shmget User Reserved Area Shared memory Segment");
-        CFE_PSP_Panic(CFE_PSP_ERROR);
-    }
-
-    /*
-    ** attach to the segment to get a pointer to it:
-    */
-    CFE_PSP_ReservedMemoryMap.UserReservedMemory.BlockPtr = shmat(UserShmId, (void *)0, 0);
-    if (CFE_PSP_ReservedMemoryMap.UserReservedMemory.BlockPtr == (void *)(-1))
-    {
-        perror("CFE_PSP - Cannot shmat to User Reserved Area Shared memory Segment");
-        CFE_PSP_Panic(CFE_PSP_ERROR);
-    }
-
-    CFE_PSP_ReservedMemoryMap.UserReservedMemory.BlockSize = CFE_PSP_USER_RESERVED_SIZE;
-}
-
-/******************************************************************************
-**
-**  Purpose:
-**   This is an internal function to delete the User Reserved Shared memory segment.
-**
-**  Arguments:
-**    (none)
-**
-**  Return:
-**    (none)
-*/
-void CFE_PSP_DeleteUserReservedArea(void)
-{
-    int             ReturnCode;
-    struct shmid_ds ShmCtrl;
-
-    ReturnCode = shmctl(UserShmId, IPC_RMID, &ShmCtrl);
-
-    if (ReturnCode == 0)
-    {
-        OS_printf("User Reserved Area Shared memory segment removed\n");
-    }
-    else
-    {
-        OS_printf("Error Removing User Reserved Area Shared memory Segment.\n");
-        OS_printf("It can be manually checked and removed using the ipcs and ipcrm commands.\n");
-    }
-}
-
 /*----------------------------------------------------------------
  *
  * Implemented per public API
@@ -593,30 +613,18 @@ int32 CFE_PSP_GetVolatileDiskMem(cpuaddr *PtrToVolDisk, uint32 *SizeOfVolDisk)
 */
 void CFE_PSP_SetupReservedMemoryMap(void)
 {
-    int tempFd;
-
-    /*
-    ** Create the key files for the shared memory segments
-    ** The files are not needed, so they are closed right away.
-    */
-    tempFd = open(CFE_PSP_CDS_KEY_FILE, O_RDONLY | O_CREAT, S_IRWXU);
-    close(tempFd);
-    tempFd = open(CFE_PSP_RESET_KEY_FILE, O_RDONLY | O_CREAT, S_IRWXU);
-    close(tempFd);
-    tempFd = open(CFE_PSP_RESERVED_KEY_FILE, O_RDONLY | O_CREAT, S_IRWXU);
-    close(tempFd);
+    bool IsNewCDS;
 
     /*
-     * The setup of each section is done as a separate init.
+     * The backend attaches the CDS, reset and user reserved areas.
      *
-     * Any failures within these routines call exit(), so there
+     * Any failures within the backend call CFE_PSP_Panic(), so there
      * is no need to check status - failure means no return.
      */
+    IsNewCDS = CFE_PSP_AttachReservedMemory_Impl();
 
-    CFE_PSP_InitCDS();
-    CFE_PSP_InitResetArea();
     CFE_PSP_InitVolatileDiskMem();
-    CFE_PSP_InitUserReservedArea();
+    CFE_PSP_InitCDSBackingStore(IsNewCDS);
 
     /*
      * Set up the "RAM" entry in the memory table.
@@ -638,6 +646,7 @@ int32 CFE_PSP_InitProcessorReservedMemory(uint32 RestartType)
     {
         OS_printf("CFE_PSP: Clearing out CFE CDS Shared memory segment.\n");
         memset(CFE_PSP_ReservedMemoryMap.CDSMemory.BlockPtr, 0, CFE_PSP_CDS_SIZE);
+        CFE_PSP_MarkCDSDirty(0, CFE_PSP_CDS_SIZE);
         OS_printf("CFE_PSP: Clearing out CFE Reset Shared memory segment.\n");
         memset(CFE_PSP_ReservedMemoryMap.ResetMemory.BlockPtr, 0, CFE_PSP_RESET_AREA_SIZE);
         OS_printf("CFE_PSP: Clearing out CFE User Reserved Shared memory segment.\n");
@@ -682,7 +691,7 @@ int32 CFE_PSP_InitProcessorReservedMemory(uint32 RestartType)
 /******************************************************************************
 **
 **  Purpose:
-**    This function cleans up all of the shared memory segments in the
+**    This function cleans up all of the reserved memory storage in the
 **     Linux/OSX ports.
 **
 **  Arguments:
@@ -693,9 +702,7 @@ int32 CFE_PSP_InitProcessorReservedMemory(uint32 RestartType)
 */
 void CFE_PSP_DeleteProcessorReservedMemory(void)
 {
-    CFE_PSP_DeleteCDS();
-    CFE_PSP_DeleteResetArea();
-    CFE_PSP_DeleteUserReservedArea();
+    CFE_PSP_DeleteReservedMemory_Impl();
 }
 
 /*
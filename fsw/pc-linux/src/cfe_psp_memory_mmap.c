@@ -0,0 +1,326 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/******************************************************************************
+** File:  cfe_psp_memory_mmap.c
+**
+**      x86 Linux Version
+**
+** Purpose:
+**   Reserved memory backend using a single file mapped with mmap().
+**
+**   All reserved areas (boot record/exception storage, ES reset area, CDS
+**   and user reserved area) are laid out back to back in one file, each
+**   aligned to the page size of the underlying file system.  Placing the
+**   directory on a tmpfs keeps the content across a processor reset just
+**   like the SysV segments do; placing it on a hugetlbfs mount backs the
+**   areas with huge pages.
+**
+**   The file name includes the user, CPU name and CPU ID, so several
+**   instances can share the directory without colliding.
+**
+******************************************************************************/
+
+/*
+**  Include Files
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/vfs.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <string.h>
+#include <fcntl.h>
+#include <limits.h>
+
+/*
+** cFE includes
+*/
+#include "common_types.h"
+#include "osapi.h"
+
+/*
+** Types and prototypes for this module
+*/
+#include "cfe_psp.h"
+
+/*
+** PSP Specific defines
+*/
+#include "cfe_psp_config.h"
+#include "cfe_psp_memory.h"
+#include "cfe_psp_linux_memory.h"
+
+/*
+ * Directory that holds the reserved memory file.
+ * Normally set by the build system from PSP_LINUX_RESERVED_MEMORY_DIR.
+ */
+#ifndef CFE_PSP_RESERVED_MEMORY_DIR
+#define CFE_PSP_RESERVED_MEMORY_DIR "/dev/shm"
+#endif
+
+/*
+ * Preferred NUMA node for the reserved memory pages, or -1 to leave the
+ * placement to the kernel default policy.
+ * Normally set by the build system from PSP_LINUX_RESERVED_MEMORY_NUMA_NODE.
+ */
+#ifndef CFE_PSP_RESERVED_MEMORY_NUMA_NODE
+#define CFE_PSP_RESERVED_MEMORY_NUMA_NODE (-1)
+#endif
+
+/*
+ * These are normally provided by linux/magic.h and numaif.h, but the values
+ * are part of the kernel ABI, so avoid a dependency on libnuma headers.
+ */
+#ifndef HUGETLBFS_MAGIC
+#define HUGETLBFS_MAGIC 0x958458f6
+#endif
+#ifndef MPOL_PREFERRED
+#define MPOL_PREFERRED 1
+#endif
+#ifndef MPOL_MF_MOVE
+#define MPOL_MF_MOVE (1 << 1)
+#endif
+
+/*
+ * Layout of the single reserved memory file
+ */
+typedef struct
+{
+    size_t Alignment;
+    size_t ResetOffset;
+    size_t CDSOffset;
+    size_t UserReservedOffset;
+    size_t TotalSize;
+    bool   IsHugeTlb;
+} CFE_PSP_LinuxReservedFileLayout_t;
+
+/*
+** External Variables
+*/
+extern uint32 CFE_PSP_CpuId;
+extern char   CFE_PSP_CpuName[];
+
+/*
+** Global variables
+*/
+char CFE_PSP_ReservedMemoryFileName[PATH_MAX];
+
+/******************************************************************************
+**
+**  Purpose:
+**    Computes the offset of each area within the reserved memory file.
+**
+**  Arguments:
+**    Layout    - layout structure to fill in
+**    Alignment - page size of the underlying file system
+**
+**  Return:
+**    (none)
+*/
+void CFE_PSP_ComputeReservedFileLayout(CFE_PSP_LinuxReservedFileLayout_t *Layout, size_t Alignment)
+{
+    size_t align_mask;
+    size_t offset;
+
+    align_mask        = Alignment - 1;
+    Layout->Alignment = Alignment;
+
+    offset              = sizeof(CFE_PSP_LinuxReservedAreaFixedLayout_t);
+    offset              = (offset + align_mask) & ~align_mask;
+    Layout->ResetOffset = offset;
+    offset += CFE_PSP_RESET_AREA_SIZE;
+    offset            = (offset + align_mask) & ~align_mask;
+    Layout->CDSOffset = offset;
+    offset += CFE_PSP_CDS_SIZE;
+    offset                     = (offset + align_mask) & ~align_mask;
+    Layout->UserReservedOffset = offset;
+    offset += CFE_PSP_USER_RESERVED_SIZE;
+    Layout->TotalSize = (offset + align_mask) & ~align_mask;
+}
+
+/******************************************************************************
+**
+**  Purpose:
+**    Applies the huge page and NUMA placement hints to the mapping.
+**    These are advisory; failures are reported but not fatal.
+**
+**  Arguments:
+**    BlockAddr - start of the mapping
+**    Layout    - layout of the mapping
+**
+**  Return:
+**    (none)
+*/
+void CFE_PSP_AdviseReservedMemory(void *BlockAddr, const CFE_PSP_LinuxReservedFileLayout_t *Layout)
+{
+    unsigned long NodeMask;
+    int           NumaNode;
+
+    /*
+     * On hugetlbfs the file is backed by huge pages already.  Otherwise ask
+     * for transparent huge pages, which tmpfs honors when mounted with the
+     * "huge=advise" (or "huge=always") option.
+     */
+#ifdef MADV_HUGEPAGE
+    if (!Layout->IsHugeTlb && madvise(BlockAddr, Layout->TotalSize, MADV_HUGEPAGE) < 0)
+    {
+        OS_printf("CFE_PSP: Transparent huge pages not available for reserved memory\n");
+    }
+#endif
+
+    /*
+     * The policy only affects pages that are not yet resident, so this
+     * is done before the areas are first touched.  Pages already present
+     * from a previous run are migrated where the kernel permits.
+     */
+    NumaNode = CFE_PSP_RESERVED_MEMORY_NUMA_NODE;
+    if (NumaNode >= 0 && NumaNode < (int)(8 * sizeof(NodeMask)))
+    {
+        NodeMask = 1UL << NumaNode;
+        if (syscall(SYS_mbind, BlockAddr, Layout->TotalSize, MPOL_PREFERRED, &NodeMask, 8 * sizeof(NodeMask),
+                    MPOL_MF_MOVE) < 0)
+        {
+            perror("CFE_PSP - Cannot set NUMA policy for reserved memory");
+        }
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per internal API
+ * See description in cfe_psp_linux_memory.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CFE_PSP_AttachReservedMemory_Impl(void)
+{
+    CFE_PSP_LinuxReservedFileLayout_t       Layout;
+    CFE_PSP_LinuxReservedAreaFixedLayout_t *FixedBlocksPtr;
+    struct statfs                           FsInfo;
+    struct stat                             StatBuf;
+    size_t                                  Alignment;
+    cpuaddr                                 block_addr;
+    bool                                    IsNewFile;
+    int                                     fd;
+    int                                     MapFlags;
+
+    snprintf(CFE_PSP_ReservedMemoryFileName, sizeof(CFE_PSP_ReservedMemoryFileName), "%s/cfe-reserved-%u-%s-%u",
+             CFE_PSP_RESERVED_MEMORY_DIR, (unsigned int)getuid(), CFE_PSP_CpuName, (unsigned int)CFE_PSP_CpuId);
+
+    /*
+     * Use the page size of the file system holding the file, so that on
+     * hugetlbfs each area starts on its own huge page.
+     */
+    Alignment = sysconf(_SC_PAGESIZE);
+    MapFlags  = MAP_SHARED;
+    if (statfs(CFE_PSP_RESERVED_MEMORY_DIR, &FsInfo) < 0)
+    {
+        perror("CFE_PSP - Cannot access reserved memory directory");
+        CFE_PSP_Panic(CFE_PSP_ERROR);
+    }
+
+    CFE_PSP_ComputeReservedFileLayout(&Layout, Alignment);
+    if (FsInfo.f_type == HUGETLBFS_MAGIC)
+    {
+        Layout.IsHugeTlb = true;
+        if ((size_t)FsInfo.f_bsize > Alignment)
+        {
+            CFE_PSP_ComputeReservedFileLayout(&Layout, FsInfo.f_bsize);
+        }
+#ifdef MAP_HUGETLB
+        MapFlags |= MAP_HUGETLB;
+#endif
+    }
+    else
+    {
+        Layout.IsHugeTlb = false;
+    }
+
+    fd = open(CFE_PSP_ReservedMemoryFileName, O_RDWR | O_CREAT, 0600);
+    if (fd < 0)
+    {
+        perror("CFE_PSP - Cannot open reserved memory file");
+        CFE_PSP_Panic(CFE_PSP_ERROR);
+    }
+
+    /*
+     * A file of a different size was made with a different configuration,
+     * so the content cannot be reused.  Truncating to zero first discards it.
+     */
+    IsNewFile = (fstat(fd, &StatBuf) < 0 || (size_t)StatBuf.st_size != Layout.TotalSize);
+    if (IsNewFile)
+    {
+        if (ftruncate(fd, 0) < 0 || ftruncate(fd, Layout.TotalSize) < 0)
+        {
+            perror("CFE_PSP - Cannot size reserved memory file");
+            CFE_PSP_Panic(CFE_PSP_ERROR);
+        }
+    }
+
+    block_addr = (cpuaddr)mmap(NULL, Layout.TotalSize, PROT_READ | PROT_WRITE, MapFlags, fd, 0);
+    if (block_addr == (cpuaddr)MAP_FAILED)
+    {
+        perror("CFE_PSP - Cannot map reserved memory file");
+        CFE_PSP_Panic(CFE_PSP_ERROR);
+    }
+
+    /* the mapping remains valid after the descriptor is closed */
+    close(fd);
+
+    CFE_PSP_AdviseReservedMemory((void *)block_addr, &Layout);
+
+    OS_printf("CFE_PSP: Reserved memory mapped from %s (%lu bytes, %lu byte pages)\n", CFE_PSP_ReservedMemoryFileName,
+              (unsigned long)Layout.TotalSize, (unsigned long)Layout.Alignment);
+
+    FixedBlocksPtr = (CFE_PSP_LinuxReservedAreaFixedLayout_t *)block_addr;
+
+    CFE_PSP_ReservedMemoryMap.BootPtr             = &FixedBlocksPtr->BootRecord;
+    CFE_PSP_ReservedMemoryMap.ExceptionStoragePtr = &FixedBlocksPtr->ExceptionStorage;
+
+    CFE_PSP_ReservedMemoryMap.ResetMemory.BlockPtr  = (void *)(block_addr + Layout.ResetOffset);
+    CFE_PSP_ReservedMemoryMap.ResetMemory.BlockSize = CFE_PSP_RESET_AREA_SIZE;
+
+    CFE_PSP_ReservedMemoryMap.CDSMemory.BlockPtr  = (void *)(block_addr + Layout.CDSOffset);
+    CFE_PSP_ReservedMemoryMap.CDSMemory.BlockSize = CFE_PSP_CDS_SIZE;
+
+    CFE_PSP_ReservedMemoryMap.UserReservedMemory.BlockPtr  = (void *)(block_addr + Layout.UserReservedOffset);
+    CFE_PSP_ReservedMemoryMap.UserReservedMemory.BlockSize = CFE_PSP_USER_RESERVED_SIZE;
+
+    return IsNewFile;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per internal API
+ * See description in cfe_psp_linux_memory.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CFE_PSP_DeleteReservedMemory_Impl(void)
+{
+    if (unlink(CFE_PSP_ReservedMemoryFileName) == 0)
+    {
+        OS_printf("CFE_PSP: Reserved memory file %s removed\n", CFE_PSP_ReservedMemoryFileName);
+    }
+    else
+    {
+        OS_printf("CFE_PSP: Error removing reserved memory file %s\n", CFE_PSP_ReservedMemoryFileName);
+    }
+}
@@ -0,0 +1,416 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/******************************************************************************
+** File:  cfe_psp_memory_shm.c
+**
+**      OSX x86 Linux Version
+**
+** Purpose:
+**   Reserved memory backend using one SysV shared memory segment per area.
+**   The segment keys are derived with ftok() from key files in the current
+**   working directory.
+**
+******************************************************************************/
+
+/*
+**  Include Files
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <string.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <fcntl.h>
+#include <errno.h>
+
+/*
+** cFE includes
+*/
+#include "common_types.h"
+#include "osapi.h"
+
+/*
+** Types and prototypes for this module
+*/
+#include "cfe_psp.h"
+
+/*
+** PSP Specific defines
+*/
+#include "cfe_psp_config.h"
+#include "cfe_psp_memory.h"
+#include "cfe_psp_linux_memory.h"
+
+#define CFE_PSP_CDS_KEY_FILE      ".cdskeyfile"
+#define CFE_PSP_RESET_KEY_FILE    ".resetkeyfile"
+#define CFE_PSP_RESERVED_KEY_FILE ".reservedkeyfile"
+
+/*
+** Internal prototypes for this module
+*/
+bool CFE_PSP_InitCDS(void);
+void CFE_PSP_InitResetArea(void);
+void CFE_PSP_InitUserReservedArea(void);
+void CFE_PSP_DeleteCDS(void);
+void CFE_PSP_DeleteResetArea(void);
+void CFE_PSP_DeleteUserReservedArea(void);
+
+/*
+** Global variables
+*/
+int ResetAreaShmId;
+int CDSShmId;
+int UserShmId;
+
+/*
+*********************************************************************************
+** CDS related functions
+*********************************************************************************
+*/
+
+/******************************************************************************
+**
+**  Purpose: This function is used by the ES startup code to initialize the
+**            Critical Data store area
+**
+**
+**  Arguments:
+**    (none)
+**
+**  Return:
+**    true if the segment was newly created
+*/
+bool CFE_PSP_InitCDS(void)
+{
+    key_t key;
+    bool  IsNewSegment;
+
+    /*
+    ** Make the Shared memory key
+    */
+    if ((key = ftok(CFE_PSP_CDS_KEY_FILE, 'R')) == -1)
+    {
+        perror("CFE_PSP - Cannot Create CDS Shared memory key");
+        CFE_PSP_Panic(CFE_PSP_ERROR);
+    }
+
+    /*
+    ** connect to (and possibly create) the segment:
+    ** Exclusive creation is tried first, to know whether the content is new.
+    */
+    IsNewSegment = true;
+    CDSShmId     = shmget(key, CFE_PSP_CDS_SIZE, 0644 | IPC_CREAT | IPC_EXCL);
+    if (CDSShmId == -1 && errno == EEXIST)
+    {
+        IsNewSegment = false;
+        CDSShmId     = shmget(key, CFE_PSP_CDS_SIZE, 0644);
+    }
+    if (CDSShmId == -1)
+    {
+        perror("CFE_PSP - Cannot shmget CDS Shared memory Segment");
+        CFE_PSP_Panic(CFE_PSP_ERROR);
+    }
+
+    /*
+    ** attach to the segment to get a pointer to it:
+    */
+    CFE_PSP_ReservedMemoryMap.CDSMemory.BlockPtr = shmat(CDSShmId, (void *)0, 0);
+    if (CFE_PSP_ReservedMemoryMap.CDSMemory.BlockPtr == (void *)(-1))
+    {
+        perror("CFE_PSP - Cannot shmat to CDS Shared memory Segment");
+        CFE_PSP_Panic(CFE_PSP_ERROR);
+    }
+
+    CFE_PSP_ReservedMemoryMap.CDSMemory.BlockSize = CFE_PSP_CDS_SIZE;
+
+    return IsNewSegment;
+}
+
+/******************************************************************************
+**
+**  Purpose:
+**   This is an internal function to delete the CDS Shared memory segment.
+**
+**  Arguments:
+**    (none)
+**
+**  Return:
+**    (none)
+*/
+void CFE_PSP_DeleteCDS(void)
+{
+    int             ReturnCode;
+    struct shmid_ds ShmCtrl;
+
+    ReturnCode = shmctl(CDSShmId, IPC_RMID, &ShmCtrl);
+
+    if (ReturnCode == 0)
+    {
+        OS_printf("CFE_PSP: Critical Data Store Shared memory segment removed\n");
+    }
+    else
+    {
+        OS_printf("CFE_PSP: Error Removing Critical Data Store Shared memory Segment.\n");
+        OS_printf("CFE_PSP: It can be manually checked and removed using the ipcs and ipcrm commands.\n");
+    }
+}
+
+/*
+*********************************************************************************
+** ES Reset Area related functions
+*********************************************************************************
+*/
+
+/******************************************************************************
+**
+**  Purpose:
+**    This function is used by the ES startup code to initialize the
+**     ES Reset Area.
+**
+**  Arguments:
+**    (none)
+**
+**  Return:
+**    (none)
+*/
+void CFE_PSP_InitResetArea(void)
+{
+    key_t                                   key;
+    size_t                                  total_size;
+    size_t                                  reset_offset;
+    size_t                                  align_mask;
+    cpuaddr                                 block_addr;
+    CFE_PSP_LinuxReservedAreaFixedLayout_t *FixedBlocksPtr;
+    /*
+    ** Make the Shared memory key
+    */
+    if ((key = ftok(CFE_PSP_RESET_KEY_FILE, 'R')) == -1)
+    {
+        perror("CFE_PSP - Cannot Create Reset Area Shared memory key");
+        CFE_PSP_Panic(CFE_PSP_ERROR);
+    }
+
+    /*
+     * NOTE: Historically the CFE ES reset area also contains the Exception log.
+     * This is now allocated as a separate structure in the PSP, but it can
+     * reside in this shared memory segment so it will be preserved on a processor
+     * reset.
+     */
+    align_mask   = sysconf(_SC_PAGESIZE) - 1; /* align blocks to whole memory pages */
+    total_size   = sizeof(CFE_PSP_LinuxReservedAreaFixedLayout_t);
+    total_size   = (total_size + align_mask) & ~align_mask;
+    reset_offset = total_size;
+    total_size += CFE_PSP_RESET_AREA_SIZE;
+    total_size = (total_size + align_mask) & ~align_mask;
+
+    /*
+    ** connect to (and possibly create) the segment:
+    */
+    if ((ResetAreaShmId = shmget(key, total_size, 0644 | IPC_CREAT)) == -1)
+    {
+        perror("CFE_PSP - Cannot shmget Reset Area Shared memory Segment");
+        CFE_PSP_Panic(CFE_PSP_ERROR);
+    }
+
+    /*
+    ** attach to the segment to get a pointer to it:
+    */
+    block_addr = (cpuaddr)shmat(ResetAreaShmId, (void *)0, 0);
+    if (block_addr == (cpuaddr)(-1))
+    {
+        perror("CFE_PSP - Cannot shmat to Reset Area Shared memory Segment");
+        CFE_PSP_Panic(CFE_PSP_ERROR);
+    }
+
+    FixedBlocksPtr = (CFE_PSP_LinuxReservedAreaFixedLayout_t *)block_addr;
+    block_addr += reset_offset;
+
+    CFE_PSP_ReservedMemoryMap.BootPtr             = &FixedBlocksPtr->BootRecord;
+    CFE_PSP_ReservedMemoryMap.ExceptionStoragePtr = &FixedBlocksPtr->ExceptionStorage;
+
+    CFE_PSP_ReservedMemoryMap.ResetMemory.BlockPtr  = (void *)block_addr;
+    CFE_PSP_ReservedMemoryMap.ResetMemory.BlockSize = CFE_PSP_RESET_AREA_SIZE;
+}
+
+/******************************************************************************
+**
+**  Purpose:
+**   This is an internal function to delete the Reset Area Shared memory segment.
+**
+**  Arguments:
+**    (none)
+**
+**  Return:
+**    (none)
+*/
+void CFE_PSP_DeleteResetArea(void)
+{
+    int             ReturnCode;
+    struct shmid_ds ShmCtrl;
+
+    ReturnCode = shmctl(ResetAreaShmId, IPC_RMID, &ShmCtrl);
+
+    if (ReturnCode == 0)
+    {
+        OS_printf("Reset Area Shared memory segment removed\n");
+    }
+    else
+    {
+        OS_printf("Error Removing Reset Area Shared memory Segment.\n");
+        OS_printf("It can be manually checked and removed using the ipcs and ipcrm commands.\n");
+    }
+}
+
+/*
+*********************************************************************************
+** ES User Reserved Area related functions
+*********************************************************************************
+*/
+
+/******************************************************************************
+**
+**  Purpose:
+**    This function is used by the ES startup code to initialize the
+**      ES user reserved area.
+**
+**  Arguments:
+**    (none)
+**
+**  Return:
+**    (none)
+*/
+void CFE_PSP_InitUserReservedArea(void)
+{
+    key_t key;
+
+    /*
+    ** Make the Shared memory key
+    */
+    if ((key = ftok(CFE_PSP_RESERVED_KEY_FILE, 'R')) == -1)
+    {
+        perror("CFE_PSP - Cannot Create User Reserved Area Shared memory key");
+        CFE_PSP_Panic(CFE_PSP_ERROR);
+    }
+
+    /*
+    ** connect to (and possibly create) the segment:
+    */
+    if ((UserShmId = shmget(key, CFE_PSP_USER_RESERVED_SIZE, 0644 | IPC_CREAT)) == -1)
+    {
+        perror("CFE_PSP - Cannot shmget User Reserved Area Shared memory Segment");
+        CFE_PSP_Panic(CFE_PSP_ERROR);
+    }
+
+    /*
+    ** attach to the segment to get a pointer to it:
+    */
+    CFE_PSP_ReservedMemoryMap.UserReservedMemory.BlockPtr = shmat(UserShmId, (void *)0, 0);
+    if (CFE_PSP_ReservedMemoryMap.UserReservedMemory.BlockPtr == (void *)(-1))
+    {
+        perror("CFE_PSP - Cannot shmat to User Reserved Area Shared memory Segment");
+        CFE_PSP_Panic(CFE_PSP_ERROR);
+    }
+
+    CFE_PSP_ReservedMemoryMap.UserReservedMemory.BlockSize = CFE_PSP_USER_RESERVED_SIZE;
+}
+
+/******************************************************************************
+**
+**  Purpose:
+**   This is an internal function to delete the User Reserved Shared memory segment.
+**
+**  Arguments:
+**    (none)
+**
+**  Return:
+**    (none)
+*/
+void CFE_PSP_DeleteUserReservedArea(void)
+{
+    int             ReturnCode;
+    struct shmid_ds ShmCtrl;
+
+    ReturnCode = shmctl(UserShmId, IPC_RMID, &ShmCtrl);
+
+    if (ReturnCode == 0)
+    {
+        OS_printf("User Reserved Area Shared memory segment removed\n");
+    }
+    else
+    {
+        OS_printf("Error Removing User Reserved Area Shared memory Segment.\n");
+        OS_printf("It can be manually checked and removed using the ipcs and ipcrm commands.\n");
+    }
+}
+
+/*
+*********************************************************************************
+** Backend entry points
+*********************************************************************************
+*/
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per internal API
+ * See description in cfe_psp_linux_memory.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CFE_PSP_AttachReservedMemory_Impl(void)
+{
+    int  tempFd;
+    bool IsNewCDS;
+
+    /*
+    ** Create the key files for the shared memory segments
+    ** The files are not needed, so they are closed right away.
+    */
+    tempFd = open(CFE_PSP_CDS_KEY_FILE, O_RDONLY | O_CREAT, S_IRWXU);
+    close(tempFd);
+    tempFd = open(CFE_PSP_RESET_KEY_FILE, O_RDONLY | O_CREAT, S_IRWXU);
+    close(tempFd);
+    tempFd = open(CFE_PSP_RESERVED_KEY_FILE, O_RDONLY | O_CREAT, S_IRWXU);
+    close(tempFd);
+
+    /*
+     * The setup of each section is done as a separate init.
+     *
+     * Any failures within these routines call exit(), so there
+     * is no need to check status - failure means no return.
+     */
+    IsNewCDS = CFE_PSP_InitCDS();
+    CFE_PSP_InitResetArea();
+    CFE_PSP_InitUserReservedArea();
+
+    return IsNewCDS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per internal API
+ * See description in cfe_psp_linux_memory.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CFE_PSP_DeleteReservedMemory_Impl(void)
+{
+    CFE_PSP_DeleteCDS();
+    CFE_PSP_DeleteResetArea();
+    CFE_PSP_DeleteUserReservedArea();
+}
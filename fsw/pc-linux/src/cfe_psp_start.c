@@ -82,6 +82,14 @@
  */
 #define CFE_PSP_KERNEL_NAME_LENGTH_MAX 16
 
+/*
+ * Option codes for the long-only options, outside the range of short option characters
+ */
+#define CFE_PSP_OPT_EEPROM_FILE      0x100
+#define CFE_PSP_OPT_EEPROM_SIZE      0x101
+#define CFE_PSP_OPT_EEPROM_BANKS     0x102
+#define CFE_PSP_OPT_WATCHDOG_RESTART 0x103
+
 /*
 ** Typedefs for this module
 */
@@ -111,6 +119,7 @@ typedef struct
 ** Prototypes for this module
 */
 void CFE_PSP_DisplayUsage(char *Name);
+bool CFE_PSP_ParseUnsignedArg(const char *Arg, uint32 MinValue, uint32 MaxValue, uint32 *Value);
 void CFE_PSP_ProcessArgumentDefaults(CFE_PSP_CommandData_t *CommandDataDefault);
 
 /*
@@ -123,6 +132,7 @@ uint32                CFE_PSP_CpuId;
 char                  CFE_PSP_CpuName[CFE_PSP_CPU_NAME_LENGTH];
 
 CFE_PSP_IdleTaskState_t CFE_PSP_IdleTaskState;
+CFE_PSP_EepromConfig_t  CFE_PSP_EepromConfig;
 
 /*
 ** getopts parameter passing options string
@@ -137,6 +147,10 @@ static const struct option longOpts[] = {{"reset", required_argument, NULL, 'R'}
                                          {"cpuid", required_argument, NULL, 'C'},
                                          {"scid", required_argument, NULL, 'I'},
                                          {"cpuname", required_argument, NULL, 'N'},
+                                         {"eeprom-file", required_argument, NULL, CFE_PSP_OPT_EEPROM_FILE},
+                                         {"eeprom-size", required_argument, NULL, CFE_PSP_OPT_EEPROM_SIZE},
+                                         {"eeprom-banks", required_argument, NULL, CFE_PSP_OPT_EEPROM_BANKS},
+                                         {"watchdog-restart", no_argument, NULL, CFE_PSP_OPT_WATCHDOG_RESTART},
                                          {"help", no_argument, NULL, 'h'},
                                          {NULL, no_argument, NULL, 0}};
 
@@ -161,9 +175,14 @@ int32 CFE_PSP_OS_EventHandler(OS_Event_t event, osal_id_t object_id, void *data)
             break;
         case OS_EVENT_RESOURCE_CREATED:
             /* resource/id has been fully created/finalized.  Invoked outside locked region. */
-            break;
         case OS_EVENT_RESOURCE_DELETED:
             /* resource/id has been deleted.  Invoked outside locked region. */
+
+            /* A module load/unload changes the objects that exceptions may refer to */
+            if (OS_IdentifyObject(object_id) == OS_OBJECT_TYPE_OS_MODULE)
+            {
+                CFE_PSP_ExceptionUpdateLoadMap();
+            }
             break;
         case OS_EVENT_TASK_STARTUP:
         {
@@ -295,6 +314,35 @@ void OS_Application_Startup(void)
                 CommandData.GotSpacecraftId = 1;
                 break;
 
+            case CFE_PSP_OPT_EEPROM_FILE:
+                strncpy(CFE_PSP_EepromConfig.FileName, optarg, sizeof(CFE_PSP_EepromConfig.FileName) - 1);
+                CFE_PSP_EepromConfig.FileName[sizeof(CFE_PSP_EepromConfig.FileName) - 1] = 0;
+                printf("CFE_PSP: EEPROM File: %s\n", CFE_PSP_EepromConfig.FileName);
+                break;
+
+            case CFE_PSP_OPT_EEPROM_SIZE:
+                if (!CFE_PSP_ParseUnsignedArg(optarg, 1, 0xFFFFFFFF, &CFE_PSP_EepromConfig.BankSize))
+                {
+                    printf("\nERROR: Invalid EEPROM Bank Size: %s\n\n", optarg);
+                    CFE_PSP_DisplayUsage(argv[0]);
+                }
+                printf("CFE_PSP: EEPROM Bank Size: %lu\n", (unsigned long)CFE_PSP_EepromConfig.BankSize);
+                break;
+
+            case CFE_PSP_OPT_EEPROM_BANKS:
+                if (!CFE_PSP_ParseUnsignedArg(optarg, 1, CFE_PSP_NUM_EEPROM_BANKS, &CFE_PSP_EepromConfig.NumBanks))
+                {
+                    printf("\nERROR: Invalid EEPROM Bank Count: %s\n\n", optarg);
+                    CFE_PSP_DisplayUsage(argv[0]);
+                }
+                printf("CFE_PSP: EEPROM Banks: %lu\n", (unsigned long)CFE_PSP_EepromConfig.NumBanks);
+                break;
+
+            case CFE_PSP_OPT_WATCHDOG_RESTART:
+                CFE_PSP_WatchdogRestartOnMiss = true;
+                printf("CFE_PSP: Watchdog deadline misses restart the cFE\n");
+                break;
+
             case 'h':
                 CFE_PSP_DisplayUsage(argv[0]);
                 break;
@@ -487,6 +535,47 @@ void OS_Application_Run(void)
     OS_DeleteAllObjects();
 }
 
+/******************************************************************************
+**
+**  Purpose:
+**    Convert a numeric command line argument, in any base accepted by strtoul().
+**    The whole argument must be a number within the given limits.
+**
+**  Arguments:
+**    Arg      -- the argument text.
+**    MinValue -- the smallest accepted value.
+**    MaxValue -- the largest accepted value.
+**    Value    -- set to the converted value, only if it is valid.
+**
+**  Return:
+**    true if the argument is valid
+*/
+bool CFE_PSP_ParseUnsignedArg(const char *Arg, uint32 MinValue, uint32 MaxValue, uint32 *Value)
+{
+    unsigned long Result;
+    char *        EndPtr;
+
+    /* strtoul() would accept and negate a leading minus sign */
+    while (*Arg == ' ' || *Arg == '\t')
+    {
+        ++Arg;
+    }
+    if (*Arg == '-')
+    {
+        return false;
+    }
+
+    errno  = 0;
+    Result = strtoul(Arg, &EndPtr, 0);
+    if (errno != 0 || EndPtr == Arg || *EndPtr != 0 || Result < MinValue || Result > MaxValue)
+    {
+        return false;
+    }
+
+    *Value = Result;
+    return true;
+}
+
 /******************************************************************************
 **
 **  Purpose:
@@ -521,6 +610,13 @@ void CFE_PSP_DisplayUsage(char *Name)
     printf("        -I [ --scid ]    Spacecraft ID is an integer Spacecraft identifier.\n");
     printf("             The default Spacecraft ID is from the mission configuration file: %d\n",
            CFE_PSP_SPACECRAFT_ID);
+    printf("        --eeprom-file    Path of the simulated EEPROM file for bank 0.\n");
+    printf("             Additional banks use the same path with the bank number appended.\n");
+    printf("        --eeprom-size    Size of each simulated EEPROM bank in bytes, at least 1.\n");
+    printf("        --eeprom-banks   Number of simulated EEPROM banks, 1 to %d.\n", CFE_PSP_NUM_EEPROM_BANKS);
+    printf("             The EEPROM defaults are set by the build configuration.\n");
+    printf("        --watchdog-restart Restart the cFE (processor reset) when the watchdog is not\n");
+    printf("             serviced in time.  By default the miss is only recorded as an exception.\n");
     printf("        -h [ --help ]    This message.\n");
     printf("\n");
     printf("       Example invocation:\n");
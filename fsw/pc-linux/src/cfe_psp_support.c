@@ -70,6 +70,9 @@ void CFE_PSP_Restart(uint32 resetType)
     else
     {
         OS_printf("CFE_PSP: Exiting cFE with PROCESSOR Reset status.\n");
+
+        /* Bring the CDS backing file up to date with any outstanding writes */
+        CFE_PSP_FlushCDS();
     }
 
     /*
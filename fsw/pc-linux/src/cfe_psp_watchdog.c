@@ -44,12 +44,77 @@
 */
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <signal.h>
+#include <execinfo.h>
+#include <sys/timerfd.h>
 
 /*
 ** Types and prototypes for this module
 */
 #include "cfe_psp.h"
 #include "cfe_psp_config.h"
+#include "cfe_psp_exceptionstorage_types.h"
+#include "cfe_psp_exceptionstorage_api.h"
+
+/*
+ * The monitor checks the deadline this many times per watchdog period,
+ * within the limits below, so a miss is detected at most one check late.
+ */
+#define CFE_PSP_WATCHDOG_CHECKS_PER_PERIOD 8
+#define CFE_PSP_WATCHDOG_MIN_CHECK_NS      1000000ULL
+#define CFE_PSP_WATCHDOG_MAX_CHECK_NS      1000000000ULL
+
+/*
+ * How long the monitor waits for the stalled thread to save its backtrace,
+ * in milliseconds.  The record is saved without one after that.
+ */
+#define CFE_PSP_WATCHDOG_BACKTRACE_WAIT 100
+
+/*
+ * States of the record of a missed deadline, see CFE_PSP_WatchdogState_t
+ */
+#define CFE_PSP_WATCHDOG_RECORD_IDLE    0 /* no record in progress */
+#define CFE_PSP_WATCHDOG_RECORD_PENDING 1 /* waiting for the backtrace of the stalled thread */
+#define CFE_PSP_WATCHDOG_RECORD_FILLING 2 /* being completed by the thread that claimed it */
+#define CFE_PSP_WATCHDOG_RECORD_DONE    3 /* committed to the exception storage */
+
+/*
+ * State of the watchdog monitor
+ *
+ * CFE_PSP_WatchdogService() only sets Serviced, which the monitor thread
+ * takes back at each check, so servicing is a single store and never waits.
+ * The statistics are only written by the monitor thread.
+ */
+typedef struct
+{
+    bool      MonitorStarted;
+    pthread_t MonitorThread;
+    int       TimerFd;
+
+    bool      Enabled;
+    uint32    Serviced;
+    bool      HaveWatchedThread;
+    pthread_t WatchedThread; /* thread that enabled the watchdog, the one reported if it stalls */
+
+    uint64 LastServiceNs;  /* time the service was last seen, CLOCK_MONOTONIC */
+    uint64 CheckNs;        /* current period of the checks */
+    bool   DeadlineMissed; /* the current miss was already recorded */
+
+    /* statistics of the service intervals, to the resolution of the checks */
+    uint32 NumServices;
+    uint32 NumMissed;
+    uint64 MaxIntervalNs;
+    uint64 SumIntervalNs;
+
+    /* the record of a missed deadline in progress */
+    CFE_PSP_Exception_LogData_t *Record;
+    uint32                       RecordState;
+} CFE_PSP_WatchdogState_t;
 
 /*
 ** Global data
@@ -60,6 +125,318 @@
 */
 uint32 CFE_PSP_WatchdogValue = CFE_PSP_WATCHDOG_MAX;
 
+/*
+** Restart the cFE when a deadline is missed, set from the command line
+*/
+bool CFE_PSP_WatchdogRestartOnMiss;
+
+CFE_PSP_WatchdogState_t CFE_PSP_WatchdogState = {.TimerFd = -1};
+
+/*
+**
+** Gets the current time of the monitor in nanoseconds
+**
+*/
+uint64 CFE_PSP_WatchdogGetTimeNs(void)
+{
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+    return ((uint64)Now.tv_sec * 1000000000ULL) + Now.tv_nsec;
+}
+
+/*
+**
+** Completes the record of a missed deadline, with whatever backtrace it holds,
+** and commits it to the exception storage.  May be called from the signal handler.
+**
+*/
+void CFE_PSP_WatchdogCommitRecord(CFE_PSP_Exception_LogData_t *Buffer)
+{
+    CFE_PSP_ExceptionSaveLoadMap(&Buffer->context_info, NULL);
+    Buffer->context_size = offsetof(CFE_PSP_Exception_ContextDataEntry_t, modules[Buffer->context_info.NumModules]);
+    CFE_PSP_Exception_WriteComplete(Buffer);
+
+    __atomic_store_n(&CFE_PSP_WatchdogState.RecordState, CFE_PSP_WATCHDOG_RECORD_DONE, __ATOMIC_RELEASE);
+}
+
+/*
+**
+** Installed as the handler of CFE_PSP_WATCHDOG_SIGNAL, which the monitor
+** sends to the stalled thread so that it saves its own backtrace.
+**
+*/
+void CFE_PSP_WatchdogSigHandler(int signo, siginfo_t *si, void *ctxt)
+{
+    CFE_PSP_Exception_LogData_t *Buffer;
+    uint32                       Expected;
+    int                          SavedErrno;
+
+    /* the monitor may have given up waiting, in which case the record is no longer ours */
+    Expected = CFE_PSP_WATCHDOG_RECORD_PENDING;
+    if (!__atomic_compare_exchange_n(&CFE_PSP_WatchdogState.RecordState, &Expected, CFE_PSP_WATCHDOG_RECORD_FILLING,
+                                     false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+        return;
+    }
+
+    /* this interrupts whatever the thread was doing, which may check errno */
+    SavedErrno = errno;
+
+    Buffer                        = CFE_PSP_WatchdogState.Record;
+    Buffer->context_info.NumAddrs = backtrace(Buffer->context_info.bt_addrs, CFE_PSP_MAX_EXCEPTION_BACKTRACE_SIZE);
+    CFE_PSP_WatchdogCommitRecord(Buffer);
+
+    errno = SavedErrno;
+}
+
+/*
+**
+** Records a missed deadline in the exception storage, with the backtrace of
+** the watched thread if it can be obtained.
+**
+** The record looks like a signal: si_signo is CFE_PSP_WATCHDOG_SIGNAL with
+** si_code SI_TIMER, see cfe_psp_exception_context.h for the other fields.
+**
+*/
+void CFE_PSP_WatchdogRecordMiss(uint64 SinceServiceNs)
+{
+    CFE_PSP_WatchdogState_t *    State = &CFE_PSP_WatchdogState;
+    CFE_PSP_Exception_LogData_t *Buffer;
+    uint32                       Expected;
+    uint32                       Wait;
+
+    Buffer = CFE_PSP_Exception_GetNextContextBuffer();
+    if (Buffer == NULL)
+    {
+        /* the storage is full, the miss is still counted and reported */
+        return;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &Buffer->context_info.event_time);
+    Buffer->context_info.si.si_signo           = CFE_PSP_WATCHDOG_SIGNAL;
+    Buffer->context_info.si.si_code            = SI_TIMER;
+    Buffer->context_info.si.si_timerid         = __atomic_load_n(&CFE_PSP_WatchdogValue, __ATOMIC_RELAXED);
+    Buffer->context_info.si.si_overrun         = State->NumMissed;
+    Buffer->context_info.si.si_value.sival_int = SinceServiceNs / 1000000;
+
+    State->Record = Buffer;
+    __atomic_store_n(&State->RecordState, CFE_PSP_WATCHDOG_RECORD_PENDING, __ATOMIC_RELEASE);
+
+    if (__atomic_load_n(&State->HaveWatchedThread, __ATOMIC_ACQUIRE))
+    {
+        Buffer->sys_task_id = State->WatchedThread;
+        if (pthread_kill(State->WatchedThread, CFE_PSP_WATCHDOG_SIGNAL) == 0)
+        {
+            for (Wait = 0; Wait < CFE_PSP_WATCHDOG_BACKTRACE_WAIT &&
+                           __atomic_load_n(&State->RecordState, __ATOMIC_ACQUIRE) != CFE_PSP_WATCHDOG_RECORD_DONE;
+                 ++Wait)
+            {
+                usleep(1000);
+            }
+        }
+    }
+
+    /* no backtrace in time, save the record without it */
+    Expected = CFE_PSP_WATCHDOG_RECORD_PENDING;
+    if (__atomic_compare_exchange_n(&State->RecordState, &Expected, CFE_PSP_WATCHDOG_RECORD_FILLING, false,
+                                    __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+        CFE_PSP_WatchdogCommitRecord(Buffer);
+    }
+
+    /* the stalled thread may be writing it right now */
+    while (__atomic_load_n(&State->RecordState, __ATOMIC_ACQUIRE) != CFE_PSP_WATCHDOG_RECORD_DONE)
+    {
+        usleep(1000);
+    }
+    __atomic_store_n(&State->RecordState, CFE_PSP_WATCHDOG_RECORD_IDLE, __ATOMIC_RELAXED);
+}
+
+/*
+**
+** Sets the period of the checks for the current watchdog value
+**
+*/
+void CFE_PSP_WatchdogArmTimer(void)
+{
+    CFE_PSP_WatchdogState_t *State = &CFE_PSP_WatchdogState;
+    struct itimerspec        Spec;
+    uint64                   CheckNs;
+
+    CheckNs = ((uint64)__atomic_load_n(&CFE_PSP_WatchdogValue, __ATOMIC_RELAXED) * 1000000ULL) /
+              CFE_PSP_WATCHDOG_CHECKS_PER_PERIOD;
+    if (CheckNs < CFE_PSP_WATCHDOG_MIN_CHECK_NS)
+    {
+        CheckNs = CFE_PSP_WATCHDOG_MIN_CHECK_NS;
+    }
+    else if (CheckNs > CFE_PSP_WATCHDOG_MAX_CHECK_NS)
+    {
+        CheckNs = CFE_PSP_WATCHDOG_MAX_CHECK_NS;
+    }
+
+    if (CheckNs != State->CheckNs)
+    {
+        State->CheckNs = CheckNs;
+
+        Spec.it_interval.tv_sec  = CheckNs / 1000000000ULL;
+        Spec.it_interval.tv_nsec = CheckNs % 1000000000ULL;
+        Spec.it_value            = Spec.it_interval;
+        timerfd_settime(State->TimerFd, 0, &Spec, NULL);
+    }
+}
+
+/*
+**
+** Checks the deadline, called by the monitor at each expiry of the timer
+**
+*/
+void CFE_PSP_WatchdogCheck(bool *WasEnabled)
+{
+    CFE_PSP_WatchdogState_t *State = &CFE_PSP_WatchdogState;
+    uint64                   Now;
+    uint64                   DeadlineNs;
+    uint64                   IntervalNs;
+
+    Now = CFE_PSP_WatchdogGetTimeNs();
+    if (!__atomic_load_n(&State->Enabled, __ATOMIC_ACQUIRE))
+    {
+        *WasEnabled = false;
+        return;
+    }
+    if (!*WasEnabled)
+    {
+        /* the deadline runs from the time the watchdog was enabled */
+        *WasEnabled           = true;
+        State->LastServiceNs  = Now;
+        State->DeadlineMissed = false;
+        __atomic_store_n(&State->Serviced, 0, __ATOMIC_RELAXED);
+        return;
+    }
+
+    if (__atomic_exchange_n(&State->Serviced, 0, __ATOMIC_ACQUIRE) != 0)
+    {
+        IntervalNs = Now - State->LastServiceNs;
+        if (IntervalNs > State->MaxIntervalNs)
+        {
+            State->MaxIntervalNs = IntervalNs;
+        }
+        State->SumIntervalNs += IntervalNs;
+        ++State->NumServices;
+
+        State->LastServiceNs  = Now;
+        State->DeadlineMissed = false;
+        return;
+    }
+
+    DeadlineNs = (uint64)__atomic_load_n(&CFE_PSP_WatchdogValue, __ATOMIC_RELAXED) * 1000000ULL;
+    if (State->DeadlineMissed || (Now - State->LastServiceNs) <= DeadlineNs)
+    {
+        return;
+    }
+
+    /* record each miss once, until the watchdog is serviced again */
+    State->DeadlineMissed = true;
+    ++State->NumMissed;
+    CFE_PSP_WatchdogRecordMiss(Now - State->LastServiceNs);
+
+    OS_printf("CFE_PSP: Watchdog deadline of %lu ms missed, not serviced for %lu ms "
+              "(interval max %lu ms, mean %lu ms, %lu missed)\n",
+              (unsigned long)(DeadlineNs / 1000000), (unsigned long)((Now - State->LastServiceNs) / 1000000),
+              (unsigned long)(State->MaxIntervalNs / 1000000),
+              (unsigned long)(State->NumServices ? (State->SumIntervalNs / State->NumServices) / 1000000 : 0),
+              (unsigned long)State->NumMissed);
+
+    if (CFE_PSP_WatchdogRestartOnMiss)
+    {
+        CFE_PSP_Restart(CFE_PSP_RST_TYPE_PROCESSOR);
+    }
+}
+
+/*
+**
+** Entry point of the monitor thread
+**
+*/
+void *CFE_PSP_WatchdogMonitor(void *arg)
+{
+    CFE_PSP_WatchdogState_t *State = &CFE_PSP_WatchdogState;
+    uint64                   Expirations;
+    bool                     WasEnabled;
+
+    WasEnabled = false;
+    while (true)
+    {
+        CFE_PSP_WatchdogArmTimer();
+        if (read(State->TimerFd, &Expirations, sizeof(Expirations)) != sizeof(Expirations))
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+
+        CFE_PSP_WatchdogCheck(&WasEnabled);
+    }
+
+    OS_printf("CFE_PSP: Watchdog monitor stopped, errno %d\n", errno);
+    return NULL;
+}
+
+/*
+**
+** Starts the monitor thread, once.  Without it the watchdog only keeps its value.
+**
+*/
+void CFE_PSP_WatchdogStartMonitor(void)
+{
+    CFE_PSP_WatchdogState_t *State = &CFE_PSP_WatchdogState;
+    struct sigaction         sa;
+    sigset_t                 AllSignals;
+    sigset_t                 SavedMask;
+    void *                   Addr[1];
+    int                      Status;
+
+    if (State->MonitorStarted)
+    {
+        return;
+    }
+
+    /* make sure backtrace() is loaded, so it is safe in the signal handler */
+    backtrace(Addr, 1);
+
+    memset(&sa, 0, sizeof(sa));
+    sigfillset(&sa.sa_mask);
+    sa.sa_sigaction = CFE_PSP_WatchdogSigHandler;
+    sa.sa_flags     = SA_SIGINFO | SA_RESTART;
+    sigaction(CFE_PSP_WATCHDOG_SIGNAL, &sa, NULL);
+
+    State->TimerFd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (State->TimerFd < 0)
+    {
+        OS_printf("CFE_PSP: Watchdog timerfd_create() failed, errno %d\n", errno);
+        return;
+    }
+
+    /* the monitor takes no signals, it inherits the mask of its creator */
+    sigfillset(&AllSignals);
+    pthread_sigmask(SIG_SETMASK, &AllSignals, &SavedMask);
+    Status = pthread_create(&State->MonitorThread, NULL, CFE_PSP_WatchdogMonitor, NULL);
+    pthread_sigmask(SIG_SETMASK, &SavedMask, NULL);
+    if (Status != 0)
+    {
+        OS_printf("CFE_PSP: Watchdog monitor not started, error %d\n", Status);
+        close(State->TimerFd);
+        State->TimerFd = -1;
+        return;
+    }
+
+    pthread_detach(State->MonitorThread);
+    pthread_setname_np(State->MonitorThread, "CFE_PSP_WDOG");
+    State->MonitorStarted = true;
+}
+
 /*----------------------------------------------------------------
  *
  * Implemented per public API
@@ -69,11 +446,11 @@ uint32 CFE_PSP_WatchdogValue = CFE_PSP_WATCHDOG_MAX;
 void CFE_PSP_WatchdogInit(void)
 {
     /*
-    ** Just set it to a value right now
-    ** The pc-linux desktop platform does not actually implement a watchdog
-    ** timeout ( but could with a signal )
+    ** Start with the maximum value, which is never missed in practice.
+    ** The deadline is monitored by a thread once the watchdog is enabled.
     */
     CFE_PSP_WatchdogValue = CFE_PSP_WATCHDOG_MAX;
+    CFE_PSP_WatchdogStartMonitor();
 }
 
 /*----------------------------------------------------------------
@@ -82,7 +459,25 @@ void CFE_PSP_WatchdogInit(void)
  * See description in header file for argument/return detail
  *
  *-----------------------------------------------------------------*/
-void CFE_PSP_WatchdogEnable(void) {}
+void CFE_PSP_WatchdogEnable(void)
+{
+    CFE_PSP_WatchdogState_t *State = &CFE_PSP_WatchdogState;
+    sigset_t                 sigset;
+
+    /*
+     * The caller is the thread that services the watchdog, so it is the
+     * one that gets reported if the deadline is missed.  OSAL blocks most
+     * signals in its tasks, so let this one through.  Taking the backtrace
+     * may cut short a sleep of this thread, which OSAL delays resume.
+     */
+    sigemptyset(&sigset);
+    sigaddset(&sigset, CFE_PSP_WATCHDOG_SIGNAL);
+    pthread_sigmask(SIG_UNBLOCK, &sigset, NULL);
+
+    State->WatchedThread = pthread_self();
+    __atomic_store_n(&State->HaveWatchedThread, true, __ATOMIC_RELEASE);
+    __atomic_store_n(&State->Enabled, true, __ATOMIC_RELEASE);
+}
 
 /*----------------------------------------------------------------
  *
@@ -90,7 +485,10 @@ void CFE_PSP_WatchdogEnable(void) {}
  * See description in header file for argument/return detail
  *
  *-----------------------------------------------------------------*/
-void CFE_PSP_WatchdogDisable(void) {}
+void CFE_PSP_WatchdogDisable(void)
+{
+    __atomic_store_n(&CFE_PSP_WatchdogState.Enabled, false, __ATOMIC_RELEASE);
+}
 
 /*----------------------------------------------------------------
  *
@@ -98,7 +496,11 @@ void CFE_PSP_WatchdogDisable(void) {}
  * See description in header file for argument/return detail
  *
  *-----------------------------------------------------------------*/
-void CFE_PSP_WatchdogService(void) {}
+void CFE_PSP_WatchdogService(void)
+{
+    /* the monitor thread does the rest */
+    __atomic_store_n(&CFE_PSP_WatchdogState.Serviced, 1, __ATOMIC_RELEASE);
+}
 
 /*----------------------------------------------------------------
  *
@@ -119,5 +521,6 @@ uint32 CFE_PSP_WatchdogGet(void)
  *-----------------------------------------------------------------*/
 void CFE_PSP_WatchdogSet(uint32 WatchdogValue)
 {
-    CFE_PSP_WatchdogValue = WatchdogValue;
+    /* the monitor uses the new deadline from its next check */
+    __atomic_store_n(&CFE_PSP_WatchdogValue, WatchdogValue, __ATOMIC_RELAXED);
 }
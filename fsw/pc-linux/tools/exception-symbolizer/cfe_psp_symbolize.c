@@ -0,0 +1,216 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * Command line tool to print a readable crash report from a saved pc-linux
+ * exception context.
+ *
+ * The input is the raw context data as saved by the PSP, for example the
+ * context of an entry in the ES exception and reset log.  When the context
+ * is part of a larger file, use -o and -n to select it.
+ *
+ * Usage: cfe-psp-symbolize [-d debugdir]... [-s searchdir]... [-o offset] [-n size] file
+ */
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cfe_psp_symbolizer.h"
+
+static void CFE_PSP_Symbolize_Usage(const char *Name)
+{
+    fprintf(stderr,
+            "Usage: %s [options] file\n"
+            "  -d DIR   directory with separate debug files in a .build-id tree (default /usr/lib/debug)\n"
+            "  -s DIR   directory with the executable and libraries (default current directory)\n"
+            "  -o N     offset of the exception context within the file (default 0)\n"
+            "  -n N     size of the exception context (default rest of the file)\n",
+            Name);
+}
+
+static void CFE_PSP_Symbolize_PrintModule(const CFE_PSP_Exception_ModuleInfo_t *Module, uint32_t Index)
+{
+    uint32_t i;
+
+    printf("  [%u] %-26.*s 0x%lx-0x%lx bias 0x%lx build-id ", (unsigned int)Index, (int)sizeof(Module->Name),
+           Module->Name, (unsigned long)Module->StartAddr, (unsigned long)Module->EndAddr,
+           (unsigned long)Module->LoadBias);
+    for (i = 0; i < Module->BuildIdSize && i < sizeof(Module->BuildId); ++i)
+    {
+        printf("%02x", Module->BuildId[i]);
+    }
+    printf("%s\n", (Module->BuildIdSize == 0) ? "none" : "");
+}
+
+static void CFE_PSP_Symbolize_PrintFrame(CFE_PSP_Symbolizer_t *Sym, const CFE_PSP_SymbolizerRecord_t *Record,
+                                         const char *Label, uintptr_t Addr, int IsReturnAddr)
+{
+    CFE_PSP_SymbolizerFrame_t Frame;
+
+    printf("  %-4s 0x%016lx ", Label, (unsigned long)Addr);
+    if (CFE_PSP_Symbolizer_Resolve(Sym, Record, Addr, IsReturnAddr, &Frame) == CFE_PSP_SYMBOLIZER_SUCCESS)
+    {
+        printf("%s+0x%lx", Frame.Function, (unsigned long)Frame.Offset);
+    }
+    else
+    {
+        printf("??");
+    }
+
+    if (Frame.Module != NULL)
+    {
+        printf(" (%.*s+0x%lx)", (int)sizeof(Frame.Module->Name), Frame.Module->Name, (unsigned long)Frame.FileAddr);
+    }
+    printf("\n");
+}
+
+int main(int argc, char *argv[])
+{
+    CFE_PSP_Symbolizer_t       Sym;
+    CFE_PSP_SymbolizerRecord_t Record;
+    FILE *                     fp;
+    unsigned char *            Data;
+    unsigned long              Offset;
+    unsigned long              Size;
+    size_t                     DataSize;
+    char                       Label[16];
+    uint32_t                   i;
+    int                        opt;
+    int                        Status;
+
+    CFE_PSP_Symbolizer_Init(&Sym);
+    Offset = 0;
+    Size   = 0;
+
+    while ((opt = getopt(argc, argv, "d:s:o:n:h")) != -1)
+    {
+        switch (opt)
+        {
+            case 'd':
+                Status = CFE_PSP_Symbolizer_AddDebugDir(&Sym, optarg);
+                break;
+            case 's':
+                Status = CFE_PSP_Symbolizer_AddSearchDir(&Sym, optarg);
+                break;
+            case 'o':
+                Offset = strtoul(optarg, NULL, 0);
+                Status = CFE_PSP_SYMBOLIZER_SUCCESS;
+                break;
+            case 'n':
+                Size   = strtoul(optarg, NULL, 0);
+                Status = CFE_PSP_SYMBOLIZER_SUCCESS;
+                break;
+            default:
+                CFE_PSP_Symbolize_Usage(argv[0]);
+                return EXIT_FAILURE;
+        }
+
+        if (Status != CFE_PSP_SYMBOLIZER_SUCCESS)
+        {
+            fprintf(stderr, "Too many directories given with -%c\n", opt);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (optind != argc - 1)
+    {
+        CFE_PSP_Symbolize_Usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (Sym.NumDebugDirs == 0)
+    {
+        CFE_PSP_Symbolizer_AddDebugDir(&Sym, "/usr/lib/debug");
+    }
+    if (Sym.NumSearchDirs == 0)
+    {
+        CFE_PSP_Symbolizer_AddSearchDir(&Sym, ".");
+    }
+
+    fp = fopen(argv[optind], "rb");
+    if (fp == NULL)
+    {
+        perror(argv[optind]);
+        return EXIT_FAILURE;
+    }
+
+    /* never need more than a full context */
+    Data = calloc(1, sizeof(Record.Context));
+    if (Data == NULL || fseek(fp, Offset, SEEK_SET) != 0)
+    {
+        fprintf(stderr, "%s: cannot read at offset %lu\n", argv[optind], Offset);
+        fclose(fp);
+        free(Data);
+        return EXIT_FAILURE;
+    }
+    if (Size == 0 || Size > sizeof(Record.Context))
+    {
+        Size = sizeof(Record.Context);
+    }
+    DataSize = fread(Data, 1, Size, fp);
+    fclose(fp);
+
+    Status = CFE_PSP_Symbolizer_DecodeRecord(Data, DataSize, &Record);
+    free(Data);
+    if (Status != CFE_PSP_SYMBOLIZER_SUCCESS)
+    {
+        fprintf(stderr, "%s: only %lu bytes, too short for an exception context\n", argv[optind],
+                (unsigned long)DataSize);
+        return EXIT_FAILURE;
+    }
+
+    printf("Signal %d code %d at %ld.%09ld (monotonic)\n", Record.Context.si.si_signo, Record.Context.si.si_code,
+           (long)Record.Context.event_time.tv_sec, (long)Record.Context.event_time.tv_nsec);
+    if (Record.Context.si.si_signo == CFE_PSP_WATCHDOG_SIGNAL && Record.Context.si.si_code == SI_TIMER)
+    {
+        printf("Watchdog deadline of %u ms missed, not serviced for %d ms (%d missed)\n",
+               (unsigned int)Record.Context.si.si_timerid, Record.Context.si.si_value.sival_int,
+               Record.Context.si.si_overrun);
+    }
+
+    if (Record.NumModules < Record.Context.NumModules)
+    {
+        printf("Note: record holds %u of %u objects, the rest was truncated\n", (unsigned int)Record.NumModules,
+               (unsigned int)Record.Context.NumModules);
+    }
+    printf("Objects:\n");
+    for (i = 0; i < Record.NumModules; ++i)
+    {
+        CFE_PSP_Symbolize_PrintModule(&Record.Context.modules[i], i);
+    }
+
+    printf("Backtrace:\n");
+    if (Record.Context.si.si_signo == SIGFPE || Record.Context.si.si_signo == SIGILL)
+    {
+        /* si_addr is the faulting instruction itself, not a return address */
+        CFE_PSP_Symbolize_PrintFrame(&Sym, &Record, "ip", (uintptr_t)Record.Context.si.si_addr, 0);
+    }
+    for (i = 0; i < Record.NumAddrs; ++i)
+    {
+        snprintf(Label, sizeof(Label), "#%u", (unsigned int)i);
+        CFE_PSP_Symbolize_PrintFrame(&Sym, &Record, Label, (uintptr_t)Record.Context.bt_addrs[i], 1);
+    }
+
+    CFE_PSP_Symbolizer_Cleanup(&Sym);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,640 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * Host-side symbolizer for pc-linux exception contexts.
+ *
+ * ELF files are read whole into memory and only the section headers,
+ * notes and symbol tables are used, so separate debug files (which have
+ * no code) work just as well as the original objects.
+ */
+
+#include <elf.h>
+#include <limits.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cfe_psp_symbolizer.h"
+
+/*
+ * A function symbol, by address within the ELF file
+ */
+typedef struct
+{
+    uintptr_t   Addr;
+    uintptr_t   Size;
+    const char *Name;
+} CFE_PSP_SymbolizerSymbol_t;
+
+/*
+ * Section header fields used here, independent of the ELF class
+ */
+typedef struct
+{
+    uint32_t Type;
+    uint32_t Link;
+    size_t   Offset;
+    size_t   Size;
+    size_t   EntSize;
+} CFE_PSP_SymbolizerSection_t;
+
+struct CFE_PSP_SymbolizerObject
+{
+    char    Name[CFE_PSP_EXCEPTION_MODULE_NAME_SIZE]; /* lookup key: object name and build-id from the record */
+    uint8_t KeyBuildId[CFE_PSP_EXCEPTION_BUILD_ID_SIZE];
+    uint8_t KeyBuildIdSize;
+
+    char    Path[PATH_MAX]; /* file that was loaded, empty if none was found */
+    uint8_t BuildId[CFE_PSP_EXCEPTION_BUILD_ID_SIZE];
+    uint8_t BuildIdSize;
+
+    uint8_t *                   Image;
+    size_t                      ImageSize;
+    CFE_PSP_SymbolizerSymbol_t *Symbols;
+    size_t                      NumSymbols;
+};
+
+/*----------------------------------------------------------------
+ * Reads a whole file into memory; returns NULL if it cannot be read.
+ *-----------------------------------------------------------------*/
+static uint8_t *CFE_PSP_Symbolizer_ReadFile(const char *Path, size_t *Size)
+{
+    FILE *   fp;
+    uint8_t *Image;
+    long     FileSize;
+
+    fp = fopen(Path, "rb");
+    if (fp == NULL)
+    {
+        return NULL;
+    }
+
+    Image = NULL;
+    if (fseek(fp, 0, SEEK_END) == 0 && (FileSize = ftell(fp)) > 0 && fseek(fp, 0, SEEK_SET) == 0)
+    {
+        Image = malloc(FileSize);
+        if (Image != NULL && fread(Image, 1, FileSize, fp) != (size_t)FileSize)
+        {
+            free(Image);
+            Image = NULL;
+        }
+        *Size = FileSize;
+    }
+
+    fclose(fp);
+    return Image;
+}
+
+/*----------------------------------------------------------------
+ * Gets section header Index of the ELF image; returns 0 if it is out of bounds.
+ *-----------------------------------------------------------------*/
+static int CFE_PSP_Symbolizer_GetSection(const CFE_PSP_SymbolizerObject_t *Obj, size_t Index,
+                                         CFE_PSP_SymbolizerSection_t *Section)
+{
+    const Elf64_Ehdr *Ehdr64 = (const Elf64_Ehdr *)Obj->Image;
+    const Elf32_Ehdr *Ehdr32 = (const Elf32_Ehdr *)Obj->Image;
+    const Elf64_Shdr *Shdr64;
+    const Elf32_Shdr *Shdr32;
+    size_t            Pos;
+
+    if (Obj->Image[EI_CLASS] == ELFCLASS64)
+    {
+        Pos = Ehdr64->e_shoff + Index * Ehdr64->e_shentsize;
+        if (Index >= Ehdr64->e_shnum || Ehdr64->e_shentsize < sizeof(*Shdr64) || Pos + sizeof(*Shdr64) > Obj->ImageSize)
+        {
+            return 0;
+        }
+        Shdr64           = (const Elf64_Shdr *)(Obj->Image + Pos);
+        Section->Type    = Shdr64->sh_type;
+        Section->Link    = Shdr64->sh_link;
+        Section->Offset  = Shdr64->sh_offset;
+        Section->Size    = Shdr64->sh_size;
+        Section->EntSize = Shdr64->sh_entsize;
+    }
+    else
+    {
+        Pos = Ehdr32->e_shoff + Index * Ehdr32->e_shentsize;
+        if (Index >= Ehdr32->e_shnum || Ehdr32->e_shentsize < sizeof(*Shdr32) || Pos + sizeof(*Shdr32) > Obj->ImageSize)
+        {
+            return 0;
+        }
+        Shdr32           = (const Elf32_Shdr *)(Obj->Image + Pos);
+        Section->Type    = Shdr32->sh_type;
+        Section->Link    = Shdr32->sh_link;
+        Section->Offset  = Shdr32->sh_offset;
+        Section->Size    = Shdr32->sh_size;
+        Section->EntSize = Shdr32->sh_entsize;
+    }
+
+    /* a section without file content (e.g. stripped code in a debug file) has nothing to read */
+    if (Section->Type == SHT_NOBITS || Section->Offset > Obj->ImageSize ||
+        Section->Size > Obj->ImageSize - Section->Offset)
+    {
+        Section->Size = 0;
+    }
+
+    return 1;
+}
+
+/*----------------------------------------------------------------
+ * Finds the GNU build-id among the notes of a section.
+ *-----------------------------------------------------------------*/
+static void CFE_PSP_Symbolizer_ReadBuildId(CFE_PSP_SymbolizerObject_t *Obj, const CFE_PSP_SymbolizerSection_t *Section)
+{
+    const Elf32_Nhdr *Note; /* same layout for both ELF classes */
+    size_t            Pos;
+    size_t            End;
+    size_t            Size;
+
+    Pos = Section->Offset;
+    End = Section->Offset + Section->Size;
+    while (Pos + sizeof(*Note) <= End && Obj->BuildIdSize == 0)
+    {
+        Note = (const Elf32_Nhdr *)(Obj->Image + Pos);
+        Pos += sizeof(*Note) + ((Note->n_namesz + 3) & ~3U) + ((Note->n_descsz + 3) & ~3U);
+        if (Pos > End)
+        {
+            break;
+        }
+        if (Note->n_type == NT_GNU_BUILD_ID && Note->n_namesz == 4 && memcmp(Note + 1, "GNU", 4) == 0)
+        {
+            Size = Note->n_descsz;
+            if (Size > sizeof(Obj->BuildId))
+            {
+                Size = sizeof(Obj->BuildId);
+            }
+            memcpy(Obj->BuildId, (const uint8_t *)(Note + 1) + 4, Size);
+            Obj->BuildIdSize = Size;
+        }
+    }
+}
+
+static int CFE_PSP_Symbolizer_CompareSymbols(const void *a, const void *b)
+{
+    const CFE_PSP_SymbolizerSymbol_t *SymA = a;
+    const CFE_PSP_SymbolizerSymbol_t *SymB = b;
+
+    if (SymA->Addr != SymB->Addr)
+    {
+        return (SymA->Addr < SymB->Addr) ? -1 : 1;
+    }
+
+    /* prefer the symbol with a known size among aliases */
+    return (SymA->Size < SymB->Size) ? 1 : (SymA->Size > SymB->Size) ? -1 : 0;
+}
+
+/*----------------------------------------------------------------
+ * Collects the function symbols of a symbol table section.
+ *-----------------------------------------------------------------*/
+static void CFE_PSP_Symbolizer_ReadSymbols(CFE_PSP_SymbolizerObject_t *       Obj,
+                                           const CFE_PSP_SymbolizerSection_t *Section)
+{
+    CFE_PSP_SymbolizerSection_t StrSection;
+    const Elf64_Sym *           Sym64;
+    const Elf32_Sym *           Sym32;
+    CFE_PSP_SymbolizerSymbol_t *Symbol;
+    size_t                      NumEntries;
+    size_t                      NameOffset;
+    size_t                      i;
+    uint8_t                     Info;
+    uint16_t                    Shndx;
+    int                         Is64;
+
+    Is64 = (Obj->Image[EI_CLASS] == ELFCLASS64);
+    if (!CFE_PSP_Symbolizer_GetSection(Obj, Section->Link, &StrSection) || StrSection.Size == 0 ||
+        Section->EntSize < (Is64 ? sizeof(*Sym64) : sizeof(*Sym32)))
+    {
+        return;
+    }
+
+    NumEntries   = Section->Size / Section->EntSize;
+    Obj->Symbols = calloc(NumEntries, sizeof(*Obj->Symbols));
+    if (Obj->Symbols == NULL)
+    {
+        return;
+    }
+
+    for (i = 0; i < NumEntries; ++i)
+    {
+        Symbol = &Obj->Symbols[Obj->NumSymbols];
+        if (Is64)
+        {
+            Sym64        = (const Elf64_Sym *)(Obj->Image + Section->Offset + i * Section->EntSize);
+            Info         = Sym64->st_info;
+            Shndx        = Sym64->st_shndx;
+            NameOffset   = Sym64->st_name;
+            Symbol->Addr = Sym64->st_value;
+            Symbol->Size = Sym64->st_size;
+        }
+        else
+        {
+            Sym32        = (const Elf32_Sym *)(Obj->Image + Section->Offset + i * Section->EntSize);
+            Info         = Sym32->st_info;
+            Shndx        = Sym32->st_shndx;
+            NameOffset   = Sym32->st_name;
+            Symbol->Addr = Sym32->st_value;
+            Symbol->Size = Sym32->st_size;
+        }
+
+        if ((ELF64_ST_TYPE(Info) != STT_FUNC && ELF64_ST_TYPE(Info) != STT_GNU_IFUNC) || Shndx == SHN_UNDEF ||
+            NameOffset >= StrSection.Size ||
+            memchr(Obj->Image + StrSection.Offset + NameOffset, 0, StrSection.Size - NameOffset) == NULL)
+        {
+            continue;
+        }
+
+        Symbol->Name = (const char *)Obj->Image + StrSection.Offset + NameOffset;
+        ++Obj->NumSymbols;
+    }
+
+    qsort(Obj->Symbols, Obj->NumSymbols, sizeof(*Obj->Symbols), CFE_PSP_Symbolizer_CompareSymbols);
+}
+
+/*----------------------------------------------------------------
+ * Loads an ELF file into Obj; returns 0 if it is not a usable ELF file.
+ *-----------------------------------------------------------------*/
+static int CFE_PSP_Symbolizer_LoadElf(CFE_PSP_SymbolizerObject_t *Obj, const char *Path)
+{
+    static const union
+    {
+        uint16_t Value;
+        uint8_t  Bytes[2];
+    } HostOrder = {.Value = 1};
+
+    CFE_PSP_SymbolizerSection_t Section;
+    CFE_PSP_SymbolizerSection_t SymTab;
+    CFE_PSP_SymbolizerSection_t DynSym;
+    size_t                      i;
+
+    Obj->Image = CFE_PSP_Symbolizer_ReadFile(Path, &Obj->ImageSize);
+    if (Obj->Image == NULL)
+    {
+        return 0;
+    }
+
+    /* only objects of the host byte order are handled */
+    if (Obj->ImageSize < sizeof(Elf64_Ehdr) || memcmp(Obj->Image, ELFMAG, SELFMAG) != 0 ||
+        (Obj->Image[EI_CLASS] != ELFCLASS64 && Obj->Image[EI_CLASS] != ELFCLASS32) ||
+        Obj->Image[EI_DATA] != (HostOrder.Bytes[0] ? ELFDATA2LSB : ELFDATA2MSB))
+    {
+        free(Obj->Image);
+        Obj->Image = NULL;
+        return 0;
+    }
+
+    memset(&SymTab, 0, sizeof(SymTab));
+    memset(&DynSym, 0, sizeof(DynSym));
+    Obj->BuildIdSize = 0;
+    for (i = 0; CFE_PSP_Symbolizer_GetSection(Obj, i, &Section); ++i)
+    {
+        if (Section.Type == SHT_NOTE)
+        {
+            CFE_PSP_Symbolizer_ReadBuildId(Obj, &Section);
+        }
+        else if (Section.Type == SHT_SYMTAB)
+        {
+            SymTab = Section;
+        }
+        else if (Section.Type == SHT_DYNSYM)
+        {
+            DynSym = Section;
+        }
+    }
+
+    /* the full symbol table includes static functions, use the dynamic one if the file is stripped */
+    CFE_PSP_Symbolizer_ReadSymbols(Obj, (SymTab.Size != 0) ? &SymTab : &DynSym);
+
+    snprintf(Obj->Path, sizeof(Obj->Path), "%s", Path);
+    return 1;
+}
+
+/*----------------------------------------------------------------
+ * Releases whatever was loaded into Obj
+ *-----------------------------------------------------------------*/
+static void CFE_PSP_Symbolizer_UnloadElf(CFE_PSP_SymbolizerObject_t *Obj)
+{
+    free(Obj->Symbols);
+    free(Obj->Image);
+    Obj->Symbols    = NULL;
+    Obj->NumSymbols = 0;
+    Obj->Image      = NULL;
+    Obj->ImageSize  = 0;
+    Obj->Path[0]    = 0;
+}
+
+/*----------------------------------------------------------------
+ * Finds and loads the ELF file for Module
+ *-----------------------------------------------------------------*/
+static void CFE_PSP_Symbolizer_FindElf(const CFE_PSP_Symbolizer_t *Sym, CFE_PSP_SymbolizerObject_t *Obj,
+                                       const CFE_PSP_Exception_ModuleInfo_t *Module)
+{
+    char     Path[PATH_MAX];
+    size_t   Pos;
+    uint32_t d;
+    uint32_t i;
+
+    /* a separate debug file must have the same build-id */
+    for (d = 0; d < Sym->NumDebugDirs && Module->BuildIdSize > 1; ++d)
+    {
+        Pos = snprintf(Path, sizeof(Path), "%s/.build-id/%02x/", Sym->DebugDirs[d], Module->BuildId[0]);
+        for (i = 1; i < Module->BuildIdSize && Pos < sizeof(Path); ++i)
+        {
+            Pos += snprintf(Path + Pos, sizeof(Path) - Pos, "%02x", Module->BuildId[i]);
+        }
+        if (Pos < sizeof(Path))
+        {
+            snprintf(Path + Pos, sizeof(Path) - Pos, ".debug");
+        }
+
+        if (CFE_PSP_Symbolizer_LoadElf(Obj, Path))
+        {
+            if (Obj->BuildIdSize == Module->BuildIdSize && memcmp(Obj->BuildId, Module->BuildId, Obj->BuildIdSize) == 0)
+            {
+                return;
+            }
+            CFE_PSP_Symbolizer_UnloadElf(Obj);
+        }
+    }
+
+    /* a file found by name is used unless its build-id shows it is a different build */
+    for (d = 0; d < Sym->NumSearchDirs && Module->Name[0] != 0; ++d)
+    {
+        snprintf(Path, sizeof(Path), "%s/%s", Sym->SearchDirs[d], Module->Name);
+        if (CFE_PSP_Symbolizer_LoadElf(Obj, Path))
+        {
+            if (Obj->BuildIdSize == 0 || Module->BuildIdSize == 0 ||
+                (Obj->BuildIdSize == Module->BuildIdSize &&
+                 memcmp(Obj->BuildId, Module->BuildId, Obj->BuildIdSize) == 0))
+            {
+                return;
+            }
+            fprintf(stderr, "%s: build-id does not match the exception record, ignored\n", Path);
+            CFE_PSP_Symbolizer_UnloadElf(Obj);
+        }
+    }
+}
+
+/*----------------------------------------------------------------
+ * Gets the loaded ELF file for Module, loading it on first use.
+ * A file that was not found is remembered too, so it is only searched once.
+ *-----------------------------------------------------------------*/
+static CFE_PSP_SymbolizerObject_t *CFE_PSP_Symbolizer_GetObject(CFE_PSP_Symbolizer_t *                Sym,
+                                                                const CFE_PSP_Exception_ModuleInfo_t *Module)
+{
+    CFE_PSP_SymbolizerObject_t *Obj;
+    uint32_t                    i;
+
+    for (i = 0; i < Sym->NumObjects; ++i)
+    {
+        Obj = Sym->Objects[i];
+        if (strncmp(Obj->Name, Module->Name, sizeof(Obj->Name)) == 0 && Obj->KeyBuildIdSize == Module->BuildIdSize &&
+            memcmp(Obj->KeyBuildId, Module->BuildId, Module->BuildIdSize) == 0)
+        {
+            return Obj;
+        }
+    }
+
+    if (Sym->NumObjects >= CFE_PSP_SYMBOLIZER_MAX_OBJECTS)
+    {
+        return NULL;
+    }
+
+    Obj = calloc(1, sizeof(*Obj));
+    if (Obj == NULL)
+    {
+        return NULL;
+    }
+
+    memcpy(Obj->Name, Module->Name, sizeof(Obj->Name));
+    Obj->Name[sizeof(Obj->Name) - 1] = 0;
+    Obj->KeyBuildIdSize = Module->BuildIdSize;
+    if (Obj->KeyBuildIdSize > sizeof(Obj->KeyBuildId))
+    {
+        Obj->KeyBuildIdSize = sizeof(Obj->KeyBuildId);
+    }
+    memcpy(Obj->KeyBuildId, Module->BuildId, Obj->KeyBuildIdSize);
+
+    CFE_PSP_Symbolizer_FindElf(Sym, Obj, Module);
+
+    Sym->Objects[Sym->NumObjects] = Obj;
+    ++Sym->NumObjects;
+
+    return Obj;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per public API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CFE_PSP_Symbolizer_Init(CFE_PSP_Symbolizer_t *Sym)
+{
+    memset(Sym, 0, sizeof(*Sym));
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per public API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CFE_PSP_Symbolizer_Cleanup(CFE_PSP_Symbolizer_t *Sym)
+{
+    uint32_t i;
+
+    for (i = 0; i < Sym->NumObjects; ++i)
+    {
+        CFE_PSP_Symbolizer_UnloadElf(Sym->Objects[i]);
+        free(Sym->Objects[i]);
+    }
+
+    memset(Sym, 0, sizeof(*Sym));
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per public API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int CFE_PSP_Symbolizer_AddDebugDir(CFE_PSP_Symbolizer_t *Sym, const char *Dir)
+{
+    if (Sym->NumDebugDirs >= CFE_PSP_SYMBOLIZER_MAX_DIRS)
+    {
+        return CFE_PSP_SYMBOLIZER_ERROR;
+    }
+
+    Sym->DebugDirs[Sym->NumDebugDirs] = Dir;
+    ++Sym->NumDebugDirs;
+
+    return CFE_PSP_SYMBOLIZER_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per public API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int CFE_PSP_Symbolizer_AddSearchDir(CFE_PSP_Symbolizer_t *Sym, const char *Dir)
+{
+    if (Sym->NumSearchDirs >= CFE_PSP_SYMBOLIZER_MAX_DIRS)
+    {
+        return CFE_PSP_SYMBOLIZER_ERROR;
+    }
+
+    Sym->SearchDirs[Sym->NumSearchDirs] = Dir;
+    ++Sym->NumSearchDirs;
+
+    return CFE_PSP_SYMBOLIZER_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per public API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int CFE_PSP_Symbolizer_DecodeRecord(const void *Data, size_t Size, CFE_PSP_SymbolizerRecord_t *Record)
+{
+    size_t Avail;
+
+    memset(Record, 0, sizeof(*Record));
+    if (Size < offsetof(CFE_PSP_Exception_ContextDataEntry_t, bt_addrs))
+    {
+        return CFE_PSP_SYMBOLIZER_TRUNCATED;
+    }
+
+    memcpy(&Record->Context, Data, (Size < sizeof(Record->Context)) ? Size : sizeof(Record->Context));
+
+    /* only count the entries that are present in the data */
+    Avail = (Size - offsetof(CFE_PSP_Exception_ContextDataEntry_t, bt_addrs)) / sizeof(Record->Context.bt_addrs[0]);
+    Record->NumAddrs = Record->Context.NumAddrs;
+    if (Record->NumAddrs > CFE_PSP_MAX_EXCEPTION_BACKTRACE_SIZE)
+    {
+        Record->NumAddrs = CFE_PSP_MAX_EXCEPTION_BACKTRACE_SIZE;
+    }
+    if (Record->NumAddrs > Avail)
+    {
+        Record->NumAddrs = Avail;
+    }
+
+    Avail = 0;
+    if (Size > offsetof(CFE_PSP_Exception_ContextDataEntry_t, modules))
+    {
+        Avail = (Size - offsetof(CFE_PSP_Exception_ContextDataEntry_t, modules)) / sizeof(Record->Context.modules[0]);
+    }
+    Record->NumModules = Record->Context.NumModules;
+    if (Record->NumModules > CFE_PSP_MAX_EXCEPTION_MODULES)
+    {
+        Record->NumModules = CFE_PSP_MAX_EXCEPTION_MODULES;
+    }
+    if (Record->NumModules > Avail)
+    {
+        Record->NumModules = Avail;
+    }
+
+    return CFE_PSP_SYMBOLIZER_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per public API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int CFE_PSP_Symbolizer_Resolve(CFE_PSP_Symbolizer_t *Sym, const CFE_PSP_SymbolizerRecord_t *Record, uintptr_t Addr,
+                               int IsReturnAddr, CFE_PSP_SymbolizerFrame_t *Frame)
+{
+    const CFE_PSP_SymbolizerObject_t *Obj;
+    const CFE_PSP_SymbolizerSymbol_t *Symbol;
+    uintptr_t                         LookupAddr;
+    size_t                            Low;
+    size_t                            High;
+    size_t                            Mid;
+    uint32_t                          i;
+
+    memset(Frame, 0, sizeof(*Frame));
+    for (i = 0; i < Record->NumModules; ++i)
+    {
+        if (Addr >= Record->Context.modules[i].StartAddr && Addr < Record->Context.modules[i].EndAddr)
+        {
+            Frame->Module = &Record->Context.modules[i];
+            break;
+        }
+    }
+
+    if (Frame->Module == NULL)
+    {
+        return CFE_PSP_SYMBOLIZER_NOT_FOUND;
+    }
+
+    Frame->FileAddr = Addr - Frame->Module->LoadBias;
+    LookupAddr      = IsReturnAddr ? (Frame->FileAddr - 1) : Frame->FileAddr;
+
+    Obj = CFE_PSP_Symbolizer_GetObject(Sym, Frame->Module);
+    if (Obj == NULL || Obj->Image == NULL)
+    {
+        return CFE_PSP_SYMBOLIZER_NOT_FOUND;
+    }
+    Frame->ObjectPath = Obj->Path;
+
+    /* find the last symbol at or below the address */
+    Low  = 0;
+    High = Obj->NumSymbols;
+    while (Low < High)
+    {
+        Mid = Low + (High - Low) / 2;
+        if (Obj->Symbols[Mid].Addr <= LookupAddr)
+        {
+            Low = Mid + 1;
+        }
+        else
+        {
+            High = Mid;
+        }
+    }
+
+    /* with aliases at the same address, the first one has the size (see CompareSymbols) */
+    while (Low > 1 && Obj->Symbols[Low - 2].Addr == Obj->Symbols[Low - 1].Addr)
+    {
+        --Low;
+    }
+
+    if (Low == 0)
+    {
+        return CFE_PSP_SYMBOLIZER_NOT_FOUND;
+    }
+
+    /* a symbol without a size is assumed to extend to the next one */
+    Symbol = &Obj->Symbols[Low - 1];
+    if (Symbol->Size != 0 && LookupAddr >= Symbol->Addr + Symbol->Size)
+    {
+        return CFE_PSP_SYMBOLIZER_NOT_FOUND;
+    }
+
+    Frame->Function = Symbol->Name;
+    Frame->Offset   = Frame->FileAddr - Symbol->Addr;
+
+    return CFE_PSP_SYMBOLIZER_SUCCESS;
+}
@@ -0,0 +1,170 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * Host-side library to resolve the backtrace of a pc-linux exception
+ * context (CFE_PSP_Exception_ContextDataEntry_t) to function+offset.
+ *
+ * The context holds the load bias and build-id of each object that the
+ * backtrace refers to.  The matching ELF files are located by build-id in
+ * the debug directories, or by name in the search directories, and the
+ * addresses are looked up in their symbol tables.
+ *
+ * This runs on the host, not on the target, so it only uses the C library.
+ */
+
+#ifndef CFE_PSP_SYMBOLIZER_H
+#define CFE_PSP_SYMBOLIZER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cfe_psp_exception_context.h"
+
+#define CFE_PSP_SYMBOLIZER_MAX_DIRS    16 /**< Maximum number of debug or search directories */
+#define CFE_PSP_SYMBOLIZER_MAX_OBJECTS 32 /**< Maximum number of ELF files kept open */
+
+/*
+ * Return codes of the symbolizer functions
+ */
+#define CFE_PSP_SYMBOLIZER_SUCCESS   0
+#define CFE_PSP_SYMBOLIZER_ERROR     (-1) /**< Invalid argument or limit reached */
+#define CFE_PSP_SYMBOLIZER_TRUNCATED (-2) /**< The record is too short to hold a context */
+#define CFE_PSP_SYMBOLIZER_NOT_FOUND (-3) /**< The address could not be resolved */
+
+/**
+ * \brief An exception context decoded from a saved record
+ *
+ * The record may have been truncated by the log that stored it, in which
+ * case the counts only reflect the entries that are actually present.
+ */
+typedef struct
+{
+    CFE_PSP_Exception_ContextDataEntry_t Context;
+    uint32_t                             NumAddrs;   /**< Number of usable entries in Context.bt_addrs */
+    uint32_t                             NumModules; /**< Number of usable entries in Context.modules */
+} CFE_PSP_SymbolizerRecord_t;
+
+/**
+ * \brief Result of resolving one address
+ */
+typedef struct
+{
+    const CFE_PSP_Exception_ModuleInfo_t *Module;     /**< Object containing the address, NULL if none */
+    const char *                          ObjectPath; /**< ELF file used, NULL if none was found */
+    const char *                          Function;   /**< Enclosing function, NULL if not found */
+    uintptr_t                             FileAddr;   /**< Address as seen in the ELF file */
+    uintptr_t                             Offset;     /**< Offset of the address from the function start */
+} CFE_PSP_SymbolizerFrame_t;
+
+/**
+ * \brief An ELF file loaded by the symbolizer (opaque)
+ */
+typedef struct CFE_PSP_SymbolizerObject CFE_PSP_SymbolizerObject_t;
+
+/**
+ * \brief State of the symbolizer
+ *
+ * Must be initialized with CFE_PSP_Symbolizer_Init() and released with
+ * CFE_PSP_Symbolizer_Cleanup().
+ */
+typedef struct
+{
+    const char *DebugDirs[CFE_PSP_SYMBOLIZER_MAX_DIRS];
+    uint32_t    NumDebugDirs;
+    const char *SearchDirs[CFE_PSP_SYMBOLIZER_MAX_DIRS];
+    uint32_t    NumSearchDirs;
+
+    CFE_PSP_SymbolizerObject_t *Objects[CFE_PSP_SYMBOLIZER_MAX_OBJECTS];
+    uint32_t                    NumObjects;
+} CFE_PSP_Symbolizer_t;
+
+/**
+ * \brief Initialize the symbolizer state
+ *
+ * \param[out] Sym Symbolizer state
+ */
+void CFE_PSP_Symbolizer_Init(CFE_PSP_Symbolizer_t *Sym);
+
+/**
+ * \brief Release all ELF files loaded by the symbolizer
+ *
+ * \param[inout] Sym Symbolizer state
+ */
+void CFE_PSP_Symbolizer_Cleanup(CFE_PSP_Symbolizer_t *Sym);
+
+/**
+ * \brief Add a directory holding separate debug files in a ".build-id" tree
+ *
+ * For example "/usr/lib/debug", where the file for build-id "abcdef..." is
+ * ".build-id/ab/cdef....debug".  The string is not copied.
+ *
+ * \param[inout] Sym Symbolizer state
+ * \param[in]    Dir Directory name
+ *
+ * \returns CFE_PSP_SYMBOLIZER_SUCCESS, or CFE_PSP_SYMBOLIZER_ERROR if the limit is reached
+ */
+int CFE_PSP_Symbolizer_AddDebugDir(CFE_PSP_Symbolizer_t *Sym, const char *Dir);
+
+/**
+ * \brief Add a directory holding the executable or libraries, looked up by name
+ *
+ * A file found by name is only used if its build-id matches the record,
+ * or if either of them has no build-id.  The string is not copied.
+ *
+ * \param[inout] Sym Symbolizer state
+ * \param[in]    Dir Directory name
+ *
+ * \returns CFE_PSP_SYMBOLIZER_SUCCESS, or CFE_PSP_SYMBOLIZER_ERROR if the limit is reached
+ */
+int CFE_PSP_Symbolizer_AddSearchDir(CFE_PSP_Symbolizer_t *Sym, const char *Dir);
+
+/**
+ * \brief Decode a saved exception context
+ *
+ * \param[in]  Data   Saved context, as stored by the PSP
+ * \param[in]  Size   Size of the saved context
+ * \param[out] Record Decoded context
+ *
+ * \returns CFE_PSP_SYMBOLIZER_SUCCESS, or CFE_PSP_SYMBOLIZER_TRUNCATED if the
+ *          data does not even hold the fixed part of the context
+ */
+int CFE_PSP_Symbolizer_DecodeRecord(const void *Data, size_t Size, CFE_PSP_SymbolizerRecord_t *Record);
+
+/**
+ * \brief Resolve an address of a decoded context to function+offset
+ *
+ * Return addresses from the backtrace point after the call instruction, so
+ * for those (IsReturnAddr true) the lookup is done one byte earlier, which
+ * keeps a call at the very end of a function attributed to that function.
+ * The reported offset is still relative to the original address.
+ *
+ * \param[inout] Sym          Symbolizer state
+ * \param[in]    Record       Decoded context
+ * \param[in]    Addr         Run-time address to resolve
+ * \param[in]    IsReturnAddr Whether the address is a return address
+ * \param[out]   Frame        Result; filled as far as possible even on failure
+ *
+ * \returns CFE_PSP_SYMBOLIZER_SUCCESS, or CFE_PSP_SYMBOLIZER_NOT_FOUND if no function was found
+ */
+int CFE_PSP_Symbolizer_Resolve(CFE_PSP_Symbolizer_t *Sym, const CFE_PSP_SymbolizerRecord_t *Record, uintptr_t Addr,
+                               int IsReturnAddr, CFE_PSP_SymbolizerFrame_t *Frame);
+
+#endif /* CFE_PSP_SYMBOLIZER_H */
@@ -32,9 +32,12 @@
  * This define sets the maximum number of exceptions
  * that can be stored.
  *
- * It must always be a power of two.
+ * It must always be a power of two.  It may be overridden
+ * at build time.
  */
+#ifndef CFE_PSP_MAX_EXCEPTION_ENTRIES
 #define CFE_PSP_MAX_EXCEPTION_ENTRIES 1
+#endif
 
 /*
  * The tick period that will be configured in the RTOS for the simulated
@@ -3,6 +3,6 @@
 # not exist in all versions of cmake.
 if(CMAKE_SYSTEM_VERSION VERSION_GREATER 4.99)
 
-    list(APPEND PSP_TARGET_MODULE_LIST rtems_sysmon)
+    list(APPEND PSP_TARGET_MODULE_LIST sysmon rtems_sysmon)
 
 endif()
\ No newline at end of file
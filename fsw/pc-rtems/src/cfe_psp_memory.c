@@ -187,6 +187,100 @@ int32 CFE_PSP_ReadFromCDS(void *PtrToDataToRead, uint32 CDSOffset, uint32 NumByt
     return return_code;
 }
 
+/*----------------------------------------------------------------
+ *
+ * Implemented per public API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CFE_PSP_WriteToCDSv(const CFE_PSP_CDSWriteVec_t *Vec, uint32 NumEntries, uint32 Flags)
+{
+    uint8 *CDSPtr;
+    size_t CDSSize;
+    uint32 i;
+
+    if (Vec == NULL)
+    {
+        return OS_ERROR;
+    }
+
+    /* Validate every range first, so the update is all or nothing */
+    CDSSize = CFE_PSP_ReservedMemoryMap.CDSMemory.BlockSize;
+    for (i = 0; i < NumEntries; ++i)
+    {
+        if (Vec[i].DataPtr == NULL || Vec[i].CDSOffset >= CDSSize || Vec[i].NumBytes > (CDSSize - Vec[i].CDSOffset))
+        {
+            return OS_ERROR;
+        }
+    }
+
+    CDSPtr = CFE_PSP_ReservedMemoryMap.CDSMemory.BlockPtr;
+    for (i = 0; i < NumEntries; ++i)
+    {
+        memcpy(&CDSPtr[Vec[i].CDSOffset], Vec[i].DataPtr, Vec[i].NumBytes);
+    }
+
+    if ((Flags & CFE_PSP_CDS_VEC_FENCE) != 0)
+    {
+        __sync_synchronize();
+    }
+
+    return OS_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per public API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CFE_PSP_ReadFromCDSv(const CFE_PSP_CDSReadVec_t *Vec, uint32 NumEntries, uint32 Flags)
+{
+    const uint8 *CDSPtr;
+    size_t       CDSSize;
+    uint32       i;
+
+    if (Vec == NULL)
+    {
+        return OS_ERROR;
+    }
+
+    /* Validate every range first, so the read is all or nothing */
+    CDSSize = CFE_PSP_ReservedMemoryMap.CDSMemory.BlockSize;
+    for (i = 0; i < NumEntries; ++i)
+    {
+        if (Vec[i].DataPtr == NULL || Vec[i].CDSOffset >= CDSSize || Vec[i].NumBytes > (CDSSize - Vec[i].CDSOffset))
+        {
+            return OS_ERROR;
+        }
+    }
+
+    if ((Flags & CFE_PSP_CDS_VEC_FENCE) != 0)
+    {
+        __sync_synchronize();
+    }
+
+    CDSPtr = CFE_PSP_ReservedMemoryMap.CDSMemory.BlockPtr;
+    for (i = 0; i < NumEntries; ++i)
+    {
+        memcpy(Vec[i].DataPtr, &CDSPtr[Vec[i].CDSOffset], Vec[i].NumBytes);
+    }
+
+    return OS_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per public API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CFE_PSP_FlushCDS(void)
+{
+    /* The CDS lives directly in preserved RAM, there is no separate backing store */
+    return CFE_PSP_ERROR_NOT_IMPLEMENTED;
+}
+
 /*
 *********************************************************************************
 ** ES Reset Area related functions
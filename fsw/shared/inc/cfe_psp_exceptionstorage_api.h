@@ -56,6 +56,10 @@ extern struct CFE_PSP_Exception_LogData *CFE_PSP_Exception_GetBuffer(uint32 seq)
  * to obtain a buffer for context capture.  The buffer is cleared (memset zero) before
  * returning to the caller.
  *
+ * This does not take any lock, so it may be called concurrently from several threads
+ * or nested handlers; each caller obtains a different buffer.  Buffers that have been
+ * obtained but not yet completed count towards the storage limit.
+ *
  * \returns pointer to buffer, or NULL if storage is full.
  */
 extern struct CFE_PSP_Exception_LogData *CFE_PSP_Exception_GetNextContextBuffer(void);
@@ -66,13 +70,21 @@ extern struct CFE_PSP_Exception_LogData *CFE_PSP_Exception_GetNextContextBuffer(
  * This function is invoked by the low level exception handler (typically an ISR/signal)
  * once the exception context capture is complete.  This should be invoked after a successful
  * call to CFE_PSP_Exception_GetNextContextBuffer() to commit the information to the log.
+ *
+ * Entries become visible to the application in the order they were obtained, so if an
+ * earlier buffer is still being filled by another handler, this entry is held back
+ * until that one is also complete.
+ *
+ * \param   Buffer  Buffer previously returned by CFE_PSP_Exception_GetNextContextBuffer()
  */
-extern void CFE_PSP_Exception_WriteComplete(void);
+extern void CFE_PSP_Exception_WriteComplete(struct CFE_PSP_Exception_LogData *Buffer);
 
 /**
  * \brief Reset the exception storage buffer
  *
  * Marks any pending exceptions as "read".  This resets the state of exception processing.
+ * Any buffer obtained but not completed is also discarded, so this must only be called
+ * while no exception handler can be running, i.e. during initialization.
  */
 extern void CFE_PSP_Exception_Reset(void);
 
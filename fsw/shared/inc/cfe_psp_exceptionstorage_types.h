@@ -39,15 +39,24 @@
 struct CFE_PSP_Exception_LogData
 {
     uint32                               context_id;   /**< a unique ID assigned to this exception entry */
+    uint32                               reserve_seq;  /**< sequence number at which this entry was reserved */
+    volatile uint32                      commit_seq;   /**< set to reserve_seq + 1 once the entry is complete */
     uint32                               context_size; /**< actual size of the "context_info" data */
     CFE_PSP_Exception_SysTaskId_t        sys_task_id;  /**< the BSP-specific task info (not osal abstracted id) */
     CFE_PSP_Exception_ContextDataEntry_t context_info;
 };
 
+/*
+ * Entries are reserved by advancing NumReserved, and become visible to the
+ * reader once NumWritten advances past them.  Several handlers may hold
+ * reserved entries at once; NumWritten only advances over a contiguous run
+ * of completed entries, so entries are always read in reservation order.
+ */
 struct CFE_PSP_ExceptionStorage
 {
     volatile uint32                  NumWritten;
     volatile uint32                  NumRead;
+    volatile uint32                  NumReserved;
     struct CFE_PSP_Exception_LogData Entries[CFE_PSP_MAX_EXCEPTION_ENTRIES];
 };
 
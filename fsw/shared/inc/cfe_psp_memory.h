@@ -50,6 +50,40 @@ typedef struct
     uint32  Attributes;
 } CFE_PSP_MemTable_t;
 
+/*
+** Number of words of CFE_PSP_MemRangeSegment_t.EntryMask, one bit per table entry
+*/
+#define CFE_PSP_MEMRANGE_MASK_WORDS ((CFE_PSP_MEM_TABLE_SIZE + 31) / 32)
+
+/*
+** Segment of the memory range index
+**
+** The address space is divided into segments at every start address and
+** every end address (+1) in the memory table, so all addresses within a
+** segment are covered by the same set of table entries.
+*/
+typedef struct
+{
+    cpuaddr StartAddr;     /**< First address of the segment */
+    cpuaddr MaxEndAddr[2]; /**< Highest end address among covering entries, by type (RAM, EEPROM) */
+    uint32  TypeMask;      /**< Bit (1 << MemoryType) set for each type with a covering entry */
+
+    /** Bit (RangeNum % 32) of word (RangeNum / 32) set for each covering table entry */
+    uint32 EntryMask[CFE_PSP_MEMRANGE_MASK_WORDS];
+} CFE_PSP_MemRangeSegment_t;
+
+/*
+** Memory range index
+**
+** Rebuilt by CFE_PSP_MemRangeSet() whenever the table changes, so that
+** CFE_PSP_MemValidateRange() is a binary search over the segments.
+*/
+typedef struct
+{
+    uint32                    NumSegments;
+    CFE_PSP_MemRangeSegment_t Segments[2 * CFE_PSP_MEM_TABLE_SIZE];
+} CFE_PSP_MemRangeIndex_t;
+
 typedef struct
 {
     void * BlockPtr;
@@ -74,6 +108,14 @@ typedef struct
      */
 
     CFE_PSP_MemTable_t SysMemoryTable[CFE_PSP_MEM_TABLE_SIZE];
+
+    /**
+     * \brief Index of the system memory table, sorted by address
+     *
+     * This is derived entirely from SysMemoryTable and maintained by
+     * CFE_PSP_MemRangeSet.
+     */
+    CFE_PSP_MemRangeIndex_t SysMemoryIndex;
 } CFE_PSP_ReservedMemoryMap_t;
 
 /**
@@ -104,6 +146,15 @@ extern int32 CFE_PSP_InitProcessorReservedMemory(uint32 RestartType);
  */
 extern void CFE_PSP_DeleteProcessorReservedMemory(void);
 
+/**
+ * \brief Rebuild the memory range index from the system memory table
+ *
+ * Called by CFE_PSP_MemRangeSet() after every change to the table.
+ * This is not synchronized with concurrent calls to CFE_PSP_MemValidateRange(),
+ * so the table is expected to be set up during initialization.
+ */
+extern void CFE_PSP_MemRangeBuildIndex(void);
+
 /*
 ** External variables
 */
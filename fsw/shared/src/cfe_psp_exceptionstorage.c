@@ -57,6 +57,10 @@
 #define CFE_PSP_MAX_EXCEPTION_ENTRY_MASK (CFE_PSP_MAX_EXCEPTION_ENTRIES - 1)
 #define CFE_PSP_EXCEPTION_ID_BASE        ((OS_OBJECT_TYPE_USER + 0x101) << OS_OBJECT_TYPE_SHIFT)
 
+#if (CFE_PSP_MAX_EXCEPTION_ENTRIES == 0) || ((CFE_PSP_MAX_EXCEPTION_ENTRIES & CFE_PSP_MAX_EXCEPTION_ENTRY_MASK) != 0)
+#error "CFE_PSP_MAX_EXCEPTION_ENTRIES must be a power of two"
+#endif
+
 /***************************************************************************
  **                    INTERNAL FUNCTION DEFINITIONS
  **                 (Functions used only within the PSP itself)
@@ -68,7 +72,13 @@
  *---------------------------------------------------------------------------*/
 void CFE_PSP_Exception_Reset(void)
 {
-    /* just reset the counter */
+    /*
+     * just reset the counters - this also discards any entry that was
+     * reserved but never completed, e.g. by a process that ended inside
+     * the exception handler.
+     */
+    CFE_PSP_ReservedMemoryMap.ExceptionStoragePtr->NumReserved =
+        CFE_PSP_ReservedMemoryMap.ExceptionStoragePtr->NumWritten;
     CFE_PSP_ReservedMemoryMap.ExceptionStoragePtr->NumRead = CFE_PSP_ReservedMemoryMap.ExceptionStoragePtr->NumWritten;
 }
 
@@ -87,20 +97,33 @@ CFE_PSP_Exception_LogData_t *CFE_PSP_Exception_GetBuffer(uint32 seq)
  *---------------------------------------------------------------------------*/
 CFE_PSP_Exception_LogData_t *CFE_PSP_Exception_GetNextContextBuffer(void)
 {
+    CFE_PSP_ExceptionStorage_t * Storage;
     CFE_PSP_Exception_LogData_t *Buffer;
     uint32                       NextWrite;
 
-    NextWrite = CFE_PSP_ReservedMemoryMap.ExceptionStoragePtr->NumWritten;
-    if ((NextWrite - CFE_PSP_ReservedMemoryMap.ExceptionStoragePtr->NumRead) >= CFE_PSP_MAX_EXCEPTION_ENTRIES)
+    Storage = CFE_PSP_ReservedMemoryMap.ExceptionStoragePtr;
+
+    /*
+     * Claim a sequence number with a compare-and-swap, so that handlers
+     * running concurrently on other threads/CPUs (or nested in this one)
+     * each get a different entry.  This does not take any lock, so it is
+     * safe to call from a signal handler or ISR.
+     */
+    do
     {
-        /* no space to store another context */
-        return NULL;
-    }
+        NextWrite = Storage->NumReserved;
+        if ((NextWrite - Storage->NumRead) >= CFE_PSP_MAX_EXCEPTION_ENTRIES)
+        {
+            /* no space to store another context */
+            return NULL;
+        }
+    } while (!__sync_bool_compare_and_swap(&Storage->NumReserved, NextWrite, NextWrite + 1));
 
     Buffer = CFE_PSP_Exception_GetBuffer(NextWrite);
 
     memset(Buffer, 0, sizeof(*Buffer));
-    Buffer->context_id = CFE_PSP_EXCEPTION_ID_BASE + (NextWrite & OS_OBJECT_INDEX_MASK);
+    Buffer->reserve_seq = NextWrite;
+    Buffer->context_id  = CFE_PSP_EXCEPTION_ID_BASE + (NextWrite & OS_OBJECT_INDEX_MASK);
 
     return Buffer;
 }
@@ -109,27 +132,40 @@ CFE_PSP_Exception_LogData_t *CFE_PSP_Exception_GetNextContextBuffer(void)
  * CFE_PSP_Exception_WriteComplete
  * Internal function - see description in prototype
  *---------------------------------------------------------------------------*/
-void CFE_PSP_Exception_WriteComplete(void)
+void CFE_PSP_Exception_WriteComplete(CFE_PSP_Exception_LogData_t *Buffer)
 {
-    CFE_PSP_Exception_LogData_t *Buffer;
+    CFE_PSP_ExceptionStorage_t *Storage;
+    uint32                      NextWrite;
+
+    Storage = CFE_PSP_ReservedMemoryMap.ExceptionStoragePtr;
 
     /*
-     * Incrementing the "NumWritten" field allows the application to receive this data
+     * Mark this entry as complete.  The barriers ensure the context data
+     * is visible before the flag, and the flag before NumWritten is checked.
      */
-    ++CFE_PSP_ReservedMemoryMap.ExceptionStoragePtr->NumWritten;
+    __sync_synchronize();
+    Buffer->commit_seq = Buffer->reserve_seq + 1;
+    __sync_synchronize();
 
     /*
-     * preemptively zero-out the "id" field of the _next_ entry -
-     * this expires the buffer, which prevents it from being read.
+     * Advance "NumWritten" over every completed entry at the head of the
+     * reserved region, which allows the application to receive this data.
      *
-     * This is just in case another exception occurs while a log
-     * file write is in progress.  It's not 100% foolproof, but
-     * it does reduce the chance of data corruption (because it
-     * is not possible to "lock out" exceptions, they can occur at
-     * any time code is running)
+     * If an earlier entry is still being written, this stops there, and
+     * the handler that completes that entry will advance over this one too.
+     * The check is repeated after each step so that an entry completed
+     * concurrently with this loop is never left behind.
      */
-    Buffer             = CFE_PSP_Exception_GetBuffer(CFE_PSP_ReservedMemoryMap.ExceptionStoragePtr->NumWritten);
-    Buffer->context_id = 0;
+    while (true)
+    {
+        NextWrite = Storage->NumWritten;
+        if (NextWrite == Storage->NumReserved || CFE_PSP_Exception_GetBuffer(NextWrite)->commit_seq != (NextWrite + 1))
+        {
+            break;
+        }
+
+        __sync_bool_compare_and_swap(&Storage->NumWritten, NextWrite, NextWrite + 1);
+    }
 }
 
 /***************************************************************************
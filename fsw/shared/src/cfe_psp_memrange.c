@@ -32,9 +32,175 @@
 ** Include section
 */
 
+#include <string.h>
+
 #include "cfe_psp.h"
 #include "cfe_psp_memory.h"
 
+/*
+ * Index into CFE_PSP_MemRangeSegment_t.MaxEndAddr for a given (valid) memory type
+ */
+#define CFE_PSP_MEMRANGE_TYPE_SLOT(t) ((t) == CFE_PSP_MEM_EEPROM)
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper, get the end address of a table entry
+ * Returns false if the entry is unused or covers no addresses
+ *
+ *-----------------------------------------------------------------*/
+static bool CFE_PSP_MemRangeGetEnd(const CFE_PSP_MemTable_t *SysMemPtr, cpuaddr *EndAddr)
+{
+    if (SysMemPtr->MemoryType != CFE_PSP_MEM_RAM && SysMemPtr->MemoryType != CFE_PSP_MEM_EEPROM)
+    {
+        return false;
+    }
+
+    /* An empty entry or one that wraps around the address space never matches */
+    *EndAddr = SysMemPtr->StartAddr + SysMemPtr->Size - 1;
+    return (SysMemPtr->Size != 0 && *EndAddr >= SysMemPtr->StartAddr);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper, add a segment boundary keeping the list sorted and unique
+ *
+ *-----------------------------------------------------------------*/
+static void CFE_PSP_MemRangeAddBoundary(CFE_PSP_MemRangeIndex_t *Index, cpuaddr Addr)
+{
+    CFE_PSP_MemRangeSegment_t *SegPtr;
+    uint32                     Pos;
+
+    for (Pos = 0; Pos < Index->NumSegments; ++Pos)
+    {
+        if (Index->Segments[Pos].StartAddr == Addr)
+        {
+            return;
+        }
+    }
+
+    /* Insertion sort, shift larger boundaries up by one */
+    Pos = Index->NumSegments;
+    while (Pos > 0 && Index->Segments[Pos - 1].StartAddr > Addr)
+    {
+        Index->Segments[Pos] = Index->Segments[Pos - 1];
+        --Pos;
+    }
+
+    SegPtr                = &Index->Segments[Pos];
+    SegPtr->StartAddr     = Addr;
+    SegPtr->MaxEndAddr[0] = 0;
+    SegPtr->MaxEndAddr[1] = 0;
+    SegPtr->TypeMask      = 0;
+    memset(SegPtr->EntryMask, 0, sizeof(SegPtr->EntryMask));
+    ++Index->NumSegments;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per internal API
+ * See description in cfe_psp_memory.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CFE_PSP_MemRangeBuildIndex(void)
+{
+    CFE_PSP_MemRangeIndex_t *  Index;
+    CFE_PSP_MemTable_t *       SysMemPtr;
+    CFE_PSP_MemRangeSegment_t *SegPtr;
+    cpuaddr                    EndAddr;
+    uint32                     i;
+    uint32                     Seg;
+    uint32                     Slot;
+
+    Index              = &CFE_PSP_ReservedMemoryMap.SysMemoryIndex;
+    Index->NumSegments = 0;
+
+    /*
+     * Pass 1: collect the distinct boundaries.  Every entry contributes at
+     * most two, so the segment array cannot overflow.
+     */
+    SysMemPtr = CFE_PSP_ReservedMemoryMap.SysMemoryTable;
+    for (i = 0; i < CFE_PSP_MEM_TABLE_SIZE; ++i, ++SysMemPtr)
+    {
+        if (CFE_PSP_MemRangeGetEnd(SysMemPtr, &EndAddr))
+        {
+            CFE_PSP_MemRangeAddBoundary(Index, SysMemPtr->StartAddr);
+            if ((EndAddr + 1) > EndAddr)
+            {
+                CFE_PSP_MemRangeAddBoundary(Index, EndAddr + 1);
+            }
+        }
+    }
+
+    /*
+     * Pass 2: record which entries cover each segment.  Because entries only
+     * begin and end on boundaries, covering the segment start address means
+     * covering the entire segment.
+     */
+    SysMemPtr = CFE_PSP_ReservedMemoryMap.SysMemoryTable;
+    for (i = 0; i < CFE_PSP_MEM_TABLE_SIZE; ++i, ++SysMemPtr)
+    {
+        if (!CFE_PSP_MemRangeGetEnd(SysMemPtr, &EndAddr))
+        {
+            continue;
+        }
+
+        Slot = CFE_PSP_MEMRANGE_TYPE_SLOT(SysMemPtr->MemoryType);
+        for (Seg = 0; Seg < Index->NumSegments; ++Seg)
+        {
+            SegPtr = &Index->Segments[Seg];
+            if (SegPtr->StartAddr >= SysMemPtr->StartAddr && SegPtr->StartAddr <= EndAddr)
+            {
+                if ((SegPtr->TypeMask & (1 << SysMemPtr->MemoryType)) == 0 || EndAddr > SegPtr->MaxEndAddr[Slot])
+                {
+                    SegPtr->MaxEndAddr[Slot] = EndAddr;
+                }
+                SegPtr->TypeMask |= 1 << SysMemPtr->MemoryType;
+                SegPtr->EntryMask[i / 32] |= 1U << (i % 32);
+            }
+        }
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper, find the index segment holding an address
+ * Returns NULL if no table entry contains the address
+ *
+ *-----------------------------------------------------------------*/
+static const CFE_PSP_MemRangeSegment_t *CFE_PSP_MemRangeSearch(cpuaddr Address)
+{
+    const CFE_PSP_MemRangeIndex_t *Index;
+    uint32                         Low;
+    uint32                         High;
+    uint32                         Mid;
+
+    /*
+    ** Find the last segment starting at or below the address
+    */
+    Index = &CFE_PSP_ReservedMemoryMap.SysMemoryIndex;
+    Low   = 0;
+    High  = Index->NumSegments;
+    while (Low < High)
+    {
+        Mid = Low + ((High - Low) / 2);
+        if (Index->Segments[Mid].StartAddr <= Address)
+        {
+            Low = Mid + 1;
+        }
+        else
+        {
+            High = Mid;
+        }
+    }
+
+    if (Low == 0 || Index->Segments[Low - 1].TypeMask == 0)
+    {
+        return NULL;
+    }
+
+    return &Index->Segments[Low - 1];
+}
+
 /*----------------------------------------------------------------
  *
  * Implemented per public API
@@ -43,14 +209,10 @@
  *-----------------------------------------------------------------*/
 int32 CFE_PSP_MemValidateRange(cpuaddr Address, size_t Size, uint32 MemoryType)
 {
-    cpuaddr             StartAddressToTest = Address;
-    cpuaddr             EndAddressToTest   = Address + Size - 1;
-    cpuaddr             StartAddressInTable;
-    cpuaddr             EndAddressInTable;
-    uint32              TypeInTable;
-    int32               ReturnCode = CFE_PSP_INVALID_MEM_ADDR;
-    size_t              i;
-    CFE_PSP_MemTable_t *SysMemPtr;
+    cpuaddr                          EndAddressToTest = Address + Size - 1;
+    const CFE_PSP_MemRangeSegment_t *SegPtr;
+    bool                             TypeFits;
+    bool                             AnyFits;
 
     /*
     ** Before searching table, do a preliminary parameter validation
@@ -60,77 +222,125 @@ int32 CFE_PSP_MemValidateRange(cpuaddr Address, size_t Size, uint32 MemoryType)
         return CFE_PSP_INVALID_MEM_TYPE;
     }
 
-    if (EndAddressToTest < StartAddressToTest)
+    if (EndAddressToTest < Address)
     {
         return CFE_PSP_INVALID_MEM_RANGE;
     }
 
-    SysMemPtr = CFE_PSP_ReservedMemoryMap.SysMemoryTable;
-    for (i = 0; i < CFE_PSP_MEM_TABLE_SIZE; i++)
+    SegPtr = CFE_PSP_MemRangeSearch(Address);
+    if (SegPtr == NULL)
+    {
+        /* No entry contains the starting address */
+        return CFE_PSP_INVALID_MEM_ADDR;
+    }
+
+    /*
+    ** An entry containing the start address also contains the whole range
+    ** if its end is beyond the end of the range.  The result reflects the
+    ** best match among all entries, independent of their order in the table:
+    ** a matching type wins over a type mismatch, which wins over a range
+    ** that is too small.
+    */
+    TypeFits = false;
+    AnyFits  = false;
+    if ((SegPtr->TypeMask & (1 << CFE_PSP_MEM_RAM)) != 0 &&
+        SegPtr->MaxEndAddr[CFE_PSP_MEMRANGE_TYPE_SLOT(CFE_PSP_MEM_RAM)] >= EndAddressToTest)
+    {
+        AnyFits  = true;
+        TypeFits = (MemoryType != CFE_PSP_MEM_EEPROM);
+    }
+    if ((SegPtr->TypeMask & (1 << CFE_PSP_MEM_EEPROM)) != 0 &&
+        SegPtr->MaxEndAddr[CFE_PSP_MEMRANGE_TYPE_SLOT(CFE_PSP_MEM_EEPROM)] >= EndAddressToTest)
+    {
+        AnyFits  = true;
+        TypeFits = TypeFits || (MemoryType != CFE_PSP_MEM_RAM);
+    }
+
+    if (TypeFits)
+    {
+        return CFE_PSP_SUCCESS;
+    }
+
+    if (AnyFits)
+    {
+        return CFE_PSP_INVALID_MEM_TYPE;
+    }
+
+    return CFE_PSP_INVALID_MEM_RANGE;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per public API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CFE_PSP_MemRangeFind(cpuaddr Address, size_t Size, uint32 Attributes, uint32 *RangeNum)
+{
+    cpuaddr                          EndAddressToTest = Address + Size - 1;
+    const CFE_PSP_MemRangeSegment_t *SegPtr;
+    const CFE_PSP_MemTable_t *       SysMemPtr;
+    cpuaddr                          EndAddr;
+    uint32                           EntryMask;
+    uint32                           Word;
+    uint32                           i;
+    int32                            Status;
+
+    if (RangeNum == NULL)
+    {
+        return CFE_PSP_INVALID_POINTER;
+    }
+
+    if (EndAddressToTest < Address)
     {
-        /*
-        ** Only look at valid memory table entries
-        */
-        if (SysMemPtr->MemoryType != CFE_PSP_MEM_INVALID)
+        return CFE_PSP_INVALID_MEM_RANGE;
+    }
+
+    SegPtr = CFE_PSP_MemRangeSearch(Address);
+    if (SegPtr == NULL)
+    {
+        return CFE_PSP_INVALID_MEM_ADDR;
+    }
+
+    /*
+    ** Only the entries covering the start address need to be checked.
+    ** The most specific failure among them is reported: a misaligned
+    ** block wins over a missing attribute, which wins over a range that
+    ** is too small.
+    */
+    Status = CFE_PSP_INVALID_MEM_RANGE;
+    for (Word = 0; Word < CFE_PSP_MEMRANGE_MASK_WORDS; ++Word)
+    {
+        EntryMask = SegPtr->EntryMask[Word];
+        for (i = Word * 32; EntryMask != 0; ++i, EntryMask >>= 1)
         {
-            StartAddressInTable = SysMemPtr->StartAddr;
-            EndAddressInTable   = SysMemPtr->StartAddr + SysMemPtr->Size - 1;
-            TypeInTable         = SysMemPtr->MemoryType;
-
-            /*
-            ** Step 1: Get the Address to Fit within the range
-            */
-            if ((StartAddressToTest >= StartAddressInTable) && (StartAddressToTest <= EndAddressInTable))
+            SysMemPtr = &CFE_PSP_ReservedMemoryMap.SysMemoryTable[i];
+            if ((EntryMask & 1) == 0 || !CFE_PSP_MemRangeGetEnd(SysMemPtr, &EndAddr) || EndAddr < EndAddressToTest)
             {
-                /*
-                ** Step 2: Does the End Address Fit within the Range?
-                **         should not have to test the lower address,
-                **         since the StartAddressToTest is already in the range.
-                **         Can it be fooled by overflowing the 32 bit int?
-                */
-                if (EndAddressToTest <= EndAddressInTable)
-                {
-                    /*
-                    ** Step 3: Is the type OK?
-                    */
-                    if (MemoryType == CFE_PSP_MEM_ANY)
-                    {
-                        ReturnCode = CFE_PSP_SUCCESS;
-                        break; /* The range is valid, break out of the loop */
-                    }
-                    else if (MemoryType == CFE_PSP_MEM_RAM && TypeInTable == CFE_PSP_MEM_RAM)
-                    {
-                        ReturnCode = CFE_PSP_SUCCESS;
-                        break; /* The range is valid, break out of the loop */
-                    }
-                    else if (MemoryType == CFE_PSP_MEM_EEPROM && TypeInTable == CFE_PSP_MEM_EEPROM)
-                    {
-                        ReturnCode = CFE_PSP_SUCCESS;
-                        break; /* The range is valid, break out of the loop */
-                    }
-                    else
-                    {
-                        ReturnCode = CFE_PSP_INVALID_MEM_TYPE;
-                        /* The range is not valid, move to the next entry */
-                    }
-                }
-                else
+                continue;
+            }
+
+            if ((SysMemPtr->Attributes & Attributes) != Attributes)
+            {
+                if (Status == CFE_PSP_INVALID_MEM_RANGE)
                 {
-                    ReturnCode = CFE_PSP_INVALID_MEM_RANGE;
-                    /* The range is not valid, move to the next entry */
+                    Status = CFE_PSP_INVALID_MEM_ATTR;
                 }
+                continue;
             }
-            else
+
+            if (((Address | Size) & (SysMemPtr->WordSize - 1)) != 0)
             {
-                ReturnCode = CFE_PSP_INVALID_MEM_ADDR;
-                /* The range is not valid, move to the next entry */
+                Status = CFE_PSP_ERROR_ADDRESS_MISALIGNED;
+                continue;
             }
-        } /* End if MemoryType != CFE_PSP_MEM_INVALID */
 
-        ++SysMemPtr;
+            *RangeNum = i;
+            return CFE_PSP_SUCCESS;
+        }
+    }
 
-    } /* End for */
-    return ReturnCode;
+    return Status;
 }
 
 /*----------------------------------------------------------------
@@ -188,6 +398,8 @@ int32 CFE_PSP_MemRangeSet(uint32 RangeNum, uint32 MemoryType, cpuaddr StartAddr,
     SysMemPtr->WordSize   = WordSize;
     SysMemPtr->Attributes = Attributes;
 
+    CFE_PSP_MemRangeBuildIndex();
+
     return CFE_PSP_SUCCESS;
 }
 
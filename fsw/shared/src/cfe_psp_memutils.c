@@ -25,6 +25,10 @@
 **		   This file  contains some of the cFE Platform Support Layer.
 **        It contains the processor architecture specific calls.
 **
+**        The bulk memory routines select an implementation by processor
+**        feature.  Each has a portable C version, so the file still
+**        builds on any target supported by the PSP.
+**
 **
 */
 
@@ -41,10 +45,267 @@
 */
 
 #include "cfe_psp.h"
+
+/*
+** Processor specific kernels, using inline assembly so that no
+** compiler intrinsic headers are required.
+*/
+#if defined(__GNUC__) && defined(__x86_64__)
+#define CFE_PSP_MEM_X86_64
+#elif defined(__GNUC__) && defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define CFE_PSP_MEM_AARCH64_CRC
+#endif
+
+/*
+ * Reflected CRC-32C (Castagnoli) polynomial
+ */
+#define CFE_PSP_MEM_CRC32C_POLY 0x82F63B78
+
+/*
+ * Number of 16-bit words that can be summed before the Fletcher-32
+ * sums must be reduced to avoid overflowing 32 bits
+ */
+#define CFE_PSP_MEM_FLETCHER_BLOCK 359
+
+typedef uint32 (*CFE_PSP_MemCrc32cFunc_t)(uint32 Crc, const uint8 *Ptr, size_t Size);
+
+static uint32 CFE_PSP_MemCrc32c_Select(uint32 Crc, const uint8 *Ptr, size_t Size);
+
 /*
 ** global memory
 */
 
+/*
+ * Tables for the portable slicing-by-8 CRC-32C, filled on first use
+ */
+static uint32 CFE_PSP_MemCrc32cTable[8][256];
+
+/*
+ * CRC-32C implementation in use; resolved by the first call
+ */
+static CFE_PSP_MemCrc32cFunc_t CFE_PSP_MemCrc32cFunc = CFE_PSP_MemCrc32c_Select;
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper, fill the slicing-by-8 CRC-32C tables
+ * Every caller computes the same values, so concurrent calls are harmless
+ *
+ *-----------------------------------------------------------------*/
+static void CFE_PSP_MemCrc32c_InitTable(void)
+{
+    uint32 i;
+    uint32 k;
+    uint32 Crc;
+
+    for (i = 0; i < 256; ++i)
+    {
+        Crc = i;
+        for (k = 0; k < 8; ++k)
+        {
+            Crc = (Crc >> 1) ^ (CFE_PSP_MEM_CRC32C_POLY & (0 - (Crc & 1)));
+        }
+        CFE_PSP_MemCrc32cTable[0][i] = Crc;
+    }
+
+    for (k = 1; k < 8; ++k)
+    {
+        for (i = 0; i < 256; ++i)
+        {
+            Crc                          = CFE_PSP_MemCrc32cTable[k - 1][i];
+            CFE_PSP_MemCrc32cTable[k][i] = (Crc >> 8) ^ CFE_PSP_MemCrc32cTable[0][Crc & 0xFF];
+        }
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper, portable CRC-32C using slicing-by-8
+ * Loads are done by byte so this works on any alignment and byte order
+ *
+ *-----------------------------------------------------------------*/
+static uint32 CFE_PSP_MemCrc32c_Table(uint32 Crc, const uint8 *Ptr, size_t Size)
+{
+    uint32 Lo;
+    uint32 Hi;
+
+    while (Size >= 8)
+    {
+        Lo = Crc ^ ((uint32)Ptr[0] | ((uint32)Ptr[1] << 8) | ((uint32)Ptr[2] << 16) | ((uint32)Ptr[3] << 24));
+        Hi = (uint32)Ptr[4] | ((uint32)Ptr[5] << 8) | ((uint32)Ptr[6] << 16) | ((uint32)Ptr[7] << 24);
+
+        Crc = CFE_PSP_MemCrc32cTable[7][Lo & 0xFF] ^ CFE_PSP_MemCrc32cTable[6][(Lo >> 8) & 0xFF] ^
+              CFE_PSP_MemCrc32cTable[5][(Lo >> 16) & 0xFF] ^ CFE_PSP_MemCrc32cTable[4][Lo >> 24] ^
+              CFE_PSP_MemCrc32cTable[3][Hi & 0xFF] ^ CFE_PSP_MemCrc32cTable[2][(Hi >> 8) & 0xFF] ^
+              CFE_PSP_MemCrc32cTable[1][(Hi >> 16) & 0xFF] ^ CFE_PSP_MemCrc32cTable[0][Hi >> 24];
+
+        Ptr += 8;
+        Size -= 8;
+    }
+
+    while (Size > 0)
+    {
+        Crc = (Crc >> 8) ^ CFE_PSP_MemCrc32cTable[0][(Crc ^ *Ptr) & 0xFF];
+        ++Ptr;
+        --Size;
+    }
+
+    return Crc;
+}
+
+#ifdef CFE_PSP_MEM_X86_64
+/*----------------------------------------------------------------
+ *
+ * Internal helper, CRC-32C using the SSE4.2 crc32 instruction
+ *
+ *-----------------------------------------------------------------*/
+static uint32 CFE_PSP_MemCrc32c_SSE42(uint32 Crc, const uint8 *Ptr, size_t Size)
+{
+    uint64 Crc64;
+    uint64 Word;
+
+    while (Size > 0 && ((cpuaddr)Ptr & 7) != 0)
+    {
+        __asm__("crc32b %1, %0" : "+r"(Crc) : "rm"(*Ptr));
+        ++Ptr;
+        --Size;
+    }
+
+    Crc64 = Crc;
+    while (Size >= 8)
+    {
+        memcpy(&Word, Ptr, sizeof(Word));
+        __asm__("crc32q %1, %0" : "+r"(Crc64) : "rm"(Word));
+        Ptr += 8;
+        Size -= 8;
+    }
+    Crc = (uint32)Crc64;
+
+    while (Size > 0)
+    {
+        __asm__("crc32b %1, %0" : "+r"(Crc) : "rm"(*Ptr));
+        ++Ptr;
+        --Size;
+    }
+
+    return Crc;
+}
+#endif
+
+#ifdef CFE_PSP_MEM_AARCH64_CRC
+/*----------------------------------------------------------------
+ *
+ * Internal helper, CRC-32C using the ARMv8 CRC32 extension
+ *
+ *-----------------------------------------------------------------*/
+static uint32 CFE_PSP_MemCrc32c_ARMv8(uint32 Crc, const uint8 *Ptr, size_t Size)
+{
+    uint64 Word;
+
+    while (Size >= 8)
+    {
+        memcpy(&Word, Ptr, sizeof(Word));
+        __asm__("crc32cx %w0, %w0, %x1" : "+r"(Crc) : "r"(Word));
+        Ptr += 8;
+        Size -= 8;
+    }
+
+    while (Size > 0)
+    {
+        __asm__("crc32cb %w0, %w0, %w1" : "+r"(Crc) : "r"((uint32)*Ptr));
+        ++Ptr;
+        --Size;
+    }
+
+    return Crc;
+}
+#endif
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper, choose the CRC-32C implementation for this processor
+ * Installed as the initial implementation, so this runs on the first call
+ *
+ *-----------------------------------------------------------------*/
+static uint32 CFE_PSP_MemCrc32c_Select(uint32 Crc, const uint8 *Ptr, size_t Size)
+{
+    CFE_PSP_MemCrc32cFunc_t Func;
+
+    Func = NULL;
+
+#if defined(CFE_PSP_MEM_X86_64)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.2"))
+    {
+        Func = CFE_PSP_MemCrc32c_SSE42;
+    }
+#elif defined(CFE_PSP_MEM_AARCH64_CRC)
+    Func = CFE_PSP_MemCrc32c_ARMv8;
+#endif
+
+    if (Func == NULL)
+    {
+        CFE_PSP_MemCrc32c_InitTable();
+        Func = CFE_PSP_MemCrc32c_Table;
+    }
+
+    /* release, so a task that loads this pointer also sees the filled tables */
+    __atomic_store_n(&CFE_PSP_MemCrc32cFunc, Func, __ATOMIC_RELEASE);
+
+    return Func(Crc, Ptr, Size);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper, Fletcher-32 over little-endian 16-bit words
+ * An odd trailing byte is treated as a word padded with zero
+ *
+ *-----------------------------------------------------------------*/
+static uint32 CFE_PSP_MemFletcher32(uint32 Checksum, const uint8 *Ptr, size_t Size)
+{
+    uint32 Sum1;
+    uint32 Sum2;
+    size_t Words;
+    size_t Block;
+
+    Sum1  = Checksum & 0xFFFF;
+    Sum2  = Checksum >> 16;
+    Words = Size / 2;
+
+    while (Words > 0)
+    {
+        Block = Words;
+        if (Block > CFE_PSP_MEM_FLETCHER_BLOCK)
+        {
+            Block = CFE_PSP_MEM_FLETCHER_BLOCK;
+        }
+        Words -= Block;
+
+        do
+        {
+            Sum1 += (uint32)Ptr[0] | ((uint32)Ptr[1] << 8);
+            Sum2 += Sum1;
+            Ptr += 2;
+        } while (--Block > 0);
+
+        Sum1 = (Sum1 & 0xFFFF) + (Sum1 >> 16);
+        Sum2 = (Sum2 & 0xFFFF) + (Sum2 >> 16);
+    }
+
+    if ((Size & 1) != 0)
+    {
+        Sum1 += *Ptr;
+        Sum2 += Sum1;
+    }
+
+    /* second reduction, the sums are now at most 0xFFFF */
+    Sum1 = (Sum1 & 0xFFFF) + (Sum1 >> 16);
+    Sum1 = (Sum1 & 0xFFFF) + (Sum1 >> 16);
+    Sum2 = (Sum2 & 0xFFFF) + (Sum2 >> 16);
+    Sum2 = (Sum2 & 0xFFFF) + (Sum2 >> 16);
+
+    return (Sum2 << 16) | Sum1;
+}
+
 /*----------------------------------------------------------------
  *
  * Implemented per public API
@@ -68,3 +329,147 @@ int32 CFE_PSP_MemSet(void *dest, uint8 value, uint32 n)
     memset(dest, (int)value, (size_t)n);
     return CFE_PSP_SUCCESS;
 }
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per public API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CFE_PSP_MemCpy64(void *dest, const void *src, size_t n)
+{
+    memcpy(dest, src, n);
+    return CFE_PSP_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per public API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CFE_PSP_MemCpyStream(void *dest, const void *src, size_t n)
+{
+#ifdef CFE_PSP_MEM_X86_64
+    uint8 *      DestPtr = dest;
+    const uint8 *SrcPtr  = src;
+    uint64       Word;
+    size_t       Head;
+
+    /*
+     * movnti is part of SSE2, so it is always available on x86-64.
+     * Align the destination for the non-temporal stores, then copy
+     * 8 bytes at a time and leave the remainder to memcpy.
+     */
+    Head = (0 - (cpuaddr)DestPtr) & 7;
+    if (Head > n)
+    {
+        Head = n;
+    }
+    memcpy(DestPtr, SrcPtr, Head);
+    DestPtr += Head;
+    SrcPtr += Head;
+    n -= Head;
+
+    while (n >= 8)
+    {
+        memcpy(&Word, SrcPtr, sizeof(Word));
+        __asm__ volatile("movnti %1, %0" : "=m"(*(uint64 *)DestPtr) : "r"(Word));
+        DestPtr += 8;
+        SrcPtr += 8;
+        n -= 8;
+    }
+
+    /* non-temporal stores are weakly ordered, so fence before returning */
+    __asm__ volatile("sfence" ::: "memory");
+
+    memcpy(DestPtr, SrcPtr, n);
+#else
+    memcpy(dest, src, n);
+#endif
+
+    return CFE_PSP_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per public API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CFE_PSP_MemCmp(const void *s1, const void *s2, size_t n, size_t *MismatchOffset)
+{
+    const uint8 *Ptr1 = s1;
+    const uint8 *Ptr2 = s2;
+    uint32       Word1;
+    uint32       Word2;
+    size_t       Offset;
+
+    if (s1 == NULL || s2 == NULL)
+    {
+        return CFE_PSP_INVALID_POINTER;
+    }
+
+    /*
+     * Compare a word at a time to find the region of the first difference,
+     * then narrow it down by byte.
+     */
+    Offset = 0;
+    while ((n - Offset) >= sizeof(Word1))
+    {
+        memcpy(&Word1, &Ptr1[Offset], sizeof(Word1));
+        memcpy(&Word2, &Ptr2[Offset], sizeof(Word2));
+        if (Word1 != Word2)
+        {
+            break;
+        }
+        Offset += sizeof(Word1);
+    }
+
+    while (Offset < n && Ptr1[Offset] == Ptr2[Offset])
+    {
+        ++Offset;
+    }
+
+    if (MismatchOffset != NULL)
+    {
+        *MismatchOffset = Offset;
+    }
+
+    if (Offset < n)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    return CFE_PSP_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per public API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CFE_PSP_MemChecksum(const void *src, size_t n, uint32 Type, uint32 *Checksum)
+{
+    if (src == NULL || Checksum == NULL)
+    {
+        return CFE_PSP_INVALID_POINTER;
+    }
+
+    switch (Type)
+    {
+        case CFE_PSP_MEM_CHECKSUM_CRC32C:
+            *Checksum = ~__atomic_load_n(&CFE_PSP_MemCrc32cFunc, __ATOMIC_ACQUIRE)(~(*Checksum), src, n);
+            break;
+
+        case CFE_PSP_MEM_CHECKSUM_FLETCHER32:
+            *Checksum = CFE_PSP_MemFletcher32(*Checksum, src, n);
+            break;
+
+        default:
+            return CFE_PSP_ERROR;
+    }
+
+    return CFE_PSP_SUCCESS;
+}
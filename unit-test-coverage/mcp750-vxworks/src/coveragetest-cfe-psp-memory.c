@@ -0,0 +1,127 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ * \ingroup  vxworks
+ *
+ */
+
+#include "coveragetest-psp-mcp750-vxworks.h"
+
+#include "cfe_psp.h"
+#include "cfe_psp_memory.h"
+#include "PCS_string.h"
+
+void Test_CFE_PSP_WriteToCDSv(void)
+{
+    uint8                 CDSBlock[32];
+    uint8                 Data[8] = {0};
+    CFE_PSP_CDSWriteVec_t Vec[2];
+
+    CFE_PSP_ReservedMemoryMap.CDSMemory.BlockPtr  = CDSBlock;
+    CFE_PSP_ReservedMemoryMap.CDSMemory.BlockSize = sizeof(CDSBlock);
+
+    Vec[0].CDSOffset = 0;
+    Vec[0].NumBytes  = sizeof(Data);
+    Vec[0].DataPtr   = Data;
+    Vec[1].CDSOffset = sizeof(CDSBlock) - sizeof(Data);
+    Vec[1].NumBytes  = sizeof(Data);
+    Vec[1].DataPtr   = Data;
+
+    /* Test NULL pointer guard */
+    UtAssert_INT32_EQ(CFE_PSP_WriteToCDSv(NULL, 2, 0), CFE_PSP_ERROR);
+
+    /* Nominal path, one copy per entry */
+    UtAssert_INT32_EQ(CFE_PSP_WriteToCDSv(Vec, 2, CFE_PSP_CDS_VEC_FENCE), CFE_PSP_SUCCESS);
+    UtAssert_STUB_COUNT(PCS_memcpy, 2);
+
+    /* Empty vector and zero length entry */
+    UT_ResetState(UT_KEY(PCS_memcpy));
+    UtAssert_INT32_EQ(CFE_PSP_WriteToCDSv(Vec, 0, 0), CFE_PSP_SUCCESS);
+    UtAssert_STUB_COUNT(PCS_memcpy, 0);
+    Vec[1].NumBytes = 0;
+    UtAssert_INT32_EQ(CFE_PSP_WriteToCDSv(Vec, 2, 0), CFE_PSP_SUCCESS);
+    UtAssert_STUB_COUNT(PCS_memcpy, 2);
+
+    /* An out of range entry rejects the whole request without copying anything */
+    UT_ResetState(UT_KEY(PCS_memcpy));
+    Vec[1].NumBytes  = sizeof(Data);
+    Vec[1].CDSOffset = sizeof(CDSBlock) - sizeof(Data) + 1;
+    UtAssert_INT32_EQ(CFE_PSP_WriteToCDSv(Vec, 2, 0), CFE_PSP_ERROR);
+    Vec[1].CDSOffset = sizeof(CDSBlock);
+    Vec[1].NumBytes  = 0;
+    UtAssert_INT32_EQ(CFE_PSP_WriteToCDSv(Vec, 2, 0), CFE_PSP_ERROR);
+    Vec[1].CDSOffset = 0xFFFFFFFF;
+    Vec[1].NumBytes  = sizeof(Data);
+    UtAssert_INT32_EQ(CFE_PSP_WriteToCDSv(Vec, 2, 0), CFE_PSP_ERROR);
+
+    /* A NULL data pointer rejects the whole request, even for a zero length entry */
+    Vec[1].CDSOffset = 0;
+    Vec[1].DataPtr   = NULL;
+    UtAssert_INT32_EQ(CFE_PSP_WriteToCDSv(Vec, 2, 0), CFE_PSP_ERROR);
+    Vec[1].NumBytes = 0;
+    UtAssert_INT32_EQ(CFE_PSP_WriteToCDSv(Vec, 2, 0), CFE_PSP_ERROR);
+    UtAssert_STUB_COUNT(PCS_memcpy, 0);
+}
+
+void Test_CFE_PSP_ReadFromCDSv(void)
+{
+    uint8                CDSBlock[32];
+    uint8                Data[8];
+    CFE_PSP_CDSReadVec_t Vec[2];
+
+    CFE_PSP_ReservedMemoryMap.CDSMemory.BlockPtr  = CDSBlock;
+    CFE_PSP_ReservedMemoryMap.CDSMemory.BlockSize = sizeof(CDSBlock);
+
+    Vec[0].CDSOffset = 0;
+    Vec[0].NumBytes  = sizeof(Data);
+    Vec[0].DataPtr   = Data;
+    Vec[1].CDSOffset = sizeof(CDSBlock) - sizeof(Data);
+    Vec[1].NumBytes  = sizeof(Data);
+    Vec[1].DataPtr   = Data;
+
+    /* Test NULL pointer guard */
+    UtAssert_INT32_EQ(CFE_PSP_ReadFromCDSv(NULL, 2, 0), CFE_PSP_ERROR);
+
+    /* Nominal path, one copy per entry */
+    UtAssert_INT32_EQ(CFE_PSP_ReadFromCDSv(Vec, 2, CFE_PSP_CDS_VEC_FENCE), CFE_PSP_SUCCESS);
+    UtAssert_STUB_COUNT(PCS_memcpy, 2);
+
+    /* Empty vector and zero length entry */
+    UT_ResetState(UT_KEY(PCS_memcpy));
+    UtAssert_INT32_EQ(CFE_PSP_ReadFromCDSv(Vec, 0, 0), CFE_PSP_SUCCESS);
+    UtAssert_STUB_COUNT(PCS_memcpy, 0);
+    Vec[1].NumBytes = 0;
+    UtAssert_INT32_EQ(CFE_PSP_ReadFromCDSv(Vec, 2, 0), CFE_PSP_SUCCESS);
+    UtAssert_STUB_COUNT(PCS_memcpy, 2);
+
+    /* An out of range entry rejects the whole request without copying anything */
+    UT_ResetState(UT_KEY(PCS_memcpy));
+    Vec[1].NumBytes = sizeof(Data) + 1;
+    UtAssert_INT32_EQ(CFE_PSP_ReadFromCDSv(Vec, 2, 0), CFE_PSP_ERROR);
+    Vec[1].CDSOffset = 0xFFFFFFFF;
+    Vec[1].NumBytes  = sizeof(Data);
+    UtAssert_INT32_EQ(CFE_PSP_ReadFromCDSv(Vec, 2, 0), CFE_PSP_ERROR);
+
+    /* A NULL buffer rejects the whole request */
+    Vec[1].CDSOffset = 0;
+    Vec[1].DataPtr   = NULL;
+    UtAssert_INT32_EQ(CFE_PSP_ReadFromCDSv(Vec, 2, 0), CFE_PSP_ERROR);
+    UtAssert_STUB_COUNT(PCS_memcpy, 0);
+}
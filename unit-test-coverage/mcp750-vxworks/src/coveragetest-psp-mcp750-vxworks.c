@@ -70,9 +70,20 @@ void UtTest_Setup(void)
     ADD_TEST(CFE_PSP_FlushCaches);
     ADD_TEST(CFE_PSP_GetProcessorId);
     ADD_TEST(CFE_PSP_GetSpacecraftId);
+    ADD_TEST(CFE_PSP_WriteToCDSv);
+    ADD_TEST(CFE_PSP_ReadFromCDSv);
 
     ADD_TEST(CFE_PSP_Exception_GetBuffer);
     ADD_TEST(CFE_PSP_Exception_GetNextContextBuffer);
     ADD_TEST(CFE_PSP_Exception_GetSummary);
     ADD_TEST(CFE_PSP_Exception_CopyContext);
+
+    ADD_TEST(CFE_PSP_MemValidateRange);
+    ADD_TEST(CFE_PSP_MemRangeFind);
+    ADD_TEST(CFE_PSP_MemRangeSet);
+
+    ADD_TEST(CFE_PSP_MemCpy64);
+    ADD_TEST(CFE_PSP_MemCpyStream);
+    ADD_TEST(CFE_PSP_MemCmp);
+    ADD_TEST(CFE_PSP_MemChecksum);
 }
@@ -0,0 +1,51 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System:
+ * Draco
+ *
+ * Copyright (c) 2023 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **********************************************************************/
+
+/**
+ * \file
+ * \ingroup  modules
+ *
+ */
+
+#ifndef COVERAGETEST_IODRIVER_H
+#define COVERAGETEST_IODRIVER_H
+
+#include "utassert.h"
+#include "uttest.h"
+#include "utstubs.h"
+
+#include "iodriver_base.h"
+#include "iodriver_impl.h"
+#include "iodriver_packet_io.h"
+#include "iodriver_stream_io.h"
+#include "iodriver_async_io.h"
+
+void Test_Lock_Nominal(void);
+void Test_Lock_Error(void);
+void Test_Handle_Nominal(void);
+void Test_Handle_Error(void);
+void Test_Batch_Nominal(void);
+void Test_Batch_Group(void);
+void Test_Batch_Error(void);
+void Test_Loan_Nominal(void);
+void Test_Loan_Error(void);
+void Test_Async_Nominal(void);
+void Test_Async_Error(void);
+
+#endif
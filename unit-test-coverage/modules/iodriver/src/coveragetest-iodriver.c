@@ -0,0 +1,731 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System:
+ * Draco
+ *
+ * Copyright (c) 2023 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **********************************************************************/
+
+/**
+ * \file
+ * \ingroup  modules
+ *
+ * Coverage test for the iodriver locks, handles, batches, loan pools and asynchronous queues
+ */
+
+#include <string.h>
+
+#include "utassert.h"
+#include "utstubs.h"
+#include "uttest.h"
+
+#include "cfe_psp.h"
+#include "cfe_psp_module.h"
+
+#include "coveragetest-iodriver.h"
+
+/*
+ * Module IDs of the test drivers, resolved by CFE_PSP_Module_GetAPIEntry() below
+ */
+#define UT_DRIVER_ID  0x00100101 /* driver with UT_NUM_LOCKS locks */
+#define UT_NOCMD_ID   0x00100102 /* driver without a command function */
+#define UT_SIMPLE_ID  0x00100103 /* module that is not a driver */
+#define UT_UNKNOWN_ID 0x00100104
+
+/*
+ * Locks of the test driver, lock N is used by subsystem N
+ */
+#define UT_NUM_LOCKS 2
+
+/* subsystem of which the lock is not declared */
+#define UT_BADLOCK_SUBSYS 5
+
+/*
+ * Commands of the test driver
+ */
+#define UT_CMD_READ   1 /* shares the lock of its subsystem */
+#define UT_CMD_WRITE  2 /* holds the lock of its subsystem alone */
+#define UT_CMD_NOLOCK 3 /* takes no lock */
+#define UT_CMD_FAIL   4 /* shares the lock of its subsystem, and fails */
+#define UT_CMD_NEG    5 /* takes no lock, selected with a negative value other than CFE_PSP_IODRIVER_LOCK_NONE */
+
+/*
+ * A call of the command function of the test driver
+ */
+typedef struct
+{
+    uint32 CommandCode;
+    uint16 Subsystem;
+    uint16 Subchannel;
+    uint32 Readers; /* readers of the lock of the subsystem during the call */
+} UT_DriverCall_t;
+
+#define UT_MAX_CALLS 16
+
+static UT_DriverCall_t UT_DriverCalls[UT_MAX_CALLS];
+static uint32          UT_NumDriverCalls;
+static uint32          UT_NumGetAPIEntry;
+
+static CFE_PSP_IODriver_Lock_t UT_DriverLocks[UT_NUM_LOCKS];
+
+static int32 UT_DevCmd(uint32 CommandCode, uint16 Subsystem, uint16 Subchannel, CFE_PSP_IODriver_Arg_t Arg)
+{
+    UT_DriverCall_t *Call;
+
+    if (UT_NumDriverCalls < UT_MAX_CALLS)
+    {
+        Call              = &UT_DriverCalls[UT_NumDriverCalls];
+        Call->CommandCode = CommandCode;
+        Call->Subsystem   = Subsystem;
+        Call->Subchannel  = Subchannel;
+        Call->Readers     = (Subsystem < UT_NUM_LOCKS) ? UT_DriverLocks[Subsystem].Readers : 0;
+    }
+    ++UT_NumDriverCalls;
+
+    return (CommandCode == UT_CMD_FAIL) ? CFE_PSP_ERROR : CFE_PSP_SUCCESS;
+}
+
+static int32 UT_DevLock(uint32 CommandCode, uint16 Subsystem, uint16 Subchannel, CFE_PSP_IODriver_Arg_t Arg)
+{
+    int32 Lock;
+
+    switch (CommandCode)
+    {
+        case UT_CMD_WRITE:
+            Lock = CFE_PSP_IODriver_LockExclusive(Subsystem);
+            break;
+        case UT_CMD_NOLOCK:
+            Lock = CFE_PSP_IODRIVER_LOCK_NONE;
+            break;
+        case UT_CMD_NEG:
+            Lock = -2;
+            break;
+        default:
+            Lock = CFE_PSP_IODriver_LockShared(Subsystem);
+            break;
+    }
+
+    return Lock;
+}
+
+/* size of the packets read by the command function for the asynchronous requests */
+#define UT_ASYNC_PACKET_SIZE 4
+
+/*
+ * Command function of the test driver for the asynchronous requests, which
+ * reads short packets and fails the stream reads
+ */
+static int32 UT_AsyncCmd(uint32 CommandCode, uint16 Subsystem, uint16 Subchannel, CFE_PSP_IODriver_Arg_t Arg)
+{
+    CFE_PSP_IODriver_ReadPacketBuffer_t *ReadPacket;
+    int32                                Status;
+
+    Status = UT_DevCmd(CommandCode, Subsystem, Subchannel, Arg);
+    switch (CommandCode)
+    {
+        case CFE_PSP_IODriver_PACKET_IO_READ:
+            ReadPacket             = Arg.Vptr;
+            ReadPacket->BufferSize = UT_ASYNC_PACKET_SIZE;
+            break;
+        case CFE_PSP_IODriver_STREAM_IO_READ:
+            Status = CFE_PSP_ERROR_TIMEOUT;
+            break;
+        default:
+            break;
+    }
+
+    return Status;
+}
+
+static CFE_PSP_IODriver_API_t UT_DriverApi = {
+    .DeviceCommand = UT_DevCmd, .DeviceLock = UT_DevLock, .Locks = UT_DriverLocks, .NumLocks = UT_NUM_LOCKS};
+
+static CFE_PSP_IODriver_API_t UT_NoCmdApi = {.DeviceCommand = NULL};
+
+static CFE_PSP_ModuleApi_t UT_DriverModule = {.ModuleType  = CFE_PSP_MODULE_TYPE_DEVICEDRIVER,
+                                              .ExtendedApi = &UT_DriverApi};
+static CFE_PSP_ModuleApi_t UT_NoCmdModule  = {.ModuleType  = CFE_PSP_MODULE_TYPE_DEVICEDRIVER,
+                                              .ExtendedApi = &UT_NoCmdApi};
+static CFE_PSP_ModuleApi_t UT_SimpleModule = {.ModuleType = CFE_PSP_MODULE_TYPE_SIMPLE};
+
+/*
+ * Module table of the test, in place of the PSP module list
+ */
+int32 CFE_PSP_Module_GetAPIEntry(uint32 PspModuleId, CFE_PSP_ModuleApi_t **API)
+{
+    ++UT_NumGetAPIEntry;
+
+    switch (PspModuleId)
+    {
+        case UT_DRIVER_ID:
+            *API = (CFE_PSP_ModuleApi_t *)&UT_DriverModule;
+            break;
+        case UT_NOCMD_ID:
+            *API = (CFE_PSP_ModuleApi_t *)&UT_NoCmdModule;
+            break;
+        case UT_SIMPLE_ID:
+            *API = (CFE_PSP_ModuleApi_t *)&UT_SimpleModule;
+            break;
+        default:
+            return CFE_PSP_INVALID_MODULE_ID;
+    }
+
+    return CFE_PSP_SUCCESS;
+}
+
+int32 CFE_PSP_Module_FindByName(const char *ModuleName, uint32 *PspModuleId)
+{
+    return CFE_PSP_INVALID_MODULE_NAME;
+}
+
+/* Sets up a request of a batch to the test driver */
+static void UT_SetRequest(CFE_PSP_IODriver_Request_t *Request, uint32 PspModuleId, uint32 CommandCode,
+                          uint16 Subsystem)
+{
+    memset(Request, 0, sizeof(*Request));
+    Request->Location.PspModuleId = PspModuleId;
+    Request->Location.SubsystemId = Subsystem;
+    Request->CommandCode          = CommandCode;
+    Request->Status               = 1; /* not a result of the test driver */
+}
+
+void ModuleTest_ResetState(void)
+{
+    UT_ResetState(0);
+    memset(UT_DriverLocks, 0, sizeof(UT_DriverLocks));
+    memset(UT_DriverCalls, 0, sizeof(UT_DriverCalls));
+    UT_NumDriverCalls = 0;
+    UT_NumGetAPIEntry = 0;
+}
+
+void Test_Lock_Nominal(void)
+{
+    CFE_PSP_IODriver_Location_t  Location = {.PspModuleId = UT_DRIVER_ID, .SubsystemId = 0, .SubchannelId = 0};
+    CFE_PSP_IODriver_LockStats_t Stats;
+    uint32                       TimedWaits;
+    uint32                       Gives;
+
+    /* Nominal Case: Read, creates the lock and shares it */
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_Command(&Location, UT_CMD_READ, CFE_PSP_IODriver_U32ARG(0)), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(UT_NumDriverCalls, 1);
+    UtAssert_UINT32_EQ(UT_DriverCalls[0].Readers, 1);
+    UtAssert_UINT32_EQ(UT_DriverLocks[0].Readers, 0);
+    UtAssert_UINT32_EQ(UT_DriverLocks[0].Created, 1);
+    UtAssert_UINT32_EQ(UT_DriverLocks[1].Created, 0);
+    UtAssert_STUB_COUNT(OS_MutSemCreate, 2);
+    UtAssert_STUB_COUNT(OS_BinSemCreate, 1);
+
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_GetLockStats(UT_DRIVER_ID, 0, &Stats), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Stats.SharedCount, 1);
+    UtAssert_UINT32_EQ(Stats.SharedContended, 0);
+    UtAssert_UINT32_EQ(Stats.ExclusiveCount, 0);
+
+    /* Nominal Case: Write, waits for the lock held by another task */
+    UT_SetDeferredRetcode(UT_KEY(OS_BinSemTimedWait), 1, OS_SEM_TIMEOUT);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_Command(&Location, UT_CMD_WRITE, CFE_PSP_IODriver_U32ARG(0)), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(UT_NumDriverCalls, 2);
+    UtAssert_UINT32_EQ(UT_DriverCalls[1].Readers, 0);
+    UtAssert_STUB_COUNT(OS_BinSemTake, 1);
+    UtAssert_STUB_COUNT(OS_MutSemCreate, 2);
+
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_GetLockStats(UT_DRIVER_ID, 0, &Stats), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Stats.SharedCount, 1);
+    UtAssert_UINT32_EQ(Stats.ExclusiveCount, 1);
+    UtAssert_UINT32_EQ(Stats.ExclusiveContended, 1);
+
+    /* Nominal Case: Readers take the access only once between them */
+    TimedWaits = UT_GetStubCount(UT_KEY(OS_BinSemTimedWait));
+    Gives      = UT_GetStubCount(UT_KEY(OS_BinSemGive));
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_LockTake(UT_DRIVER_ID, 0, &UT_DriverLocks[0], true), CFE_PSP_SUCCESS);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_LockTake(UT_DRIVER_ID, 0, &UT_DriverLocks[0], true), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(UT_DriverLocks[0].Readers, 2);
+    UtAssert_UINT32_EQ(UT_GetStubCount(UT_KEY(OS_BinSemTimedWait)), TimedWaits + 1);
+    CFE_PSP_IODriver_LockGive(&UT_DriverLocks[0], true);
+    UtAssert_UINT32_EQ(UT_GetStubCount(UT_KEY(OS_BinSemGive)), Gives);
+    CFE_PSP_IODriver_LockGive(&UT_DriverLocks[0], true);
+    UtAssert_UINT32_EQ(UT_GetStubCount(UT_KEY(OS_BinSemGive)), Gives + 1);
+    UtAssert_UINT32_EQ(UT_DriverLocks[0].Readers, 0);
+
+    /* Nominal Case: A command without a lock */
+    Location.SubsystemId = 1;
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_Command(&Location, UT_CMD_NOLOCK, CFE_PSP_IODriver_U32ARG(0)),
+                      CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(UT_NumDriverCalls, 3);
+    UtAssert_UINT32_EQ(UT_DriverLocks[1].Created, 0);
+}
+
+void Test_Lock_Error(void)
+{
+    CFE_PSP_IODriver_Location_t  Location = {.PspModuleId = UT_DRIVER_ID, .SubsystemId = 1, .SubchannelId = 0};
+    CFE_PSP_IODriver_LockStats_t Stats;
+
+    /* Error Case: Lock not declared by the driver */
+    Location.SubsystemId = UT_BADLOCK_SUBSYS;
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_Command(&Location, UT_CMD_READ, CFE_PSP_IODriver_U32ARG(0)), CFE_PSP_ERROR);
+    UtAssert_UINT32_EQ(UT_NumDriverCalls, 0);
+
+    /* Error Case: Lock cannot be created, nothing is left behind */
+    Location.SubsystemId = 1;
+    UT_SetDeferredRetcode(UT_KEY(OS_BinSemCreate), 1, OS_ERROR);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_Command(&Location, UT_CMD_READ, CFE_PSP_IODriver_U32ARG(0)), CFE_PSP_ERROR);
+    UtAssert_UINT32_EQ(UT_NumDriverCalls, 0);
+    UtAssert_UINT32_EQ(UT_DriverLocks[1].Created, 0);
+    UtAssert_STUB_COUNT(OS_MutSemDelete, 2);
+
+    /* Nominal Case: The next request creates it */
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_Command(&Location, UT_CMD_READ, CFE_PSP_IODriver_U32ARG(0)), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(UT_NumDriverCalls, 1);
+    UtAssert_UINT32_EQ(UT_DriverLocks[1].Created, 1);
+
+    /* Error Case: Creation of the locks cannot be serialized */
+    Location.SubsystemId = 0;
+    UT_SetDeferredRetcode(UT_KEY(OS_MutSemTake), 1, OS_ERROR);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_Command(&Location, UT_CMD_WRITE, CFE_PSP_IODriver_U32ARG(0)), CFE_PSP_ERROR);
+    UtAssert_UINT32_EQ(UT_NumDriverCalls, 1);
+    UtAssert_UINT32_EQ(UT_DriverLocks[0].Created, 0);
+
+    /* Error Case: Driver without a command function */
+    Location.PspModuleId = UT_NOCMD_ID;
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_Command(&Location, UT_CMD_READ, CFE_PSP_IODriver_U32ARG(0)),
+                      CFE_PSP_ERROR_NOT_IMPLEMENTED);
+
+    /* Error Case: Lock statistics */
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_GetLockStats(UT_DRIVER_ID, 0, NULL), CFE_PSP_INVALID_POINTER);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_GetLockStats(UT_DRIVER_ID, UT_NUM_LOCKS, &Stats),
+                      CFE_PSP_ERROR_NOT_IMPLEMENTED);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_GetLockStats(UT_SIMPLE_ID, 0, &Stats), CFE_PSP_ERROR_NOT_IMPLEMENTED);
+}
+
+void Test_Handle_Nominal(void)
+{
+    CFE_PSP_IODriver_Location_t Location = {.PspModuleId = UT_DRIVER_ID, .SubsystemId = 1, .SubchannelId = 3};
+    CFE_PSP_IODriver_Handle_t   Handle;
+
+    /* Nominal Case: Bind creates all the locks */
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_Bind(&Location, &Handle), CFE_PSP_SUCCESS);
+    UtAssert_True(Handle.Api == &UT_DriverApi, "Nominal Case: Bind, Handle Resolved");
+    UtAssert_UINT32_EQ(Handle.Location.SubchannelId, 3);
+    UtAssert_UINT32_EQ(UT_DriverLocks[0].Created, 1);
+    UtAssert_UINT32_EQ(UT_DriverLocks[1].Created, 1);
+
+    /* Nominal Case: Commands by handle do not look up the driver again */
+    UT_NumGetAPIEntry = 0;
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_CommandByHandle(&Handle, UT_CMD_READ, CFE_PSP_IODriver_U32ARG(0)),
+                      CFE_PSP_SUCCESS);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_CommandByHandle(&Handle, UT_CMD_WRITE, CFE_PSP_IODriver_U32ARG(0)),
+                      CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(UT_NumGetAPIEntry, 0);
+    UtAssert_UINT32_EQ(UT_NumDriverCalls, 2);
+    UtAssert_UINT32_EQ(UT_DriverCalls[0].Subsystem, 1);
+    UtAssert_UINT32_EQ(UT_DriverCalls[0].Subchannel, 3);
+    UtAssert_UINT32_EQ(UT_DriverCalls[0].Readers, 1);
+    UtAssert_UINT32_EQ(UT_DriverCalls[1].CommandCode, UT_CMD_WRITE);
+}
+
+void Test_Handle_Error(void)
+{
+    CFE_PSP_IODriver_Location_t Location = {.PspModuleId = UT_DRIVER_ID, .SubsystemId = 0, .SubchannelId = 0};
+    CFE_PSP_IODriver_Handle_t   Handle;
+
+    /* Error Case: NULL pointers */
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_Bind(NULL, &Handle), CFE_PSP_INVALID_POINTER);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_Bind(&Location, NULL), CFE_PSP_INVALID_POINTER);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_CommandByHandle(NULL, UT_CMD_READ, CFE_PSP_IODriver_U32ARG(0)),
+                      CFE_PSP_INVALID_POINTER);
+
+    /* Error Case: Not a driver */
+    Location.PspModuleId = UT_UNKNOWN_ID;
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_Bind(&Location, &Handle), CFE_PSP_INVALID_MODULE_ID);
+    UtAssert_NULL(Handle.Api);
+    Location.PspModuleId = UT_SIMPLE_ID;
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_Bind(&Location, &Handle), CFE_PSP_INVALID_MODULE_ID);
+    UtAssert_NULL(Handle.Api);
+
+    /* Error Case: Driver without a command function */
+    Location.PspModuleId = UT_NOCMD_ID;
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_Bind(&Location, &Handle), CFE_PSP_ERROR_NOT_IMPLEMENTED);
+    UtAssert_NULL(Handle.Api);
+
+    /* Error Case: Locks cannot be created */
+    Location.PspModuleId = UT_DRIVER_ID;
+    UT_SetDeferredRetcode(UT_KEY(OS_MutSemCreate), 1, OS_ERROR);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_Bind(&Location, &Handle), CFE_PSP_ERROR);
+    UtAssert_NULL(Handle.Api);
+
+    /* Error Case: Handle not bound */
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_CommandByHandle(&Handle, UT_CMD_READ, CFE_PSP_IODriver_U32ARG(0)),
+                      CFE_PSP_INVALID_POINTER);
+    UtAssert_UINT32_EQ(UT_NumDriverCalls, 0);
+}
+
+void Test_Batch_Nominal(void)
+{
+    CFE_PSP_IODriver_Request_t   Requests[3];
+    CFE_PSP_IODriver_LockStats_t Stats;
+
+    /* Nominal Case: Reads of a lock share it once, for all of them */
+    UT_SetRequest(&Requests[0], UT_DRIVER_ID, UT_CMD_READ, 0);
+    UT_SetRequest(&Requests[1], UT_DRIVER_ID, UT_CMD_NOLOCK, 0);
+    UT_SetRequest(&Requests[2], UT_DRIVER_ID, UT_CMD_READ, 0);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_CommandBatch(Requests, 3), CFE_PSP_SUCCESS);
+    UtAssert_INT32_EQ(Requests[0].Status, CFE_PSP_SUCCESS);
+    UtAssert_INT32_EQ(Requests[1].Status, CFE_PSP_SUCCESS);
+    UtAssert_INT32_EQ(Requests[2].Status, CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(UT_NumDriverCalls, 3);
+    UtAssert_UINT32_EQ(UT_DriverCalls[0].Readers, 1);
+    UtAssert_UINT32_EQ(UT_DriverCalls[1].Readers, 1);
+
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_GetLockStats(UT_DRIVER_ID, 0, &Stats), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Stats.SharedCount, 1);
+    UtAssert_UINT32_EQ(Stats.ExclusiveCount, 0);
+
+    /* Nominal Case: A write makes the whole group hold the lock alone */
+    UT_SetRequest(&Requests[0], UT_DRIVER_ID, UT_CMD_READ, 0);
+    UT_SetRequest(&Requests[1], UT_DRIVER_ID, UT_CMD_WRITE, 0);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_CommandBatch(Requests, 2), CFE_PSP_SUCCESS);
+    UtAssert_INT32_EQ(Requests[0].Status, CFE_PSP_SUCCESS);
+    UtAssert_INT32_EQ(Requests[1].Status, CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(UT_DriverCalls[3].Readers, 0);
+
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_GetLockStats(UT_DRIVER_ID, 0, &Stats), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Stats.SharedCount, 1);
+    UtAssert_UINT32_EQ(Stats.ExclusiveCount, 1);
+
+    /* Nominal Case: Empty batch */
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_CommandBatch(Requests, 0), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(UT_NumDriverCalls, 5);
+}
+
+void Test_Batch_Group(void)
+{
+    CFE_PSP_IODriver_Request_t   Requests[5];
+    CFE_PSP_IODriver_LockStats_t Stats;
+
+    /*
+     * Nominal Case: Requests are executed by lock, in the order of the first
+     * request of each lock, and a group holds its lock alone if any of its
+     * requests needs that
+     */
+    UT_SetRequest(&Requests[0], UT_DRIVER_ID, UT_CMD_READ, 0);
+    UT_SetRequest(&Requests[1], UT_DRIVER_ID, UT_CMD_READ, 1);
+    UT_SetRequest(&Requests[2], UT_DRIVER_ID, UT_CMD_WRITE, 0);
+    UT_SetRequest(&Requests[3], UT_DRIVER_ID, UT_CMD_NOLOCK, 0);
+    UT_SetRequest(&Requests[4], UT_DRIVER_ID, UT_CMD_READ, 1);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_CommandBatch(Requests, 5), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(UT_NumDriverCalls, 5);
+    UtAssert_UINT32_EQ(UT_DriverCalls[0].CommandCode, UT_CMD_READ);
+    UtAssert_UINT32_EQ(UT_DriverCalls[0].Subsystem, 0);
+    UtAssert_UINT32_EQ(UT_DriverCalls[1].CommandCode, UT_CMD_WRITE);
+    UtAssert_UINT32_EQ(UT_DriverCalls[2].Subsystem, 1);
+    UtAssert_UINT32_EQ(UT_DriverCalls[2].Readers, 1);
+    UtAssert_UINT32_EQ(UT_DriverCalls[3].Subsystem, 1);
+    UtAssert_UINT32_EQ(UT_DriverCalls[3].Readers, 1);
+    UtAssert_UINT32_EQ(UT_DriverCalls[4].CommandCode, UT_CMD_NOLOCK);
+
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_GetLockStats(UT_DRIVER_ID, 0, &Stats), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Stats.ExclusiveCount, 1);
+    UtAssert_UINT32_EQ(Stats.SharedCount, 0);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_GetLockStats(UT_DRIVER_ID, 1, &Stats), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Stats.ExclusiveCount, 0);
+    UtAssert_UINT32_EQ(Stats.SharedCount, 1);
+
+    /* Nominal Case: Any negative lock selection means no lock, and the request still executes */
+    UT_SetRequest(&Requests[0], UT_DRIVER_ID, UT_CMD_NEG, 0);
+    UT_SetRequest(&Requests[1], UT_DRIVER_ID, UT_CMD_READ, 0);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_CommandBatch(Requests, 2), CFE_PSP_SUCCESS);
+    UtAssert_INT32_EQ(Requests[0].Status, CFE_PSP_SUCCESS);
+    UtAssert_INT32_EQ(Requests[1].Status, CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(UT_NumDriverCalls, 7);
+    UtAssert_UINT32_EQ(UT_DriverCalls[5].CommandCode, UT_CMD_NEG);
+    UtAssert_UINT32_EQ(UT_DriverCalls[5].Readers, 0);
+}
+
+void Test_Batch_Error(void)
+{
+    CFE_PSP_IODriver_Request_t Requests[3];
+
+    /* Error Case: NULL pointer */
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_CommandBatch(NULL, 1), CFE_PSP_INVALID_POINTER);
+
+    /* Error Case: One request fails, the others still execute */
+    UT_SetRequest(&Requests[0], UT_DRIVER_ID, UT_CMD_FAIL, 0);
+    UT_SetRequest(&Requests[1], UT_DRIVER_ID, UT_CMD_READ, 0);
+    UT_SetRequest(&Requests[2], UT_SIMPLE_ID, UT_CMD_READ, 0);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_CommandBatch(Requests, 3), CFE_PSP_ERROR);
+    UtAssert_INT32_EQ(Requests[0].Status, CFE_PSP_ERROR);
+    UtAssert_INT32_EQ(Requests[1].Status, CFE_PSP_SUCCESS);
+    UtAssert_INT32_EQ(Requests[2].Status, CFE_PSP_ERROR_NOT_IMPLEMENTED);
+    UtAssert_UINT32_EQ(UT_NumDriverCalls, 2);
+
+    /* Error Case: Lock not declared by the driver */
+    UT_SetRequest(&Requests[0], UT_DRIVER_ID, UT_CMD_READ, UT_BADLOCK_SUBSYS);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_CommandBatch(Requests, 1), CFE_PSP_ERROR);
+    UtAssert_INT32_EQ(Requests[0].Status, CFE_PSP_ERROR);
+    UtAssert_UINT32_EQ(UT_NumDriverCalls, 2);
+
+    /* Error Case: Lock cannot be created, all the requests of the group fail */
+    UT_SetRequest(&Requests[0], UT_DRIVER_ID, UT_CMD_READ, 1);
+    UT_SetRequest(&Requests[1], UT_DRIVER_ID, UT_CMD_WRITE, 1);
+    UT_SetDeferredRetcode(UT_KEY(OS_MutSemCreate), 1, OS_ERROR);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_CommandBatch(Requests, 2), CFE_PSP_ERROR);
+    UtAssert_INT32_EQ(Requests[0].Status, CFE_PSP_ERROR);
+    UtAssert_INT32_EQ(Requests[1].Status, CFE_PSP_ERROR);
+    UtAssert_UINT32_EQ(UT_NumDriverCalls, 2);
+}
+
+void Test_Loan_Nominal(void)
+{
+    CFE_PSP_IODriver_LoanPool_t   Pool;
+    CFE_PSP_IODriver_PacketLoan_t Loans[3];
+    CFE_PSP_IODriver_PacketLoan_t Loan;
+    uint8                         Memory[3 * 16];
+    uint32                        i;
+
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_LoanPoolInit(&Pool, Memory, 16, 3), CFE_PSP_SUCCESS);
+
+    /* Nominal Case: Each loan gets the first free buffer */
+    for (i = 0; i < 3; ++i)
+    {
+        UtAssert_INT32_EQ(CFE_PSP_IODriver_LoanTake(&Pool, &Loans[i]), CFE_PSP_SUCCESS);
+        UtAssert_UINT32_EQ(Loans[i].LoanId, i);
+        UtAssert_UINT32_EQ(Loans[i].BufferSize, 16);
+        UtAssert_True(Loans[i].BufferMem == &Memory[i * 16], "Nominal Case: Loan %u, Buffer", (unsigned int)i);
+        UtAssert_INT32_EQ(CFE_PSP_IODriver_LoanCheck(&Pool, &Loans[i]), CFE_PSP_SUCCESS);
+    }
+
+    /* Nominal Case: All buffers on loan */
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_LoanTake(&Pool, &Loan), CFE_PSP_IODriver_PACKET_NO_LOAN_ERROR);
+
+    /* Nominal Case: An ended loan frees its buffer */
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_LoanEnd(&Pool, &Loans[1]), CFE_PSP_SUCCESS);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_LoanTake(&Pool, &Loan), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Loan.LoanId, 1);
+
+    /* Nominal Case: Loan of a given buffer */
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_LoanEnd(&Pool, &Loans[2]), CFE_PSP_SUCCESS);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_LoanTakeBuffer(&Pool, 2, &Loan), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Loan.LoanId, 2);
+    UtAssert_True(Loan.BufferMem == &Memory[2 * 16], "Nominal Case: Loan of Buffer 2");
+}
+
+void Test_Loan_Error(void)
+{
+    CFE_PSP_IODriver_LoanPool_t   Pool;
+    CFE_PSP_IODriver_PacketLoan_t Loan;
+    CFE_PSP_IODriver_PacketLoan_t BadLoan;
+    uint8                         Memory[3 * 16];
+
+    /* Error Case: Pool setup */
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_LoanPoolInit(NULL, Memory, 16, 3), CFE_PSP_INVALID_POINTER);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_LoanPoolInit(&Pool, NULL, 16, 3), CFE_PSP_INVALID_POINTER);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_LoanPoolInit(&Pool, Memory, 16, 0), CFE_PSP_ERROR);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_LoanPoolInit(&Pool, Memory, 16, CFE_PSP_IODRIVER_LOAN_POOL_MAX + 1),
+                      CFE_PSP_ERROR);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_LoanPoolInit(&Pool, Memory, 16, 3), CFE_PSP_SUCCESS);
+
+    /* Error Case: Loan of a given buffer */
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_LoanTakeBuffer(&Pool, 3, &Loan), CFE_PSP_ERROR);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_LoanTakeBuffer(&Pool, 0, &Loan), CFE_PSP_SUCCESS);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_LoanTakeBuffer(&Pool, 0, &BadLoan), CFE_PSP_IODriver_PACKET_NO_LOAN_ERROR);
+
+    /* Error Case: Loans that are not from the pool */
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_LoanCheck(&Pool, NULL), CFE_PSP_ERROR);
+    BadLoan        = Loan;
+    BadLoan.LoanId = 3;
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_LoanCheck(&Pool, &BadLoan), CFE_PSP_ERROR);
+    BadLoan           = Loan;
+    BadLoan.BufferMem = &Memory[16];
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_LoanCheck(&Pool, &BadLoan), CFE_PSP_ERROR);
+    BadLoan.LoanId = 1;
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_LoanCheck(&Pool, &BadLoan), CFE_PSP_ERROR);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_LoanEnd(&Pool, &BadLoan), CFE_PSP_ERROR);
+
+    /* Error Case: Loan ended twice */
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_LoanEnd(&Pool, &Loan), CFE_PSP_SUCCESS);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_LoanEnd(&Pool, &Loan), CFE_PSP_ERROR);
+}
+
+static void UT_SetAsyncRequest(CFE_PSP_IODriver_AsyncRequest_t *Request, uint32 CommandCode, uint32 BufferSize,
+                               void *BufferMem, uintptr_t UserData)
+{
+    Request->CommandCode = CommandCode;
+    Request->BufferSize  = BufferSize;
+    Request->BufferMem   = BufferMem;
+    Request->UserData    = (void *)UserData;
+}
+
+void Test_Async_Nominal(void)
+{
+    CFE_PSP_IODriver_AsyncQueue_t      Queue;
+    CFE_PSP_IODriver_AsyncRequest_t    SubmitEntries[4];
+    CFE_PSP_IODriver_AsyncCompletion_t CompleteEntries[2];
+    CFE_PSP_IODriver_AsyncRequest_t    Request;
+    CFE_PSP_IODriver_AsyncCompletion_t Completion;
+    uint8                              Buffers[4][16];
+
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_AsyncQueueInit(&Queue, SubmitEntries, 4, CompleteEntries, 2,
+                                                      OS_ObjectIdFromInteger(1)),
+                      CFE_PSP_SUCCESS);
+
+    /* Nominal Case: Nothing to process, the caller is not woken up */
+    UtAssert_UINT32_EQ(CFE_PSP_IODriver_AsyncProcess(&Queue, UT_AsyncCmd, 1, 2), 0);
+    UtAssert_STUB_COUNT(OS_BinSemGive, 0);
+    UtAssert_True(!CFE_PSP_IODriver_AsyncReap(&Queue, &Completion), "No result");
+
+    /* Nominal Case: Requests up to the size of the ring */
+    UT_SetAsyncRequest(&Request, CFE_PSP_IODriver_PACKET_IO_READ, 16, Buffers[0], 10);
+    UtAssert_True(CFE_PSP_IODriver_AsyncSubmit(&Queue, &Request), "Request submitted");
+    UT_SetAsyncRequest(&Request, CFE_PSP_IODriver_PACKET_IO_WRITE, 8, Buffers[1], 11);
+    UtAssert_True(CFE_PSP_IODriver_AsyncSubmit(&Queue, &Request), "Request submitted");
+    UT_SetAsyncRequest(&Request, CFE_PSP_IODriver_STREAM_IO_READ, 16, Buffers[2], 12);
+    UtAssert_True(CFE_PSP_IODriver_AsyncSubmit(&Queue, &Request), "Request submitted");
+    UT_SetAsyncRequest(&Request, CFE_PSP_IODriver_STREAM_IO_WRITE, 5, Buffers[3], 13);
+    UtAssert_True(CFE_PSP_IODriver_AsyncSubmit(&Queue, &Request), "Request submitted");
+
+    /* Nominal Case: Only the requests with room for their result are processed */
+    UtAssert_UINT32_EQ(CFE_PSP_IODriver_AsyncProcess(&Queue, UT_AsyncCmd, 1, 2), 2);
+    UtAssert_STUB_COUNT(OS_BinSemGive, 1);
+    UtAssert_UINT32_EQ(UT_NumDriverCalls, 2);
+    UtAssert_UINT32_EQ(UT_DriverCalls[0].CommandCode, CFE_PSP_IODriver_PACKET_IO_READ);
+    UtAssert_UINT32_EQ(UT_DriverCalls[0].Subsystem, 1);
+    UtAssert_UINT32_EQ(UT_DriverCalls[0].Subchannel, 2);
+    UtAssert_UINT32_EQ(UT_DriverCalls[1].CommandCode, CFE_PSP_IODriver_PACKET_IO_WRITE);
+    UtAssert_UINT32_EQ(Queue.InFlight, 0);
+    UtAssert_UINT32_EQ(CFE_PSP_IODriver_AsyncProcess(&Queue, UT_AsyncCmd, 1, 2), 0);
+    UtAssert_UINT32_EQ(UT_NumDriverCalls, 2);
+    UtAssert_STUB_COUNT(OS_BinSemGive, 1);
+
+    /* Nominal Case: Results in the order of the requests, with the size from the driver */
+    UtAssert_True(CFE_PSP_IODriver_AsyncReap(&Queue, &Completion), "Result reaped");
+    UtAssert_INT32_EQ(Completion.Status, CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Completion.ActualSize, UT_ASYNC_PACKET_SIZE);
+    UtAssert_True(Completion.BufferMem == Buffers[0], "BufferMem == Buffers[0]");
+    UtAssert_True(Completion.UserData == (void *)10, "UserData == (void *)10");
+    UtAssert_True(CFE_PSP_IODriver_AsyncReap(&Queue, &Completion), "Result reaped");
+    UtAssert_INT32_EQ(Completion.Status, CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Completion.ActualSize, 8);
+    UtAssert_True(Completion.UserData == (void *)11, "UserData == (void *)11");
+    UtAssert_True(!CFE_PSP_IODriver_AsyncReap(&Queue, &Completion), "No result");
+
+    /* Nominal Case: A failed request has no data */
+    UtAssert_UINT32_EQ(CFE_PSP_IODriver_AsyncProcess(&Queue, UT_AsyncCmd, 1, 2), 2);
+    UtAssert_STUB_COUNT(OS_BinSemGive, 2);
+    UtAssert_UINT32_EQ(UT_DriverCalls[2].CommandCode, CFE_PSP_IODriver_STREAM_IO_READ);
+    UtAssert_UINT32_EQ(UT_DriverCalls[3].CommandCode, CFE_PSP_IODriver_STREAM_IO_WRITE);
+    UtAssert_True(CFE_PSP_IODriver_AsyncReap(&Queue, &Completion), "Result reaped");
+    UtAssert_INT32_EQ(Completion.Status, CFE_PSP_ERROR_TIMEOUT);
+    UtAssert_UINT32_EQ(Completion.ActualSize, 0);
+    UtAssert_True(Completion.BufferMem == Buffers[2], "BufferMem == Buffers[2]");
+    UtAssert_True(Completion.UserData == (void *)12, "UserData == (void *)12");
+    UtAssert_True(CFE_PSP_IODriver_AsyncReap(&Queue, &Completion), "Result reaped");
+    UtAssert_INT32_EQ(Completion.Status, CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Completion.ActualSize, 5);
+    UtAssert_True(Completion.UserData == (void *)13, "UserData == (void *)13");
+
+    /* Nominal Case: A queue without semaphore is polled */
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_AsyncQueueInit(&Queue, SubmitEntries, 4, CompleteEntries, 2,
+                                                      OS_OBJECT_ID_UNDEFINED),
+                      CFE_PSP_SUCCESS);
+    UT_SetAsyncRequest(&Request, CFE_PSP_IODriver_PACKET_IO_WRITE, 8, Buffers[0], 20);
+    UtAssert_True(CFE_PSP_IODriver_AsyncSubmit(&Queue, &Request), "Request submitted");
+    UtAssert_UINT32_EQ(CFE_PSP_IODriver_AsyncProcess(&Queue, UT_AsyncCmd, 1, 2), 1);
+    UtAssert_STUB_COUNT(OS_BinSemGive, 2);
+    UtAssert_True(CFE_PSP_IODriver_AsyncReap(&Queue, &Completion), "Result reaped");
+    UtAssert_True(Completion.UserData == (void *)20, "UserData == (void *)20");
+}
+
+void Test_Async_Error(void)
+{
+    CFE_PSP_IODriver_AsyncQueue_t      Queue;
+    CFE_PSP_IODriver_AsyncRequest_t    SubmitEntries[2];
+    CFE_PSP_IODriver_AsyncCompletion_t CompleteEntries[4];
+    CFE_PSP_IODriver_AsyncRequest_t    Request;
+    CFE_PSP_IODriver_AsyncCompletion_t Completion;
+    uint8                              Buffer[16];
+
+    /* Error Case: Queue setup */
+    UtAssert_INT32_EQ(
+        CFE_PSP_IODriver_AsyncQueueInit(NULL, SubmitEntries, 2, CompleteEntries, 4, OS_ObjectIdFromInteger(1)),
+        CFE_PSP_INVALID_POINTER);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_AsyncQueueInit(&Queue, NULL, 2, CompleteEntries, 4, OS_ObjectIdFromInteger(1)),
+                      CFE_PSP_INVALID_POINTER);
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_AsyncQueueInit(&Queue, SubmitEntries, 2, NULL, 4, OS_ObjectIdFromInteger(1)),
+                      CFE_PSP_INVALID_POINTER);
+    UtAssert_INT32_EQ(
+        CFE_PSP_IODriver_AsyncQueueInit(&Queue, SubmitEntries, 0, CompleteEntries, 4, OS_ObjectIdFromInteger(1)),
+        CFE_PSP_ERROR);
+    UtAssert_INT32_EQ(
+        CFE_PSP_IODriver_AsyncQueueInit(&Queue, SubmitEntries, 3, CompleteEntries, 4, OS_ObjectIdFromInteger(1)),
+        CFE_PSP_ERROR);
+    UtAssert_INT32_EQ(
+        CFE_PSP_IODriver_AsyncQueueInit(&Queue, SubmitEntries, 2, CompleteEntries, 0, OS_ObjectIdFromInteger(1)),
+        CFE_PSP_ERROR);
+    UtAssert_INT32_EQ(
+        CFE_PSP_IODriver_AsyncQueueInit(&Queue, SubmitEntries, 2, CompleteEntries, 6, OS_ObjectIdFromInteger(1)),
+        CFE_PSP_ERROR);
+    UtAssert_INT32_EQ(
+        CFE_PSP_IODriver_AsyncQueueInit(&Queue, SubmitEntries, 2, CompleteEntries, 4, OS_ObjectIdFromInteger(1)),
+        CFE_PSP_SUCCESS);
+
+    /* Error Case: Ring of requests full */
+    UT_SetAsyncRequest(&Request, 0, sizeof(Buffer), Buffer, 1);
+    UtAssert_True(CFE_PSP_IODriver_AsyncSubmit(&Queue, &Request), "Request submitted");
+    UT_SetAsyncRequest(&Request, CFE_PSP_IODriver_PACKET_IO_READ, sizeof(Buffer), Buffer, 2);
+    UtAssert_True(CFE_PSP_IODriver_AsyncSubmit(&Queue, &Request), "Request submitted");
+    UtAssert_True(!CFE_PSP_IODriver_AsyncSubmit(&Queue, &Request), "Request refused");
+
+    /* Error Case: Opcode that is not a read or a write is not passed to the driver */
+    UtAssert_UINT32_EQ(CFE_PSP_IODriver_AsyncProcess(&Queue, UT_AsyncCmd, 0, 0), 2);
+    UtAssert_UINT32_EQ(UT_NumDriverCalls, 1);
+    UtAssert_UINT32_EQ(UT_DriverCalls[0].CommandCode, CFE_PSP_IODriver_PACKET_IO_READ);
+    UtAssert_True(CFE_PSP_IODriver_AsyncReap(&Queue, &Completion), "Result reaped");
+    UtAssert_INT32_EQ(Completion.Status, CFE_PSP_ERROR_NOT_IMPLEMENTED);
+    UtAssert_UINT32_EQ(Completion.ActualSize, 0);
+    UtAssert_True(Completion.UserData == (void *)1, "UserData == (void *)1");
+
+    /* Error Case: Room again once the driver took the requests */
+    UtAssert_True(CFE_PSP_IODriver_AsyncSubmit(&Queue, &Request), "Request submitted");
+    UtAssert_True(CFE_PSP_IODriver_AsyncSubmit(&Queue, &Request), "Request submitted");
+    UtAssert_True(!CFE_PSP_IODriver_AsyncSubmit(&Queue, &Request), "Request refused");
+
+    /* Error Case: No request taken while a result is in flight, even with room in the ring */
+    UtAssert_True(CFE_PSP_IODriver_AsyncNextRequest(&Queue, &Request), "Request taken");
+    Queue.InFlight = 3;
+    UtAssert_True(!CFE_PSP_IODriver_AsyncNextRequest(&Queue, &Request), "No request taken");
+    Queue.InFlight = 1;
+    UtAssert_True(CFE_PSP_IODriver_AsyncNextRequest(&Queue, &Request), "Request taken");
+}
+
+/*
+ * Macro to add a test case to the list of tests to execute
+ */
+#define ADD_TEST(test) UtTest_Add(test, ModuleTest_ResetState, NULL, #test)
+
+/*
+ * Register the test cases to execute with the unit test tool
+ */
+void UtTest_Setup(void)
+{
+    ADD_TEST(Test_Lock_Nominal);
+    ADD_TEST(Test_Lock_Error);
+    ADD_TEST(Test_Handle_Nominal);
+    ADD_TEST(Test_Handle_Error);
+    ADD_TEST(Test_Batch_Nominal);
+    ADD_TEST(Test_Batch_Group);
+    ADD_TEST(Test_Batch_Error);
+    ADD_TEST(Test_Loan_Nominal);
+    ADD_TEST(Test_Loan_Error);
+    ADD_TEST(Test_Async_Nominal);
+    ADD_TEST(Test_Async_Error);
+}
@@ -49,6 +49,8 @@
 #include "vxworks_sysmon.h"
 
 void  UT_TaskDelay_Hook(void *UserObj);
+int32 UT_SpyReport_Hook(void *UserObj, int32 StubRetcode, uint32 CallCount, const UT_StubContext_t *Context);
+uint64 UT_GetTimeNs(void);
 
 void Test_Init_Nominal(void);
 void Test_Entry_Nominal(void);
@@ -59,5 +61,11 @@ void Test_Dispatch_Error(void);
 void Test_UpdateStat_Nominal(void);
 void Test_Task_Nominal(void);
 void Test_Task_Error(void);
+void Test_Snapshot_Nominal(void);
+void Test_Snapshot_Error(void);
+void Test_History_Nominal(void);
+void Test_History_Error(void);
+void Test_Lock_Nominal(void);
+void Test_Lock_Writer(void);
 
 #endif
@@ -56,26 +56,94 @@ extern CFE_PSP_ModuleApi_t CFE_PSP_vxworks_sysmon_API;
 extern vxworks_sysmon_state_t vxworks_sysmon_global;
 const CFE_PSP_ModuleApi_t *TgtAPI = &CFE_PSP_vxworks_sysmon_API;
 
+/* Module ID of the driver, resolved by CFE_PSP_Module_GetAPIEntry() below */
+#define UT_SYSMON_ID 0x00100201
+
+/* Format of the lines of the spy report */
+static const char *UT_SpyFmt = "%s      %s        %s      %s              %d (    %d)   %d (    %d)";
+
 /* Hook */
 void  UT_TaskDelay_Hook(void *UserObj)
 {
     int *DelayCounter = UserObj;
-    vxworks_sysmon_global.cpu_load.should_run = false;
+    vxworks_sysmon_global.sysmon.ShouldRun = false;
     
     (*DelayCounter)++;
 
 }
 
+/* Hook that reports one IDLE line, with the idle percentage in UserObj */
+int32 UT_SpyReport_Hook(void *UserObj, int32 StubRetcode, uint32 CallCount, const UT_StubContext_t *Context)
+{
+    int *IdlePercent = UserObj;
+
+    vxworks_sysmon_update_stat(UT_SpyFmt, "IDLE", "", "", "", 95, 7990, *IdlePercent, 1998);
+
+    return StubRetcode;
+}
+
+/* Expected load for an idle percentage */
+static uint32 UT_ExpectedLoad(int IdlePercent)
+{
+    uint32 Load;
+
+    Load = ( (0x1000 * (100 - IdlePercent) ) / 100 );
+    Load |= (Load << 12);
+
+    return Load;
+}
+
+/* Time of the samples, from UT_GetTimeNs() */
+static uint64 UT_TimeNs;
+
+/* Clock of the driver used by the history tests */
+uint64 UT_GetTimeNs(void)
+{
+    return UT_TimeNs;
+}
+
+/* Takes a sample at a given time and idle percentage */
+static void UT_TakeSample(int *IdlePercent, int Idle, uint64 TimeSec)
+{
+    *IdlePercent = Idle;
+    UT_TimeNs    = TimeSec * 1000000000ULL;
+    CFE_PSP_Sysmon_TakeSample(&vxworks_sysmon_global.sysmon, false);
+}
+
+/*
+ * Module table of the test, in place of the PSP module list, for the
+ * requests through CFE_PSP_IODriver_Command()
+ */
+int32 CFE_PSP_Module_GetAPIEntry(uint32 PspModuleId, CFE_PSP_ModuleApi_t **API)
+{
+    if (PspModuleId != UT_SYSMON_ID)
+    {
+        return CFE_PSP_INVALID_MODULE_ID;
+    }
+
+    *API = (CFE_PSP_ModuleApi_t *)TgtAPI;
+    return CFE_PSP_SUCCESS;
+}
+
+int32 CFE_PSP_Module_FindByName(const char *ModuleName, uint32 *PspModuleId)
+{
+    return CFE_PSP_INVALID_MODULE_NAME;
+}
+
 void ModuleTest_ResetState(void)
 {
+    UT_ResetState(0);
     memset(&vxworks_sysmon_global, 0, sizeof(vxworks_sysmon_global));
+    TgtAPI->Init(0);
 }
 
 void Test_Init_Nominal(void)
 {
     TgtAPI->Init(1); /* Init Vxworks Sysmon */
     UtAssert_True(vxworks_sysmon_global.local_module_id == 1, "Nominal Case: Init Vxworks Sysmon");
-
+    UtAssert_True(vxworks_sysmon_global.sysmon.Driver != NULL, "Nominal Case: Init Vxworks Sysmon Driver");
+    UtAssert_True(vxworks_sysmon_global.sysmon.SamplePeriodMs == CFE_PSP_SYSMON_DEFAULT_PERIOD_MS,
+                  "Nominal Case: Init Vxworks Sysmon Default Period");
 }
 
 void Test_Entry_Nominal(void)
@@ -85,33 +153,38 @@ void Test_Entry_Nominal(void)
 
     /* Nominal Case: Aggregate Subsystem */
     StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_NOOP, 0, 0, CFE_PSP_IODriver_U32ARG(0)); 
-    UtAssert_True(StatusCode == CFE_PSP_ERROR_NOT_IMPLEMENTED, "Nominal Case: Aggregate Subsystem");
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS, "Nominal Case: Aggregate Subsystem");
 
     /* Nominal Case: Cpuload Subsystem */
     StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_NOOP, 1, 0, CFE_PSP_IODriver_U32ARG(0)); 
     UtAssert_True(StatusCode == CFE_PSP_SUCCESS, "Nominal Case: Cpuload Subsystem");
 
+    /* Nominal Case: Cpuload Max Subsystem */
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_NOOP, 4, 0, CFE_PSP_IODriver_U32ARG(0)); 
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS, "Nominal Case: Cpuload Max Subsystem");
+
     /* Nominal Case: No Subsystem */
-    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_NOOP, 2, 0, CFE_PSP_IODriver_U32ARG(0)); 
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_NOOP, 5, 0, CFE_PSP_IODriver_U32ARG(0)); 
     UtAssert_True(StatusCode == CFE_PSP_ERROR_NOT_IMPLEMENTED, "Nominal Case: No Subsystem");
 }
 
 void Test_Aggregate_Nominal(void)
 {
     int32 StatusCode;
-    int32 IsRunningStatus;;
+    int32 IsRunningStatus;
     CFE_PSP_IODriver_AdcCode_t     Sample;
-    CFE_PSP_IODriver_AnalogRdWr_t  RdWr = {.NumChannels = 1, .Samples = &Sample};;    
+    CFE_PSP_IODriver_AnalogRdWr_t  RdWr = {.NumChannels = 1, .Samples = &Sample};
     CFE_PSP_IODriver_Direction_t QueryDirArg;
+    CFE_PSP_Sysmon_Config_t      Config;
     CFE_PSP_IODriver_API_t *EntryAPI = TgtAPI->ExtendedApi;
 
-    /* Nominal Case: Aggregate Dispatch Noop CMD (Not Impl) */
+    /* Nominal Case: Aggregate Dispatch Noop CMD */
     StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_NOOP, 0, 0, CFE_PSP_IODriver_U32ARG(0)); /* Entry Point */
-    UtAssert_True(StatusCode == CFE_PSP_ERROR_NOT_IMPLEMENTED, "Nominal Case: IO Driver NOOP");
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS, "Nominal Case: IO Driver NOOP");
 
-    /* Nominal Case: Aggregate Dispatch Noop CMD (Not Impl) */
+    /* Nominal Case: Aggregate Dispatch Analog Noop CMD */
     StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_NOOP, 0, 0, CFE_PSP_IODriver_U32ARG(0));
-    UtAssert_True(StatusCode == CFE_PSP_ERROR_NOT_IMPLEMENTED, "Nominal Case:  ANALOG IO NOOP");
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS, "Nominal Case:  ANALOG IO NOOP");
 
     /* Nominal Case: Start Vxworks Sysmon */
     StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(1));
@@ -125,6 +198,24 @@ void Test_Aggregate_Nominal(void)
     UtAssert_True(StatusCode == CFE_PSP_SUCCESS, "Nominal Case: Vxworks Sysmon Already Running");
     UtAssert_True(IsRunningStatus == true, "Nominal Case: Vxworks Sysmon running status already set");
 
+    /* Nominal Case: Analog IO Read Channel, first sample is taken when starting */
+    Sample = -1;
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS, 0, 0, CFE_PSP_IODriver_VPARG(&RdWr));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS, "Nominal Case: VxWorks Sysmon Aggregate CPU Load Status Code");
+    UtAssert_True(Sample == 0, "Nominal Case: VxWorks Sysmon Aggregate CPU");
+
+    /* Nominal Case: Set Configuration while running */
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_CONFIGURATION, 0, 0,
+                                         CFE_PSP_IODriver_CONST_STR("period_ms=100, window=5"));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS, "Nominal Case: Set Configuration");
+
+    /* Nominal Case: Get Configuration */
+    memset(&Config, 0, sizeof(Config));
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_GET_CONFIGURATION, 0, 0, CFE_PSP_IODriver_VPARG(&Config));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS, "Nominal Case: Get Configuration");
+    UtAssert_True(Config.SamplePeriodMs == 100 && Config.WindowSamples == 5 && Config.SyncStart,
+                  "Nominal Case: Get Configuration Values");
+
     /* Nominal Case: Stop Vxworks Sysmon */
     StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(0));
     IsRunningStatus = EntryAPI->DeviceCommand(CFE_PSP_IODriver_GET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(1));
@@ -136,20 +227,17 @@ void Test_Aggregate_Nominal(void)
     IsRunningStatus = EntryAPI->DeviceCommand(CFE_PSP_IODriver_GET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(1));
     UtAssert_True(StatusCode == CFE_PSP_SUCCESS, "Nominal Case: Vxworks Sysmon already stopped");
     UtAssert_True(IsRunningStatus == false, "Nominal Case: Vxworks Sysmon running status already disabled"); 
-    
-    /* Nominal Case: Set Configuration (Not Impl) */
-    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_CONFIGURATION, 0, 0, CFE_PSP_IODriver_U32ARG(0)); 
-    UtAssert_True(StatusCode == CFE_PSP_ERROR_NOT_IMPLEMENTED, "Nominal Case: Set Configuration");
-
-    /* Nominal Case: Get Configuration (Not Impl) */
-    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_GET_CONFIGURATION, 0, 0, CFE_PSP_IODriver_U32ARG(0)); 
-    UtAssert_True(StatusCode == CFE_PSP_ERROR_NOT_IMPLEMENTED, "Nominal Case: Get Configuration");
 
     /* Nominal Case: Look Up per-cpu Subsystem */
     StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_LOOKUP_SUBSYSTEM, 0, 0, 
                                            CFE_PSP_IODriver_CONST_STR("per-cpu"));
     UtAssert_True(StatusCode == 1, "Nominal Case: Look up per-cpu subsytem");
 
+    /* Nominal Case: Look Up per-cpu-max Subsystem */
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_LOOKUP_SUBSYSTEM, 0, 0, 
+                                           CFE_PSP_IODriver_CONST_STR("per-cpu-max"));
+    UtAssert_True(StatusCode == 4, "Nominal Case: Look up per-cpu-max subsytem");
+
     /* Nominal Case: Look Up aggregate Subsystem */
     StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_LOOKUP_SUBSYSTEM, 0, 0, 
                                            CFE_PSP_IODriver_CONST_STR("aggregate"));
@@ -160,18 +248,16 @@ void Test_Aggregate_Nominal(void)
                                            CFE_PSP_IODriver_CONST_STR("cpu-load"));
     UtAssert_True(StatusCode == 0, "Nominal Case: Look up cpu-load subchannel");
 
+    /* Nominal Case: Look Up cpu-load-mean subchannel */
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_LOOKUP_SUBCHANNEL, 0, 0, 
+                                           CFE_PSP_IODriver_CONST_STR("cpu-load-mean"));
+    UtAssert_True(StatusCode == 2, "Nominal Case: Look up cpu-load-mean subchannel");
+
     /* Nominal Case: Query Direction */
     QueryDirArg = CFE_PSP_IODriver_Direction_DISABLED;
     StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_QUERY_DIRECTION, 0, 0, CFE_PSP_IODriver_VPARG(&QueryDirArg));
     UtAssert_True(StatusCode == CFE_PSP_SUCCESS, "Nominal Case: VxWorks Sysmon Driver Query Direction Status Code");
     UtAssert_True(QueryDirArg == CFE_PSP_IODriver_Direction_INPUT_ONLY, "Nominal Case: VxWorks Sysmon Direction (INPUT ONLY)");
-
-    /* Nominal Case: Analog IO Read Channel */
-    Sample = -1;
-    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS, 0, 0, CFE_PSP_IODriver_VPARG(&RdWr));
-    UtAssert_True(StatusCode == CFE_PSP_SUCCESS, "Nominal Case: VxWorks Sysmon Aggregate CPU Load Status Code");
-    UtAssert_True(Sample == 0, "Nominal Case: VxWorks Sysmon Aggregate CPU");
-
 }
 
 void Test_Aggregate_Error(void)
@@ -180,33 +266,52 @@ void Test_Aggregate_Error(void)
     int32 StatusCode;
     int32 IsRunningStatus;
     CFE_PSP_IODriver_AdcCode_t     Sample;
-    CFE_PSP_IODriver_AnalogRdWr_t  RdWr = {.NumChannels = 1, .Samples = &Sample};; 
+    CFE_PSP_IODriver_AnalogRdWr_t  RdWr = {.NumChannels = 1, .Samples = &Sample};
 
     /* Error Case: Look Up Subsystem Not Found */
     StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_LOOKUP_SUBSYSTEM, 0, 0, 
                                            CFE_PSP_IODriver_CONST_STR("Empty"));
-    UtAssert_True(StatusCode == CFE_PSP_ERROR_NOT_IMPLEMENTED, "Error Case: Subsystem Not Found");
+    UtAssert_True(StatusCode == CFE_PSP_ERROR, "Error Case: Subsystem Not Found");
 
     /* Error Case: Look Up Subchannel Not Found */
     StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_LOOKUP_SUBCHANNEL, 0, 0, 
                                            CFE_PSP_IODriver_CONST_STR("Empty"));
-    UtAssert_True(StatusCode == CFE_PSP_ERROR_NOT_IMPLEMENTED, "Error Case: Subchannel Not Found");
+    UtAssert_True(StatusCode == CFE_PSP_ERROR, "Error Case: Subchannel Not Found");
 
     /* Error Case: NULL Query Direction */
     StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_QUERY_DIRECTION, 0, 0, CFE_PSP_IODriver_VPARG(NULL));
     UtAssert_True(StatusCode == CFE_PSP_ERROR_NOT_IMPLEMENTED, "Error Case: NULL Query Direction Status Code");
 
-    /* Error Case: Analog IO Read, Wrong Channel Number */
+    /* Error Case: Analog IO Read while stopped */
     Sample = -1;
-    RdWr.NumChannels = 0;
     StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS, 0, 0, CFE_PSP_IODriver_VPARG(&RdWr));
-    UtAssert_True(StatusCode == CFE_PSP_ERROR_NOT_IMPLEMENTED, "Error Case: Analog IO Read, Wrong Channel Number");
+    UtAssert_True(StatusCode == CFE_PSP_ERROR && Sample == -1, "Error Case: Analog IO Read, Stopped");
 
-    /* Error Case: Analog IO Read, Wrong Channel Subchannel */
-    Sample = -1;
-    RdWr.NumChannels = 1;
-    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS, 0, 5, CFE_PSP_IODriver_VPARG(&RdWr));
-    UtAssert_True(StatusCode == CFE_PSP_ERROR_NOT_IMPLEMENTED, "Error Case: Analog IO Read, Wrong Subchannel");
+    /* Error Case: Analog IO Read, NULL Argument */
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS, 0, 0, CFE_PSP_IODriver_VPARG(NULL));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR, "Error Case: Analog IO Read, NULL Argument");
+
+    /* Error Case: Bad Configurations, which leave the configuration unchanged */
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_CONFIGURATION, 0, 0,
+                                         CFE_PSP_IODriver_CONST_STR("period_ms=5"));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR, "Error Case: Set Configuration, Period Too Short");
+
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_CONFIGURATION, 0, 0,
+                                         CFE_PSP_IODriver_CONST_STR("period_ms=100,window=0"));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR, "Error Case: Set Configuration, Empty Window");
+
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_CONFIGURATION, 0, 0,
+                                         CFE_PSP_IODriver_CONST_STR("rate=1"));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR, "Error Case: Set Configuration, Unknown Setting");
+
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_CONFIGURATION, 0, 0, CFE_PSP_IODriver_CONST_STR(NULL));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR, "Error Case: Set Configuration, NULL String");
+    UtAssert_True(vxworks_sysmon_global.sysmon.SamplePeriodMs == CFE_PSP_SYSMON_DEFAULT_PERIOD_MS,
+                  "Error Case: Set Configuration, Period Unchanged");
+
+    /* Error Case: Get Configuration, NULL Argument */
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_GET_CONFIGURATION, 0, 0, CFE_PSP_IODriver_VPARG(NULL));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR_NOT_IMPLEMENTED, "Error Case: Get Configuration, NULL Argument");
 
     /* Error Case: Command Code Not Found */
     StatusCode = EntryAPI->DeviceCommand(40, 0, 0, CFE_PSP_IODriver_U32ARG(0)); 
@@ -218,6 +323,13 @@ void Test_Aggregate_Error(void)
     IsRunningStatus = EntryAPI->DeviceCommand(CFE_PSP_IODriver_GET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(1));
     UtAssert_True(StatusCode == CFE_PSP_ERROR, "Error Case: Creating Child Process, Status Code");
     UtAssert_True(IsRunningStatus == false, "Error Case: Creating Child Process, Running Status");
+
+    /* Error Case: Unable To Create Semaphore */
+    UT_SetDeferredRetcode(UT_KEY(OS_BinSemCreate), 1, OS_ERROR);
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(1));
+    IsRunningStatus = EntryAPI->DeviceCommand(CFE_PSP_IODriver_GET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(1));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR, "Error Case: Creating Semaphore, Status Code");
+    UtAssert_True(IsRunningStatus == false, "Error Case: Creating Semaphore, Running Status");
 }
 
 void Test_Dispatch_Nominal(void)
@@ -226,6 +338,7 @@ void Test_Dispatch_Nominal(void)
     CFE_PSP_IODriver_AdcCode_t     Sample[2];
     CFE_PSP_IODriver_AnalogRdWr_t  RdWr = {.NumChannels = 1, .Samples = Sample};
     int32 StatusCode;
+    int   IdlePercent;
 
     /* Nominal Case: Dispatch IO Driver NOOP */
     StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_NOOP, 1, 0, CFE_PSP_IODriver_U32ARG(1));
@@ -235,11 +348,38 @@ void Test_Dispatch_Nominal(void)
     StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_NOOP, 1, 0, CFE_PSP_IODriver_U32ARG(1));
     UtAssert_True(StatusCode == CFE_PSP_SUCCESS, "Nominal Case: Dispatch Analog IO NOOP");
 
-    /* Nominal Case: Dispatch Analog Read Channels */
+    /* Nominal Case: Dispatch Analog Read Channels, 3 percents load */
+    IdlePercent = 97;
+    UT_SetHookFunction(UT_KEY(PCS_spyReportCommon), UT_SpyReport_Hook, &IdlePercent);
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_CONFIGURATION, 0, 0,
+                                         CFE_PSP_IODriver_CONST_STR("window=1"));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS, "Nominal Case: Dispatch Set Configuration");
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(1));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS, "Nominal Case: Dispatch Start");
+
     Sample[0] = -1;
     Sample[1] = -1;
     StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS, 1, 0, CFE_PSP_IODriver_VPARG(&RdWr));
-    UtAssert_True(StatusCode == CFE_PSP_SUCCESS && Sample[0] == 0 && Sample[1] == -1, "Nominal Case: Dispatch cpuload");
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS && Sample[0] == UT_ExpectedLoad(97) && Sample[1] == -1,
+                  "Nominal Case: Dispatch cpuload");
+
+    /* Nominal Case: Window statistics after the next sample */
+    IdlePercent = 51;
+    CFE_PSP_Sysmon_TakeSample(&vxworks_sysmon_global.sysmon, false);
+
+    Sample[0] = -1;
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS, 4, 0, CFE_PSP_IODriver_VPARG(&RdWr));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS && Sample[0] == UT_ExpectedLoad(51), "Nominal Case: Dispatch cpuload max");
+
+    RdWr.NumChannels = 2;
+    Sample[0] = -1;
+    Sample[1] = -1;
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS, 0, 0, CFE_PSP_IODriver_VPARG(&RdWr));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS && Sample[0] == UT_ExpectedLoad(51) && Sample[1] == UT_ExpectedLoad(51),
+                  "Nominal Case: Dispatch aggregate cpuload and min");
+
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(0));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS, "Nominal Case: Dispatch Stop");
 }
 
 void Test_Dispatch_Error(void)
@@ -249,6 +389,8 @@ void Test_Dispatch_Error(void)
     CFE_PSP_IODriver_AnalogRdWr_t  RdWr = {.NumChannels = 1, .Samples = Sample};
     int StatusCode;
 
+    EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(1));
+
     /* Error Case: Dispatch Analog Read Channels, Subchannel >= Max Cpu */
     /* Default max cpu == 1 */
     Sample[0] = -1;
@@ -261,51 +403,61 @@ void Test_Dispatch_Error(void)
     StatusCode =EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS, 1, 0, CFE_PSP_IODriver_VPARG(&RdWr));
     UtAssert_True(StatusCode == CFE_PSP_ERROR && Sample[0] == -1 && Sample[1] == -1, "Error Case: Dispatch cpuload, NumChannels > max cpu");
 
+    /* Error Case: Dispatch Look Up Subchannel, no names for the CPUs */
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_LOOKUP_SUBCHANNEL, 1, 0, CFE_PSP_IODriver_CONST_STR("cpu0"));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR_NOT_IMPLEMENTED, "Error Case: Dispatch Look Up Subchannel");
+
     /* Error Case: Command Code Not Found */
     StatusCode = EntryAPI->DeviceCommand(10, 1, 0, CFE_PSP_IODriver_U32ARG(1));
     UtAssert_True(StatusCode == CFE_PSP_ERROR_NOT_IMPLEMENTED, "Error Case: Command Code Not Found");
+
+    EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(0));
 }
 
 void Test_UpdateStat_Nominal(void)
 {
-    const char * fmt = "%s      %s        %s      %s              %d (    %d)   %d (    %d)";
     uint32 AvgLoad;
     uint32 IdleTaskLoad;
 
     /* Nominal Case: Idle String 3 percents load */
     IdleTaskLoad = 97;
-    vxworks_sysmon_update_stat(fmt, "IDLE", "", "", "", 95, 7990, IdleTaskLoad, 1998); /* Function under test */
+    vxworks_sysmon_update_stat(UT_SpyFmt, "IDLE", "", "", "", 95, 7990, IdleTaskLoad, 1998); /* Function under test */
 
     AvgLoad = ( (0x1000 * (100 - IdleTaskLoad) ) / 100 );
     AvgLoad |= (AvgLoad << 12);  
-    UtAssert_True(vxworks_sysmon_global.cpu_load.per_core[0].avg_load == AvgLoad, "Nominal Case: 3 percents cpuload");
+    UtAssert_True(vxworks_sysmon_global.cpu_load.cpus[0].Load == AvgLoad, "Nominal Case: 3 percents cpuload");
 
     /* Nominal Case: Idle String 0 percents load */
     memset(&vxworks_sysmon_global, 0, sizeof(vxworks_sysmon_global));
     IdleTaskLoad = 100;
-    vxworks_sysmon_update_stat(fmt, "IDLE", "", "", "", 95, 7990, IdleTaskLoad, 1998); /* Function under test */
+    vxworks_sysmon_update_stat(UT_SpyFmt, "IDLE", "", "", "", 95, 7990, IdleTaskLoad, 1998); /* Function under test */
 
     AvgLoad = 0;
-    UtAssert_True(vxworks_sysmon_global.cpu_load.per_core[0].avg_load == AvgLoad, "Nominal Case: 0 percents cpuload");
+    UtAssert_True(vxworks_sysmon_global.cpu_load.cpus[0].Load == AvgLoad, "Nominal Case: 0 percents cpuload");
 
     /* Nominal Case: Idle String 100 percents load */
     memset(&vxworks_sysmon_global, 0, sizeof(vxworks_sysmon_global));
     IdleTaskLoad = 0;
-    vxworks_sysmon_update_stat(fmt, "IDLE", "", "", "", 95, 7990, IdleTaskLoad, 1998); /* Function under test */
+    vxworks_sysmon_update_stat(UT_SpyFmt, "IDLE", "", "", "", 95, 7990, IdleTaskLoad, 1998); /* Function under test */
 
     AvgLoad = 0xFFFFFF;
-    UtAssert_True(vxworks_sysmon_global.cpu_load.per_core[0].avg_load == AvgLoad, "Nominal Case: 100 percents cpuload");
+    UtAssert_True(vxworks_sysmon_global.cpu_load.cpus[0].Load == AvgLoad, "Nominal Case: 100 percents cpuload");
+
+    /* Nominal Case: Idle percentage above 100 */
+    memset(&vxworks_sysmon_global, 0, sizeof(vxworks_sysmon_global));
+    vxworks_sysmon_update_stat(UT_SpyFmt, "IDLE", "", "", "", 95, 7990, 101, 1998); /* Function under test */
+    UtAssert_True(vxworks_sysmon_global.cpu_load.cpus[0].Load == 0, "Nominal Case: Idle above 100 percents");
 
     /* Nominal Case: Max Cpu Num */
     IdleTaskLoad = 0;
     vxworks_sysmon_global.cpu_load.num_cpus = 1;
-    vxworks_sysmon_update_stat(fmt, "IDLE", "", "", "", 95, 7990, IdleTaskLoad, 1998); /* Function under test */
+    vxworks_sysmon_update_stat(UT_SpyFmt, "IDLE", "", "", "", 95, 7990, IdleTaskLoad, 1998); /* Function under test */
     UtAssert_True(vxworks_sysmon_global.cpu_load.num_cpus == 1, "Nominal Case: Max Cpu Nums");
 
     /* Nominal Case: Not Idle String */
     memset(&vxworks_sysmon_global, 0, sizeof(vxworks_sysmon_global));
-    vxworks_sysmon_update_stat(fmt, "KERNEL", "", "", "", 95, 7990, 95, 1998); /* Function under test */
-    UtAssert_True(vxworks_sysmon_global.cpu_load.per_core[0].avg_load  == 0  && vxworks_sysmon_global.cpu_load.num_cpus == 0, 
+    vxworks_sysmon_update_stat(UT_SpyFmt, "KERNEL", "", "", "", 95, 7990, 95, 1998); /* Function under test */
+    UtAssert_True(vxworks_sysmon_global.cpu_load.cpus[0].Load  == 0  && vxworks_sysmon_global.cpu_load.num_cpus == 0, 
                   "Nominal Case: Not Idle String");
 
 }
@@ -314,22 +466,325 @@ void Test_Task_Nominal(void)
 {
     int DelayCounter = 0;
 
-    /* Nominal Case: vxworks sysmon task */
-    vxworks_sysmon_global.cpu_load.should_run = true;
-    UT_SetHookFunction(UT_KEY(OS_TaskDelay), (UT_HookFunc_t)UT_TaskDelay_Hook, &DelayCounter);
+    /* Nominal Case: vxworks sysmon task, takes one sample then waits for the next period */
+    UtAssert_True(vxworks_sysmon_Open(&vxworks_sysmon_global.sysmon) == CFE_PSP_SUCCESS,
+                  "Nominal Case: Vxworks Sysmon Open");
+    vxworks_sysmon_global.sysmon.ShouldRun = true;
+    UT_SetHookFunction(UT_KEY(OS_BinSemTimedWait), (UT_HookFunc_t)UT_TaskDelay_Hook, &DelayCounter);
     vxworks_sysmon_Task();
 
     UtAssert_True(DelayCounter == 1, "Nominal Case: Vxworks Sysmon Task");
+    UtAssert_True(vxworks_sysmon_global.sysmon.NumSamples == 1, "Nominal Case: Vxworks Sysmon Task Sampled");
+    UtAssert_True(vxworks_sysmon_global.sysmon.Published.Sequence == 1, "Nominal Case: Vxworks Sysmon Task Published");
 }
 
 void Test_Task_Error(void)
 {
-    vxworks_sysmon_global.cpu_load.should_run = true;
+    CFE_PSP_IODriver_API_t *EntryAPI = TgtAPI->ExtendedApi;
+    int32 StatusCode;
+    int32 IsRunningStatus;
+
+    /* Error Case: Cannot Start Auxillary Clock, so the monitoring does not start */
     UT_SetDeferredRetcode(UT_KEY(PCS_spyClkStartCommon), 1, OS_ERROR); 
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(1));
+    IsRunningStatus = EntryAPI->DeviceCommand(CFE_PSP_IODriver_GET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(1));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR, "Error Case: Cannot Start Auxillary Clock");
+    UtAssert_True(IsRunningStatus == false, "Error Case: Cannot Start Auxillary Clock, Running Status");
 
-    vxworks_sysmon_Task();
-    UtAssert_True(vxworks_sysmon_global.cpu_load.should_run == false, "Error Case: Cannot Start Auxillary Clock");
+}
+
+void Test_Snapshot_Nominal(void)
+{
+    CFE_PSP_IODriver_API_t *EntryAPI = TgtAPI->ExtendedApi;
+    CFE_PSP_IODriver_AdcCode_t        Sample[2];
+    CFE_PSP_IODriver_AnalogSnapshot_t Snapshot = {.RdWr = {.NumChannels = 1, .Samples = Sample}};
+    int32  StatusCode;
+    uint32 Sequence;
+    int    IdlePercent;
+
+    /* Nominal Case: The first sample is published when starting */
+    IdlePercent = 50;
+    UT_SetHookFunction(UT_KEY(PCS_spyReportCommon), UT_SpyReport_Hook, &IdlePercent);
+    EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(1));
+    Sequence = vxworks_sysmon_global.sysmon.Published.Sequence;
+
+    Sample[0] = -1;
+    Sample[1] = -1;
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_SNAPSHOT, 1, 0, CFE_PSP_IODriver_VPARG(&Snapshot));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS && Sample[0] == UT_ExpectedLoad(50) && Sample[1] == -1,
+                  "Nominal Case: Read Snapshot cpuload");
+    UtAssert_True(Snapshot.Sequence == Sequence, "Nominal Case: Read Snapshot cpuload Sequence");
 
+    /* Nominal Case: Next sample goes to the other copy, readers only see it once published */
+    IdlePercent = 75;
+    CFE_PSP_Sysmon_TakeSample(&vxworks_sysmon_global.sysmon, false);
+    UtAssert_True(vxworks_sysmon_global.sysmon.Published.Sequence == Sequence + 1, "Nominal Case: Publish Second Sequence");
+
+    Sample[0] = -1;
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_SNAPSHOT, 0, 0, CFE_PSP_IODriver_VPARG(&Snapshot));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS && Sample[0] == UT_ExpectedLoad(75), "Nominal Case: Read Snapshot aggregate");
+    UtAssert_True(Snapshot.Sequence == Sequence + 1, "Nominal Case: Read Snapshot aggregate Sequence");
+
+    /* Nominal Case: Read Channels returns the published sample as well */
+    Sample[0] = -1;
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS, 1, 0,
+                                         CFE_PSP_IODriver_VPARG(&Snapshot.RdWr));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS && Sample[0] == UT_ExpectedLoad(75), "Nominal Case: Read Channels published");
+
+    EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(0));
+}
+
+void Test_Snapshot_Error(void)
+{
+    CFE_PSP_IODriver_API_t *EntryAPI = TgtAPI->ExtendedApi;
+    CFE_PSP_IODriver_AdcCode_t        Sample[2];
+    CFE_PSP_IODriver_AnalogSnapshot_t Snapshot = {.RdWr = {.NumChannels = 1, .Samples = Sample}};
+    int32 StatusCode;
+
+    /* Error Case: Read Snapshot while stopped */
+    Sample[0] = -1;
+    Snapshot.Sequence = 5;
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_SNAPSHOT, 0, 0, CFE_PSP_IODriver_VPARG(&Snapshot));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR && Sample[0] == -1 && Snapshot.Sequence == 5,
+                  "Error Case: Read Snapshot, Stopped");
+
+    EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(1));
+
+    /* Error Case: Aggregate Read Snapshot, Wrong Subchannel */
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_SNAPSHOT, 0, 4, CFE_PSP_IODriver_VPARG(&Snapshot));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR && Sample[0] == -1 && Snapshot.Sequence == 5,
+                  "Error Case: Aggregate Read Snapshot, Wrong Subchannel");
+
+    /* Error Case: Dispatch Read Snapshot, NumChannels > max cpu */
+    /* Default max cpu == 1 */
+    Snapshot.RdWr.NumChannels = 2;
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_SNAPSHOT, 1, 0, CFE_PSP_IODriver_VPARG(&Snapshot));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR && Sample[0] == -1 && Snapshot.Sequence == 5,
+                  "Error Case: Dispatch Read Snapshot, NumChannels > max cpu");
+
+    /* Error Case: Read Snapshot, NULL Argument */
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_SNAPSHOT, 1, 0, CFE_PSP_IODriver_VPARG(NULL));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR, "Error Case: Read Snapshot, NULL Argument");
+
+    EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(0));
+}
+
+void Test_History_Nominal(void)
+{
+    CFE_PSP_IODriver_API_t *EntryAPI = TgtAPI->ExtendedApi;
+    static struct CFE_PSP_Sysmon_Driver   Driver;
+    CFE_PSP_IODriver_AnalogHistoryEntry_t Entries[4];
+    CFE_PSP_IODriver_AnalogHistory_t      History     = {.Resolution = CFE_PSP_IODriver_AnalogHistory_SAMPLES,
+                                                         .MaxEntries = 4,
+                                                         .Entries    = Entries};
+    CFE_PSP_IODriver_AnalogPercentiles_t  Percentiles = {.Resolution = CFE_PSP_IODriver_AnalogHistory_SAMPLES};
+    int32 StatusCode;
+    int   IdlePercent;
+
+    /* The first sample, taken when starting, is not in the history */
+    IdlePercent = 50;
+    UT_SetHookFunction(UT_KEY(PCS_spyReportCommon), UT_SpyReport_Hook, &IdlePercent);
+    EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(1));
+
+    Driver                                 = *vxworks_sysmon_global.sysmon.Driver;
+    Driver.GetTimeNs                       = UT_GetTimeNs;
+    vxworks_sysmon_global.sysmon.Driver = &Driver;
+
+    UT_TakeSample(&IdlePercent, 75, 10);
+    UT_TakeSample(&IdlePercent, 25, 20);
+    UT_TakeSample(&IdlePercent, 50, 30);
+
+    /* Nominal Case: Samples, oldest first */
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_HISTORY, 0, 0, CFE_PSP_IODriver_VPARG(&History));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS && History.NumEntries == 3, "Nominal Case: Read History samples");
+    UtAssert_True(Entries[0].TimestampNs == 10000000000ULL && Entries[0].Mean == UT_ExpectedLoad(75) &&
+                      Entries[2].TimestampNs == 30000000000ULL && Entries[2].Mean == UT_ExpectedLoad(50),
+                  "Nominal Case: Read History samples order");
+
+    /* Nominal Case: The minute is not complete yet */
+    History.Resolution = CFE_PSP_IODriver_AnalogHistory_MINUTES;
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_HISTORY, 0, 0, CFE_PSP_IODriver_VPARG(&History));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS && History.NumEntries == 0, "Nominal Case: Read History, no minute yet");
+
+    /* Nominal Case: The first sample of the next minute completes it */
+    UT_TakeSample(&IdlePercent, 10, 70);
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_HISTORY, 0, 0, CFE_PSP_IODriver_VPARG(&History));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS && History.NumEntries == 1, "Nominal Case: Read History minutes");
+    UtAssert_True(Entries[0].TimestampNs == 0 && Entries[0].Min == UT_ExpectedLoad(75) &&
+                      Entries[0].Mean == UT_ExpectedLoad(50) && Entries[0].Max == UT_ExpectedLoad(25),
+                  "Nominal Case: Read History minute statistics");
+
+    /* Nominal Case: The first sample of the next hour completes the minute and the hour */
+    UT_TakeSample(&IdlePercent, 50, 3700);
+    History.Resolution = CFE_PSP_IODriver_AnalogHistory_HOURS;
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_HISTORY, 0, 0, CFE_PSP_IODriver_VPARG(&History));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS && History.NumEntries == 1 && Entries[0].TimestampNs == 0 &&
+                      Entries[0].Min == UT_ExpectedLoad(75) && Entries[0].Max == UT_ExpectedLoad(10),
+                  "Nominal Case: Read History hours");
+    History.Resolution = CFE_PSP_IODriver_AnalogHistory_MINUTES;
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_HISTORY, 0, 0, CFE_PSP_IODriver_VPARG(&History));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS && History.NumEntries == 2 &&
+                      Entries[1].TimestampNs == 60000000000ULL && Entries[1].Mean == UT_ExpectedLoad(10),
+                  "Nominal Case: Read History minutes, next minute");
+
+    /* Nominal Case: Per CPU history, limited to the most recent entries */
+    History.Resolution = CFE_PSP_IODriver_AnalogHistory_SAMPLES;
+    History.MaxEntries = 2;
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_HISTORY, 1, 0, CFE_PSP_IODriver_VPARG(&History));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS && History.NumEntries == 2 &&
+                      Entries[0].TimestampNs == 70000000000ULL && Entries[1].Mean == UT_ExpectedLoad(50),
+                  "Nominal Case: Read History cpuload, most recent");
+
+    /* Nominal Case: Percentiles of all samples */
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_PERCENTILES, 0, 0,
+                                         CFE_PSP_IODriver_VPARG(&Percentiles));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS && Percentiles.NumEntries == 5, "Nominal Case: Read Percentiles");
+    UtAssert_True(Percentiles.Min == UT_ExpectedLoad(75) && Percentiles.P50 == UT_ExpectedLoad(50) &&
+                      Percentiles.P95 == UT_ExpectedLoad(10) && Percentiles.P99 == UT_ExpectedLoad(10) &&
+                      Percentiles.Max == UT_ExpectedLoad(10),
+                  "Nominal Case: Read Percentiles values");
+
+    /* Nominal Case: Percentiles of the last samples */
+    Percentiles.WindowEntries = 2;
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_PERCENTILES, 1, 0,
+                                         CFE_PSP_IODriver_VPARG(&Percentiles));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS && Percentiles.NumEntries == 2 &&
+                      Percentiles.Min == UT_ExpectedLoad(50) && Percentiles.P50 == UT_ExpectedLoad(50) &&
+                      Percentiles.Max == UT_ExpectedLoad(10),
+                  "Nominal Case: Read Percentiles window");
+
+    EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(0));
+}
+
+void Test_History_Error(void)
+{
+    CFE_PSP_IODriver_API_t *EntryAPI = TgtAPI->ExtendedApi;
+    CFE_PSP_IODriver_AnalogHistoryEntry_t Entries[1];
+    CFE_PSP_IODriver_AnalogHistory_t      History     = {.MaxEntries = 1, .Entries = Entries};
+    CFE_PSP_IODriver_AnalogPercentiles_t  Percentiles = {0};
+    int32 StatusCode;
+
+    /* Error Case: Read History while stopped */
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_HISTORY, 0, 0, CFE_PSP_IODriver_VPARG(&History));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR, "Error Case: Read History, Stopped");
+
+    EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(1));
+
+    /* Error Case: Read Percentiles, no history yet */
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_PERCENTILES, 0, 0,
+                                         CFE_PSP_IODriver_VPARG(&Percentiles));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR, "Error Case: Read Percentiles, Empty");
+
+    /* Error Case: Aggregate Read History, Wrong Subchannel */
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_HISTORY, 0, 1, CFE_PSP_IODriver_VPARG(&History));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR, "Error Case: Aggregate Read History, Wrong Subchannel");
+
+    /* Error Case: Dispatch Read History, Subchannel > max cpu */
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_HISTORY, 1, 1, CFE_PSP_IODriver_VPARG(&History));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR, "Error Case: Dispatch Read History, Subchannel > max cpu");
+
+    /* Error Case: Read History, Wrong Resolution */
+    History.Resolution = CFE_PSP_IODriver_AnalogHistory_MAX;
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_HISTORY, 0, 0, CFE_PSP_IODriver_VPARG(&History));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR, "Error Case: Read History, Wrong Resolution");
+
+    /* Error Case: Read History, NULL Entries */
+    History.Resolution = CFE_PSP_IODriver_AnalogHistory_SAMPLES;
+    History.Entries    = NULL;
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_HISTORY, 0, 0, CFE_PSP_IODriver_VPARG(&History));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR, "Error Case: Read History, NULL Entries");
+
+    /* Error Case: Read History and Percentiles, NULL Argument */
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_HISTORY, 0, 0, CFE_PSP_IODriver_VPARG(NULL));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR, "Error Case: Read History, NULL Argument");
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_PERCENTILES, 0, 0, CFE_PSP_IODriver_VPARG(NULL));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR, "Error Case: Read Percentiles, NULL Argument");
+
+    /* Error Case: Read History, Window Statistics */
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_HISTORY, 2, 0, CFE_PSP_IODriver_VPARG(&History));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR_NOT_IMPLEMENTED, "Error Case: Read History, Window Statistics");
+
+    EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(0));
+}
+
+void Test_Lock_Nominal(void)
+{
+    CFE_PSP_IODriver_API_t *EntryAPI = TgtAPI->ExtendedApi;
+    int32                   Lock;
+
+    UtAssert_True(EntryAPI->DeviceLock != NULL && EntryAPI->Locks != NULL && EntryAPI->NumLocks == 1,
+                  "Nominal Case: Locks Declared");
+
+    /* Nominal Case: Start/Stop and Configuration hold the lock alone */
+    Lock = EntryAPI->DeviceLock(CFE_PSP_IODriver_SET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(1));
+    UtAssert_True(Lock == CFE_PSP_IODriver_LockExclusive(0), "Nominal Case: Set Running, Exclusive Lock");
+    Lock = EntryAPI->DeviceLock(CFE_PSP_IODriver_SET_CONFIGURATION, 0, 0, CFE_PSP_IODriver_CONST_STR(""));
+    UtAssert_True(Lock == CFE_PSP_IODriver_LockExclusive(0), "Nominal Case: Set Configuration, Exclusive Lock");
+
+    /* Nominal Case: Getting the configuration shares the lock */
+    Lock = EntryAPI->DeviceLock(CFE_PSP_IODriver_GET_CONFIGURATION, 0, 0, CFE_PSP_IODriver_VPARG(NULL));
+    UtAssert_True(Lock == CFE_PSP_IODriver_LockShared(0), "Nominal Case: Get Configuration, Shared Lock");
+
+    /* Nominal Case: Reads take no lock */
+    Lock = EntryAPI->DeviceLock(CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS, 1, 0, CFE_PSP_IODriver_VPARG(NULL));
+    UtAssert_True(Lock == CFE_PSP_IODRIVER_LOCK_NONE, "Nominal Case: Read Channels, No Lock");
+    Lock = EntryAPI->DeviceLock(CFE_PSP_IODriver_ANALOG_IO_READ_HISTORY, 1, 0, CFE_PSP_IODriver_VPARG(NULL));
+    UtAssert_True(Lock == CFE_PSP_IODRIVER_LOCK_NONE, "Nominal Case: Read History, No Lock");
+    Lock = EntryAPI->DeviceLock(CFE_PSP_IODriver_GET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(0));
+    UtAssert_True(Lock == CFE_PSP_IODRIVER_LOCK_NONE, "Nominal Case: Get Running, No Lock");
+}
+
+void Test_Lock_Writer(void)
+{
+    CFE_PSP_IODriver_API_t *      EntryAPI = TgtAPI->ExtendedApi;
+    CFE_PSP_IODriver_Location_t   Location = {.PspModuleId = UT_SYSMON_ID, .SubsystemId = 0, .SubchannelId = 0};
+    CFE_PSP_IODriver_AdcCode_t    Sample[1];
+    CFE_PSP_IODriver_AnalogRdWr_t RdWr = {.NumChannels = 1, .Samples = Sample};
+    CFE_PSP_Sysmon_Config_t       Config;
+    CFE_PSP_IODriver_LockStats_t  Stats;
+    int32                         StatusCode;
+    int                           IdlePercent;
+    uint32                        Waits;
+
+    IdlePercent = 97;
+    UT_SetHookFunction(UT_KEY(PCS_spyReportCommon), UT_SpyReport_Hook, &IdlePercent);
+    StatusCode = CFE_PSP_IODriver_Command(&Location, CFE_PSP_IODriver_SET_RUNNING, CFE_PSP_IODriver_U32ARG(1));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS, "Nominal Case: Start");
+
+    /* A writer holds the lock: the semaphore of the lock is no longer available */
+    UtAssert_True(CFE_PSP_IODriver_LockTake(UT_SYSMON_ID, 0, &EntryAPI->Locks[0], false) == CFE_PSP_SUCCESS,
+                  "Nominal Case: Writer Holds the Lock");
+    UT_SetDefaultReturnValue(UT_KEY(OS_BinSemTimedWait), OS_SEM_TIMEOUT);
+    Waits = UT_GetStubCount(UT_KEY(OS_BinSemTake));
+
+    /* Nominal Case: Reads complete without waiting for the writer */
+    StatusCode = CFE_PSP_IODriver_Command(&Location, CFE_PSP_IODriver_GET_RUNNING, CFE_PSP_IODriver_U32ARG(0));
+    UtAssert_True(StatusCode == true, "Nominal Case: Get Running, Writer Holds the Lock");
+    Location.SubsystemId = 1;
+    Sample[0]            = -1;
+    StatusCode =
+        CFE_PSP_IODriver_Command(&Location, CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS, CFE_PSP_IODriver_VPARG(&RdWr));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS && Sample[0] == UT_ExpectedLoad(97),
+                  "Nominal Case: Read Channels, Writer Holds the Lock");
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_BinSemTake)) == Waits, "Nominal Case: Reads Did Not Wait");
+
+    UtAssert_True(CFE_PSP_IODriver_GetLockStats(UT_SYSMON_ID, 0, &Stats) == CFE_PSP_SUCCESS &&
+                      Stats.SharedCount == 0 && Stats.SharedContended == 0,
+                  "Nominal Case: Reads Did Not Take the Lock");
+
+    /* Nominal Case: Getting the configuration waits for the writer */
+    Location.SubsystemId = 0;
+    StatusCode =
+        CFE_PSP_IODriver_Command(&Location, CFE_PSP_IODriver_GET_CONFIGURATION, CFE_PSP_IODriver_VPARG(&Config));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS, "Nominal Case: Get Configuration");
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_BinSemTake)) == Waits + 1, "Nominal Case: Get Configuration Waited");
+    UtAssert_True(CFE_PSP_IODriver_GetLockStats(UT_SYSMON_ID, 0, &Stats) == CFE_PSP_SUCCESS &&
+                      Stats.SharedCount == 1 && Stats.SharedContended == 1,
+                  "Nominal Case: Get Configuration Shared the Lock");
+
+    UT_ClearDefaultReturnValue(UT_KEY(OS_BinSemTimedWait));
+    CFE_PSP_IODriver_LockGive(&EntryAPI->Locks[0], false);
+    EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(0));
 }
 
 /*
@@ -351,5 +806,11 @@ void UtTest_Setup(void)
     ADD_TEST(Test_UpdateStat_Nominal);
     ADD_TEST(Test_Task_Nominal);
     ADD_TEST(Test_Task_Error);
+    ADD_TEST(Test_Snapshot_Nominal);
+    ADD_TEST(Test_Snapshot_Error);
+    ADD_TEST(Test_History_Nominal);
+    ADD_TEST(Test_History_Error);
+    ADD_TEST(Test_Lock_Nominal);
+    ADD_TEST(Test_Lock_Writer);
 
 }
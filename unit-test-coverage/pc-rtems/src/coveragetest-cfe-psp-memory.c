@@ -19,7 +19,9 @@
 #include "coveragetest-psp-pc-rtems.h"
 
 #include "cfe_psp.h"
+#include "cfe_psp_memory.h"
 #include "PCS_stdlib.h"
+#include "PCS_string.h"
 
 extern int32 CFE_PSP_InitProcessorReservedMemory(uint32 ResetType);
 extern void  CFE_PSP_SetupReservedMemoryMap(void);
@@ -57,6 +59,77 @@ void Test_CFE_PSP_ReadFromCDS(void)
     UtAssert_INT32_EQ(CFE_PSP_ReadFromCDS(NULL, CDSOffset, NumBytes), OS_ERROR);
 }
 
+void Test_CFE_PSP_WriteToCDSv(void)
+{
+    uint8                 CDSBlock[32];
+    uint8                 Data[8] = {0};
+    CFE_PSP_CDSWriteVec_t Vec[2];
+
+    CFE_PSP_ReservedMemoryMap.CDSMemory.BlockPtr  = CDSBlock;
+    CFE_PSP_ReservedMemoryMap.CDSMemory.BlockSize = sizeof(CDSBlock);
+
+    Vec[0].CDSOffset = 0;
+    Vec[0].NumBytes  = sizeof(Data);
+    Vec[0].DataPtr   = Data;
+    Vec[1].CDSOffset = sizeof(CDSBlock) - sizeof(Data);
+    Vec[1].NumBytes  = sizeof(Data);
+    Vec[1].DataPtr   = Data;
+
+    /* Test NULL pointer guard */
+    UtAssert_INT32_EQ(CFE_PSP_WriteToCDSv(NULL, 2, 0), OS_ERROR);
+
+    /* Nominal path, one copy per entry */
+    UtAssert_INT32_EQ(CFE_PSP_WriteToCDSv(Vec, 2, CFE_PSP_CDS_VEC_FENCE), OS_SUCCESS);
+    UtAssert_STUB_COUNT(PCS_memcpy, 2);
+
+    /* An out of range entry rejects the whole request without copying anything */
+    UT_ResetState(UT_KEY(PCS_memcpy));
+    Vec[1].CDSOffset = sizeof(CDSBlock) - sizeof(Data) + 1;
+    UtAssert_INT32_EQ(CFE_PSP_WriteToCDSv(Vec, 2, 0), OS_ERROR);
+    Vec[1].CDSOffset = 0xFFFFFFFF;
+    UtAssert_INT32_EQ(CFE_PSP_WriteToCDSv(Vec, 2, 0), OS_ERROR);
+    Vec[1].CDSOffset = 0;
+    Vec[1].DataPtr   = NULL;
+    UtAssert_INT32_EQ(CFE_PSP_WriteToCDSv(Vec, 2, 0), OS_ERROR);
+    UtAssert_STUB_COUNT(PCS_memcpy, 0);
+}
+
+void Test_CFE_PSP_ReadFromCDSv(void)
+{
+    uint8                CDSBlock[32];
+    uint8                Data[8];
+    CFE_PSP_CDSReadVec_t Vec[2];
+
+    CFE_PSP_ReservedMemoryMap.CDSMemory.BlockPtr  = CDSBlock;
+    CFE_PSP_ReservedMemoryMap.CDSMemory.BlockSize = sizeof(CDSBlock);
+
+    Vec[0].CDSOffset = 0;
+    Vec[0].NumBytes  = sizeof(Data);
+    Vec[0].DataPtr   = Data;
+    Vec[1].CDSOffset = sizeof(CDSBlock) - sizeof(Data);
+    Vec[1].NumBytes  = sizeof(Data);
+    Vec[1].DataPtr   = Data;
+
+    /* Test NULL pointer guard */
+    UtAssert_INT32_EQ(CFE_PSP_ReadFromCDSv(NULL, 2, 0), OS_ERROR);
+
+    /* Nominal path, one copy per entry */
+    UtAssert_INT32_EQ(CFE_PSP_ReadFromCDSv(Vec, 2, CFE_PSP_CDS_VEC_FENCE), OS_SUCCESS);
+    UtAssert_STUB_COUNT(PCS_memcpy, 2);
+
+    /* An out of range entry rejects the whole request without copying anything */
+    UT_ResetState(UT_KEY(PCS_memcpy));
+    Vec[1].NumBytes = sizeof(Data) + 1;
+    UtAssert_INT32_EQ(CFE_PSP_ReadFromCDSv(Vec, 2, 0), OS_ERROR);
+    UtAssert_STUB_COUNT(PCS_memcpy, 0);
+}
+
+void Test_CFE_PSP_FlushCDS(void)
+{
+    /* No backing store on this platform */
+    UtAssert_INT32_EQ(CFE_PSP_FlushCDS(), CFE_PSP_ERROR_NOT_IMPLEMENTED);
+}
+
 void Test_CFE_PSP_GetResetArea(void)
 {
     cpuaddr PtrToResetArea;
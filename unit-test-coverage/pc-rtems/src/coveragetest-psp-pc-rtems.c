@@ -36,6 +36,9 @@ void UtTest_Setup(void)
     ADD_TEST(CFE_PSP_GetCDSSize);
     ADD_TEST(CFE_PSP_WriteToCDS);
     ADD_TEST(CFE_PSP_ReadFromCDS);
+    ADD_TEST(CFE_PSP_WriteToCDSv);
+    ADD_TEST(CFE_PSP_ReadFromCDSv);
+    ADD_TEST(CFE_PSP_FlushCDS);
     ADD_TEST(CFE_PSP_GetResetArea);
     ADD_TEST(CFE_PSP_GetUserReservedArea);
     ADD_TEST(CFE_PSP_GetVolatileDiskMem);
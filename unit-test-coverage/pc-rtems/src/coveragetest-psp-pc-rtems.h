@@ -39,6 +39,9 @@ void Test_CFE_PSP_SetDefaultExceptionEnvironment(void);
 void Test_CFE_PSP_GetCDSSize(void);
 void Test_CFE_PSP_WriteToCDS(void);
 void Test_CFE_PSP_ReadFromCDS(void);
+void Test_CFE_PSP_WriteToCDSv(void);
+void Test_CFE_PSP_ReadFromCDSv(void);
+void Test_CFE_PSP_FlushCDS(void);
 void Test_CFE_PSP_GetResetArea(void);
 void Test_CFE_PSP_GetUserReservedArea(void);
 void Test_CFE_PSP_GetVolatileDiskMem(void);
@@ -47,4 +47,13 @@ void Test_CFE_PSP_Exception_GetNextContextBuffer(void);
 void Test_CFE_PSP_Exception_GetSummary(void);
 void Test_CFE_PSP_Exception_CopyContext(void);
 
+void Test_CFE_PSP_MemValidateRange(void);
+void Test_CFE_PSP_MemRangeFind(void);
+void Test_CFE_PSP_MemRangeSet(void);
+
+void Test_CFE_PSP_MemCpy64(void);
+void Test_CFE_PSP_MemCpyStream(void);
+void Test_CFE_PSP_MemCmp(void);
+void Test_CFE_PSP_MemChecksum(void);
+
 #endif
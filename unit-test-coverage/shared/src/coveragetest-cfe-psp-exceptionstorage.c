@@ -67,11 +67,13 @@ void Test_CFE_PSP_Exception_GetNextContextBuffer(void)
      *
      * void CFE_PSP_Exception_Reset(void)
      * CFE_PSP_Exception_LogData_t* CFE_PSP_Exception_GetNextContextBuffer(void)
-     * void CFE_PSP_Exception_WriteComplete(void)
+     * void CFE_PSP_Exception_WriteComplete(CFE_PSP_Exception_LogData_t *Buffer)
      * uint32 CFE_PSP_Exception_GetCount(void)
      */
-    uint32 NumEntries;
-    uint32 Count;
+    struct CFE_PSP_Exception_LogData *Ptr;
+    struct CFE_PSP_Exception_LogData *Ptr2;
+    uint32                            NumEntries;
+    uint32                            Count;
 
     CFE_PSP_Exception_Reset();
     UtAssert_ZERO(CFE_PSP_Exception_GetCount());
@@ -79,8 +81,9 @@ void Test_CFE_PSP_Exception_GetNextContextBuffer(void)
 
     for (Count = 1; Count <= NumEntries; ++Count)
     {
-        UtAssert_NOT_NULL(CFE_PSP_Exception_GetNextContextBuffer());
-        CFE_PSP_Exception_WriteComplete();
+        Ptr = CFE_PSP_Exception_GetNextContextBuffer();
+        UtAssert_NOT_NULL(Ptr);
+        CFE_PSP_Exception_WriteComplete(Ptr);
 
         UtAssert_UINT32_EQ(CFE_PSP_Exception_GetCount(), Count);
     }
@@ -89,6 +92,35 @@ void Test_CFE_PSP_Exception_GetNextContextBuffer(void)
     UtAssert_NULL(CFE_PSP_Exception_GetNextContextBuffer());
     CFE_PSP_Exception_Reset();
     UtAssert_ZERO(CFE_PSP_Exception_GetCount());
+
+    /* Entries completed out of order are published in reservation order */
+    if (NumEntries >= 2)
+    {
+        Ptr = CFE_PSP_Exception_GetNextContextBuffer();
+        UtAssert_NOT_NULL(Ptr);
+        Ptr2 = CFE_PSP_Exception_GetNextContextBuffer();
+        UtAssert_NOT_NULL(Ptr2);
+        UtAssert_True(Ptr != Ptr2, "Concurrent buffers (%p) != (%p)", (void *)Ptr, (void *)Ptr2);
+        CFE_PSP_Exception_WriteComplete(Ptr2);
+        UtAssert_ZERO(CFE_PSP_Exception_GetCount());
+        CFE_PSP_Exception_WriteComplete(Ptr);
+        UtAssert_UINT32_EQ(CFE_PSP_Exception_GetCount(), 2);
+    }
+
+    /* Reserved but incomplete entries count towards the limit, and are discarded by reset */
+    CFE_PSP_Exception_Reset();
+    for (Count = 0; Count < NumEntries; ++Count)
+    {
+        UtAssert_NOT_NULL(CFE_PSP_Exception_GetNextContextBuffer());
+    }
+    UtAssert_NULL(CFE_PSP_Exception_GetNextContextBuffer());
+    UtAssert_ZERO(CFE_PSP_Exception_GetCount());
+    CFE_PSP_Exception_Reset();
+    Ptr = CFE_PSP_Exception_GetNextContextBuffer();
+    UtAssert_NOT_NULL(Ptr);
+    CFE_PSP_Exception_WriteComplete(Ptr);
+    UtAssert_UINT32_EQ(CFE_PSP_Exception_GetCount(), 1);
+    CFE_PSP_Exception_Reset();
 }
 
 void Test_CFE_PSP_Exception_GetSummary(void)
@@ -97,10 +129,11 @@ void Test_CFE_PSP_Exception_GetSummary(void)
      * Test Case For:
      * int32 CFE_PSP_Exception_GetSummary(uint32 *ContextLogId, uint32 *TaskId, char *ReasonBuf, uint32 ReasonSize)
      */
-    char      ReasonBuf[128];
-    uint32    LogId;
-    osal_id_t TaskId;
-    osal_id_t TestId;
+    struct CFE_PSP_Exception_LogData *Ptr;
+    char                              ReasonBuf[128];
+    uint32                            LogId;
+    osal_id_t                         TaskId;
+    osal_id_t                         TestId;
 
     /* Nominal - no exceptions pending should return CFE_PSP_NO_EXCEPTION_DATA */
     CFE_PSP_Exception_Reset();
@@ -110,28 +143,32 @@ void Test_CFE_PSP_Exception_GetSummary(void)
     /* Set up an entry and then run again */
     TestId = OS_ObjectIdFromInteger(2857);
     UT_SetDataBuffer(UT_KEY(OS_TaskFindIdBySystemData), &TestId, sizeof(TestId), false);
-    UtAssert_NOT_NULL(CFE_PSP_Exception_GetNextContextBuffer());
-    CFE_PSP_Exception_WriteComplete();
+    Ptr = CFE_PSP_Exception_GetNextContextBuffer();
+    UtAssert_NOT_NULL(Ptr);
+    CFE_PSP_Exception_WriteComplete(Ptr);
     UtAssert_INT32_EQ(CFE_PSP_Exception_GetSummary(&LogId, &TaskId, ReasonBuf, sizeof(ReasonBuf)), CFE_PSP_SUCCESS);
     UtAssert_NONZERO(LogId);
     UtAssert_UINT32_EQ(OS_ObjectIdToInteger(TaskId), OS_ObjectIdToInteger(TestId));
     UtAssert_ZERO(CFE_PSP_Exception_GetCount());
 
     /* Get an entry with failure to obtain task ID */
-    UtAssert_NOT_NULL(CFE_PSP_Exception_GetNextContextBuffer());
-    CFE_PSP_Exception_WriteComplete();
+    Ptr = CFE_PSP_Exception_GetNextContextBuffer();
+    UtAssert_NOT_NULL(Ptr);
+    CFE_PSP_Exception_WriteComplete(Ptr);
     UT_SetDefaultReturnValue(UT_KEY(OS_TaskFindIdBySystemData), OS_ERROR);
     UtAssert_INT32_EQ(CFE_PSP_Exception_GetSummary(&LogId, &TaskId, ReasonBuf, sizeof(ReasonBuf)), CFE_PSP_SUCCESS);
     UT_ClearDefaultReturnValue(UT_KEY(OS_TaskFindIdBySystemData));
     UtAssert_NONZERO(LogId);
     UtAssert_ZERO(OS_ObjectIdToInteger(TaskId));
 
-    UtAssert_NOT_NULL(CFE_PSP_Exception_GetNextContextBuffer());
-    CFE_PSP_Exception_WriteComplete();
+    Ptr = CFE_PSP_Exception_GetNextContextBuffer();
+    UtAssert_NOT_NULL(Ptr);
+    CFE_PSP_Exception_WriteComplete(Ptr);
     UtAssert_INT32_EQ(CFE_PSP_Exception_GetSummary(&LogId, &TaskId, NULL, 0), CFE_PSP_SUCCESS);
 
-    UtAssert_NOT_NULL(CFE_PSP_Exception_GetNextContextBuffer());
-    CFE_PSP_Exception_WriteComplete();
+    Ptr = CFE_PSP_Exception_GetNextContextBuffer();
+    UtAssert_NOT_NULL(Ptr);
+    CFE_PSP_Exception_WriteComplete(Ptr);
     UtAssert_INT32_EQ(CFE_PSP_Exception_GetSummary(&LogId, NULL, ReasonBuf, sizeof(ReasonBuf)), CFE_PSP_SUCCESS);
 }
 
@@ -155,7 +192,7 @@ void Test_CFE_PSP_Exception_CopyContext(void)
     UtAssert_True(Ptr != NULL, "CFE_PSP_Exception_GetNextContextBuffer() (%p) != NULL", (void *)Ptr);
     LogId = UT_Get_Exception_Id(Ptr);
     UT_Generate_Exception_Context(Ptr, sizeof(LargeBuf));
-    CFE_PSP_Exception_WriteComplete();
+    CFE_PSP_Exception_WriteComplete(Ptr);
     UtAssert_NONZERO(LogId);
 
     /* Read first entry  - remove from ring */
@@ -173,8 +210,8 @@ void Test_CFE_PSP_Exception_CopyContext(void)
     NumEntries = UT_Get_Exception_MaxEntries();
     for (Count = 0; Count < NumEntries; ++Count)
     {
-        CFE_PSP_Exception_GetNextContextBuffer();
-        CFE_PSP_Exception_WriteComplete();
+        Ptr = CFE_PSP_Exception_GetNextContextBuffer();
+        CFE_PSP_Exception_WriteComplete(Ptr);
     }
 
     UtAssert_UINT32_EQ(CFE_PSP_Exception_GetCount(), NumEntries);
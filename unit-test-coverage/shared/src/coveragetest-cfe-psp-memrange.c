@@ -0,0 +1,200 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ * \ingroup  shared
+ *
+ * Coverage tests for the memory range table and its index
+ */
+
+#include "utassert.h"
+#include "utstubs.h"
+
+#include "cfe_psp.h"
+#include "coveragetest-psp-shared.h"
+
+/*
+ * Put every table entry into a known state, using only the public API.
+ * All entries become a duplicate RAM range at 0x100-0x1FF.
+ */
+static uint32 UT_MemRange_Reset(void)
+{
+    uint32 NumRanges;
+    uint32 i;
+
+    NumRanges = CFE_PSP_MemRanges();
+    for (i = 0; i < NumRanges; ++i)
+    {
+        UtAssert_INT32_EQ(CFE_PSP_MemRangeSet(i, CFE_PSP_MEM_RAM, 0x100, 0x100, CFE_PSP_MEM_SIZE_BYTE,
+                                              CFE_PSP_MEM_ATTR_READWRITE),
+                          CFE_PSP_SUCCESS);
+    }
+
+    return NumRanges;
+}
+
+static void UT_MemRange_CheckOverlap(void)
+{
+    /* Fully inside the EEPROM range only */
+    UtAssert_INT32_EQ(CFE_PSP_MemValidateRange(0x1000, 0x10, CFE_PSP_MEM_EEPROM), CFE_PSP_SUCCESS);
+    UtAssert_INT32_EQ(CFE_PSP_MemValidateRange(0x1000, 0x10, CFE_PSP_MEM_ANY), CFE_PSP_SUCCESS);
+    UtAssert_INT32_EQ(CFE_PSP_MemValidateRange(0x1000, 0x10, CFE_PSP_MEM_RAM), CFE_PSP_INVALID_MEM_TYPE);
+
+    /* In the overlap, both types are valid */
+    UtAssert_INT32_EQ(CFE_PSP_MemValidateRange(0x1090, 0x10, CFE_PSP_MEM_EEPROM), CFE_PSP_SUCCESS);
+    UtAssert_INT32_EQ(CFE_PSP_MemValidateRange(0x1090, 0x10, CFE_PSP_MEM_RAM), CFE_PSP_SUCCESS);
+
+    /* Starts in the overlap but only the RAM range is long enough */
+    UtAssert_INT32_EQ(CFE_PSP_MemValidateRange(0x1090, 0xF0, CFE_PSP_MEM_RAM), CFE_PSP_SUCCESS);
+    UtAssert_INT32_EQ(CFE_PSP_MemValidateRange(0x1090, 0xF0, CFE_PSP_MEM_EEPROM), CFE_PSP_INVALID_MEM_TYPE);
+
+    /* Starts in the overlap but runs past both ranges */
+    UtAssert_INT32_EQ(CFE_PSP_MemValidateRange(0x1090, 0xF1, CFE_PSP_MEM_ANY), CFE_PSP_INVALID_MEM_RANGE);
+
+    /* Outside of every range */
+    UtAssert_INT32_EQ(CFE_PSP_MemValidateRange(0x1180, 0x1, CFE_PSP_MEM_ANY), CFE_PSP_INVALID_MEM_ADDR);
+    UtAssert_INT32_EQ(CFE_PSP_MemValidateRange(0xFFF, 0x1, CFE_PSP_MEM_ANY), CFE_PSP_INVALID_MEM_ADDR);
+}
+
+void Test_CFE_PSP_MemValidateRange(void)
+{
+    /*
+     * Test Case For:
+     * int32 CFE_PSP_MemValidateRange(cpuaddr Address, size_t Size, uint32 MemoryType)
+     */
+    uint32 NumRanges;
+
+    NumRanges = UT_MemRange_Reset();
+    UtAssert_True(NumRanges >= 3, "CFE_PSP_MemRanges() (%lu) >= 3", (unsigned long)NumRanges);
+
+    /* Parameter checks */
+    UtAssert_INT32_EQ(CFE_PSP_MemValidateRange(0x100, 0x10, CFE_PSP_MEM_INVALID), CFE_PSP_INVALID_MEM_TYPE);
+    UtAssert_INT32_EQ(CFE_PSP_MemValidateRange(0x100, 0, CFE_PSP_MEM_ANY), CFE_PSP_INVALID_MEM_RANGE);
+    UtAssert_INT32_EQ(CFE_PSP_MemValidateRange(0x100, (size_t)-1, CFE_PSP_MEM_ANY), CFE_PSP_INVALID_MEM_RANGE);
+
+    /* Nominal lookups in the duplicated entry */
+    UtAssert_INT32_EQ(CFE_PSP_MemValidateRange(0x100, 0x100, CFE_PSP_MEM_RAM), CFE_PSP_SUCCESS);
+    UtAssert_INT32_EQ(CFE_PSP_MemValidateRange(0x1FF, 0x1, CFE_PSP_MEM_ANY), CFE_PSP_SUCCESS);
+    UtAssert_INT32_EQ(CFE_PSP_MemValidateRange(0x100, 0x101, CFE_PSP_MEM_RAM), CFE_PSP_INVALID_MEM_RANGE);
+    UtAssert_INT32_EQ(CFE_PSP_MemValidateRange(0x100, 0x10, CFE_PSP_MEM_EEPROM), CFE_PSP_INVALID_MEM_TYPE);
+
+    /*
+     * Overlapping EEPROM and RAM ranges, checked with the entries in both
+     * orders.  The result must not depend on the position in the table.
+     */
+    CFE_PSP_MemRangeSet(1, CFE_PSP_MEM_EEPROM, 0x1000, 0x100, CFE_PSP_MEM_SIZE_BYTE, CFE_PSP_MEM_ATTR_READWRITE);
+    CFE_PSP_MemRangeSet(NumRanges - 1, CFE_PSP_MEM_RAM, 0x1080, 0x100, CFE_PSP_MEM_SIZE_BYTE,
+                        CFE_PSP_MEM_ATTR_READWRITE);
+    UT_MemRange_CheckOverlap();
+
+    UT_MemRange_Reset();
+    CFE_PSP_MemRangeSet(NumRanges - 1, CFE_PSP_MEM_EEPROM, 0x1000, 0x100, CFE_PSP_MEM_SIZE_BYTE,
+                        CFE_PSP_MEM_ATTR_READWRITE);
+    CFE_PSP_MemRangeSet(1, CFE_PSP_MEM_RAM, 0x1080, 0x100, CFE_PSP_MEM_SIZE_BYTE, CFE_PSP_MEM_ATTR_READWRITE);
+    UT_MemRange_CheckOverlap();
+
+    /* A range reaching the top of the address space */
+    CFE_PSP_MemRangeSet(0, CFE_PSP_MEM_RAM, ((cpuaddr)-1) - 0xFF, 0x100, CFE_PSP_MEM_SIZE_BYTE,
+                        CFE_PSP_MEM_ATTR_READWRITE);
+    UtAssert_INT32_EQ(CFE_PSP_MemValidateRange(((cpuaddr)-1) - 0xF, 0x10, CFE_PSP_MEM_RAM), CFE_PSP_SUCCESS);
+    UtAssert_INT32_EQ(CFE_PSP_MemValidateRange(((cpuaddr)-1) - 0x100, 0x10, CFE_PSP_MEM_RAM),
+                      CFE_PSP_INVALID_MEM_ADDR);
+}
+
+void Test_CFE_PSP_MemRangeFind(void)
+{
+    /*
+     * Test Case For:
+     * int32 CFE_PSP_MemRangeFind(cpuaddr Address, size_t Size, uint32 Attributes, uint32 *RangeNum)
+     */
+    uint32 NumRanges;
+    uint32 RangeNum;
+
+    NumRanges = UT_MemRange_Reset();
+
+    UtAssert_INT32_EQ(CFE_PSP_MemRangeFind(0x100, 0x10, CFE_PSP_MEM_ATTR_READ, NULL), CFE_PSP_INVALID_POINTER);
+    UtAssert_INT32_EQ(CFE_PSP_MemRangeFind(0x100, 0, CFE_PSP_MEM_ATTR_READ, &RangeNum), CFE_PSP_INVALID_MEM_RANGE);
+    UtAssert_INT32_EQ(CFE_PSP_MemRangeFind(0x80, 0x10, CFE_PSP_MEM_ATTR_READ, &RangeNum), CFE_PSP_INVALID_MEM_ADDR);
+    UtAssert_INT32_EQ(CFE_PSP_MemRangeFind(0x100, 0x101, CFE_PSP_MEM_ATTR_READ, &RangeNum),
+                      CFE_PSP_INVALID_MEM_RANGE);
+
+    /* The duplicated entry is found as the first in the table */
+    RangeNum = NumRanges;
+    UtAssert_INT32_EQ(CFE_PSP_MemRangeFind(0x100, 0x100, CFE_PSP_MEM_ATTR_READWRITE, &RangeNum), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(RangeNum, 0);
+
+    /*
+     * A read-only word register block overlapping a writable byte range.
+     * Reads of whole words find the register block, writes only the byte
+     * range, and accesses past the byte range report the register errors.
+     */
+    CFE_PSP_MemRangeSet(0, CFE_PSP_MEM_RAM, 0x1000, 0x40, CFE_PSP_MEM_SIZE_BYTE, CFE_PSP_MEM_ATTR_WRITE);
+    CFE_PSP_MemRangeSet(NumRanges - 1, CFE_PSP_MEM_EEPROM, 0x1000, 0x100, CFE_PSP_MEM_SIZE_DWORD,
+                        CFE_PSP_MEM_ATTR_READ);
+
+    UtAssert_INT32_EQ(CFE_PSP_MemRangeFind(0x1010, 0x10, CFE_PSP_MEM_ATTR_READ, &RangeNum), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(RangeNum, NumRanges - 1);
+    UtAssert_INT32_EQ(CFE_PSP_MemRangeFind(0x1011, 0x10, CFE_PSP_MEM_ATTR_WRITE, &RangeNum), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(RangeNum, 0);
+    UtAssert_INT32_EQ(CFE_PSP_MemRangeFind(0x1011, 0x10, CFE_PSP_MEM_ATTR_READ, &RangeNum),
+                      CFE_PSP_ERROR_ADDRESS_MISALIGNED);
+    UtAssert_INT32_EQ(CFE_PSP_MemRangeFind(0x1010, 0x10, CFE_PSP_MEM_ATTR_READWRITE, &RangeNum),
+                      CFE_PSP_INVALID_MEM_ATTR);
+    UtAssert_INT32_EQ(CFE_PSP_MemRangeFind(0x1040, 0x10, CFE_PSP_MEM_ATTR_WRITE, &RangeNum),
+                      CFE_PSP_INVALID_MEM_ATTR);
+    UtAssert_INT32_EQ(CFE_PSP_MemRangeFind(0x1010, 0x100, CFE_PSP_MEM_ATTR_READ, &RangeNum),
+                      CFE_PSP_INVALID_MEM_RANGE);
+}
+
+void Test_CFE_PSP_MemRangeSet(void)
+{
+    /*
+     * Test Case For:
+     * int32 CFE_PSP_MemRangeSet(uint32 RangeNum, uint32 MemoryType, cpuaddr StartAddr, size_t Size, size_t WordSize,
+     *                           uint32 Attributes)
+     */
+    uint32  MemoryType;
+    cpuaddr StartAddr;
+    size_t  Size;
+    size_t  WordSize;
+    uint32  Attributes;
+
+    UtAssert_INT32_EQ(CFE_PSP_MemRangeSet(CFE_PSP_MemRanges(), CFE_PSP_MEM_RAM, 0x100, 0x100,
+                                          CFE_PSP_MEM_SIZE_BYTE, CFE_PSP_MEM_ATTR_READWRITE),
+                      CFE_PSP_INVALID_MEM_RANGE);
+    UtAssert_INT32_EQ(
+        CFE_PSP_MemRangeSet(0, CFE_PSP_MEM_ANY, 0x100, 0x100, CFE_PSP_MEM_SIZE_BYTE, CFE_PSP_MEM_ATTR_READWRITE),
+        CFE_PSP_INVALID_MEM_TYPE);
+    UtAssert_INT32_EQ(CFE_PSP_MemRangeSet(0, CFE_PSP_MEM_RAM, 0x100, 0x100, 3, CFE_PSP_MEM_ATTR_READWRITE),
+                      CFE_PSP_INVALID_MEM_WORDSIZE);
+    UtAssert_INT32_EQ(CFE_PSP_MemRangeSet(0, CFE_PSP_MEM_RAM, 0x100, 0x100, CFE_PSP_MEM_SIZE_BYTE, 0),
+                      CFE_PSP_INVALID_MEM_ATTR);
+
+    UtAssert_INT32_EQ(CFE_PSP_MemRangeSet(0, CFE_PSP_MEM_EEPROM, 0x2000, 0x40, CFE_PSP_MEM_SIZE_WORD,
+                                          CFE_PSP_MEM_ATTR_READ),
+                      CFE_PSP_SUCCESS);
+    UtAssert_INT32_EQ(CFE_PSP_MemRangeGet(0, &MemoryType, &StartAddr, &Size, &WordSize, &Attributes),
+                      CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(MemoryType, CFE_PSP_MEM_EEPROM);
+    UtAssert_True(StartAddr == 0x2000, "StartAddr (%lx) == 0x2000", (unsigned long)StartAddr);
+    UtAssert_True(Size == 0x40, "Size (%lu) == 0x40", (unsigned long)Size);
+
+    /* The index follows the table */
+    UtAssert_INT32_EQ(CFE_PSP_MemValidateRange(0x2000, 0x40, CFE_PSP_MEM_EEPROM), CFE_PSP_SUCCESS);
+}
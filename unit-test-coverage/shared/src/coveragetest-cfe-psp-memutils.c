@@ -0,0 +1,158 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ * \ingroup  shared
+ *
+ * Coverage tests for the bulk memory routines
+ */
+
+#include <string.h>
+
+#include "utassert.h"
+#include "utstubs.h"
+
+#include "cfe_psp.h"
+#include "coveragetest-psp-shared.h"
+
+static uint8 UT_MemSrc[259];
+static uint8 UT_MemDest[272];
+
+static void UT_MemUtils_Setup(void)
+{
+    uint32 i;
+
+    for (i = 0; i < sizeof(UT_MemSrc); ++i)
+    {
+        UT_MemSrc[i] = (uint8)(i * 7 + 1);
+    }
+    memset(UT_MemDest, 0, sizeof(UT_MemDest));
+}
+
+void Test_CFE_PSP_MemCpy64(void)
+{
+    /*
+     * Test Case For:
+     * int32 CFE_PSP_MemCpy64(void *dest, const void *src, size_t n)
+     */
+    UT_MemUtils_Setup();
+    UtAssert_INT32_EQ(CFE_PSP_MemCpy64(UT_MemDest, UT_MemSrc, sizeof(UT_MemSrc)), CFE_PSP_SUCCESS);
+    UtAssert_True(memcmp(UT_MemDest, UT_MemSrc, sizeof(UT_MemSrc)) == 0, "MemCpy64 content");
+}
+
+void Test_CFE_PSP_MemCpyStream(void)
+{
+    /*
+     * Test Case For:
+     * int32 CFE_PSP_MemCpyStream(void *dest, const void *src, size_t n)
+     */
+    uint32 Offset;
+
+    /* every destination alignment, with an odd length */
+    for (Offset = 0; Offset < 8; ++Offset)
+    {
+        UT_MemUtils_Setup();
+        UtAssert_INT32_EQ(CFE_PSP_MemCpyStream(&UT_MemDest[Offset], UT_MemSrc, sizeof(UT_MemSrc)), CFE_PSP_SUCCESS);
+        UtAssert_True(memcmp(&UT_MemDest[Offset], UT_MemSrc, sizeof(UT_MemSrc)) == 0, "MemCpyStream content, offset %u",
+                      (unsigned int)Offset);
+        UtAssert_UINT32_EQ(UT_MemDest[Offset + sizeof(UT_MemSrc)], 0);
+    }
+
+    /* shorter than the destination alignment */
+    UT_MemUtils_Setup();
+    UtAssert_INT32_EQ(CFE_PSP_MemCpyStream(&UT_MemDest[1], UT_MemSrc, 3), CFE_PSP_SUCCESS);
+    UtAssert_True(memcmp(&UT_MemDest[1], UT_MemSrc, 3) == 0, "MemCpyStream short content");
+    UtAssert_UINT32_EQ(UT_MemDest[4], 0);
+}
+
+void Test_CFE_PSP_MemCmp(void)
+{
+    /*
+     * Test Case For:
+     * int32 CFE_PSP_MemCmp(const void *s1, const void *s2, size_t n, size_t *MismatchOffset)
+     */
+    size_t Offset;
+
+    UT_MemUtils_Setup();
+    memcpy(UT_MemDest, UT_MemSrc, sizeof(UT_MemSrc));
+
+    UtAssert_INT32_EQ(CFE_PSP_MemCmp(NULL, UT_MemSrc, 1, &Offset), CFE_PSP_INVALID_POINTER);
+    UtAssert_INT32_EQ(CFE_PSP_MemCmp(UT_MemSrc, NULL, 1, &Offset), CFE_PSP_INVALID_POINTER);
+
+    UtAssert_INT32_EQ(CFE_PSP_MemCmp(UT_MemDest, UT_MemSrc, sizeof(UT_MemSrc), &Offset), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Offset, sizeof(UT_MemSrc));
+    UtAssert_INT32_EQ(CFE_PSP_MemCmp(UT_MemDest, UT_MemSrc, 0, NULL), CFE_PSP_SUCCESS);
+
+    /* difference within the word compare */
+    UT_MemDest[101] ^= 0x10;
+    UtAssert_INT32_EQ(CFE_PSP_MemCmp(UT_MemDest, UT_MemSrc, sizeof(UT_MemSrc), &Offset), CFE_PSP_ERROR);
+    UtAssert_UINT32_EQ(Offset, 101);
+    UtAssert_INT32_EQ(CFE_PSP_MemCmp(UT_MemDest, UT_MemSrc, sizeof(UT_MemSrc), NULL), CFE_PSP_ERROR);
+    UT_MemDest[101] ^= 0x10;
+
+    /* difference in the trailing bytes */
+    UT_MemDest[sizeof(UT_MemSrc) - 1] ^= 0x01;
+    UtAssert_INT32_EQ(CFE_PSP_MemCmp(UT_MemDest, UT_MemSrc, sizeof(UT_MemSrc), &Offset), CFE_PSP_ERROR);
+    UtAssert_UINT32_EQ(Offset, sizeof(UT_MemSrc) - 1);
+}
+
+void Test_CFE_PSP_MemChecksum(void)
+{
+    /*
+     * Test Case For:
+     * int32 CFE_PSP_MemChecksum(const void *src, size_t n, uint32 Type, uint32 *Checksum)
+     */
+    uint32 Checksum;
+    uint32 Expected;
+
+    Checksum = 0;
+    UtAssert_INT32_EQ(CFE_PSP_MemChecksum(NULL, 1, CFE_PSP_MEM_CHECKSUM_CRC32C, &Checksum), CFE_PSP_INVALID_POINTER);
+    UtAssert_INT32_EQ(CFE_PSP_MemChecksum("1", 1, CFE_PSP_MEM_CHECKSUM_CRC32C, NULL), CFE_PSP_INVALID_POINTER);
+    UtAssert_INT32_EQ(CFE_PSP_MemChecksum("1", 1, 0, &Checksum), CFE_PSP_ERROR);
+
+    /* standard check values */
+    Checksum = 0;
+    UtAssert_INT32_EQ(CFE_PSP_MemChecksum("123456789", 9, CFE_PSP_MEM_CHECKSUM_CRC32C, &Checksum), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Checksum, 0xE3069283);
+
+    Checksum = 0;
+    UtAssert_INT32_EQ(CFE_PSP_MemChecksum("abcde", 5, CFE_PSP_MEM_CHECKSUM_FLETCHER32, &Checksum), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Checksum, 0xF04FC729);
+
+    Checksum = 0;
+    UtAssert_INT32_EQ(CFE_PSP_MemChecksum("abcdef", 6, CFE_PSP_MEM_CHECKSUM_FLETCHER32, &Checksum), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Checksum, 0x56502D2A);
+
+    /* incremental computation matches a single pass */
+    UT_MemUtils_Setup();
+
+    Expected = 0;
+    CFE_PSP_MemChecksum(UT_MemSrc, sizeof(UT_MemSrc), CFE_PSP_MEM_CHECKSUM_CRC32C, &Expected);
+    Checksum = 0;
+    CFE_PSP_MemChecksum(UT_MemSrc, 13, CFE_PSP_MEM_CHECKSUM_CRC32C, &Checksum);
+    CFE_PSP_MemChecksum(&UT_MemSrc[13], sizeof(UT_MemSrc) - 13, CFE_PSP_MEM_CHECKSUM_CRC32C, &Checksum);
+    UtAssert_UINT32_EQ(Checksum, Expected);
+
+    Expected = 0;
+    CFE_PSP_MemChecksum(UT_MemSrc, sizeof(UT_MemSrc), CFE_PSP_MEM_CHECKSUM_FLETCHER32, &Expected);
+    Checksum = 0;
+    CFE_PSP_MemChecksum(UT_MemSrc, 14, CFE_PSP_MEM_CHECKSUM_FLETCHER32, &Checksum);
+    CFE_PSP_MemChecksum(&UT_MemSrc[14], sizeof(UT_MemSrc) - 14, CFE_PSP_MEM_CHECKSUM_FLETCHER32, &Checksum);
+    UtAssert_UINT32_EQ(Checksum, Expected);
+}
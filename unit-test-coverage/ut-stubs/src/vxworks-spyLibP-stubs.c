@@ -26,7 +26,9 @@
 
 void PCS_spyReportCommon(PCS_FUNCPTR print)
 {
-    /* Not Implement*/
+    UT_GenStub_AddParam(PCS_spyReportCommon, PCS_FUNCPTR, print);
+
+    UT_GenStub_Execute(PCS_spyReportCommon, Basic, NULL);
 }
 
 void PCS_spyClkStopCommon(void)
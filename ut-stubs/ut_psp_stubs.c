@@ -265,6 +265,112 @@ int32 CFE_PSP_ReadFromCDS(void *PtrToDataToRead, uint32 CDSOffset, uint32 NumByt
     return status;
 }
 
+/*****************************************************************************/
+/**
+** \brief CFE_PSP_WriteToCDSv stub function
+**
+** \par Description
+**        This function is used to mimic the response of the PSP function
+**        CFE_PSP_WriteToCDSv.  Each entry is copied into the data buffer
+**        registered for CFE_PSP_WriteToCDS, if any.
+**
+** \par Assumptions, External Events, and Notes:
+**        None
+**
+** \returns
+**        Returns either OS_SUCCESS, OS_ERROR, or a user-defined value.
+**
+******************************************************************************/
+int32 CFE_PSP_WriteToCDSv(const CFE_PSP_CDSWriteVec_t *Vec, uint32 NumEntries, uint32 Flags)
+{
+    uint8 *BufPtr;
+    size_t CdsSize;
+    size_t Position;
+    uint32 i;
+    int32  status;
+
+    status = UT_DEFAULT_IMPL(CFE_PSP_WriteToCDSv);
+
+    if (status >= 0)
+    {
+        UT_GetDataBuffer(UT_KEY(CFE_PSP_WriteToCDS), (void **)&BufPtr, &CdsSize, &Position);
+        for (i = 0; BufPtr != NULL && i < NumEntries; ++i)
+        {
+            if ((Vec[i].CDSOffset + Vec[i].NumBytes) <= CdsSize)
+            {
+                memcpy(BufPtr + Vec[i].CDSOffset, Vec[i].DataPtr, Vec[i].NumBytes);
+            }
+        }
+    }
+
+    return status;
+}
+
+/*****************************************************************************/
+/**
+** \brief CFE_PSP_ReadFromCDSv stub function
+**
+** \par Description
+**        This function is used to mimic the response of the PSP function
+**        CFE_PSP_ReadFromCDSv.  Each entry is copied from the data buffer
+**        registered for CFE_PSP_ReadFromCDS, if any.
+**
+** \par Assumptions, External Events, and Notes:
+**        None
+**
+** \returns
+**        Returns either OS_SUCCESS, OS_ERROR, or a user-defined value.
+**
+******************************************************************************/
+int32 CFE_PSP_ReadFromCDSv(const CFE_PSP_CDSReadVec_t *Vec, uint32 NumEntries, uint32 Flags)
+{
+    uint8 *BufPtr;
+    size_t CdsSize;
+    size_t Position;
+    uint32 i;
+    int32  status;
+
+    status = UT_DEFAULT_IMPL(CFE_PSP_ReadFromCDSv);
+
+    if (status >= 0)
+    {
+        UT_GetDataBuffer(UT_KEY(CFE_PSP_ReadFromCDS), (void **)&BufPtr, &CdsSize, &Position);
+        for (i = 0; BufPtr != NULL && i < NumEntries; ++i)
+        {
+            if ((Vec[i].CDSOffset + Vec[i].NumBytes) <= CdsSize)
+            {
+                memcpy(Vec[i].DataPtr, BufPtr + Vec[i].CDSOffset, Vec[i].NumBytes);
+            }
+        }
+    }
+
+    return status;
+}
+
+/*****************************************************************************/
+/**
+** \brief CFE_PSP_FlushCDS stub function
+**
+** \par Description
+**        This function is used to mimic the response of the PSP function
+**        CFE_PSP_FlushCDS.
+**
+** \par Assumptions, External Events, and Notes:
+**        None
+**
+** \returns
+**        Returns either OS_SUCCESS or a user-defined value.
+**
+******************************************************************************/
+int32 CFE_PSP_FlushCDS(void)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(CFE_PSP_FlushCDS);
+
+    return status;
+}
+
 /*****************************************************************************/
 /**
 ** \brief CFE_PSP_GetCDSSize stub function
@@ -624,6 +730,66 @@ int32 CFE_PSP_MemRead8(cpuaddr Address, uint8 *Data)
     return status;
 }
 
+/*****************************************************************************/
+/**
+** \brief CFE_PSP_MemReadBlock stub function
+**
+** \par Description
+**        This function is used to mimic the response of the PSP function
+**        CFE_PSP_MemReadBlock.  The buffer is filled from the data buffer
+**        registered for this function, if any.
+**
+** \par Assumptions, External Events, and Notes:
+**        None
+**
+** \returns
+**        Returns OS_SUCCESS or a user-defined value.
+**
+******************************************************************************/
+int32 CFE_PSP_MemReadBlock(cpuaddr MemoryAddress, void *Buffer, size_t Size)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(CFE_PSP_MemReadBlock);
+
+    if (status >= 0)
+    {
+        UT_Stub_CopyToLocal(UT_KEY(CFE_PSP_MemReadBlock), Buffer, Size);
+    }
+
+    return status;
+}
+
+/*****************************************************************************/
+/**
+** \brief CFE_PSP_MemWriteBlock stub function
+**
+** \par Description
+**        This function is used to mimic the response of the PSP function
+**        CFE_PSP_MemWriteBlock.  The buffer is copied into the data buffer
+**        registered for this function, if any.
+**
+** \par Assumptions, External Events, and Notes:
+**        None
+**
+** \returns
+**        Returns OS_SUCCESS or a user-defined value.
+**
+******************************************************************************/
+int32 CFE_PSP_MemWriteBlock(cpuaddr MemoryAddress, const void *Buffer, size_t Size)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(CFE_PSP_MemWriteBlock);
+
+    if (status >= 0)
+    {
+        UT_Stub_CopyFromLocal(UT_KEY(CFE_PSP_MemWriteBlock), Buffer, Size);
+    }
+
+    return status;
+}
+
 /*****************************************************************************/
 /**
 ** \brief CFE_PSP_MemValidateRange stub function
@@ -653,6 +819,36 @@ int32 CFE_PSP_MemValidateRange(cpuaddr Address, size_t Size, uint32 MemoryType)
     return status;
 }
 
+/*****************************************************************************/
+/**
+** \brief CFE_PSP_MemRangeFind stub function
+**
+** \par Description
+**        This function is used to mimic the response of the PSP function
+**        CFE_PSP_MemRangeFind.  The range number is copied from the data
+**        buffer registered for this function, if any.
+**
+** \par Assumptions, External Events, and Notes:
+**        None
+**
+** \returns
+**        Returns OS_SUCCESS or a user-defined value.
+**
+******************************************************************************/
+int32 CFE_PSP_MemRangeFind(cpuaddr Address, size_t Size, uint32 Attributes, uint32 *RangeNum)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(CFE_PSP_MemRangeFind);
+
+    if (status >= 0 && RangeNum != NULL)
+    {
+        UT_Stub_CopyToLocal(UT_KEY(CFE_PSP_MemRangeFind), RangeNum, sizeof(*RangeNum));
+    }
+
+    return status;
+}
+
 /*****************************************************************************/
 /**
 ** \brief CFE_PSP_MemCpy stub function
@@ -713,6 +909,125 @@ int32 CFE_PSP_MemSet(void *dest, uint8 value, uint32 n)
     return status;
 }
 
+/*****************************************************************************/
+/**
+** \brief CFE_PSP_MemCpy64 stub function
+**
+** \par Description
+**        This function is used to mimic the response of the PSP function
+**        CFE_PSP_MemCpy64.  The copy is performed if the status is not negative.
+**
+** \par Assumptions, External Events, and Notes:
+**        None
+**
+** \returns
+**        Returns OS_SUCCESS or a user-defined value.
+**
+******************************************************************************/
+int32 CFE_PSP_MemCpy64(void *dest, const void *src, size_t n)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(CFE_PSP_MemCpy64);
+
+    if (status >= 0)
+    {
+        /* this is not actually a stub; it actually has to _do_ the intended function */
+        memcpy(dest, src, n);
+    }
+
+    return status;
+}
+
+/*****************************************************************************/
+/**
+** \brief CFE_PSP_MemCpyStream stub function
+**
+** \par Description
+**        This function is used to mimic the response of the PSP function
+**        CFE_PSP_MemCpyStream.  The copy is performed if the status is not negative.
+**
+** \par Assumptions, External Events, and Notes:
+**        None
+**
+** \returns
+**        Returns OS_SUCCESS or a user-defined value.
+**
+******************************************************************************/
+int32 CFE_PSP_MemCpyStream(void *dest, const void *src, size_t n)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(CFE_PSP_MemCpyStream);
+
+    if (status >= 0)
+    {
+        /* this is not actually a stub; it actually has to _do_ the intended function */
+        memcpy(dest, src, n);
+    }
+
+    return status;
+}
+
+/*****************************************************************************/
+/**
+** \brief CFE_PSP_MemCmp stub function
+**
+** \par Description
+**        This function is used to mimic the response of the PSP function
+**        CFE_PSP_MemCmp.  The mismatch offset is set to 0.
+**
+** \par Assumptions, External Events, and Notes:
+**        None
+**
+** \returns
+**        Returns OS_SUCCESS or a user-defined value.
+**
+******************************************************************************/
+int32 CFE_PSP_MemCmp(const void *s1, const void *s2, size_t n, size_t *MismatchOffset)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(CFE_PSP_MemCmp);
+
+    if (MismatchOffset != NULL)
+    {
+        *MismatchOffset = 0;
+    }
+
+    return status;
+}
+
+/*****************************************************************************/
+/**
+** \brief CFE_PSP_MemChecksum stub function
+**
+** \par Description
+**        This function is used to mimic the response of the PSP function
+**        CFE_PSP_MemChecksum.  The checksum is copied from the data
+**        buffer registered for this function, if any.
+**
+** \par Assumptions, External Events, and Notes:
+**        None
+**
+** \returns
+**        Returns OS_SUCCESS or a user-defined value.
+**
+******************************************************************************/
+int32 CFE_PSP_MemChecksum(const void *src, size_t n, uint32 Type, uint32 *Checksum)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(CFE_PSP_MemChecksum);
+
+    if (status >= 0 && Checksum != NULL)
+    {
+        UT_Stub_CopyToLocal(UT_KEY(CFE_PSP_MemChecksum), Checksum, sizeof(*Checksum));
+    }
+
+    return status;
+}
+
 uint32 CFE_PSP_Exception_GetCount(void)
 {
     int32 status;